@@ -26,6 +26,7 @@
 #include <wpi/MemAlloc.h>
 #include <wpi/SmallString.h>
 #include <wpi/StringExtras.h>
+#include <wpi/Trace.h>
 #include <wpi/fs.h>
 #include <wpi/raw_ostream.h>
 #include <wpi/timestamp.h>
@@ -363,6 +364,8 @@ void UsbCameraImpl::Start() {
 }
 
 void UsbCameraImpl::CameraThreadMain() {
+  wpi::trace::SetThreadName("UsbCamera");
+
   // We want to be notified on file creation and deletion events in the device
   // path.  This is used to detect disconnects and reconnects.
   std::unique_ptr<wpi::raw_fd_istream> notify_is;
@@ -510,6 +513,7 @@ void UsbCameraImpl::CameraThreadMain() {
       }
 
       if ((buf.flags & V4L2_BUF_FLAG_ERROR) == 0) {
+        WPI_TRACE_SCOPE("UsbCamera frame");
         SDEBUG4("got image size={} index={}", buf.bytesused, buf.index);
 
         if (buf.index >= kNumBuffers || !m_buffers[buf.index].m_data) {
@@ -0,0 +1,304 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+// Runs a representative robot in simulation with fast timing and reports the
+// achievable real-time factor, where each tick's time goes and the heap
+// allocations per tick.
+//
+// Usage: hal_bench [--ticks=<count>]
+//
+// Runs in the default sim context, so extensions loaded through
+// HALSIM_EXTENSIONS (e.g. halsim_ws_server) observe the robot and their costs
+// show up in the report.
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string_view>
+
+#include <fmt/format.h>
+
+#include "hal/AnalogInput.h"
+#include "hal/DIO.h"
+#include "hal/DriverStation.h"
+#include "hal/Encoder.h"
+#include "hal/HAL.h"
+#include "hal/Notifier.h"
+#include "hal/PWM.h"
+#include "hal/simulation/AnalogInData.h"
+#include "hal/simulation/DIOData.h"
+#include "hal/simulation/DriverStationData.h"
+#include "hal/simulation/EncoderData.h"
+#include "hal/simulation/MockHooks.h"
+#include "hal/simulation/PWMData.h"
+
+static std::atomic<uint64_t> gAllocations{0};
+
+#ifdef __GLIBC__
+// Count every allocation in the process, including those made by the HAL, its
+// threads and extensions, by interposing the glibc allocation functions
+extern "C" {
+void* __libc_malloc(size_t size) noexcept;
+void* __libc_calloc(size_t count, size_t size) noexcept;
+void* __libc_realloc(void* ptr, size_t size) noexcept;
+void* __libc_memalign(size_t alignment, size_t size) noexcept;
+
+void* malloc(size_t size) noexcept {
+  gAllocations.fetch_add(1, std::memory_order_relaxed);
+  return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) noexcept {
+  gAllocations.fetch_add(1, std::memory_order_relaxed);
+  return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, size_t size) noexcept {
+  gAllocations.fetch_add(1, std::memory_order_relaxed);
+  return __libc_realloc(ptr, size);
+}
+
+void* aligned_alloc(size_t alignment, size_t size) noexcept {
+  gAllocations.fetch_add(1, std::memory_order_relaxed);
+  return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void** ptr, size_t alignment, size_t size) noexcept {
+  gAllocations.fetch_add(1, std::memory_order_relaxed);
+  *ptr = __libc_memalign(alignment, size);
+  return *ptr ? 0 : ENOMEM;
+}
+}  // extern "C"
+#endif
+
+using Clock = std::chrono::steady_clock;
+
+namespace hal {
+
+namespace {
+
+constexpr uint64_t kPeriod = 20000;
+constexpr double kDt = kPeriod * 1.0e-6;
+
+// Wall time spent in each part of the sim ticks
+struct TickTimes {
+  Clock::duration robot{};
+  Clock::duration physics{};
+  Clock::duration callbacks{};
+  Clock::duration periodic{};
+  Clock::duration total{};
+};
+
+// Stands in for an extension sending every changed value to a remote
+// simulator
+void ObserveCallback(const char* name, void* param, const HAL_Value* value) {
+  auto start = Clock::now();
+  char buf[64];
+  std::snprintf(buf, sizeof(buf), "{\"%s\":%g}", name,
+                value->type == HAL_DOUBLE
+                    ? value->data.v_double
+                    : static_cast<double>(value->data.v_int));
+  static_cast<TickTimes*>(param)->callbacks += Clock::now() - start;
+}
+
+// A differential drive robot driven by joystick 0, with an encoder per side,
+// a limit switch and a pressure sensor
+class Robot {
+ public:
+  explicit Robot(TickTimes* times) {
+    int32_t status = 0;
+    for (int i = 0; i < 2; ++i) {
+      m_motors[i] = HAL_InitializePWMPort(HAL_GetPort(kMotorChannels[i]),
+                                          nullptr, &status);
+      m_encoderA[i] = HAL_InitializeDIOPort(
+          HAL_GetPort(kEncoderChannels[i]), true, nullptr, &status);
+      m_encoderB[i] = HAL_InitializeDIOPort(
+          HAL_GetPort(kEncoderChannels[i] + 1), true, nullptr, &status);
+      m_encoders[i] = HAL_InitializeEncoder(
+          m_encoderA[i], HAL_Trigger_kInWindow, m_encoderB[i],
+          HAL_Trigger_kInWindow, false, HAL_Encoder_k4X, &status);
+      m_simEncoders[i] = HALSIM_FindEncoderForChannel(kEncoderChannels[i]);
+      m_callbacks[i] = HALSIM_RegisterPWMSpeedCallback(
+          kMotorChannels[i], ObserveCallback, times, false);
+      m_callbacks[i + 2] = HALSIM_RegisterEncoderCountCallback(
+          m_simEncoders[i], ObserveCallback, times, false);
+    }
+    m_limitSwitch = HAL_InitializeDIOPort(HAL_GetPort(kLimitSwitchChannel),
+                                          true, nullptr, &status);
+    m_pressure = HAL_InitializeAnalogInputPort(HAL_GetPort(kPressureChannel),
+                                               nullptr, &status);
+    if (status != 0) {
+      fmt::print(stderr, "failed to initialize the robot: {}\n",
+                 HAL_GetErrorMessage(status));
+      std::exit(1);
+    }
+  }
+
+  ~Robot() {
+    int32_t status = 0;
+    for (int i = 0; i < 2; ++i) {
+      HALSIM_CancelPWMSpeedCallback(kMotorChannels[i], m_callbacks[i]);
+      HALSIM_CancelEncoderCountCallback(m_simEncoders[i], m_callbacks[i + 2]);
+      HAL_FreeEncoder(m_encoders[i], &status);
+      HAL_FreeDIOPort(m_encoderA[i]);
+      HAL_FreeDIOPort(m_encoderB[i]);
+      HAL_FreePWMPort(m_motors[i], &status);
+      HALSIM_ResetPWMData(kMotorChannels[i]);
+      HALSIM_ResetEncoderData(m_simEncoders[i]);
+    }
+    HAL_FreeDIOPort(m_limitSwitch);
+    HAL_FreeAnalogInputPort(m_pressure);
+    HALSIM_ResetDIOData(kLimitSwitchChannel);
+    HALSIM_ResetAnalogInData(kPressureChannel);
+  }
+
+  // Arcade drive, slowing down near the limit switch or at low pressure
+  void RobotPeriodic() {
+    int32_t status = 0;
+    HAL_JoystickAxes axes;
+    HAL_GetJoystickAxes(0, &axes);
+    double scale = HAL_GetDIO(m_limitSwitch, &status) ||
+                           HAL_GetAnalogVoltage(m_pressure, &status) < 1.0
+                       ? 0.5
+                       : 1.0;
+    int32_t difference =
+        HAL_GetEncoder(m_encoders[0], &status) -
+        HAL_GetEncoder(m_encoders[1], &status);
+    double turn = axes.axes[1] - difference * 1.0e-4;
+    HAL_SetPWMSpeed(m_motors[0],
+                    std::clamp((axes.axes[0] + turn) * scale, -1.0, 1.0),
+                    &status);
+    HAL_SetPWMSpeed(m_motors[1],
+                    std::clamp((axes.axes[0] - turn) * scale, -1.0, 1.0),
+                    &status);
+  }
+
+  // First order wheel dynamics driving the sensors
+  void SimulationPeriodic() {
+    for (int i = 0; i < 2; ++i) {
+      double speed = HALSIM_GetPWMSpeed(kMotorChannels[i]) * kMaxSpeed;
+      m_velocity[i] += (speed - m_velocity[i]) * kDt / kTimeConstant;
+      m_position[i] += m_velocity[i] * kDt;
+      HALSIM_SetEncoderCount(m_simEncoders[i],
+                             static_cast<int32_t>(m_position[i] / kPerPulse));
+    }
+    HALSIM_SetDIOValue(kLimitSwitchChannel, m_position[0] > 100.0);
+    m_pressurePsi = std::max(m_pressurePsi - 0.01, 60.0);
+    HALSIM_SetAnalogInVoltage(kPressureChannel, m_pressurePsi / 40.0);
+  }
+
+ private:
+  static constexpr int32_t kMotorChannels[2] = {8, 9};
+  static constexpr int32_t kEncoderChannels[2] = {10, 12};
+  static constexpr int32_t kLimitSwitchChannel = 14;
+  static constexpr int32_t kPressureChannel = 3;
+  static constexpr double kMaxSpeed = 4.0;
+  static constexpr double kTimeConstant = 0.1;
+  static constexpr double kPerPulse = 0.0005;
+
+  HAL_DigitalHandle m_motors[2];
+  HAL_DigitalHandle m_encoderA[2];
+  HAL_DigitalHandle m_encoderB[2];
+  HAL_EncoderHandle m_encoders[2];
+  int32_t m_simEncoders[2];
+  int32_t m_callbacks[4];
+  HAL_DigitalHandle m_limitSwitch;
+  HAL_AnalogInputHandle m_pressure;
+  double m_velocity[2] = {0.0, 0.0};
+  double m_position[2] = {0.0, 0.0};
+  double m_pressurePsi = 120.0;
+};
+
+}  // namespace
+}  // namespace hal
+
+using namespace hal;
+
+int main(int argc, char** argv) {
+  int ticks = 3000;
+  for (int i = 1; i < argc; ++i) {
+    std::string_view arg{argv[i]};
+    if (arg.substr(0, 8) == "--ticks=" && std::atoi(argv[i] + 8) > 0) {
+      ticks = std::atoi(argv[i] + 8);
+    } else {
+      fmt::print(stderr, "Usage: {} [--ticks=<count>]\n", argv[0]);
+      return 1;
+    }
+  }
+  auto perTickUs = [&](Clock::duration time) {
+    return std::chrono::duration<double, std::micro>(time).count() / ticks;
+  };
+
+  if (!HAL_Initialize(500, 0)) {
+    fmt::print(stderr, "failed to initialize the HAL\n");
+    return 1;
+  }
+
+  TickTimes times;
+  Robot robot{&times};
+  HAL_JoystickAxes axes{};
+  axes.count = 2;
+  axes.axes[0] = 0.8f;
+  axes.axes[1] = 0.1f;
+  HALSIM_SetJoystickAxes(0, &axes);
+
+  int32_t status = 0;
+  HAL_NotifierHandle notifier = HAL_InitializeNotifier(&status);
+  HALSIM_SetFastTiming(true);
+  uint64_t startAllocations = gAllocations.load(std::memory_order_relaxed);
+  uint64_t startTime = HAL_GetFPGATime(&status);
+  auto start = Clock::now();
+  for (int i = 1; i <= ticks; ++i) {
+    HAL_UpdateNotifierAlarm(notifier, startTime + i * kPeriod, &status);
+    if (HAL_WaitForNotifierAlarm(notifier, &status) == 0) {
+      break;
+    }
+    // The same order as TimedRobot
+    auto robotStart = Clock::now();
+    robot.RobotPeriodic();
+    auto beforeStart = Clock::now();
+    HAL_SimPeriodicBefore();
+    auto physicsStart = Clock::now();
+    robot.SimulationPeriodic();
+    auto afterStart = Clock::now();
+    HAL_SimPeriodicAfter();
+    auto end = Clock::now();
+    times.robot += beforeStart - robotStart;
+    times.physics += afterStart - physicsStart;
+    times.periodic += (physicsStart - beforeStart) + (end - afterStart);
+  }
+  times.total = Clock::now() - start;
+  uint64_t allocations =
+      gAllocations.load(std::memory_order_relaxed) - startAllocations;
+  HALSIM_SetFastTiming(false);
+  HAL_StopNotifier(notifier, &status);
+  HAL_CleanNotifier(notifier, &status);
+
+  const char* extensions = std::getenv("HALSIM_EXTENSIONS");
+  Clock::duration timing =
+      times.total - times.robot - times.physics - times.periodic;
+  fmt::print("extensions: {}\n", extensions ? extensions : "none");
+  fmt::print("real-time factor: {:.1f}\n",
+             ticks * kDt / std::chrono::duration<double>(times.total).count());
+  fmt::print("per tick: {:.2f} us\n", perTickUs(times.total));
+  fmt::print("  robot code: {:.2f} us\n", perTickUs(times.robot));
+  fmt::print("  physics: {:.2f} us\n", perTickUs(times.physics));
+  fmt::print("  HAL callbacks (within the above): {:.2f} us\n",
+             perTickUs(times.callbacks));
+  fmt::print("  extension sim periodic: {:.2f} us\n",
+             perTickUs(times.periodic));
+  fmt::print("  notifier and timing: {:.2f} us\n", perTickUs(timing));
+#ifdef __GLIBC__
+  fmt::print("allocations per tick: {:.2f}\n",
+             static_cast<double>(allocations) / ticks);
+#else
+  static_cast<void>(allocations);
+  fmt::print("allocations per tick: -\n");
+#endif
+}
@@ -27,5 +27,9 @@ public class SimulatorJNI extends JNIWrapper {
 
   public static native void stepTimingAsync(long delta);
 
+  public static native void setFastTiming(boolean fast);
+
+  public static native boolean isFastTiming();
+
   public static native void resetHandles();
 }
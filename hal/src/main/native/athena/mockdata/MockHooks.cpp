@@ -30,6 +30,12 @@ void HALSIM_StepTiming(uint64_t delta) {}
 
 void HALSIM_StepTimingAsync(uint64_t delta) {}
 
+void HALSIM_SetFastTiming(HAL_Bool fast) {}
+
+HAL_Bool HALSIM_IsFastTiming(void) {
+  return false;
+}
+
 void HALSIM_SetSendError(HALSIM_SendErrorHandler handler) {}
 
 void HALSIM_SetSendConsoleLine(HALSIM_SendConsoleLineHandler handler) {}
@@ -48,4 +54,18 @@ int32_t HALSIM_RegisterSimPeriodicAfterCallback(
 
 void HALSIM_CancelSimPeriodicAfterCallback(int32_t uid) {}
 
+int32_t HALSIM_CreateSimContext(void) {
+  return 0;
+}
+
+HAL_Bool HALSIM_DestroySimContext(int32_t context) {
+  return false;
+}
+
+void HALSIM_SetThreadSimContext(int32_t context) {}
+
+int32_t HALSIM_GetThreadSimContext(void) {
+  return 0;
+}
+
 }  // extern "C"
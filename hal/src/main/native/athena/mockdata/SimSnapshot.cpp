@@ -0,0 +1,24 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "hal/simulation/SimSnapshot.h"
+
+extern "C" {
+
+int32_t HALSIM_SaveSimSnapshot(uint8_t* buffer, int32_t size) {
+  return 0;
+}
+
+HAL_Bool HALSIM_RestoreSimSnapshot(const uint8_t* buffer, int32_t size) {
+  return false;
+}
+
+int32_t HALSIM_RegisterSimSnapshotRestoredCallback(
+    HALSIM_SimPeriodicCallback callback, void* param) {
+  return 0;
+}
+
+void HALSIM_CancelSimSnapshotRestoredCallback(int32_t uid) {}
+
+}  // extern "C"
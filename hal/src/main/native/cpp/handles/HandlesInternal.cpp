@@ -5,11 +5,62 @@
 #include "hal/handles/HandlesInternal.h"
 
 #include <algorithm>
+#include <atomic>
+#include <thread>
 
 #include <wpi/SmallVector.h>
 #include <wpi/mutex.h>
 
+#include "hal/handles/HandleSlot.h"
+
 namespace hal {
+namespace {
+// Hazard pointers of a thread. Records are never freed, and the records of
+// exited threads are reused.
+struct HazardRecord {
+  impl::HandleHazards hazards;
+  std::atomic<bool> active{true};
+  HazardRecord* next = nullptr;
+};
+
+std::atomic<HazardRecord*> hazardRecords{nullptr};
+
+struct ThreadHazard {
+  ThreadHazard() {
+    for (record = hazardRecords.load(std::memory_order_acquire); record;
+         record = record->next) {
+      bool active = false;
+      if (record->active.compare_exchange_strong(active, true)) {
+        return;
+      }
+    }
+    record = new HazardRecord;
+    record->next = hazardRecords.load(std::memory_order_relaxed);
+    while (!hazardRecords.compare_exchange_weak(record->next, record)) {
+    }
+  }
+  ~ThreadHazard() { record->active.store(false, std::memory_order_release); }
+
+  HazardRecord* record;
+};
+}  // namespace
+
+impl::HandleHazards& impl::GetHandleHazards() {
+  thread_local ThreadHazard threadHazard;
+  return threadHazard.record->hazards;
+}
+
+void impl::WaitForHandleReaders(const void* ptr) {
+  for (auto record = hazardRecords.load(std::memory_order_acquire); record;
+       record = record->next) {
+    for (auto&& hazard : record->hazards.hazards) {
+      while (hazard.load(std::memory_order_seq_cst) == ptr) {
+        std::this_thread::yield();
+      }
+    }
+  }
+}
+
 static wpi::SmallVector<HandleBase*, 32>* globalHandles = nullptr;
 static wpi::mutex globalHandleMutex;
 HandleBase::HandleBase() {
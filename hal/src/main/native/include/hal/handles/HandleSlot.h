@@ -0,0 +1,211 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace hal {
+
+namespace impl {
+/**
+ * The hazard pointers of a thread. A thread publishes the slot nodes it is
+ * reading there so writers don't delete them. There are several so a thread
+ * can borrow structures from several slots at once.
+ */
+struct HandleHazards {
+  static constexpr int kSize = 4;
+
+  std::atomic<const void*> hazards[kSize] = {};
+  // the number of hazard pointers held by HandleBorrows; only accessed by the
+  // owning thread
+  int inUse = 0;
+};
+
+/**
+ * Gets the hazard pointers of the calling thread.
+ */
+HandleHazards& GetHandleHazards();
+
+/**
+ * Waits until no thread's hazard pointer points to ptr.
+ */
+void WaitForHandleReaders(const void* ptr);
+}  // namespace impl
+
+template <typename TStruct>
+class HandleSlot;
+
+/**
+ * A structure borrowed from a HandleSlot without counting a reference. The
+ * slot can't free the structure while it is borrowed, so only hold it on the
+ * stack for the duration of a non-blocking call, and don't free the handle or
+ * invoke callbacks that might while holding it.
+ *
+ * @tparam TStruct The struct type held by the slot
+ */
+template <typename TStruct>
+class HandleBorrow {
+ public:
+  HandleBorrow() = default;
+  HandleBorrow(const HandleBorrow&) = delete;
+  HandleBorrow& operator=(const HandleBorrow&) = delete;
+  ~HandleBorrow() {
+    if (m_hazards) {
+      // borrows are scoped, so this is the last hazard pointer in use
+      m_hazards->hazards[--m_hazards->inUse].store(nullptr,
+                                                   std::memory_order_release);
+    }
+  }
+
+  TStruct* get() const { return m_structure; }
+  TStruct& operator*() const { return *m_structure; }
+  TStruct* operator->() const { return m_structure; }
+  explicit operator bool() const { return m_structure != nullptr; }
+
+  friend bool operator==(const HandleBorrow& lhs, std::nullptr_t) {
+    return lhs.m_structure == nullptr;
+  }
+  friend bool operator!=(const HandleBorrow& lhs, std::nullptr_t) {
+    return lhs.m_structure != nullptr;
+  }
+
+ private:
+  friend class HandleSlot<TStruct>;
+
+  HandleBorrow(TStruct* structure, impl::HandleHazards* hazards)
+      : m_structure{structure}, m_hazards{hazards} {}
+  explicit HandleBorrow(std::shared_ptr<TStruct> structure)
+      : m_structure{structure.get()}, m_owned{std::move(structure)} {}
+
+  TStruct* m_structure = nullptr;
+  // the hazard pointers protecting the structure, or null if m_owned holds it
+  impl::HandleHazards* m_hazards = nullptr;
+  std::shared_ptr<TStruct> m_owned;
+};
+
+/**
+ * A slot holding the structure of a handle. Reading it is lock-free, so
+ * resolving a handle doesn't contend with other threads using the same
+ * handle. Writes must be serialized by the caller.
+ *
+ * @tparam TStruct The struct type held by the slot
+ */
+template <typename TStruct>
+class HandleSlot {
+ public:
+  HandleSlot() = default;
+  HandleSlot(const HandleSlot&) = delete;
+  HandleSlot& operator=(const HandleSlot&) = delete;
+  ~HandleSlot() { delete m_node.load(std::memory_order_relaxed); }
+
+  /**
+   * Gets the structure, or nullptr if the slot is empty.
+   */
+  std::shared_ptr<TStruct> Get() const;
+
+  /**
+   * Borrows the structure, which is empty if the slot is. This is cheaper than
+   * Get() as it doesn't count a reference.
+   */
+  HandleBorrow<TStruct> Borrow() const;
+
+  /**
+   * Returns true if the slot is empty.
+   */
+  bool IsEmpty() const {
+    return m_node.load(std::memory_order_acquire) == nullptr;
+  }
+
+  /**
+   * Replaces the structure, waiting for threads reading the old one to finish
+   * copying it.
+   *
+   * @return The previous structure
+   */
+  std::shared_ptr<TStruct> Exchange(std::shared_ptr<TStruct> structure);
+
+ private:
+  struct Node {
+    std::shared_ptr<TStruct> structure;
+  };
+
+  // Publishes the current node in hazard and returns it, or returns nullptr
+  // with hazard cleared if the slot is empty
+  Node* Protect(std::atomic<const void*>& hazard) const;
+
+  std::atomic<Node*> m_node{nullptr};
+};
+
+template <typename TStruct>
+typename HandleSlot<TStruct>::Node* HandleSlot<TStruct>::Protect(
+    std::atomic<const void*>& hazard) const {
+  Node* node = m_node.load(std::memory_order_acquire);
+  // publish the node, then make sure it wasn't replaced before it was
+  // published
+  while (node) {
+    hazard.store(node, std::memory_order_seq_cst);
+    Node* current = m_node.load(std::memory_order_seq_cst);
+    if (current == node) {
+      return node;
+    }
+    node = current;
+  }
+  hazard.store(nullptr, std::memory_order_release);
+  return nullptr;
+}
+
+template <typename TStruct>
+std::shared_ptr<TStruct> HandleSlot<TStruct>::Get() const {
+  if (IsEmpty()) {
+    return nullptr;
+  }
+  // the hazard pointer after the borrowed ones is only used while copying
+  auto& hazards = impl::GetHandleHazards();
+  auto& hazard = hazards.hazards[hazards.inUse];
+  Node* node = Protect(hazard);
+  if (!node) {
+    return nullptr;
+  }
+  std::shared_ptr<TStruct> structure = node->structure;
+  hazard.store(nullptr, std::memory_order_release);
+  return structure;
+}
+
+template <typename TStruct>
+HandleBorrow<TStruct> HandleSlot<TStruct>::Borrow() const {
+  if (IsEmpty()) {
+    return {};
+  }
+  auto& hazards = impl::GetHandleHazards();
+  // keep the last hazard pointer for Get()
+  if (hazards.inUse >= impl::HandleHazards::kSize - 1) {
+    return HandleBorrow<TStruct>{Get()};
+  }
+  Node* node = Protect(hazards.hazards[hazards.inUse]);
+  if (!node) {
+    return {};
+  }
+  ++hazards.inUse;
+  return HandleBorrow<TStruct>{node->structure.get(), &hazards};
+}
+
+template <typename TStruct>
+std::shared_ptr<TStruct> HandleSlot<TStruct>::Exchange(
+    std::shared_ptr<TStruct> structure) {
+  Node* node = structure ? new Node{std::move(structure)} : nullptr;
+  Node* old = m_node.exchange(node, std::memory_order_seq_cst);
+  if (!old) {
+    return nullptr;
+  }
+  impl::WaitForHandleReaders(old);
+  std::shared_ptr<TStruct> oldStructure = std::move(old->structure);
+  delete old;
+  return oldStructure;
+}
+
+}  // namespace hal
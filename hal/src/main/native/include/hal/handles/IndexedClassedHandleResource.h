@@ -14,6 +14,7 @@
 
 #include "hal/Errors.h"
 #include "hal/Types.h"
+#include "hal/handles/HandleSlot.h"
 #include "hal/handles/HandlesInternal.h"
 
 namespace hal {
@@ -23,7 +24,8 @@ namespace hal {
  * version
  * allows a limited number of handles that are allocated by index.
  * Because they are allocated by index, each individual index holds its own
- * mutex, which reduces contention heavily.]
+ * mutex for allocation, which reduces contention heavily. Getting a handle's
+ * structure doesn't lock.
  *
  * @tparam THandle The Handle Type (Must be typedefed from HAL_Handle)
  * @tparam TStruct The struct type held by this resource
@@ -52,7 +54,7 @@ class IndexedClassedHandleResource : public HandleBase {
   void ResetHandles() override;
 
  private:
-  std::array<std::shared_ptr<TStruct>, size> m_structures;
+  std::array<HandleSlot<TStruct>, size> m_structures;
   std::array<wpi::mutex, size> m_handleMutexes;
 };
 
@@ -68,11 +70,11 @@ IndexedClassedHandleResource<THandle, TStruct, size, enumValue>::Allocate(
   }
   std::scoped_lock lock(m_handleMutexes[index]);
   // check for allocation, otherwise allocate and return a valid handle
-  if (m_structures[index] != nullptr) {
+  if (!m_structures[index].IsEmpty()) {
     *status = RESOURCE_IS_ALLOCATED;
     return HAL_kInvalidHandle;
   }
-  m_structures[index] = toSet;
+  m_structures[index].Exchange(toSet);
   return static_cast<THandle>(hal::createHandle(index, enumValue, m_version));
 }
 
@@ -86,10 +88,9 @@ IndexedClassedHandleResource<THandle, TStruct, size, enumValue>::Get(
   if (index < 0 || index >= size) {
     return nullptr;
   }
-  std::scoped_lock lock(m_handleMutexes[index]);
   // return structure. Null will propagate correctly, so no need to manually
   // check.
-  return m_structures[index];
+  return m_structures[index].Get();
 }
 
 template <typename THandle, typename TStruct, int16_t size,
@@ -103,7 +104,7 @@ void IndexedClassedHandleResource<THandle, TStruct, size, enumValue>::Free(
   }
   // lock and deallocated handle
   std::scoped_lock lock(m_handleMutexes[index]);
-  m_structures[index].reset();
+  m_structures[index].Exchange(nullptr);
 }
 
 template <typename THandle, typename TStruct, int16_t size,
@@ -112,7 +113,7 @@ void IndexedClassedHandleResource<THandle, TStruct, size,
                                   enumValue>::ResetHandles() {
   for (int i = 0; i < size; i++) {
     std::scoped_lock lock(m_handleMutexes[i]);
-    m_structures[i].reset();
+    m_structures[i].Exchange(nullptr);
   }
   HandleBase::ResetHandles();
 }
@@ -13,6 +13,7 @@
 
 #include "hal/Errors.h"
 #include "hal/Types.h"
+#include "hal/handles/HandleSlot.h"
 #include "hal/handles/HandlesInternal.h"
 
 namespace hal {
@@ -21,7 +22,8 @@ namespace hal {
  * The IndexedHandleResource class is a way to track handles. This version
  * allows a limited number of handles that are allocated by index.
  * Because they are allocated by index, each individual index holds its own
- * mutex, which reduces contention heavily.]
+ * mutex for allocation, which reduces contention heavily. Getting a handle's
+ * structure doesn't lock.
  *
  * @tparam THandle The Handle Type (Must be typedefed from HAL_Handle)
  * @tparam TStruct The struct type held by this resource
@@ -49,7 +51,7 @@ class IndexedHandleResource : public HandleBase {
   void ResetHandles() override;
 
  private:
-  std::array<std::shared_ptr<TStruct>, size> m_structures;
+  std::array<HandleSlot<TStruct>, size> m_structures;
   std::array<wpi::mutex, size> m_handleMutexes;
 };
 
@@ -66,16 +68,17 @@ IndexedHandleResource<THandle, TStruct, size, enumValue>::Allocate(
   }
   std::scoped_lock lock(m_handleMutexes[index]);
   // check for allocation, otherwise allocate and return a valid handle
-  if (m_structures[index] != nullptr) {
+  if (!m_structures[index].IsEmpty()) {
     *status = RESOURCE_IS_ALLOCATED;
     *handle = HAL_kInvalidHandle;
-    return m_structures[index];
+    return m_structures[index].Get();
   }
-  m_structures[index] = std::make_shared<TStruct>();
+  auto structure = std::make_shared<TStruct>();
+  m_structures[index].Exchange(structure);
   *handle =
       static_cast<THandle>(hal::createHandle(index, enumValue, m_version));
   *status = HAL_SUCCESS;
-  return m_structures[index];
+  return structure;
 }
 
 template <typename THandle, typename TStruct, int16_t size,
@@ -87,10 +90,9 @@ IndexedHandleResource<THandle, TStruct, size, enumValue>::Get(THandle handle) {
   if (index < 0 || index >= size) {
     return nullptr;
   }
-  std::scoped_lock lock(m_handleMutexes[index]);
   // return structure. Null will propagate correctly, so no need to manually
   // check.
-  return m_structures[index];
+  return m_structures[index].Get();
 }
 
 template <typename THandle, typename TStruct, int16_t size,
@@ -104,7 +106,7 @@ void IndexedHandleResource<THandle, TStruct, size, enumValue>::Free(
   }
   // lock and deallocated handle
   std::scoped_lock lock(m_handleMutexes[index]);
-  m_structures[index].reset();
+  m_structures[index].Exchange(nullptr);
 }
 
 template <typename THandle, typename TStruct, int16_t size,
@@ -112,7 +114,7 @@ template <typename THandle, typename TStruct, int16_t size,
 void IndexedHandleResource<THandle, TStruct, size, enumValue>::ResetHandles() {
   for (int i = 0; i < size; i++) {
     std::scoped_lock lock(m_handleMutexes[i]);
-    m_structures[i].reset();
+    m_structures[i].Exchange(nullptr);
   }
   HandleBase::ResetHandles();
 }
@@ -11,6 +11,7 @@
 
 #include <wpi/mutex.h>
 
+#include "HandleSlot.h"
 #include "HandlesInternal.h"
 #include "hal/Types.h"
 
@@ -19,6 +20,7 @@ namespace hal {
 /**
  * The LimitedHandleResource class is a way to track handles. This version
  * allows a limited number of handles that are allocated sequentially.
+ * Getting a handle's structure doesn't lock.
  *
  * @tparam THandle The Handle Type (Must be typedefed from HAL_Handle)
  * @tparam TStruct The struct type held by this resource
@@ -45,8 +47,7 @@ class LimitedHandleResource : public HandleBase {
   void ResetHandles() override;
 
  private:
-  std::array<std::shared_ptr<TStruct>, size> m_structures;
-  std::array<wpi::mutex, size> m_handleMutexes;
+  std::array<HandleSlot<TStruct>, size> m_structures;
   wpi::mutex m_allocateMutex;
 };
 
@@ -56,11 +57,9 @@ THandle LimitedHandleResource<THandle, TStruct, size, enumValue>::Allocate() {
   // globally lock to loop through indices
   std::scoped_lock lock(m_allocateMutex);
   for (int16_t i = 0; i < size; i++) {
-    if (m_structures[i] == nullptr) {
-      // if a false index is found, grab its specific mutex
-      // and allocate it.
-      std::scoped_lock lock(m_handleMutexes[i]);
-      m_structures[i] = std::make_shared<TStruct>();
+    if (m_structures[i].IsEmpty()) {
+      // if a false index is found, allocate it.
+      m_structures[i].Exchange(std::make_shared<TStruct>());
       return static_cast<THandle>(createHandle(i, enumValue, m_version));
     }
   }
@@ -76,10 +75,9 @@ LimitedHandleResource<THandle, TStruct, size, enumValue>::Get(THandle handle) {
   if (index < 0 || index >= size) {
     return nullptr;
   }
-  std::scoped_lock lock(m_handleMutexes[index]);
   // return structure. Null will propagate correctly, so no need to manually
   // check.
-  return m_structures[index];
+  return m_structures[index].Get();
 }
 
 template <typename THandle, typename TStruct, int16_t size,
@@ -93,8 +91,7 @@ void LimitedHandleResource<THandle, TStruct, size, enumValue>::Free(
   }
   // lock and deallocated handle
   std::scoped_lock allocateLock(m_allocateMutex);
-  std::scoped_lock handleLock(m_handleMutexes[index]);
-  m_structures[index].reset();
+  m_structures[index].Exchange(nullptr);
 }
 
 template <typename THandle, typename TStruct, int16_t size,
@@ -103,8 +100,7 @@ void LimitedHandleResource<THandle, TStruct, size, enumValue>::ResetHandles() {
   {
     std::scoped_lock allocateLock(m_allocateMutex);
     for (int i = 0; i < size; i++) {
-      std::scoped_lock handleLock(m_handleMutexes[i]);
-      m_structures[i].reset();
+      m_structures[i].Exchange(nullptr);
     }
   }
   HandleBase::ResetHandles();
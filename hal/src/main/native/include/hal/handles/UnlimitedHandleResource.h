@@ -6,13 +6,15 @@
 
 #include <stdint.h>
 
+#include <array>
+#include <atomic>
 #include <memory>
 #include <utility>
-#include <vector>
 
 #include <wpi/mutex.h>
 
 #include "hal/Types.h"
+#include "hal/handles/HandleSlot.h"
 #include "hal/handles/HandlesInternal.h"
 
 namespace hal {
@@ -24,7 +26,8 @@ namespace hal {
  * down.
  * However, automatic array management has not been implemented, but might be in
  * the future.
- * Because we have to loop through the allocator, we must use a global mutex.
+ * Because we have to loop through the allocator, we must use a global mutex,
+ * but getting a handle's structure doesn't lock.
 
  * @tparam THandle The Handle Type (Must be typedefed from HAL_Handle)
  * @tparam TStruct The struct type held by this resource
@@ -37,6 +40,7 @@ class UnlimitedHandleResource : public HandleBase {
 
  public:
   UnlimitedHandleResource() = default;
+  ~UnlimitedHandleResource();
   UnlimitedHandleResource(const UnlimitedHandleResource&) = delete;
   UnlimitedHandleResource& operator=(const UnlimitedHandleResource&) = delete;
 
@@ -56,18 +60,38 @@ class UnlimitedHandleResource : public HandleBase {
   void ForEach(Functor func);
 
  private:
-  std::vector<std::shared_ptr<TStruct>> m_structures;
+  // Structures are stored in blocks that never move once allocated, so they
+  // can be read without locking
+  static constexpr int kBlockSize = 256;
+  using Block = std::array<HandleSlot<TStruct>, kBlockSize>;
+
+  HandleSlot<TStruct>& GetSlot(int16_t index) {
+    return (*m_blocks[index / kBlockSize].load(std::memory_order_relaxed))
+        [index % kBlockSize];
+  }
+
+  std::array<std::atomic<Block*>, (INT16_MAX + 1) / kBlockSize> m_blocks{};
+  // number of indices used so far
+  int16_t m_size = 0;
   wpi::mutex m_handleMutex;
 };
 
+template <typename THandle, typename TStruct, HAL_HandleEnum enumValue>
+UnlimitedHandleResource<THandle, TStruct, enumValue>::
+    ~UnlimitedHandleResource() {
+  for (auto&& block : m_blocks) {
+    delete block.load(std::memory_order_relaxed);
+  }
+}
+
 template <typename THandle, typename TStruct, HAL_HandleEnum enumValue>
 THandle UnlimitedHandleResource<THandle, TStruct, enumValue>::Allocate(
     std::shared_ptr<TStruct> structure) {
   std::scoped_lock lock(m_handleMutex);
-  size_t i;
-  for (i = 0; i < m_structures.size(); i++) {
-    if (m_structures[i] == nullptr) {
-      m_structures[i] = structure;
+  int16_t i;
+  for (i = 0; i < m_size; i++) {
+    if (GetSlot(i).IsEmpty()) {
+      GetSlot(i).Exchange(std::move(structure));
       return static_cast<THandle>(createHandle(i, enumValue, m_version));
     }
   }
@@ -75,20 +99,27 @@ THandle UnlimitedHandleResource<THandle, TStruct, enumValue>::Allocate(
     return HAL_kInvalidHandle;
   }
 
-  m_structures.push_back(structure);
-  return static_cast<THandle>(
-      createHandle(static_cast<int16_t>(i), enumValue, m_version));
+  auto& block = m_blocks[i / kBlockSize];
+  if (!block.load(std::memory_order_relaxed)) {
+    block.store(new Block, std::memory_order_release);
+  }
+  GetSlot(i).Exchange(std::move(structure));
+  m_size++;
+  return static_cast<THandle>(createHandle(i, enumValue, m_version));
 }
 
 template <typename THandle, typename TStruct, HAL_HandleEnum enumValue>
 std::shared_ptr<TStruct>
 UnlimitedHandleResource<THandle, TStruct, enumValue>::Get(THandle handle) {
   int16_t index = GetIndex(handle);
-  std::scoped_lock lock(m_handleMutex);
-  if (index < 0 || index >= static_cast<int16_t>(m_structures.size())) {
+  if (index < 0) {
+    return nullptr;
+  }
+  Block* block = m_blocks[index / kBlockSize].load(std::memory_order_acquire);
+  if (!block) {
     return nullptr;
   }
-  return m_structures[index];
+  return (*block)[index % kBlockSize].Get();
 }
 
 template <typename THandle, typename TStruct, HAL_HandleEnum enumValue>
@@ -96,18 +127,18 @@ std::shared_ptr<TStruct>
 UnlimitedHandleResource<THandle, TStruct, enumValue>::Free(THandle handle) {
   int16_t index = GetIndex(handle);
   std::scoped_lock lock(m_handleMutex);
-  if (index < 0 || index >= static_cast<int16_t>(m_structures.size())) {
+  if (index < 0 || index >= m_size) {
     return nullptr;
   }
-  return std::move(m_structures[index]);
+  return GetSlot(index).Exchange(nullptr);
 }
 
 template <typename THandle, typename TStruct, HAL_HandleEnum enumValue>
 void UnlimitedHandleResource<THandle, TStruct, enumValue>::ResetHandles() {
   {
     std::scoped_lock lock(m_handleMutex);
-    for (size_t i = 0; i < m_structures.size(); i++) {
-      m_structures[i].reset();
+    for (int16_t i = 0; i < m_size; i++) {
+      GetSlot(i).Exchange(nullptr);
     }
   }
   HandleBase::ResetHandles();
@@ -118,11 +149,10 @@ template <typename Functor>
 void UnlimitedHandleResource<THandle, TStruct, enumValue>::ForEach(
     Functor func) {
   std::scoped_lock lock(m_handleMutex);
-  size_t i;
-  for (i = 0; i < m_structures.size(); i++) {
-    if (m_structures[i] != nullptr) {
+  for (int16_t i = 0; i < m_size; i++) {
+    if (auto structure = GetSlot(i).Get()) {
       func(static_cast<THandle>(createHandle(i, enumValue, m_version)),
-           m_structures[i].get());
+           structure.get());
     }
   }
 }
@@ -19,6 +19,19 @@ HAL_Bool HALSIM_IsTimingPaused(void);
 void HALSIM_StepTiming(uint64_t delta);
 void HALSIM_StepTimingAsync(uint64_t delta);
 
+/**
+ * Runs simulated time as fast as possible instead of in real time. Whenever
+ * every active notifier is waiting for its alarm, time jumps to the earliest
+ * alarm and only that notifier runs. Notifiers with the same alarm run one at a
+ * time in handle order, so a program driven by notifiers behaves the same on
+ * every run. Disabling this resumes real time from the current simulated time.
+ * HALSIM_StepTiming() must not be called while this is enabled.
+ *
+ * @param fast true to run as fast as possible
+ */
+void HALSIM_SetFastTiming(HAL_Bool fast);
+HAL_Bool HALSIM_IsFastTiming(void);
+
 typedef int32_t (*HALSIM_SendErrorHandler)(
     HAL_Bool isError, int32_t errorCode, HAL_Bool isLVCode, const char* details,
     const char* location, const char* callStack, HAL_Bool printMsg);
@@ -36,4 +49,44 @@ int32_t HALSIM_RegisterSimPeriodicAfterCallback(
     HALSIM_SimPeriodicCallback callback, void* param);
 void HALSIM_CancelSimPeriodicAfterCallback(int32_t uid);
 
+/**
+ * Creates a sim context. Each context is an independent simulated robot with
+ * its own sim data, handles, notifiers, driver station data and timing, so
+ * several robots can run in one process. A thread uses the default context
+ * (0) until it binds another one with HALSIM_SetThreadSimContext().
+ * Registered callbacks run on the threads of the context they were
+ * registered in.
+ *
+ * @return the context id
+ */
+int32_t HALSIM_CreateSimContext(void);
+
+/**
+ * Destroys a sim context and everything in it. It isn't destroyed while
+ * another thread is bound to it, so threads must bind another context (or
+ * exit) first. If the calling thread is bound to it, the thread is bound to
+ * the default context. The default context can't be destroyed.
+ *
+ * @param context the context id
+ * @return true if the context was destroyed, false if the id is invalid or
+ *         another thread is still bound to it
+ */
+HAL_Bool HALSIM_DestroySimContext(int32_t context);
+
+/**
+ * Binds a sim context to the calling thread. All HAL calls from the thread use
+ * it until another context is bound. A context can't be destroyed while any
+ * other thread is bound to it.
+ *
+ * @param context the context id; 0 or an invalid id binds the default context
+ */
+void HALSIM_SetThreadSimContext(int32_t context);
+
+/**
+ * Gets the sim context bound to the calling thread.
+ *
+ * @return the context id; 0 is the default context
+ */
+int32_t HALSIM_GetThreadSimContext(void);
+
 }  // extern "C"
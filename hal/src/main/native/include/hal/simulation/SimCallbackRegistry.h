@@ -4,7 +4,11 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <utility>
 
 #include <wpi/Compiler.h>
@@ -17,24 +21,145 @@ namespace hal {
 
 namespace impl {
 
+// The number of callback lists being invoked by this thread
+inline thread_local int gSimCallbackInvokeDepth = 0;
+
+// Threads waiting in RetireSimCallbacks(), woken when a snapshot is released
+inline std::atomic<int> gSimCallbackRetireWaiters{0};
+inline std::mutex gSimCallbackRetireMutex;
+inline std::condition_variable gSimCallbackRetireCond;
+
+/// A callback list replaced by SimCallbackList::Erase() or Clear().
+using RetiredSimCallbacks = std::shared_ptr<const void>;
+
+/**
+ * Waits until other threads are done invoking a replaced callback list, so
+ * canceled callbacks aren't called after the cancel returns. It doesn't wait if
+ * called from a callback, as the other thread could be waiting on this one.
+ * Must be called without the list owner's lock held, as callbacks may take it.
+ *
+ * @param retired the list returned by SimCallbackList::Erase() or Clear()
+ */
+inline void RetireSimCallbacks(RetiredSimCallbacks retired) {
+  if (!retired || gSimCallbackInvokeDepth > 0 || retired.use_count() == 1) {
+    return;
+  }
+  gSimCallbackRetireWaiters.fetch_add(1);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  {
+    std::unique_lock lock(gSimCallbackRetireMutex);
+    // Snapshots released by a copy of this header in another module don't
+    // notify this condition variable, so re-check periodically too
+    while (retired.use_count() > 1) {
+      gSimCallbackRetireCond.wait_for(lock, std::chrono::milliseconds(1));
+    }
+  }
+  gSimCallbackRetireWaiters.fetch_sub(1, std::memory_order_relaxed);
+}
+
+/**
+ * Copy-on-write callback list. Registering or canceling a callback replaces
+ * the list under the owner's lock, while invoking iterates a snapshot of it
+ * without any lock, so a slow callback doesn't block other threads using the
+ * same data and callbacks can register or cancel callbacks.
+ *
+ * @tparam T listener type; must be convertible to bool like
+ *           HalCallbackListener
+ */
+template <typename T>
+class SimCallbackList {
+ public:
+  using Vector = wpi::UidVector<T, 4>;
+
+  /**
+   * The callbacks at the time it was created. Iterate it to invoke them.
+   */
+  class Snapshot {
+   public:
+    explicit Snapshot(const SimCallbackList& list)
+        : m_callbacks{std::atomic_load(&list.m_callbacks)} {
+      ++gSimCallbackInvokeDepth;
+    }
+    ~Snapshot() {
+      --gSimCallbackInvokeDepth;
+      m_callbacks.reset();
+      // Pairs with the fence in RetireSimCallbacks(), so either it sees the
+      // released reference or this sees it waiting
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (gSimCallbackRetireWaiters.load(std::memory_order_relaxed) > 0) {
+        std::scoped_lock lock(gSimCallbackRetireMutex);
+        gSimCallbackRetireCond.notify_all();
+      }
+    }
+
+    Snapshot(const Snapshot&) = delete;
+    Snapshot& operator=(const Snapshot&) = delete;
+
+    explicit operator bool() const { return m_callbacks != nullptr; }
+    auto begin() const { return m_callbacks->begin(); }
+    auto end() const { return m_callbacks->end(); }
+
+   private:
+    std::shared_ptr<const Vector> m_callbacks;
+  };
+
+  // Must be called with the owner's lock held
+  template <typename... Args>
+  int32_t Emplace(Args&&... args) {
+    auto callbacks = m_callbacks ? std::make_shared<Vector>(*m_callbacks)
+                                 : std::make_shared<Vector>();
+    int32_t index = callbacks->emplace_back(std::forward<Args>(args)...);
+    std::atomic_store(&m_callbacks,
+                      std::shared_ptr<const Vector>{std::move(callbacks)});
+    return index;
+  }
+
+  // Must be called with the owner's lock held; pass the result to
+  // RetireSimCallbacks() after releasing it
+  [[nodiscard]] RetiredSimCallbacks Erase(int32_t index) {
+    if (!m_callbacks || index < 0) {
+      return nullptr;
+    }
+    auto callbacks = std::make_shared<Vector>(*m_callbacks);
+    callbacks->erase(index);
+    return std::atomic_exchange(
+        &m_callbacks, std::shared_ptr<const Vector>{std::move(callbacks)});
+  }
+
+  // Must be called with the owner's lock held; pass the result to
+  // RetireSimCallbacks() after releasing it
+  [[nodiscard]] RetiredSimCallbacks Clear() {
+    return std::atomic_exchange(&m_callbacks, std::shared_ptr<const Vector>{});
+  }
+
+ private:
+  std::shared_ptr<const Vector> m_callbacks;
+};
+
 class SimCallbackRegistryBase {
  public:
   using RawFunctor = void (*)();
 
  protected:
-  using CallbackVector = wpi::UidVector<HalCallbackListener<RawFunctor>, 4>;
+  using CallbackList = SimCallbackList<HalCallbackListener<RawFunctor>>;
 
  public:
   void Cancel(int32_t uid) {
-    std::scoped_lock lock(m_mutex);
-    if (m_callbacks && uid > 0) {
-      m_callbacks->erase(uid - 1);
+    RetiredSimCallbacks retired;
+    {
+      std::scoped_lock lock(m_mutex);
+      retired = m_callbacks.Erase(uid - 1);
     }
+    RetireSimCallbacks(std::move(retired));
   }
 
   void Reset() {
-    std::scoped_lock lock(m_mutex);
-    DoReset();
+    RetiredSimCallbacks retired;
+    {
+      std::scoped_lock lock(m_mutex);
+      retired = m_callbacks.Clear();
+    }
+    RetireSimCallbacks(std::move(retired));
   }
 
   wpi::recursive_spinlock& GetMutex() { return m_mutex; }
@@ -45,20 +170,11 @@ class SimCallbackRegistryBase {
     if (callback == nullptr) {
       return -1;
     }
-    if (!m_callbacks) {
-      m_callbacks = std::make_unique<CallbackVector>();
-    }
-    return m_callbacks->emplace_back(param, callback) + 1;
-  }
-
-  LLVM_ATTRIBUTE_ALWAYS_INLINE void DoReset() {
-    if (m_callbacks) {
-      m_callbacks->clear();
-    }
+    return m_callbacks.Emplace(param, callback) + 1;
   }
 
   mutable wpi::recursive_spinlock m_mutex;
-  std::unique_ptr<CallbackVector> m_callbacks;
+  CallbackList m_callbacks;
 };
 
 }  // namespace impl
@@ -79,14 +195,10 @@ class SimCallbackRegistry : public impl::SimCallbackRegistryBase {
 
   template <typename... U>
   void Invoke(U&&... u) const {
-#ifdef _MSC_VER  // work around VS2019 16.4.0 bug
-    std::scoped_lock<wpi::recursive_spinlock> lock(m_mutex);
-#else
-    std::scoped_lock lock(m_mutex);
-#endif
-    if (m_callbacks) {
+    CallbackList::Snapshot callbacks{m_callbacks};
+    if (callbacks) {
       const char* name = GetName();
-      for (auto&& cb : *m_callbacks) {
+      for (auto&& cb : callbacks) {
         reinterpret_cast<CallbackFunction>(cb.callback)(name, cb.param,
                                                         std::forward<U>(u)...);
       }
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 
 #include <wpi/Compiler.h>
@@ -16,26 +17,36 @@
 namespace hal {
 
 namespace impl {
+// The value is atomic and the callbacks are invoked from a snapshot, so only
+// registering callbacks takes the lock. Callback invocations for a value are
+// serialized and the last one always sees the latest value.
 template <typename T, HAL_Value (*MakeValue)(T)>
 class SimDataValueBase : protected SimCallbackRegistryBase {
+  static_assert(std::atomic<T>::is_always_lock_free,
+                "SimDataValue requires a lock-free value type");
+
  public:
   explicit SimDataValueBase(T value) : m_value(value) {}
 
   LLVM_ATTRIBUTE_ALWAYS_INLINE void CancelCallback(int32_t uid) { Cancel(uid); }
 
-  T Get() const {
-    std::scoped_lock lock(m_mutex);
-    return m_value;
-  }
+  T Get() const { return m_value.load(std::memory_order_acquire); }
 
   LLVM_ATTRIBUTE_ALWAYS_INLINE operator T() const { return Get(); }  // NOLINT
 
   void Reset(T value) {
-    std::scoped_lock lock(m_mutex);
-    DoReset();
-    m_value = value;
+    RetiredSimCallbacks retired;
+    {
+      std::scoped_lock lock(m_mutex);
+      retired = m_callbacks.Clear();
+      m_value.store(value, std::memory_order_release);
+    }
+    RetireSimCallbacks(std::move(retired));
   }
 
+  // Sets the value without invoking callbacks, e.g. to restore a snapshot
+  void Restore(T value) { m_value.store(value, std::memory_order_release); }
+
   wpi::recursive_spinlock& GetMutex() { return m_mutex; }
 
  protected:
@@ -48,7 +59,7 @@ class SimDataValueBase : protected SimCallbackRegistryBase {
     }
     if (initialNotify) {
       // We know that the callback is not null because of earlier null check
-      HAL_Value value = MakeValue(m_value);
+      HAL_Value value = MakeValue(m_value.load(std::memory_order_relaxed));
       lock.unlock();
       callback(name, param, &value);
     }
@@ -56,20 +67,47 @@ class SimDataValueBase : protected SimCallbackRegistryBase {
   }
 
   void DoSet(T value, const char* name) {
-    std::scoped_lock lock(this->m_mutex);
-    if (m_value != value) {
-      m_value = value;
-      if (m_callbacks) {
-        HAL_Value halValue = MakeValue(value);
-        for (auto&& cb : *m_callbacks) {
-          reinterpret_cast<HAL_NotifyCallback>(cb.callback)(name, cb.param,
-                                                            &halValue);
-        }
+    // Only the thread that changes the value notifies
+    if (m_value.load(std::memory_order_relaxed) == value ||
+        m_value.exchange(value, std::memory_order_acq_rel) == value) {
+      return;
+    }
+    // Only one thread invokes the callbacks at a time, so they see the changes
+    // in order. If the value is set while they're running, the notifying
+    // thread runs them again with the latest value instead of this one.
+    uint32_t pending = m_pendingNotify.fetch_add(1, std::memory_order_acq_rel);
+    if (pending != 0) {
+      return;
+    }
+    pending = 1;
+    bool notified = false;
+    T notifiedValue{};
+    do {
+      T current = m_value.load(std::memory_order_acquire);
+      if (!notified || current != notifiedValue) {
+        Notify(current, name);
+        notified = true;
+        notifiedValue = current;
+      }
+      pending = m_pendingNotify.fetch_sub(pending, std::memory_order_acq_rel) -
+                pending;
+    } while (pending != 0);
+  }
+
+  void Notify(T value, const char* name) {
+    CallbackList::Snapshot callbacks{m_callbacks};
+    if (callbacks) {
+      HAL_Value halValue = MakeValue(value);
+      for (auto&& cb : callbacks) {
+        reinterpret_cast<HAL_NotifyCallback>(cb.callback)(name, cb.param,
+                                                          &halValue);
       }
     }
   }
 
-  T m_value;
+  std::atomic<T> m_value;
+  // The number of changes not yet notified; nonzero while notifying
+  std::atomic<uint32_t> m_pendingNotify{0};
 };
 }  // namespace impl
 
@@ -0,0 +1,53 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include "hal/Types.h"
+#include "hal/simulation/MockHooks.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Saves the sim state of the calling thread's sim context as a compact binary
+ * snapshot: every sim data value, sim device value, joystick, match info and
+ * addressable LED data, the simulated time, and the Notifier alarms. Handle
+ * allocations and registered callbacks aren't part of the snapshot.
+ *
+ * @param buffer buffer to save the snapshot to; may be null to get the size
+ * @param size size of buffer
+ * @return size of the snapshot; nothing is saved if it's larger than size
+ */
+int32_t HALSIM_SaveSimSnapshot(uint8_t* buffer, int32_t size);
+
+/**
+ * Restores a snapshot saved by HALSIM_SaveSimSnapshot() in the same build.
+ * Values are restored without invoking their callbacks; the snapshot restored
+ * callbacks are invoked once afterwards instead. Sim device values and
+ * Notifiers created after the snapshot keep their state.
+ *
+ * @param buffer the snapshot
+ * @param size size of the snapshot
+ * @return true if restored; false if the snapshot is invalid, in which case
+ *         nothing is changed
+ */
+HAL_Bool HALSIM_RestoreSimSnapshot(const uint8_t* buffer, int32_t size);
+
+/**
+ * Registers a callback invoked after a snapshot is restored, e.g. to refresh
+ * state derived from sim values whose callbacks were skipped.
+ *
+ * @param callback callback
+ * @param param parameter passed to the callback
+ * @return uid to cancel the callback
+ */
+int32_t HALSIM_RegisterSimSnapshotRestoredCallback(
+    HALSIM_SimPeriodicCallback callback, void* param);
+void HALSIM_CancelSimSnapshotRestoredCallback(int32_t uid);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
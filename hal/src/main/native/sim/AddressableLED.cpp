@@ -10,6 +10,7 @@
 #include "HALInitializer.h"
 #include "HALInternal.h"
 #include "PortsInternal.h"
+#include "SimContextInternal.h"
 #include "hal/Errors.h"
 #include "hal/handles/HandlesInternal.h"
 #include "hal/handles/LimitedHandleResource.h"
@@ -23,18 +24,13 @@ struct AddressableLED {
 };
 }  // namespace
 
-static LimitedHandleResource<HAL_AddressableLEDHandle, AddressableLED,
-                             kNumAddressableLEDs,
-                             HAL_HandleEnum::AddressableLED>* ledHandles;
+static SimContextLocal<LimitedHandleResource<
+    HAL_AddressableLEDHandle, AddressableLED, kNumAddressableLEDs,
+    HAL_HandleEnum::AddressableLED>>
+    ledHandles;
 
 namespace hal::init {
-void InitializeAddressableLED() {
-  static LimitedHandleResource<HAL_AddressableLEDHandle, AddressableLED,
-                               kNumAddressableLEDs,
-                               HAL_HandleEnum::AddressableLED>
-      dcH;
-  ledHandles = &dcH;
-}
+void InitializeAddressableLED() {}
 }  // namespace hal::init
 
 extern "C" {
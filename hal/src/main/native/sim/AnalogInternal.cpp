@@ -8,15 +8,12 @@
 #include "hal/handles/IndexedHandleResource.h"
 
 namespace hal {
-IndexedHandleResource<HAL_AnalogInputHandle, hal::AnalogPort, kNumAnalogInputs,
-                      HAL_HandleEnum::AnalogInput>* analogInputHandles;
+SimContextLocal<IndexedHandleResource<
+    HAL_AnalogInputHandle, hal::AnalogPort, kNumAnalogInputs,
+    HAL_HandleEnum::AnalogInput>>
+    analogInputHandles;
 }  // namespace hal
 
 namespace hal::init {
-void InitializeAnalogInternal() {
-  static IndexedHandleResource<HAL_AnalogInputHandle, hal::AnalogPort,
-                               kNumAnalogInputs, HAL_HandleEnum::AnalogInput>
-      aiH;
-  analogInputHandles = &aiH;
-}
+void InitializeAnalogInternal() {}
 }  // namespace hal::init
@@ -9,6 +9,7 @@
 #include "HALInitializer.h"
 #include "HALInternal.h"
 #include "PortsInternal.h"
+#include "SimContextInternal.h"
 #include "hal/Errors.h"
 #include "hal/handles/HandlesInternal.h"
 #include "hal/handles/IndexedHandleResource.h"
@@ -23,17 +24,13 @@ struct AnalogOutput {
 };
 }  // namespace
 
-static IndexedHandleResource<HAL_AnalogOutputHandle, AnalogOutput,
-                             kNumAnalogOutputs, HAL_HandleEnum::AnalogOutput>*
+static SimContextLocal<IndexedHandleResource<
+    HAL_AnalogOutputHandle, AnalogOutput, kNumAnalogOutputs,
+    HAL_HandleEnum::AnalogOutput>>
     analogOutputHandles;
 
 namespace hal::init {
-void InitializeAnalogOutput() {
-  static IndexedHandleResource<HAL_AnalogOutputHandle, AnalogOutput,
-                               kNumAnalogOutputs, HAL_HandleEnum::AnalogOutput>
-      aoH;
-  analogOutputHandles = &aoH;
-}
+void InitializeAnalogOutput() {}
 }  // namespace hal::init
 
 extern "C" {
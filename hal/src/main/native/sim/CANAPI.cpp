@@ -8,6 +8,7 @@
 
 #include "CANAPIInternal.h"
 #include "HALInitializer.h"
+#include "SimContextInternal.h"
 #include "hal/CAN.h"
 #include "hal/Errors.h"
 #include "hal/HALBase.h"
@@ -32,7 +33,8 @@ struct CANStorage {
 };
 }  // namespace
 
-static UnlimitedHandleResource<HAL_CANHandle, CANStorage, HAL_HandleEnum::CAN>*
+static SimContextLocal<UnlimitedHandleResource<
+    HAL_CANHandle, CANStorage, HAL_HandleEnum::CAN>>
     canHandles;
 
 static uint32_t GetPacketBaseTime() {
@@ -44,11 +46,7 @@ static uint32_t GetPacketBaseTime() {
 
 namespace hal {
 namespace init {
-void InitializeCANAPI() {
-  static UnlimitedHandleResource<HAL_CANHandle, CANStorage, HAL_HandleEnum::CAN>
-      cH;
-  canHandles = &cH;
-}
+void InitializeCANAPI() {}
 }  // namespace init
 namespace can {
 int32_t GetCANModuleFromHandle(HAL_CANHandle handle, int32_t* status) {
@@ -7,6 +7,7 @@
 #include "HALInitializer.h"
 #include "HALInternal.h"
 #include "PortsInternal.h"
+#include "SimContextInternal.h"
 #include "hal/CANAPI.h"
 #include "hal/Errors.h"
 #include "hal/handles/IndexedHandleResource.h"
@@ -22,16 +23,12 @@ struct PCM {
 };
 }  // namespace
 
-static IndexedHandleResource<HAL_CTREPCMHandle, PCM, kNumCTREPCMModules,
-                             HAL_HandleEnum::CTREPCM>* pcmHandles;
+static SimContextLocal<IndexedHandleResource<
+    HAL_CTREPCMHandle, PCM, kNumCTREPCMModules, HAL_HandleEnum::CTREPCM>>
+    pcmHandles;
 
 namespace hal::init {
-void InitializeCTREPCM() {
-  static IndexedHandleResource<HAL_CTREPCMHandle, PCM, kNumCTREPCMModules,
-                               HAL_HandleEnum::CTREPCM>
-      pH;
-  pcmHandles = &pH;
-}
+void InitializeCTREPCM() {}
 }  // namespace hal::init
 
 HAL_CTREPCMHandle HAL_InitializeCTREPCM(int32_t module,
@@ -12,17 +12,13 @@
 
 namespace hal {
 
-LimitedHandleResource<HAL_CounterHandle, Counter, kNumCounters,
-                      HAL_HandleEnum::Counter>* counterHandles;
+SimContextLocal<LimitedHandleResource<
+    HAL_CounterHandle, Counter, kNumCounters, HAL_HandleEnum::Counter>>
+    counterHandles;
 }  // namespace hal
 
 namespace hal::init {
-void InitializeCounter() {
-  static LimitedHandleResource<HAL_CounterHandle, Counter, kNumCounters,
-                               HAL_HandleEnum::Counter>
-      cH;
-  counterHandles = &cH;
-}
+void InitializeCounter() {}
 }  // namespace hal::init
 
 extern "C" {
@@ -5,6 +5,7 @@
 #pragma once
 
 #include "PortsInternal.h"
+#include "SimContextInternal.h"
 #include "hal/handles/HandlesInternal.h"
 #include "hal/handles/LimitedHandleResource.h"
 
@@ -14,7 +15,8 @@ struct Counter {
   uint8_t index;
 };
 
-extern LimitedHandleResource<HAL_CounterHandle, Counter, kNumCounters,
-                             HAL_HandleEnum::Counter>* counterHandles;
+extern SimContextLocal<LimitedHandleResource<
+    HAL_CounterHandle, Counter, kNumCounters, HAL_HandleEnum::Counter>>
+    counterHandles;
 
 }  // namespace hal
@@ -8,6 +8,7 @@
 #include "HALInitializer.h"
 #include "HALInternal.h"
 #include "PortsInternal.h"
+#include "SimContextInternal.h"
 #include "hal/handles/HandlesInternal.h"
 #include "hal/handles/LimitedHandleResource.h"
 #include "mockdata/DIODataInternal.h"
@@ -15,18 +16,13 @@
 
 using namespace hal;
 
-static LimitedHandleResource<HAL_DigitalPWMHandle, uint8_t,
-                             kNumDigitalPWMOutputs, HAL_HandleEnum::DigitalPWM>*
+static SimContextLocal<LimitedHandleResource<
+    HAL_DigitalPWMHandle, uint8_t, kNumDigitalPWMOutputs,
+    HAL_HandleEnum::DigitalPWM>>
     digitalPWMHandles;
 
 namespace hal::init {
-void InitializeDIO() {
-  static LimitedHandleResource<HAL_DigitalPWMHandle, uint8_t,
-                               kNumDigitalPWMOutputs,
-                               HAL_HandleEnum::DigitalPWM>
-      dpH;
-  digitalPWMHandles = &dpH;
-}
+void InitializeDIO() {}
 }  // namespace hal::init
 
 extern "C" {
@@ -164,22 +160,28 @@ void HAL_SetDigitalPWMOutputChannel(HAL_DigitalPWMHandle pwmGenerator,
 
 void HAL_SetDIO(HAL_DigitalHandle dioPortHandle, HAL_Bool value,
                 int32_t* status) {
-  auto port = digitalChannelHandles->Get(dioPortHandle, HAL_HandleEnum::DIO);
-  if (port == nullptr) {
-    *status = HAL_HANDLE_ERROR;
-    return;
+  int32_t channel;
+  {
+    // only borrow the port, as setting the sim data invokes callbacks
+    auto port =
+        digitalChannelHandles->Borrow(dioPortHandle, HAL_HandleEnum::DIO);
+    if (port == nullptr) {
+      *status = HAL_HANDLE_ERROR;
+      return;
+    }
+    channel = port->channel;
   }
   if (value != 0 && value != 1) {
     if (value != 0) {
       value = 1;
     }
   }
-  if (SimDIOData[port->channel].isInput) {
+  if (SimDIOData[channel].isInput) {
     *status = PARAMETER_OUT_OF_RANGE;
     hal::SetLastError(status, "Cannot set output of an input channel");
     return;
   }
-  SimDIOData[port->channel].value = value;
+  SimDIOData[channel].value = value;
 }
 
 void HAL_SetDIODirection(HAL_DigitalHandle dioPortHandle, HAL_Bool input,
@@ -194,7 +196,8 @@ void HAL_SetDIODirection(HAL_DigitalHandle dioPortHandle, HAL_Bool input,
 }
 
 HAL_Bool HAL_GetDIO(HAL_DigitalHandle dioPortHandle, int32_t* status) {
-  auto port = digitalChannelHandles->Get(dioPortHandle, HAL_HandleEnum::DIO);
+  auto port =
+      digitalChannelHandles->Borrow(dioPortHandle, HAL_HandleEnum::DIO);
   if (port == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return false;
@@ -210,7 +213,8 @@ HAL_Bool HAL_GetDIO(HAL_DigitalHandle dioPortHandle, int32_t* status) {
 }
 
 HAL_Bool HAL_GetDIODirection(HAL_DigitalHandle dioPortHandle, int32_t* status) {
-  auto port = digitalChannelHandles->Get(dioPortHandle, HAL_HandleEnum::DIO);
+  auto port =
+      digitalChannelHandles->Borrow(dioPortHandle, HAL_HandleEnum::DIO);
   if (port == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return false;
@@ -236,7 +240,8 @@ void HAL_Pulse(HAL_DigitalHandle dioPortHandle, double pulseLength,
 }
 
 HAL_Bool HAL_IsPulsing(HAL_DigitalHandle dioPortHandle, int32_t* status) {
-  auto port = digitalChannelHandles->Get(dioPortHandle, HAL_HandleEnum::DIO);
+  auto port =
+      digitalChannelHandles->Borrow(dioPortHandle, HAL_HandleEnum::DIO);
   if (port == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return false;
@@ -261,7 +266,8 @@ void HAL_SetFilterSelect(HAL_DigitalHandle dioPortHandle, int32_t filterIndex,
 }
 
 int32_t HAL_GetFilterSelect(HAL_DigitalHandle dioPortHandle, int32_t* status) {
-  auto port = digitalChannelHandles->Get(dioPortHandle, HAL_HandleEnum::DIO);
+  auto port =
+      digitalChannelHandles->Borrow(dioPortHandle, HAL_HandleEnum::DIO);
   if (port == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return 0;
@@ -12,17 +12,12 @@
 
 namespace hal {
 
-DigitalHandleResource<HAL_DigitalHandle, DigitalPort,
-                      kNumDigitalChannels + kNumPWMHeaders>*
+SimContextLocal<DigitalHandleResource<
+    HAL_DigitalHandle, DigitalPort, kNumDigitalChannels + kNumPWMHeaders>>
     digitalChannelHandles;
 
 namespace init {
-void InitializeDigitalInternal() {
-  static DigitalHandleResource<HAL_DigitalHandle, DigitalPort,
-                               kNumDigitalChannels + kNumPWMHeaders>
-      dcH;
-  digitalChannelHandles = &dcH;
-}
+void InitializeDigitalInternal() {}
 }  // namespace init
 
 bool remapDigitalSource(HAL_Handle digitalSourceHandle,
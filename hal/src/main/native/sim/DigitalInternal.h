@@ -9,6 +9,7 @@
 #include <string>
 
 #include "PortsInternal.h"
+#include "SimContextInternal.h"
 #include "hal/AnalogTrigger.h"
 #include "hal/handles/DigitalHandleResource.h"
 
@@ -61,8 +62,8 @@ struct DigitalPort {
   std::string previousAllocation;
 };
 
-extern DigitalHandleResource<HAL_DigitalHandle, DigitalPort,
-                             kNumDigitalChannels + kNumPWMHeaders>*
+extern SimContextLocal<DigitalHandleResource<
+    HAL_DigitalHandle, DigitalPort, kNumDigitalChannels + kNumPWMHeaders>>
     digitalChannelHandles;
 
 /**
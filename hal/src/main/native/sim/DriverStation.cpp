@@ -18,24 +18,28 @@
 #include <wpi/mutex.h>
 
 #include "HALInitializer.h"
+#include "SimContextInternal.h"
 #include "hal/cpp/fpga_clock.h"
 #include "hal/simulation/MockHooks.h"
 #include "mockdata/DriverStationDataInternal.h"
 
+namespace {
+struct NewDSDataAvailable {
+  wpi::mutex mutex;
+  wpi::condition_variable cond;
+  int counter{0};
+};
+}  // namespace
+
 static wpi::mutex msgMutex;
-static wpi::condition_variable* newDSDataAvailableCond;
-static wpi::mutex newDSDataAvailableMutex;
-static int newDSDataAvailableCounter{0};
+static hal::SimContextLocal<NewDSDataAvailable> newDSDataAvailable;
 static std::atomic_bool isFinalized{false};
 static std::atomic<HALSIM_SendErrorHandler> sendErrorHandler{nullptr};
 static std::atomic<HALSIM_SendConsoleLineHandler> sendConsoleLineHandler{
     nullptr};
 
 namespace hal::init {
-void InitializeDriverStation() {
-  static wpi::condition_variable nddaC;
-  newDSDataAvailableCond = &nddaC;
-}
+void InitializeDriverStation() {}
 }  // namespace hal::init
 
 using namespace hal;
@@ -234,9 +238,10 @@ static int& GetThreadLocalLastCount() {
 }
 
 HAL_Bool HAL_IsNewControlData(void) {
-  std::scoped_lock lock(newDSDataAvailableMutex);
+  auto& newData = *newDSDataAvailable;
+  std::scoped_lock lock(newData.mutex);
   int& lastCount = GetThreadLocalLastCount();
-  int currentCount = newDSDataAvailableCounter;
+  int currentCount = newData.counter;
   if (lastCount == currentCount) {
     return false;
   }
@@ -249,9 +254,10 @@ void HAL_WaitForDSData(void) {
 }
 
 HAL_Bool HAL_WaitForDSDataTimeout(double timeout) {
-  std::unique_lock lock(newDSDataAvailableMutex);
+  auto& newData = *newDSDataAvailable;
+  std::unique_lock lock(newData.mutex);
   int& lastCount = GetThreadLocalLastCount();
-  int currentCount = newDSDataAvailableCounter;
+  int currentCount = newData.counter;
   if (lastCount != currentCount) {
     lastCount = currentCount;
     return true;
@@ -263,17 +269,17 @@ HAL_Bool HAL_WaitForDSDataTimeout(double timeout) {
   auto timeoutTime =
       std::chrono::steady_clock::now() + std::chrono::duration<double>(timeout);
 
-  while (newDSDataAvailableCounter == currentCount) {
+  while (newData.counter == currentCount) {
     if (timeout > 0) {
-      auto timedOut = newDSDataAvailableCond->wait_until(lock, timeoutTime);
+      auto timedOut = newData.cond.wait_until(lock, timeoutTime);
       if (timedOut == std::cv_status::timeout) {
         return false;
       }
     } else {
-      newDSDataAvailableCond->wait(lock);
+      newData.cond.wait(lock);
     }
   }
-  lastCount = newDSDataAvailableCounter;
+  lastCount = newData.counter;
   return true;
 }
 
@@ -287,10 +293,11 @@ static int32_t newDataOccur(uint32_t refNum) {
     return 0;
   }
   SimDriverStationData->CallNewDataCallbacks();
-  std::scoped_lock lock(newDSDataAvailableMutex);
+  auto& newData = *newDSDataAvailable;
+  std::scoped_lock lock(newData.mutex);
   // Nofify all threads
-  newDSDataAvailableCounter++;
-  newDSDataAvailableCond->notify_all();
+  newData.counter++;
+  newData.cond.notify_all();
   return 0;
 }
 
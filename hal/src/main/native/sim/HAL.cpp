@@ -18,6 +18,7 @@
 #include "ErrorsInternal.h"
 #include "HALInitializer.h"
 #include "MockHooksInternal.h"
+#include "SimContextInternal.h"
 #include "hal/DriverStation.h"
 #include "hal/Errors.h"
 #include "hal/Extensions.h"
@@ -28,34 +29,11 @@
 
 using namespace hal;
 
-namespace {
-class SimPeriodicCallbackRegistry : public impl::SimCallbackRegistryBase {
- public:
-  int32_t Register(HALSIM_SimPeriodicCallback callback, void* param) {
-    std::scoped_lock lock(m_mutex);
-    return DoRegister(reinterpret_cast<RawFunctor>(callback), param);
-  }
-
-  void operator()() const {
-#ifdef _MSC_VER  // work around VS2019 16.4.0 bug
-    std::scoped_lock<wpi::recursive_spinlock> lock(m_mutex);
-#else
-    std::scoped_lock lock(m_mutex);
-#endif
-    if (m_callbacks) {
-      for (auto&& cb : *m_callbacks) {
-        reinterpret_cast<HALSIM_SimPeriodicCallback>(cb.callback)(cb.param);
-      }
-    }
-  }
-};
-}  // namespace
-
 static HAL_RuntimeType runtimeType{HAL_Mock};
 static wpi::spinlock gOnShutdownMutex;
 static std::vector<std::pair<void*, void (*)(void*)>> gOnShutdown;
-static SimPeriodicCallbackRegistry gSimPeriodicBefore;
-static SimPeriodicCallbackRegistry gSimPeriodicAfter;
+static SimContextLocal<SimPeriodicCallbackRegistry> gSimPeriodicBefore;
+static SimContextLocal<SimPeriodicCallbackRegistry> gSimPeriodicAfter;
 
 namespace hal::init {
 void InitializeHAL() {
@@ -301,7 +279,7 @@ uint64_t HAL_ExpandFPGATime(uint32_t unexpanded_lower, int32_t* status) {
 }
 
 HAL_Bool HAL_GetFPGAButton(int32_t* status) {
-  return SimRoboRioData[0].fpgaButton;
+  return SimRoboRioData->fpgaButton;
 }
 
 HAL_Bool HAL_GetSystemActive(int32_t* status) {
@@ -380,29 +358,29 @@ void HAL_OnShutdown(void* param, void (*func)(void*)) {
 }
 
 void HAL_SimPeriodicBefore(void) {
-  gSimPeriodicBefore();
+  (*gSimPeriodicBefore)();
 }
 
 void HAL_SimPeriodicAfter(void) {
-  gSimPeriodicAfter();
+  (*gSimPeriodicAfter)();
 }
 
 int32_t HALSIM_RegisterSimPeriodicBeforeCallback(
     HALSIM_SimPeriodicCallback callback, void* param) {
-  return gSimPeriodicBefore.Register(callback, param);
+  return gSimPeriodicBefore->Register(callback, param);
 }
 
 void HALSIM_CancelSimPeriodicBeforeCallback(int32_t uid) {
-  gSimPeriodicBefore.Cancel(uid);
+  gSimPeriodicBefore->Cancel(uid);
 }
 
 int32_t HALSIM_RegisterSimPeriodicAfterCallback(
     HALSIM_SimPeriodicCallback callback, void* param) {
-  return gSimPeriodicAfter.Register(callback, param);
+  return gSimPeriodicAfter->Register(callback, param);
 }
 
 void HALSIM_CancelSimPeriodicAfterCallback(int32_t uid) {
-  gSimPeriodicAfter.Cancel(uid);
+  gSimPeriodicAfter->Cancel(uid);
 }
 
 int64_t HAL_Report(int32_t resource, int32_t instanceNumber, int32_t context,
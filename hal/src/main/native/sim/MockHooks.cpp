@@ -13,13 +13,22 @@
 
 #include "MockHooksInternal.h"
 #include "NotifierInternal.h"
+#include "SimContextInternal.h"
+#include "SimSnapshotInternal.h"
 #include "hal/simulation/NotifierData.h"
 
-static std::atomic<bool> programStarted{false};
+namespace {
+struct Timing {
+  std::atomic<bool> programStarted{false};
 
-static std::atomic<uint64_t> programStartTime{0};
-static std::atomic<uint64_t> programPauseTime{0};
-static std::atomic<uint64_t> programStepTime{0};
+  // a new sim context starts its time at 0
+  std::atomic<uint64_t> programStartTime{wpi::NowDefault()};
+  std::atomic<uint64_t> programPauseTime{0};
+  std::atomic<uint64_t> programStepTime{0};
+};
+}  // namespace
+
+static hal::SimContextLocal<Timing> timing;
 
 namespace hal::init {
 void InitializeMockHooks() {
@@ -29,40 +38,44 @@ void InitializeMockHooks() {
 
 namespace hal {
 void RestartTiming() {
-  programStartTime = wpi::NowDefault();
-  programStepTime = 0;
-  if (programPauseTime != 0) {
-    programPauseTime = programStartTime.load();
+  auto& t = *timing;
+  t.programStartTime = wpi::NowDefault();
+  t.programStepTime = 0;
+  if (t.programPauseTime != 0) {
+    t.programPauseTime = t.programStartTime.load();
   }
 }
 
 void PauseTiming() {
-  if (programPauseTime == 0) {
-    programPauseTime = wpi::NowDefault();
+  auto& t = *timing;
+  if (t.programPauseTime == 0) {
+    t.programPauseTime = wpi::NowDefault();
   }
 }
 
 void ResumeTiming() {
-  if (programPauseTime != 0) {
-    programStartTime += wpi::NowDefault() - programPauseTime;
-    programPauseTime = 0;
+  auto& t = *timing;
+  if (t.programPauseTime != 0) {
+    t.programStartTime += wpi::NowDefault() - t.programPauseTime;
+    t.programPauseTime = 0;
   }
 }
 
 bool IsTimingPaused() {
-  return programPauseTime != 0;
+  return timing->programPauseTime != 0;
 }
 
 void StepTiming(uint64_t delta) {
-  programStepTime += delta;
+  timing->programStepTime += delta;
 }
 
 uint64_t GetFPGATime() {
-  uint64_t curTime = programPauseTime;
+  auto& t = *timing;
+  uint64_t curTime = t.programPauseTime;
   if (curTime == 0) {
     curTime = wpi::NowDefault();
   }
-  return curTime + programStepTime - programStartTime;
+  return curTime + t.programStepTime - t.programStartTime;
 }
 
 double GetFPGATimestamp() {
@@ -70,10 +83,28 @@ double GetFPGATimestamp() {
 }
 
 void SetProgramStarted() {
-  programStarted = true;
+  timing->programStarted = true;
 }
 bool GetProgramStarted() {
-  return programStarted;
+  return timing->programStarted;
+}
+
+void SaveTimingSnapshot(SimSnapshotWriter& writer) {
+  writer.Write(GetFPGATime());
+  writer.Write(IsTimingPaused());
+}
+
+void RestoreTimingSnapshot(SimSnapshotReader& reader) {
+  uint64_t time;
+  bool paused;
+  if (!reader.Read(&time) || !reader.Read(&paused) || !reader.IsApplying()) {
+    return;
+  }
+  auto& t = *timing;
+  uint64_t now = wpi::NowDefault();
+  t.programStartTime = now - time;
+  t.programStepTime = 0;
+  t.programPauseTime = paused ? now : 0;
 }
 }  // namespace hal
 
@@ -82,7 +113,7 @@ using namespace hal;
 extern "C" {
 void HALSIM_WaitForProgramStart(void) {
   int count = 0;
-  while (!programStarted) {
+  while (!GetProgramStarted()) {
     count++;
     fmt::print("Waiting for program start signal: {}\n", count);
     std::this_thread::sleep_for(std::chrono::milliseconds(500));
@@ -122,7 +153,8 @@ void HALSIM_StepTiming(uint64_t delta) {
     int32_t status = 0;
     uint64_t curTime = HAL_GetFPGATime(&status);
     uint64_t nextTimeout = HALSIM_GetNextNotifierTimeout();
-    uint64_t step = std::min(delta, nextTimeout - curTime);
+    uint64_t step =
+        nextTimeout > curTime ? std::min(delta, nextTimeout - curTime) : 0;
 
     StepTiming(step);
     delta -= step;
@@ -135,4 +167,20 @@ void HALSIM_StepTimingAsync(uint64_t delta) {
   StepTiming(delta);
   WakeupNotifiers();
 }
+
+void HALSIM_SetFastTiming(HAL_Bool fast) {
+  if (fast) {
+    PauseTiming();
+    PauseNotifiers();
+    StartFastNotifiers();
+  } else {
+    StopFastNotifiers();
+    ResumeTiming();
+    ResumeNotifiers();
+  }
+}
+
+HAL_Bool HALSIM_IsFastTiming(void) {
+  return IsFastNotifiers();
+}
 }  // extern "C"
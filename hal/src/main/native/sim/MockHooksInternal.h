@@ -6,9 +6,15 @@
 
 #include <stdint.h>
 
+#include <mutex>
+
 #include "hal/simulation/MockHooks.h"
+#include "hal/simulation/SimCallbackRegistry.h"
 
 namespace hal {
+class SimSnapshotReader;
+class SimSnapshotWriter;
+
 void RestartTiming();
 
 void PauseTiming();
@@ -24,4 +30,26 @@ uint64_t GetFPGATime();
 double GetFPGATimestamp();
 
 void SetProgramStarted();
+
+// Saves and restores the simulated time and whether it's paused
+void SaveTimingSnapshot(SimSnapshotWriter& writer);
+void RestoreTimingSnapshot(SimSnapshotReader& reader);
+
+// Callbacks without arguments, like the sim periodic callbacks
+class SimPeriodicCallbackRegistry : public impl::SimCallbackRegistryBase {
+ public:
+  int32_t Register(HALSIM_SimPeriodicCallback callback, void* param) {
+    std::scoped_lock lock(m_mutex);
+    return DoRegister(reinterpret_cast<RawFunctor>(callback), param);
+  }
+
+  void operator()() const {
+    CallbackList::Snapshot callbacks{m_callbacks};
+    if (callbacks) {
+      for (auto&& cb : callbacks) {
+        reinterpret_cast<HALSIM_SimPeriodicCallback>(cb.callback)(cb.param);
+      }
+    }
+  }
+};
 }  // namespace hal
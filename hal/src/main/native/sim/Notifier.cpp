@@ -9,13 +9,17 @@
 #include <cstdio>
 #include <cstring>
 #include <string>
+#include <thread>
 
 #include <wpi/SmallVector.h>
 #include <wpi/condition_variable.h>
 #include <wpi/mutex.h>
 
 #include "HALInitializer.h"
+#include "MockHooksInternal.h"
 #include "NotifierInternal.h"
+#include "SimContextInternal.h"
+#include "SimSnapshotInternal.h"
 #include "hal/Errors.h"
 #include "hal/HALBase.h"
 #include "hal/cpp/fpga_clock.h"
@@ -30,6 +34,7 @@ struct Notifier {
   bool waitTimeValid = false;    // True if waitTime is set and in the future
   bool waitingForAlarm = false;  // True if in HAL_WaitForNotifierAlarm()
   uint64_t waitCount = 0;        // Counts calls to HAL_WaitForNotifierAlarm()
+  bool released = false;         // True if chosen to run by fast timing
   wpi::mutex mutex;
   wpi::condition_variable cond;
 };
@@ -37,14 +42,13 @@ struct Notifier {
 
 using namespace hal;
 
-static wpi::mutex notifiersWaiterMutex;
-static wpi::condition_variable notifiersWaiterCond;
-
+// The Notifiers of a sim context, and what threads wait on for them
 class NotifierHandleContainer
     : public UnlimitedHandleResource<HAL_NotifierHandle, Notifier,
                                      HAL_HandleEnum::Notifier> {
  public:
   ~NotifierHandleContainer() {
+    StopFast();
     ForEach([](HAL_NotifierHandle handle, Notifier* notifier) {
       {
         std::scoped_lock lock(notifier->mutex);
@@ -53,30 +57,129 @@ class NotifierHandleContainer
       }
       notifier->cond.notify_all();  // wake up any waiting threads
     });
-    notifiersWaiterCond.notify_all();
+    waiterCond.notify_all();
+  }
+
+  void StopFast() {
+    {
+      std::scoped_lock lock(waiterMutex);
+      if (!fastRunning) {
+        return;
+      }
+      fastRunning = false;
+      fast = false;
+    }
+    waiterCond.notify_all();
+    fastThread.join();
   }
+
+  wpi::mutex waiterMutex;
+  wpi::condition_variable waiterCond;
+
+  // The fast timing thread; fastRunning is guarded by waiterMutex
+  std::atomic<bool> fast{false};
+  std::thread fastThread;
+  bool fastRunning = false;
+
+  std::atomic<bool> paused{false};
 };
 
-static NotifierHandleContainer* notifierHandles;
-static std::atomic<bool> notifiersPaused{false};
+static SimContextLocal<NotifierHandleContainer> notifierHandles;
+
+// Wakes up threads waiting on waiterCond. Locking the mutex first makes sure a
+// waiter either sees the new state or is already waiting, so nothing is missed
+// without timed waits.
+static void NotifyWaiters() {
+  auto& notifiers = *notifierHandles;
+  { std::scoped_lock lock(notifiers.waiterMutex); }
+  notifiers.waiterCond.notify_all();
+}
 
 namespace hal {
 namespace init {
-void InitializeNotifier() {
-  static NotifierHandleContainer nH;
-  notifierHandles = &nH;
-}
+void InitializeNotifier() {}
 }  // namespace init
 
 void PauseNotifiers() {
-  notifiersPaused = true;
+  notifierHandles->paused = true;
 }
 
 void ResumeNotifiers() {
-  notifiersPaused = false;
+  notifierHandles->paused = false;
   WakeupNotifiers();
 }
 
+static void RunFastNotifiers(SimContext* context) {
+  // Step the time of the sim context that enabled fast timing
+  SetThreadSimContext(context);
+  auto& notifiers = *notifierHandles;
+  std::unique_lock ulock(notifiers.waiterMutex);
+  while (notifiers.fastRunning) {
+    // Once every active Notifier is in HAL_WaitForNotifierAlarm(), pick the
+    // one with the earliest alarm. Ties go to the lowest handle so the order is
+    // the same on every run.
+    bool parked = true;
+    HAL_NotifierHandle next = HAL_kInvalidHandle;
+    uint64_t nextTime = UINT64_MAX;
+    notifiers.ForEach([&](HAL_NotifierHandle handle, Notifier* notifier) {
+      std::scoped_lock lock(notifier->mutex);
+      if (!notifier->active) {
+        return;
+      }
+      if (!notifier->waitingForAlarm) {
+        parked = false;
+      } else if (notifier->waitTimeValid && notifier->waitTime < nextTime) {
+        next = handle;
+        nextTime = notifier->waitTime;
+      }
+    });
+    auto notifier = notifiers.Get(next);
+    if (!parked || !notifier) {
+      notifiers.waiterCond.wait(ulock);
+      continue;
+    }
+
+    // Jump straight to the alarm and let only that Notifier run until it
+    // returns from HAL_WaitForNotifierAlarm()
+    uint64_t curTime = GetFPGATime();
+    if (nextTime > curTime) {
+      StepTiming(nextTime - curTime);
+    }
+    {
+      std::scoped_lock lock(notifier->mutex);
+      notifier->released = true;
+    }
+    notifier->cond.notify_all();
+    notifiers.waiterCond.wait(ulock, [&] {
+      std::scoped_lock lock(notifier->mutex);
+      return !notifiers.fastRunning || !notifier->released;
+    });
+  }
+}
+
+void StartFastNotifiers() {
+  auto& notifiers = *notifierHandles;
+  std::scoped_lock lock(notifiers.waiterMutex);
+  if (notifiers.fastRunning) {
+    return;
+  }
+  notifiers.ForEach([](HAL_NotifierHandle handle, Notifier* notifier) {
+    std::scoped_lock lock(notifier->mutex);
+    notifier->released = false;
+  });
+  notifiers.fast = true;
+  notifiers.fastRunning = true;
+  notifiers.fastThread = std::thread{RunFastNotifiers, GetThreadSimContext()};
+}
+
+void StopFastNotifiers() {
+  notifierHandles->StopFast();
+}
+
+bool IsFastNotifiers() {
+  return notifierHandles->fast;
+}
+
 void WakeupNotifiers() {
   notifierHandles->ForEach([](HAL_NotifierHandle handle, Notifier* notifier) {
     notifier->cond.notify_all();
@@ -84,11 +187,12 @@ void WakeupNotifiers() {
 }
 
 void WaitNotifiers() {
-  std::unique_lock ulock(notifiersWaiterMutex);
+  auto& notifiers = *notifierHandles;
+  std::unique_lock ulock(notifiers.waiterMutex);
   wpi::SmallVector<HAL_NotifierHandle, 8> waiters;
 
   // Wait for all Notifiers to hit HAL_WaitForNotifierAlarm()
-  notifierHandles->ForEach([&](HAL_NotifierHandle handle, Notifier* notifier) {
+  notifiers.ForEach([&](HAL_NotifierHandle handle, Notifier* notifier) {
     std::scoped_lock lock(notifier->mutex);
     if (notifier->active && !notifier->waitingForAlarm) {
       waiters.emplace_back(handle);
@@ -99,7 +203,7 @@ void WaitNotifiers() {
     int end = waiters.size();
     while (count < end) {
       auto& it = waiters[count];
-      if (auto notifier = notifierHandles->Get(it)) {
+      if (auto notifier = notifiers.Get(it)) {
         std::scoped_lock lock(notifier->mutex);
         if (notifier->active && !notifier->waitingForAlarm) {
           ++count;
@@ -113,18 +217,19 @@ void WaitNotifiers() {
       break;
     }
     waiters.resize(count);
-    notifiersWaiterCond.wait_for(ulock, std::chrono::duration<double>(1));
+    notifiers.waiterCond.wait(ulock);
   }
 }
 
 void WakeupWaitNotifiers() {
-  std::unique_lock ulock(notifiersWaiterMutex);
+  auto& notifiers = *notifierHandles;
+  std::unique_lock ulock(notifiers.waiterMutex);
   int32_t status = 0;
   uint64_t curTime = HAL_GetFPGATime(&status);
   wpi::SmallVector<std::pair<HAL_NotifierHandle, uint64_t>, 8> waiters;
 
   // Wake up Notifiers that have expired timeouts
-  notifierHandles->ForEach([&](HAL_NotifierHandle handle, Notifier* notifier) {
+  notifiers.ForEach([&](HAL_NotifierHandle handle, Notifier* notifier) {
     std::scoped_lock lock(notifier->mutex);
 
     // Only wait for the Notifier if it has a valid timeout that's expired
@@ -139,7 +244,7 @@ void WakeupWaitNotifiers() {
     int end = waiters.size();
     while (count < end) {
       auto& it = waiters[count];
-      if (auto notifier = notifierHandles->Get(it.first)) {
+      if (auto notifier = notifiers.Get(it.first)) {
         std::scoped_lock lock(notifier->mutex);
 
         // waitCount is used here instead of waitingForAlarm because we want to
@@ -156,7 +261,60 @@ void WakeupWaitNotifiers() {
       break;
     }
     waiters.resize(count);
-    notifiersWaiterCond.wait_for(ulock, std::chrono::duration<double>(1));
+    notifiers.waiterCond.wait(ulock);
+  }
+}
+
+void SaveNotifierSnapshot(SimSnapshotWriter& writer) {
+  struct Alarm {
+    HAL_NotifierHandle handle;
+    uint64_t waitTime;
+    bool waitTimeValid;
+  };
+  wpi::SmallVector<Alarm, 8> alarms;
+  notifierHandles->ForEach([&](HAL_NotifierHandle handle, Notifier* notifier) {
+    std::scoped_lock lock(notifier->mutex);
+    alarms.push_back({handle, notifier->waitTime, notifier->waitTimeValid});
+  });
+  writer.Write(static_cast<int32_t>(alarms.size()));
+  for (auto&& alarm : alarms) {
+    writer.Write(alarm.handle);
+    writer.Write(alarm.waitTime);
+    writer.Write(alarm.waitTimeValid);
+  }
+}
+
+void RestoreNotifierSnapshot(SimSnapshotReader& reader) {
+  auto& notifiers = *notifierHandles;
+  int32_t count;
+  if (!reader.Read(&count)) {
+    return;
+  }
+  for (int32_t i = 0; i < count; ++i) {
+    HAL_NotifierHandle handle;
+    uint64_t waitTime;
+    bool waitTimeValid;
+    if (!reader.Read(&handle) || !reader.Read(&waitTime) ||
+        !reader.Read(&waitTimeValid)) {
+      return;
+    }
+    if (!reader.IsApplying()) {
+      continue;
+    }
+    if (auto notifier = notifiers.Get(handle)) {
+      {
+        std::scoped_lock lock(notifier->mutex);
+        if (notifier->active) {
+          notifier->waitTime = waitTime;
+          notifier->waitTimeValid = waitTimeValid;
+        }
+      }
+      // wake it up to wait for the restored alarm and time
+      notifier->cond.notify_all();
+    }
+  }
+  if (reader.IsApplying()) {
+    NotifyWaiters();
   }
 }
 }  // namespace hal
@@ -201,6 +359,7 @@ void HAL_StopNotifier(HAL_NotifierHandle notifierHandle, int32_t* status) {
     notifier->waitTimeValid = false;
   }
   notifier->cond.notify_all();
+  NotifyWaiters();
 }
 
 void HAL_CleanNotifier(HAL_NotifierHandle notifierHandle, int32_t* status) {
@@ -216,6 +375,7 @@ void HAL_CleanNotifier(HAL_NotifierHandle notifierHandle, int32_t* status) {
     notifier->waitTimeValid = false;
   }
   notifier->cond.notify_all();
+  NotifyWaiters();
 }
 
 void HAL_UpdateNotifierAlarm(HAL_NotifierHandle notifierHandle,
@@ -233,6 +393,9 @@ void HAL_UpdateNotifierAlarm(HAL_NotifierHandle notifierHandle,
 
   // We wake up any waiters to change how long they're sleeping for
   notifier->cond.notify_all();
+  if (notifierHandles->fast) {
+    NotifyWaiters();
+  }
 }
 
 void HAL_CancelNotifierAlarm(HAL_NotifierHandle notifierHandle,
@@ -250,27 +413,44 @@ void HAL_CancelNotifierAlarm(HAL_NotifierHandle notifierHandle,
 
 uint64_t HAL_WaitForNotifierAlarm(HAL_NotifierHandle notifierHandle,
                                   int32_t* status) {
-  auto notifier = notifierHandles->Get(notifierHandle);
+  auto& notifiers = *notifierHandles;
+  auto notifier = notifiers.Get(notifierHandle);
   if (!notifier) {
     return 0;
   }
 
-  std::unique_lock ulock(notifiersWaiterMutex);
+  std::unique_lock ulock(notifiers.waiterMutex);
   std::unique_lock lock(notifier->mutex);
   notifier->waitingForAlarm = true;
   ++notifier->waitCount;
   ulock.unlock();
-  notifiersWaiterCond.notify_all();
+  notifiers.waiterCond.notify_all();
   while (notifier->active) {
     uint64_t curTime = HAL_GetFPGATime(status);
-    if (notifier->waitTimeValid && curTime >= notifier->waitTime) {
-      notifier->waitTimeValid = false;
-      notifier->waitingForAlarm = false;
-      return curTime;
+    bool expired = notifier->waitTimeValid && curTime >= notifier->waitTime;
+    if (notifiers.fast && !notifier->released) {
+      // Only the Notifier chosen by the fast timing thread may run
+      expired = false;
+    }
+    if (expired || notifier->released) {
+      // If the alarm moved after this Notifier was chosen, let the fast timing
+      // thread choose again
+      notifier->released = false;
+      if (expired) {
+        notifier->waitTimeValid = false;
+      }
+      notifier->waitingForAlarm = !expired;
+      lock.unlock();
+      NotifyWaiters();
+      if (expired) {
+        return curTime;
+      }
+      lock.lock();
+      continue;
     }
 
     double waitDuration;
-    if (!notifier->waitTimeValid || notifiersPaused) {
+    if (!notifier->waitTimeValid || notifiers.paused) {
       // If not running, wait 1000 seconds
       waitDuration = 1000.0;
     } else {
@@ -280,6 +460,9 @@ uint64_t HAL_WaitForNotifierAlarm(HAL_NotifierHandle notifierHandle,
     notifier->cond.wait_for(lock, std::chrono::duration<double>(waitDuration));
   }
   notifier->waitingForAlarm = false;
+  notifier->released = false;
+  lock.unlock();
+  NotifyWaiters();
   return 0;
 }
 
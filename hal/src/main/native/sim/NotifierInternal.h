@@ -5,9 +5,20 @@
 #pragma once
 
 namespace hal {
+class SimSnapshotReader;
+class SimSnapshotWriter;
+
 void PauseNotifiers();
 void ResumeNotifiers();
 void WakeupNotifiers();
 void WaitNotifiers();
 void WakeupWaitNotifiers();
+void StartFastNotifiers();
+void StopFastNotifiers();
+bool IsFastNotifiers();
+
+// Saves and restores the alarms of the Notifiers; Notifiers created after the
+// snapshot keep their alarms
+void SaveNotifierSnapshot(SimSnapshotWriter& writer);
+void RestoreNotifierSnapshot(SimSnapshotReader& reader);
 }  // namespace hal
@@ -18,6 +18,23 @@ namespace hal::init {
 void InitializePWM() {}
 }  // namespace hal::init
 
+// Gets the channel of a PWM port, or returns -1 and sets status on error. The
+// port is only borrowed here, as setting the sim data invokes callbacks.
+static int32_t GetPWMChannel(HAL_DigitalHandle pwmPortHandle,
+                             bool requireConfig, int32_t* status) {
+  auto port =
+      digitalChannelHandles->Borrow(pwmPortHandle, HAL_HandleEnum::PWM);
+  if (port == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return -1;
+  }
+  if (requireConfig && !port->configSet) {
+    *status = INCOMPATIBLE_STATE;
+    return -1;
+  }
+  return port->channel;
+}
+
 extern "C" {
 
 HAL_DigitalHandle HAL_InitializePWMPort(HAL_PortHandle portHandle,
@@ -140,7 +157,8 @@ void HAL_GetPWMConfigRaw(HAL_DigitalHandle pwmPortHandle, int32_t* maxPwm,
                          int32_t* deadbandMaxPwm, int32_t* centerPwm,
                          int32_t* deadbandMinPwm, int32_t* minPwm,
                          int32_t* status) {
-  auto port = digitalChannelHandles->Get(pwmPortHandle, HAL_HandleEnum::PWM);
+  auto port =
+      digitalChannelHandles->Borrow(pwmPortHandle, HAL_HandleEnum::PWM);
   if (port == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return;
@@ -164,7 +182,8 @@ void HAL_SetPWMEliminateDeadband(HAL_DigitalHandle pwmPortHandle,
 
 HAL_Bool HAL_GetPWMEliminateDeadband(HAL_DigitalHandle pwmPortHandle,
                                      int32_t* status) {
-  auto port = digitalChannelHandles->Get(pwmPortHandle, HAL_HandleEnum::PWM);
+  auto port =
+      digitalChannelHandles->Borrow(pwmPortHandle, HAL_HandleEnum::PWM);
   if (port == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return false;
@@ -174,24 +193,18 @@ HAL_Bool HAL_GetPWMEliminateDeadband(HAL_DigitalHandle pwmPortHandle,
 
 void HAL_SetPWMRaw(HAL_DigitalHandle pwmPortHandle, int32_t value,
                    int32_t* status) {
-  auto port = digitalChannelHandles->Get(pwmPortHandle, HAL_HandleEnum::PWM);
-  if (port == nullptr) {
-    *status = HAL_HANDLE_ERROR;
+  int32_t channel = GetPWMChannel(pwmPortHandle, false, status);
+  if (channel < 0) {
     return;
   }
 
-  SimPWMData[port->channel].rawValue = value;
+  SimPWMData[channel].rawValue = value;
 }
 
 void HAL_SetPWMSpeed(HAL_DigitalHandle pwmPortHandle, double speed,
                      int32_t* status) {
-  auto port = digitalChannelHandles->Get(pwmPortHandle, HAL_HandleEnum::PWM);
-  if (port == nullptr) {
-    *status = HAL_HANDLE_ERROR;
-    return;
-  }
-  if (!port->configSet) {
-    *status = INCOMPATIBLE_STATE;
+  int32_t channel = GetPWMChannel(pwmPortHandle, true, status);
+  if (channel < 0) {
     return;
   }
 
@@ -201,18 +214,13 @@ void HAL_SetPWMSpeed(HAL_DigitalHandle pwmPortHandle, double speed,
     speed = 1.0;
   }
 
-  SimPWMData[port->channel].speed = speed;
+  SimPWMData[channel].speed = speed;
 }
 
 void HAL_SetPWMPosition(HAL_DigitalHandle pwmPortHandle, double pos,
                         int32_t* status) {
-  auto port = digitalChannelHandles->Get(pwmPortHandle, HAL_HandleEnum::PWM);
-  if (port == nullptr) {
-    *status = HAL_HANDLE_ERROR;
-    return;
-  }
-  if (!port->configSet) {
-    *status = INCOMPATIBLE_STATE;
+  int32_t channel = GetPWMChannel(pwmPortHandle, true, status);
+  if (channel < 0) {
     return;
   }
 
@@ -222,22 +230,22 @@ void HAL_SetPWMPosition(HAL_DigitalHandle pwmPortHandle, double pos,
     pos = 1.0;
   }
 
-  SimPWMData[port->channel].position = pos;
+  SimPWMData[channel].position = pos;
 }
 
 void HAL_SetPWMDisabled(HAL_DigitalHandle pwmPortHandle, int32_t* status) {
-  auto port = digitalChannelHandles->Get(pwmPortHandle, HAL_HandleEnum::PWM);
-  if (port == nullptr) {
-    *status = HAL_HANDLE_ERROR;
+  int32_t channel = GetPWMChannel(pwmPortHandle, false, status);
+  if (channel < 0) {
     return;
   }
-  SimPWMData[port->channel].rawValue = 0;
-  SimPWMData[port->channel].position = 0;
-  SimPWMData[port->channel].speed = 0;
+  SimPWMData[channel].rawValue = 0;
+  SimPWMData[channel].position = 0;
+  SimPWMData[channel].speed = 0;
 }
 
 int32_t HAL_GetPWMRaw(HAL_DigitalHandle pwmPortHandle, int32_t* status) {
-  auto port = digitalChannelHandles->Get(pwmPortHandle, HAL_HandleEnum::PWM);
+  auto port =
+      digitalChannelHandles->Borrow(pwmPortHandle, HAL_HandleEnum::PWM);
   if (port == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return 0;
@@ -247,7 +255,8 @@ int32_t HAL_GetPWMRaw(HAL_DigitalHandle pwmPortHandle, int32_t* status) {
 }
 
 double HAL_GetPWMSpeed(HAL_DigitalHandle pwmPortHandle, int32_t* status) {
-  auto port = digitalChannelHandles->Get(pwmPortHandle, HAL_HandleEnum::PWM);
+  auto port =
+      digitalChannelHandles->Borrow(pwmPortHandle, HAL_HandleEnum::PWM);
   if (port == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return 0;
@@ -268,7 +277,8 @@ double HAL_GetPWMSpeed(HAL_DigitalHandle pwmPortHandle, int32_t* status) {
 }
 
 double HAL_GetPWMPosition(HAL_DigitalHandle pwmPortHandle, int32_t* status) {
-  auto port = digitalChannelHandles->Get(pwmPortHandle, HAL_HandleEnum::PWM);
+  auto port =
+      digitalChannelHandles->Borrow(pwmPortHandle, HAL_HandleEnum::PWM);
   if (port == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return 0;
@@ -0,0 +1,209 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <wpi/mutex.h>
+
+#include "NotifierInternal.h"
+#include "SimContextInternal.h"
+#include "hal/simulation/MockHooks.h"
+
+namespace {
+struct LocalInfo {
+  void* (*create)(size_t);
+  void (*destroy)(void*);
+  size_t count;
+};
+
+constexpr size_t kMaxLocals = 128;
+
+// Variables are registered during static initialization, so this isn't locked
+std::vector<LocalInfo>& GetLocalInfos() {
+  static std::vector<LocalInfo> infos;
+  return infos;
+}
+}  // namespace
+
+namespace hal {
+class SimContext {
+ public:
+  explicit SimContext(int32_t id) : m_id{id} {}
+  SimContext(const SimContext&) = delete;
+  SimContext& operator=(const SimContext&) = delete;
+  ~SimContext();
+
+  int32_t GetId() const { return m_id; }
+
+  std::atomic<void*>* GetLocals() { return m_locals.data(); }
+
+  // The number of threads bound with HALSIM_SetThreadSimContext()
+  std::atomic<int> bindings{0};
+
+  void* GetLocal(size_t id) {
+    void* local = m_locals[id].load(std::memory_order_acquire);
+    if (!local) {
+      std::scoped_lock lock(m_mutex);
+      local = m_locals[id].load(std::memory_order_relaxed);
+      if (!local) {
+        auto& info = GetLocalInfos()[id];
+        local = info.create(info.count);
+        m_locals[id].store(local, std::memory_order_release);
+      }
+    }
+    return local;
+  }
+
+ private:
+  int32_t m_id;
+  std::array<std::atomic<void*>, kMaxLocals> m_locals{};
+  wpi::mutex m_mutex;
+};
+}  // namespace hal
+
+using namespace hal;
+
+static thread_local SimContext* currentContext = nullptr;
+
+namespace {
+// Unbinds the context bound with HALSIM_SetThreadSimContext() when the thread
+// exits
+struct ThreadBinding {
+  ~ThreadBinding() { Bind(nullptr); }
+
+  void Bind(SimContext* newContext) {
+    if (context) {
+      context->bindings.fetch_sub(1, std::memory_order_relaxed);
+    }
+    context = newContext;
+    if (context) {
+      context->bindings.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  SimContext* context = nullptr;
+};
+}  // namespace
+
+static thread_local ThreadBinding threadBinding;
+
+static SimContext& GetDefaultSimContext() {
+  static SimContext context{0};
+  return context;
+}
+
+static wpi::mutex contextsMutex;
+// contexts[i] has id i + 1
+static std::vector<std::unique_ptr<SimContext>> contexts;
+
+SimContext::~SimContext() {
+  // Destroy the variables in reverse order with this context bound, so their
+  // destructors use the rest of this context
+  SimContext* prev = currentContext;
+  SetThreadSimContext(this);
+  // The fast timing thread uses the other variables, so stop it first
+  StopFastNotifiers();
+  auto& infos = GetLocalInfos();
+  for (size_t i = infos.size(); i-- > 0;) {
+    if (void* local = m_locals[i].load()) {
+      infos[i].destroy(local);
+      m_locals[i] = nullptr;
+    }
+  }
+  SetThreadSimContext(prev == this ? nullptr : prev);
+}
+
+namespace hal {
+size_t impl::RegisterSimContextLocal(void* (*create)(size_t),
+                                     void (*destroy)(void*), size_t count) {
+  auto& infos = GetLocalInfos();
+  if (infos.size() >= kMaxLocals) {
+    std::fputs("HAL: too many sim context variables\n", stderr);
+    std::abort();
+  }
+  infos.push_back({create, destroy, count});
+  return infos.size() - 1;
+}
+
+void* impl::GetSimContextLocalSlow(size_t id) {
+  SimContext* context = currentContext;
+  if (!context) {
+    context = &GetDefaultSimContext();
+  }
+  gThreadSimContextLocals = context->GetLocals();
+  return context->GetLocal(id);
+}
+
+SimContext* GetThreadSimContext() {
+  return currentContext;
+}
+
+void SetThreadSimContext(SimContext* context) {
+  currentContext = context;
+  impl::gThreadSimContextLocals = nullptr;
+}
+}  // namespace hal
+
+extern "C" {
+int32_t HALSIM_CreateSimContext(void) {
+  std::scoped_lock lock(contextsMutex);
+  size_t i = 0;
+  while (i < contexts.size() && contexts[i]) {
+    ++i;
+  }
+  if (i == contexts.size()) {
+    contexts.emplace_back();
+  }
+  contexts[i] = std::make_unique<SimContext>(static_cast<int32_t>(i + 1));
+  return static_cast<int32_t>(i + 1);
+}
+
+HAL_Bool HALSIM_DestroySimContext(int32_t context) {
+  std::unique_ptr<SimContext> destroyed;
+  {
+    std::scoped_lock lock(contextsMutex);
+    if (context < 1 || static_cast<size_t>(context) > contexts.size() ||
+        !contexts[context - 1]) {
+      return false;
+    }
+    // Other threads bound to the context would be left using freed memory
+    SimContext* impl = contexts[context - 1].get();
+    int otherBindings = impl->bindings.load(std::memory_order_relaxed) -
+                        (threadBinding.context == impl ? 1 : 0);
+    if (otherBindings > 0) {
+      std::fprintf(stderr,
+                   "HAL: sim context %d is still bound to %d other "
+                   "thread(s); not destroying it\n",
+                   static_cast<int>(context), otherBindings);
+      return false;
+    }
+    if (threadBinding.context == impl) {
+      threadBinding.Bind(nullptr);
+      SetThreadSimContext(nullptr);
+    }
+    destroyed = std::move(contexts[context - 1]);
+  }
+  return true;
+}
+
+void HALSIM_SetThreadSimContext(int32_t context) {
+  std::scoped_lock lock(contextsMutex);
+  SimContext* impl = nullptr;
+  if (context >= 1 && static_cast<size_t>(context) <= contexts.size()) {
+    impl = contexts[context - 1].get();
+  }
+  threadBinding.Bind(impl);
+  SetThreadSimContext(impl);
+}
+
+int32_t HALSIM_GetThreadSimContext(void) {
+  return currentContext ? currentContext->GetId() : 0;
+}
+}  // extern "C"
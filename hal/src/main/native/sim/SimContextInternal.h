@@ -0,0 +1,124 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stddef.h>
+
+#include <atomic>
+
+namespace hal {
+class SimContext;
+
+namespace impl {
+/**
+ * Registers a variable that each sim context has its own instance of.
+ *
+ * @param create creates an instance with the given count
+ * @param destroy destroys an instance
+ * @param count the number of elements of array instances
+ * @return id of the variable
+ */
+size_t RegisterSimContextLocal(void* (*create)(size_t), void (*destroy)(void*),
+                               size_t count);
+
+/**
+ * The variables of the sim context bound to the calling thread, cached so
+ * getting an existing one doesn't call into the context; nullptr until the
+ * thread gets one after binding a context.
+ */
+inline thread_local std::atomic<void*>* gThreadSimContextLocals = nullptr;
+
+/**
+ * Gets the calling thread's instance of a variable, creating it if needed,
+ * and caches the variables of the thread's context.
+ */
+void* GetSimContextLocalSlow(size_t id);
+
+/**
+ * Gets the calling thread's instance of a variable, creating it if needed.
+ */
+inline void* GetSimContextLocal(size_t id) {
+  if (auto locals = gThreadSimContextLocals) {
+    if (void* local = locals[id].load(std::memory_order_acquire)) {
+      return local;
+    }
+  }
+  return GetSimContextLocalSlow(id);
+}
+}  // namespace impl
+
+/**
+ * Gets the sim context bound to the calling thread.
+ */
+SimContext* GetThreadSimContext();
+
+/**
+ * Binds a sim context to the calling thread; nullptr binds the default context.
+ * Unlike HALSIM_SetThreadSimContext(), the binding doesn't keep
+ * HALSIM_DestroySimContext() from destroying the context, so it's only for
+ * threads the context owns.
+ */
+void SetThreadSimContext(SimContext* context);
+
+/**
+ * A variable that each sim context has its own instance of, created the first
+ * time the context uses it.
+ *
+ * @tparam T The type of the variable; it's value-initialized
+ */
+template <typename T>
+class SimContextLocal {
+ public:
+  SimContextLocal()
+      : m_id{impl::RegisterSimContextLocal(
+            [](size_t) -> void* { return new Holder(); },
+            [](void* ptr) { delete static_cast<Holder*>(ptr); }, 1)} {}
+  SimContextLocal(const SimContextLocal&) = delete;
+  SimContextLocal& operator=(const SimContextLocal&) = delete;
+
+  T& Get() const {
+    return static_cast<Holder*>(impl::GetSimContextLocal(m_id))->value;
+  }
+  T& operator*() const { return Get(); }
+  T* operator->() const { return &Get(); }
+
+ private:
+  // handle resources are polymorphic but have no virtual destructor
+  struct Holder {
+    T value;
+  };
+
+  size_t m_id;
+};
+
+/**
+ * An array that each sim context has its own instance of, created the first
+ * time the context uses it.
+ *
+ * @tparam T The element type; elements are value-initialized
+ */
+template <typename T>
+class SimContextArray {
+ public:
+  explicit SimContextArray(size_t size)
+      : m_id{impl::RegisterSimContextLocal(
+            [](size_t count) -> void* { return new T[count](); },
+            [](void* ptr) { delete[] static_cast<T*>(ptr); }, size)},
+        m_size{size} {}
+  SimContextArray(const SimContextArray&) = delete;
+  SimContextArray& operator=(const SimContextArray&) = delete;
+
+  T& operator[](size_t index) const {
+    return static_cast<T*>(impl::GetSimContextLocal(m_id))[index];
+  }
+
+  size_t size() const { return m_size; }
+
+ private:
+  size_t m_id;
+  size_t m_size;
+};
+
+}  // namespace hal
@@ -0,0 +1,197 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "hal/simulation/SimSnapshot.h"
+
+#include <cstring>
+#include <vector>
+
+#include "MockHooksInternal.h"
+#include "NotifierInternal.h"
+#include "SimContextInternal.h"
+#include "SimSnapshotInternal.h"
+#include "mockdata/AccelerometerDataInternal.h"
+#include "mockdata/AddressableLEDDataInternal.h"
+#include "mockdata/AnalogGyroDataInternal.h"
+#include "mockdata/AnalogInDataInternal.h"
+#include "mockdata/AnalogOutDataInternal.h"
+#include "mockdata/AnalogTriggerDataInternal.h"
+#include "mockdata/CTREPCMDataInternal.h"
+#include "mockdata/DIODataInternal.h"
+#include "mockdata/DigitalPWMDataInternal.h"
+#include "mockdata/DriverStationDataInternal.h"
+#include "mockdata/DutyCycleDataInternal.h"
+#include "mockdata/EncoderDataInternal.h"
+#include "mockdata/I2CDataInternal.h"
+#include "mockdata/PDPDataInternal.h"
+#include "mockdata/PWMDataInternal.h"
+#include "mockdata/RelayDataInternal.h"
+#include "mockdata/RoboRioDataInternal.h"
+#include "mockdata/SPIAccelerometerDataInternal.h"
+#include "mockdata/SPIDataInternal.h"
+#include "mockdata/SimDeviceDataInternal.h"
+
+using namespace hal;
+
+namespace {
+// "HSIM" and the format version
+constexpr uint32_t kMagic = 0x4853494d;
+constexpr uint32_t kVersion = 1;
+
+template <typename T, typename F>
+void ForEach(SimContextArray<T>& data, F&& func) {
+  for (size_t i = 0; i < data.size(); ++i) {
+    func(data[i]);
+  }
+}
+
+template <typename T>
+void VisitState(SimSnapshotWriter& writer, T& data) {
+  data.SaveSnapshot(writer);
+}
+
+template <typename T>
+void VisitState(SimSnapshotReader& reader, T& data) {
+  data.RestoreSnapshot(reader);
+}
+
+void VisitTiming(SimSnapshotWriter& writer) {
+  SaveTimingSnapshot(writer);
+  SaveNotifierSnapshot(writer);
+}
+
+void VisitTiming(SimSnapshotReader& reader) {
+  RestoreTimingSnapshot(reader);
+  RestoreNotifierSnapshot(reader);
+}
+
+// Lists the state in a snapshot, in order
+template <typename Archive>
+void Visit(Archive& ar) {
+  ForEach(SimAccelerometerData, [&](AccelerometerData& d) {
+    ar(d.active, d.range, d.x, d.y, d.z);
+  });
+  ForEach(SimAddressableLEDData, [&](AddressableLEDData& d) {
+    ar(d.initialized, d.outputPort, d.length, d.running);
+    VisitState(ar, d);
+  });
+  ForEach(SimAnalogGyroData, [&](AnalogGyroData& d) {
+    ar(d.angle, d.rate, d.initialized);
+  });
+  ForEach(SimAnalogInData, [&](AnalogInData& d) {
+    ar(d.initialized, d.simDevice, d.averageBits, d.oversampleBits, d.voltage,
+       d.accumulatorInitialized, d.accumulatorValue, d.accumulatorCount,
+       d.accumulatorCenter, d.accumulatorDeadband);
+  });
+  ForEach(SimAnalogOutData, [&](AnalogOutData& d) {
+    ar(d.voltage, d.initialized);
+  });
+  ForEach(SimAnalogTriggerData, [&](AnalogTriggerData& d) {
+    ar(d.initialized, d.triggerLowerBound, d.triggerUpperBound, d.triggerMode,
+       d.inputPort);
+  });
+  ForEach(SimCTREPCMData, [&](CTREPCMData& d) {
+    ar(d.initialized, d.solenoidOutput, d.compressorOn, d.closedLoopEnabled,
+       d.pressureSwitch, d.compressorCurrent);
+  });
+  ForEach(SimDIOData, [&](DIOData& d) {
+    ar(d.initialized, d.simDevice, d.value, d.pulseLength, d.isInput,
+       d.filterIndex);
+  });
+  ForEach(SimDigitalPWMData, [&](DigitalPWMData& d) {
+    ar(d.initialized, d.dutyCycle, d.pin);
+  });
+  {
+    auto& d = *SimDriverStationData;
+    ar(d.enabled, d.autonomous, d.test, d.eStop, d.fmsAttached, d.dsAttached,
+       d.allianceStationId, d.matchTime);
+    VisitState(ar, d);
+  }
+  ForEach(SimDutyCycleData, [&](DutyCycleData& d) {
+    ar(d.digitalChannel, d.initialized, d.simDevice, d.frequency, d.output);
+  });
+  ForEach(SimEncoderData, [&](EncoderData& d) {
+    ar(d.digitalChannelA, d.digitalChannelB, d.initialized, d.simDevice,
+       d.count, d.period, d.reset, d.maxPeriod, d.direction, d.reverseDirection,
+       d.samplesToAverage, d.distancePerPulse);
+  });
+  ForEach(SimI2CData, [&](I2CData& d) {
+    ar(d.initialized);
+  });
+  ForEach(SimPDPData, [&](PDPData& d) {
+    ar(d.initialized, d.temperature, d.voltage, d.current);
+  });
+  ForEach(SimPWMData, [&](PWMData& d) {
+    ar(d.initialized, d.rawValue, d.speed, d.position, d.periodScale,
+       d.zeroLatch);
+  });
+  ForEach(SimRelayData, [&](RelayData& d) {
+    ar(d.initializedForward, d.initializedReverse, d.forward, d.reverse);
+  });
+  {
+    auto& d = *SimRoboRioData;
+    ar(d.fpgaButton, d.vInVoltage, d.vInCurrent, d.userVoltage6V,
+       d.userCurrent6V, d.userActive6V, d.userVoltage5V, d.userCurrent5V,
+       d.userActive5V, d.userVoltage3V3, d.userCurrent3V3, d.userActive3V3,
+       d.userFaults6V, d.userFaults5V, d.userFaults3V3);
+  }
+  ForEach(SimSPIAccelerometerData, [&](SPIAccelerometerData& d) {
+    ar(d.active, d.range, d.x, d.y, d.z);
+  });
+  ForEach(SimSPIData, [&](SPIData& d) {
+    ar(d.initialized);
+  });
+  VisitState(ar, *SimSimDeviceData);
+  VisitTiming(ar);
+}
+}  // namespace
+
+static SimContextLocal<SimPeriodicCallbackRegistry> restoredCallbacks;
+
+extern "C" {
+
+int32_t HALSIM_SaveSimSnapshot(uint8_t* buffer, int32_t size) {
+  SimSnapshotWriter writer;
+  writer.Write(kMagic);
+  writer.Write(kVersion);
+  Visit(writer);
+  auto& data = writer.GetData();
+  if (buffer && data.size() <= static_cast<size_t>(size)) {
+    std::memcpy(buffer, data.data(), data.size());
+  }
+  return static_cast<int32_t>(data.size());
+}
+
+HAL_Bool HALSIM_RestoreSimSnapshot(const uint8_t* buffer, int32_t size) {
+  if (!buffer || size < 0) {
+    return false;
+  }
+  // Check the whole snapshot before changing anything
+  for (bool apply : {false, true}) {
+    SimSnapshotReader reader{buffer, static_cast<size_t>(size), apply};
+    uint32_t magic;
+    uint32_t version;
+    if (!reader.Read(&magic) || magic != kMagic || !reader.Read(&version) ||
+        version != kVersion) {
+      return false;
+    }
+    Visit(reader);
+    if (!reader.IsValid() || !reader.AtEnd()) {
+      return false;
+    }
+  }
+  (*restoredCallbacks)();
+  return true;
+}
+
+int32_t HALSIM_RegisterSimSnapshotRestoredCallback(
+    HALSIM_SimPeriodicCallback callback, void* param) {
+  return restoredCallbacks->Register(callback, param);
+}
+
+void HALSIM_CancelSimSnapshotRestoredCallback(int32_t uid) {
+  restoredCallbacks->Cancel(uid);
+}
+
+}  // extern "C"
@@ -0,0 +1,143 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include "hal/simulation/SimDataValue.h"
+
+namespace hal {
+
+/**
+ * Appends sim state to a snapshot. Values are stored as raw bytes, so a
+ * snapshot can only be restored by the same build.
+ */
+class SimSnapshotWriter {
+ public:
+  template <typename T>
+  void Write(const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    WriteBytes(&value, sizeof(value));
+  }
+
+  void WriteBytes(const void* data, size_t size) {
+    auto bytes = static_cast<const uint8_t*>(data);
+    m_data.insert(m_data.end(), bytes, bytes + size);
+  }
+
+  template <typename... Ts>
+  void operator()(Ts&... values) {
+    (Visit(values), ...);
+  }
+
+  std::vector<uint8_t>& GetData() { return m_data; }
+
+ private:
+  template <typename T, HAL_Value (*MakeValue)(T)>
+  void Visit(const impl::SimDataValueBase<T, MakeValue>& value) {
+    Write(value.Get());
+  }
+
+  template <typename T>
+  void Visit(const std::atomic<T>& value) {
+    Write(value.load());
+  }
+
+  template <typename T, size_t N>
+  void Visit(T (&values)[N]) {
+    for (auto&& value : values) {
+      Visit(value);
+    }
+  }
+
+  std::vector<uint8_t> m_data;
+};
+
+/**
+ * Reads sim state from a snapshot. A snapshot is read twice: first to check
+ * it, then to apply it, so an invalid snapshot changes nothing. Values are
+ * restored without invoking callbacks.
+ */
+class SimSnapshotReader {
+ public:
+  SimSnapshotReader(const uint8_t* data, size_t size, bool apply)
+      : m_data{data}, m_size{size}, m_apply{apply} {}
+
+  // Returns false if the snapshot is too short
+  template <typename T>
+  bool Read(T* value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    const uint8_t* data = ReadBytes(sizeof(*value));
+    if (!data) {
+      return false;
+    }
+    std::memcpy(value, data, sizeof(*value));
+    return true;
+  }
+
+  // Returns the next size bytes, or nullptr if the snapshot is too short
+  const uint8_t* ReadBytes(size_t size) {
+    if (!m_valid || size > m_size - m_pos) {
+      m_valid = false;
+      return nullptr;
+    }
+    const uint8_t* data = m_data + m_pos;
+    m_pos += size;
+    return data;
+  }
+
+  // Marks the snapshot as invalid, e.g. when a count is out of range
+  void Invalidate() { m_valid = false; }
+
+  template <typename... Ts>
+  void operator()(Ts&... values) {
+    (Visit(values), ...);
+  }
+
+  // Returns true if values should be changed, false when checking
+  bool IsApplying() const { return m_apply; }
+
+  // Returns true if everything read so far was in the snapshot
+  bool IsValid() const { return m_valid; }
+
+  bool AtEnd() const { return m_pos == m_size; }
+
+ private:
+  template <typename T, HAL_Value (*MakeValue)(T)>
+  void Visit(impl::SimDataValueBase<T, MakeValue>& value) {
+    T v;
+    if (Read(&v) && m_apply) {
+      value.Restore(v);
+    }
+  }
+
+  template <typename T>
+  void Visit(std::atomic<T>& value) {
+    T v;
+    if (Read(&v) && m_apply) {
+      value = v;
+    }
+  }
+
+  template <typename T, size_t N>
+  void Visit(T (&values)[N]) {
+    for (auto&& value : values) {
+      Visit(value);
+    }
+  }
+
+  const uint8_t* m_data;
+  size_t m_size;
+  size_t m_pos = 0;
+  bool m_apply;
+  bool m_valid = true;
+};
+
+}  // namespace hal
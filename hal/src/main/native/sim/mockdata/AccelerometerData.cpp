@@ -8,13 +8,10 @@
 using namespace hal;
 
 namespace hal::init {
-void InitializeAccelerometerData() {
-  static AccelerometerData sad[1];
-  ::hal::SimAccelerometerData = sad;
-}
+void InitializeAccelerometerData() {}
 }  // namespace hal::init
 
-AccelerometerData* hal::SimAccelerometerData;
+SimContextArray<AccelerometerData> hal::SimAccelerometerData{1};
 void AccelerometerData::ResetData() {
   active.Reset(false);
   range.Reset(static_cast<HAL_AccelerometerRange>(0));
@@ -6,18 +6,17 @@
 #include <cstring>
 
 #include "../PortsInternal.h"
+#include "../SimSnapshotInternal.h"
 #include "AddressableLEDDataInternal.h"
 
 using namespace hal;
 
 namespace hal::init {
-void InitializeAddressableLEDData() {
-  static AddressableLEDData sad[kNumAddressableLEDs];
-  ::hal::SimAddressableLEDData = sad;
-}
+void InitializeAddressableLEDData() {}
 }  // namespace hal::init
 
-AddressableLEDData* hal::SimAddressableLEDData;
+SimContextArray<AddressableLEDData> hal::SimAddressableLEDData{
+    kNumAddressableLEDs};
 
 void AddressableLEDData::ResetData() {
   initialized.Reset(false);
@@ -45,6 +44,29 @@ int32_t AddressableLEDData::GetData(HAL_AddressableLEDData* d) {
   return len;
 }
 
+void AddressableLEDData::SaveSnapshot(SimSnapshotWriter& writer) {
+  std::scoped_lock lock(m_dataMutex);
+  int32_t len = std::clamp(length.Get(), 0, HAL_kAddressableLEDMaxLength);
+  writer.Write(len);
+  writer.WriteBytes(m_data, len * sizeof(m_data[0]));
+}
+
+void AddressableLEDData::RestoreSnapshot(SimSnapshotReader& reader) {
+  int32_t len;
+  if (!reader.Read(&len)) {
+    return;
+  }
+  if (len < 0 || len > HAL_kAddressableLEDMaxLength) {
+    reader.Invalidate();
+    return;
+  }
+  const uint8_t* data = reader.ReadBytes(len * sizeof(m_data[0]));
+  if (data && reader.IsApplying()) {
+    std::scoped_lock lock(m_dataMutex);
+    std::memcpy(m_data, data, len * sizeof(m_data[0]));
+  }
+}
+
 extern "C" {
 
 int32_t HALSIM_FindAddressableLEDForChannel(int32_t channel) {
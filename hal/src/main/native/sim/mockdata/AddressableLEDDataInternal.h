@@ -8,11 +8,15 @@
 
 #include <wpi/spinlock.h>
 
+#include "../SimContextInternal.h"
 #include "hal/simulation/AddressableLEDData.h"
 #include "hal/simulation/SimCallbackRegistry.h"
 #include "hal/simulation/SimDataValue.h"
 
 namespace hal {
+class SimSnapshotReader;
+class SimSnapshotWriter;
+
 class AddressableLEDData {
   HAL_SIMDATAVALUE_DEFINE_NAME(Initialized)
   HAL_SIMDATAVALUE_DEFINE_NAME(OutputPort)
@@ -35,6 +39,10 @@ class AddressableLEDData {
   SimCallbackRegistry<HAL_ConstBufferCallback, GetDataName> data;
 
   void ResetData();
+
+  // Saves and restores the state that isn't in SimDataValues
+  void SaveSnapshot(SimSnapshotWriter& writer);
+  void RestoreSnapshot(SimSnapshotReader& reader);
 };
-extern AddressableLEDData* SimAddressableLEDData;
+extern SimContextArray<AddressableLEDData> SimAddressableLEDData;
 }  // namespace hal
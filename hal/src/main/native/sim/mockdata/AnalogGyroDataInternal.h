@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "../SimContextInternal.h"
 #include "hal/simulation/AnalogGyroData.h"
 #include "hal/simulation/SimDataValue.h"
 
@@ -21,5 +22,5 @@ class AnalogGyroData {
 
   virtual void ResetData();
 };
-extern AnalogGyroData* SimAnalogGyroData;
+extern SimContextArray<AnalogGyroData> SimAnalogGyroData;
 }  // namespace hal
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "../SimContextInternal.h"
 #include "hal/simulation/AnalogTriggerData.h"
 #include "hal/simulation/SimDataValue.h"
 
@@ -32,5 +33,5 @@ class AnalogTriggerData {
 
   virtual void ResetData();
 };
-extern AnalogTriggerData* SimAnalogTriggerData;
+extern SimContextArray<AnalogTriggerData> SimAnalogTriggerData;
 }  // namespace hal
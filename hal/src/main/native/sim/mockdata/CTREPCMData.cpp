@@ -8,13 +8,10 @@
 using namespace hal;
 
 namespace hal::init {
-void InitializeCTREPCMData() {
-  static CTREPCMData spd[kNumCTREPCMModules];
-  ::hal::SimCTREPCMData = spd;
-}
+void InitializeCTREPCMData() {}
 }  // namespace hal::init
 
-CTREPCMData* hal::SimCTREPCMData;
+SimContextArray<CTREPCMData> hal::SimCTREPCMData{kNumCTREPCMModules};
 void CTREPCMData::ResetData() {
   for (int i = 0; i < kNumCTRESolenoidChannels; i++) {
     solenoidOutput[i].Reset(false);
@@ -5,6 +5,7 @@
 #pragma once
 
 #include "../PortsInternal.h"
+#include "../SimContextInternal.h"
 #include "hal/simulation/CTREPCMData.h"
 #include "hal/simulation/SimDataValue.h"
 
@@ -39,5 +40,5 @@ class CTREPCMData {
 
   virtual void ResetData();
 };
-extern CTREPCMData* SimCTREPCMData;
+extern SimContextArray<CTREPCMData> SimCTREPCMData;
 }  // namespace hal
@@ -7,13 +7,10 @@
 using namespace hal;
 
 namespace hal::init {
-void InitializeCanData() {
-  static CanData scd;
-  ::hal::SimCanData = &scd;
-}
+void InitializeCanData() {}
 }  // namespace hal::init
 
-CanData* hal::SimCanData;
+SimContextLocal<CanData> hal::SimCanData;
 
 void CanData::ResetData() {
   sendMessage.Reset();
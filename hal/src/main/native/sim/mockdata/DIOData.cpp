@@ -8,13 +8,10 @@
 using namespace hal;
 
 namespace hal::init {
-void InitializeDIOData() {
-  static DIOData sdd[kNumDigitalChannels];
-  ::hal::SimDIOData = sdd;
-}
+void InitializeDIOData() {}
 }  // namespace hal::init
 
-DIOData* hal::SimDIOData;
+SimContextArray<DIOData> hal::SimDIOData{kNumDigitalChannels};
 void DIOData::ResetData() {
   initialized.Reset(false);
   simDevice = 0;
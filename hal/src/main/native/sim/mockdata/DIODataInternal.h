@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "../SimContextInternal.h"
 #include "hal/simulation/DIOData.h"
 #include "hal/simulation/SimDataValue.h"
 
@@ -26,5 +27,5 @@ class DIOData {
 
   virtual void ResetData();
 };
-extern DIOData* SimDIOData;
+extern SimContextArray<DIOData> SimDIOData;
 }  // namespace hal
@@ -4,19 +4,17 @@
 
 #include <cstring>
 
+#include "../SimSnapshotInternal.h"
 #include "DriverStationDataInternal.h"
 #include "hal/DriverStation.h"
 
 using namespace hal;
 
 namespace hal::init {
-void InitializeDriverStationData() {
-  static DriverStationData dsd;
-  ::hal::SimDriverStationData = &dsd;
-}
+void InitializeDriverStationData() {}
 }  // namespace hal::init
 
-DriverStationData* hal::SimDriverStationData;
+SimContextLocal<DriverStationData> hal::SimDriverStationData;
 
 DriverStationData::DriverStationData() {
   ResetData();
@@ -56,6 +54,29 @@ void DriverStationData::ResetData() {
   m_newDataCallbacks.Reset();
 }
 
+void DriverStationData::SaveSnapshot(SimSnapshotWriter& writer) {
+  {
+    std::scoped_lock lock(m_joystickDataMutex);
+    writer.WriteBytes(m_joystickData, sizeof(m_joystickData));
+  }
+  std::scoped_lock lock(m_matchInfoMutex);
+  writer.Write(m_matchInfo);
+}
+
+void DriverStationData::RestoreSnapshot(SimSnapshotReader& reader) {
+  const uint8_t* joystickData = reader.ReadBytes(sizeof(m_joystickData));
+  HAL_MatchInfo matchInfo;
+  if (!reader.Read(&matchInfo) || !reader.IsApplying()) {
+    return;
+  }
+  {
+    std::scoped_lock lock(m_joystickDataMutex);
+    std::memcpy(m_joystickData, joystickData, sizeof(m_joystickData));
+  }
+  std::scoped_lock lock(m_matchInfoMutex);
+  m_matchInfo = matchInfo;
+}
+
 #define DEFINE_CPPAPI_CALLBACKS(name, data, data2)                             \
   int32_t DriverStationData::RegisterJoystick##name##Callback(                 \
       int32_t joystickNum, HAL_Joystick##name##Callback callback, void* param, \
@@ -8,11 +8,15 @@
 
 #include <wpi/spinlock.h>
 
+#include "../SimContextInternal.h"
 #include "hal/simulation/DriverStationData.h"
 #include "hal/simulation/SimCallbackRegistry.h"
 #include "hal/simulation/SimDataValue.h"
 
 namespace hal {
+class SimSnapshotReader;
+class SimSnapshotWriter;
+
 
 class DriverStationData {
   HAL_SIMDATAVALUE_DEFINE_NAME(Enabled)
@@ -40,6 +44,10 @@ class DriverStationData {
   DriverStationData();
   void ResetData();
 
+  // Saves and restores the state that isn't in SimDataValues
+  void SaveSnapshot(SimSnapshotWriter& writer);
+  void RestoreSnapshot(SimSnapshotReader& reader);
+
   int32_t RegisterJoystickAxesCallback(int32_t joystickNum,
                                        HAL_JoystickAxesCallback callback,
                                        void* param, HAL_Bool initialNotify);
@@ -164,5 +172,5 @@ class DriverStationData {
   wpi::spinlock m_matchInfoMutex;
   HAL_MatchInfo m_matchInfo;
 };
-extern DriverStationData* SimDriverStationData;
+extern SimContextLocal<DriverStationData> SimDriverStationData;
 }  // namespace hal
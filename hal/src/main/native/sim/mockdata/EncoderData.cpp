@@ -8,13 +8,10 @@
 using namespace hal;
 
 namespace hal::init {
-void InitializeEncoderData() {
-  static EncoderData sed[kNumEncoders];
-  ::hal::SimEncoderData = sed;
-}
+void InitializeEncoderData() {}
 }  // namespace hal::init
 
-EncoderData* hal::SimEncoderData;
+SimContextArray<EncoderData> hal::SimEncoderData{kNumEncoders};
 void EncoderData::ResetData() {
   digitalChannelA = 0;
   digitalChannelB = 0;
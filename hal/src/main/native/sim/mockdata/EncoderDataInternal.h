@@ -7,6 +7,7 @@
 #include <atomic>
 #include <limits>
 
+#include "../SimContextInternal.h"
 #include "hal/simulation/EncoderData.h"
 #include "hal/simulation/SimDataValue.h"
 
@@ -43,5 +44,5 @@ class EncoderData {
 
   virtual void ResetData();
 };
-extern EncoderData* SimEncoderData;
+extern SimContextArray<EncoderData> SimEncoderData;
 }  // namespace hal
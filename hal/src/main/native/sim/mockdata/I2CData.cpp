@@ -8,13 +8,10 @@
 using namespace hal;
 
 namespace hal::init {
-void InitializeI2CData() {
-  static I2CData sid[2];
-  ::hal::SimI2CData = sid;
-}
+void InitializeI2CData() {}
 }  // namespace hal::init
 
-I2CData* hal::SimI2CData;
+SimContextArray<I2CData> hal::SimI2CData{2};
 
 void I2CData::ResetData() {
   initialized.Reset(false);
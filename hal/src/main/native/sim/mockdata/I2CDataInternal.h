@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "../SimContextInternal.h"
 #include "hal/simulation/I2CData.h"
 #include "hal/simulation/SimCallbackRegistry.h"
 #include "hal/simulation/SimDataValue.h"
@@ -26,5 +27,5 @@ class I2CData {
 
   void ResetData();
 };
-extern I2CData* SimI2CData;
+extern SimContextArray<I2CData> SimI2CData;
 }  // namespace hal
@@ -8,13 +8,10 @@
 using namespace hal;
 
 namespace hal::init {
-void InitializePDPData() {
-  static PDPData spd[kNumPDPModules];
-  ::hal::SimPDPData = spd;
-}
+void InitializePDPData() {}
 }  // namespace hal::init
 
-PDPData* hal::SimPDPData;
+SimContextArray<PDPData> hal::SimPDPData{kNumPDPModules};
 void PDPData::ResetData() {
   initialized.Reset(false);
   temperature.Reset(0.0);
@@ -5,6 +5,7 @@
 #pragma once
 
 #include "../PortsInternal.h"
+#include "../SimContextInternal.h"
 #include "hal/simulation/PDPData.h"
 #include "hal/simulation/SimDataValue.h"
 
@@ -29,5 +30,5 @@ class PDPData {
 
   virtual void ResetData();
 };
-extern PDPData* SimPDPData;
+extern SimContextArray<PDPData> SimPDPData;
 }  // namespace hal
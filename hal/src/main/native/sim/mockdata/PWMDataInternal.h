@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "../SimContextInternal.h"
 #include "hal/simulation/PWMData.h"
 #include "hal/simulation/SimDataValue.h"
 
@@ -27,5 +28,5 @@ class PWMData {
 
   virtual void ResetData();
 };
-extern PWMData* SimPWMData;
+extern SimContextArray<PWMData> SimPWMData;
 }  // namespace hal
@@ -8,13 +8,10 @@
 using namespace hal;
 
 namespace hal::init {
-void InitializeRoboRioData() {
-  static RoboRioData srrd;
-  ::hal::SimRoboRioData = &srrd;
-}
+void InitializeRoboRioData() {}
 }  // namespace hal::init
 
-RoboRioData* hal::SimRoboRioData;
+SimContextLocal<RoboRioData> hal::SimRoboRioData;
 void RoboRioData::ResetData() {
   fpgaButton.Reset(false);
   vInVoltage.Reset(12.0);
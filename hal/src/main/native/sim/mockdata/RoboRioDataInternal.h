@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "../SimContextInternal.h"
 #include "hal/simulation/RoboRioData.h"
 #include "hal/simulation/SimDataValue.h"
 
@@ -49,5 +50,5 @@ class RoboRioData {
 
   virtual void ResetData();
 };
-extern RoboRioData* SimRoboRioData;
+extern SimContextLocal<RoboRioData> SimRoboRioData;
 }  // namespace hal
@@ -8,13 +8,10 @@
 using namespace hal;
 
 namespace hal::init {
-void InitializeSPIAccelerometerData() {
-  static SPIAccelerometerData ssad[5];
-  ::hal::SimSPIAccelerometerData = ssad;
-}
+void InitializeSPIAccelerometerData() {}
 }  // namespace hal::init
 
-SPIAccelerometerData* hal::SimSPIAccelerometerData;
+SimContextArray<SPIAccelerometerData> hal::SimSPIAccelerometerData{5};
 void SPIAccelerometerData::ResetData() {
   active.Reset(false);
   range.Reset(0);
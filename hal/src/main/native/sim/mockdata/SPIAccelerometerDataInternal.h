@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "../SimContextInternal.h"
 #include "hal/simulation/SPIAccelerometerData.h"
 #include "hal/simulation/SimDataValue.h"
 
@@ -24,5 +25,5 @@ class SPIAccelerometerData {
 
   virtual void ResetData();
 };
-extern SPIAccelerometerData* SimSPIAccelerometerData;
+extern SimContextArray<SPIAccelerometerData> SimSPIAccelerometerData;
 }  // namespace hal
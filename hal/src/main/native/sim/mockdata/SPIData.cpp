@@ -8,13 +8,10 @@
 using namespace hal;
 
 namespace hal::init {
-void InitializeSPIData() {
-  static SPIData ssd[5];
-  ::hal::SimSPIData = ssd;
-}
+void InitializeSPIData() {}
 }  // namespace hal::init
 
-SPIData* hal::SimSPIData;
+SimContextArray<SPIData> hal::SimSPIData{5};
 void SPIData::ResetData() {
   initialized.Reset(false);
   read.Reset();
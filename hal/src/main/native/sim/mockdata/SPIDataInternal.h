@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "../SimContextInternal.h"
 #include "hal/simulation/SPIData.h"
 #include "hal/simulation/SimCallbackRegistry.h"
 #include "hal/simulation/SimDataValue.h"
@@ -33,5 +34,5 @@ class SPIData {
 
   void ResetData();
 };
-extern SPIData* SimSPIData;
+extern SimContextArray<SPIData> SimSPIData;
 }  // namespace hal
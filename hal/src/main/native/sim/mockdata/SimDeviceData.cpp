@@ -5,21 +5,21 @@
 #include "hal/simulation/SimDeviceData.h"  // NOLINT(build/include_order)
 
 #include <algorithm>
+#include <utility>
+#include <vector>
 
 #include <wpi/StringExtras.h>
 
+#include "../SimSnapshotInternal.h"
 #include "SimDeviceDataInternal.h"
 
 using namespace hal;
 
 namespace hal::init {
-void InitializeSimDeviceData() {
-  static SimDeviceData sdd;
-  ::hal::SimSimDeviceData = &sdd;
-}
+void InitializeSimDeviceData() {}
 }  // namespace hal::init
 
-SimDeviceData* hal::SimSimDeviceData;
+SimContextLocal<SimDeviceData> hal::SimSimDeviceData;
 
 SimDeviceData::Device* SimDeviceData::LookupDevice(HAL_SimDeviceHandle handle) {
   if (handle <= 0) {
@@ -81,7 +81,7 @@ bool SimDeviceData::IsDeviceEnabled(const char* name) {
 }
 
 HAL_SimDeviceHandle SimDeviceData::CreateDevice(const char* name) {
-  std::scoped_lock lock(m_mutex);
+  std::unique_lock lock(m_mutex);
 
   // don't create if disabled
   for (const auto& elem : m_prefixEnabled) {
@@ -109,6 +109,7 @@ HAL_SimDeviceHandle SimDeviceData::CreateDevice(const char* name) {
   HAL_SimDeviceHandle deviceHandle = m_devices.emplace_back(deviceImpl) + 1;
   deviceImpl->handle = deviceHandle;
   m_deviceMap[name] = deviceImpl;
+  lock.unlock();
 
   // notify callbacks
   m_deviceCreated(name, deviceHandle);
@@ -117,7 +118,7 @@ HAL_SimDeviceHandle SimDeviceData::CreateDevice(const char* name) {
 }
 
 void SimDeviceData::FreeDevice(HAL_SimDeviceHandle handle) {
-  std::scoped_lock lock(m_mutex);
+  std::unique_lock lock(m_mutex);
   --handle;
 
   // see if it exists
@@ -134,6 +135,7 @@ void SimDeviceData::FreeDevice(HAL_SimDeviceHandle handle) {
 
   // remove from vector
   m_devices.erase(handle);
+  lock.unlock();
 
   // notify callbacks
   m_deviceFreed(deviceImpl->name.c_str(), handle + 1);
@@ -143,7 +145,7 @@ HAL_SimValueHandle SimDeviceData::CreateValue(
     HAL_SimDeviceHandle device, const char* name, int32_t direction,
     int32_t numOptions, const char** options, const double* optionValues,
     const HAL_Value& initialValue) {
-  std::scoped_lock lock(m_mutex);
+  std::unique_lock lock(m_mutex);
 
   // look up device
   Device* deviceImpl = LookupDevice(device);
@@ -187,7 +189,9 @@ HAL_SimValueHandle SimDeviceData::CreateValue(
   }
   deviceImpl->valueMap[name] = valueImpl;
 
-  // notify callbacks
+  // notify callbacks; keep the device alive in case it's freed meanwhile
+  auto keepAlive = m_devices[device - 1];
+  lock.unlock();
   deviceImpl->valueCreated(name, valueHandle, direction, &initialValue);
 
   return valueHandle;
@@ -209,7 +213,7 @@ HAL_Value SimDeviceData::GetValue(HAL_SimValueHandle handle) {
 
 void SimDeviceData::SetValue(HAL_SimValueHandle handle,
                              const HAL_Value& value) {
-  std::scoped_lock lock(m_mutex);
+  std::unique_lock lock(m_mutex);
   Value* valueImpl = LookupValue(handle);
   if (!valueImpl) {
     return;
@@ -217,13 +221,25 @@ void SimDeviceData::SetValue(HAL_SimValueHandle handle,
 
   valueImpl->value = value;
 
-  // notify callbacks
-  valueImpl->changed(valueImpl->name.c_str(), valueImpl->handle,
-                     valueImpl->direction, &value);
+  // notify callbacks one thread at a time so they see the changes in order;
+  // if the value is set meanwhile, notify again with the latest value
+  if (valueImpl->pendingNotify++ != 0) {
+    return;
+  }
+  // keep the device alive in case it's freed meanwhile
+  auto keepAlive = m_devices[(handle >> 16) - 1];
+  for (uint32_t pending = 1; pending != 0;) {
+    HAL_Value current = valueImpl->value;
+    lock.unlock();
+    valueImpl->changed(valueImpl->name.c_str(), valueImpl->handle,
+                       valueImpl->direction, &current);
+    lock.lock();
+    pending = valueImpl->pendingNotify -= pending;
+  }
 }
 
 void SimDeviceData::ResetValue(HAL_SimValueHandle handle) {
-  std::scoped_lock lock(m_mutex);
+  std::unique_lock lock(m_mutex);
   Value* valueImpl = LookupValue(handle);
   if (!valueImpl) {
     return;
@@ -239,9 +255,8 @@ void SimDeviceData::ResetValue(HAL_SimValueHandle handle) {
       return;
   }
 
-  // notify reset callbacks (done here so they're called with the old value)
-  valueImpl->reset(valueImpl->name.c_str(), valueImpl->handle,
-                   valueImpl->direction, &valueImpl->value);
+  // reset callbacks are called with the old value
+  HAL_Value oldValue = valueImpl->value;
 
   // set user-facing value to 0
   switch (valueImpl->value.type) {
@@ -257,10 +272,15 @@ void SimDeviceData::ResetValue(HAL_SimValueHandle handle) {
     default:
       return;
   }
+  HAL_Value newValue = valueImpl->value;
 
-  // notify changed callbacks
+  // notify callbacks; keep the device alive in case it's freed meanwhile
+  auto keepAlive = m_devices[(handle >> 16) - 1];
+  lock.unlock();
+  valueImpl->reset(valueImpl->name.c_str(), valueImpl->handle,
+                   valueImpl->direction, &oldValue);
   valueImpl->changed(valueImpl->name.c_str(), valueImpl->handle,
-                     valueImpl->direction, &valueImpl->value);
+                     valueImpl->direction, &newValue);
 }
 
 int32_t SimDeviceData::RegisterDeviceCreatedCallback(
@@ -287,8 +307,12 @@ void SimDeviceData::CancelDeviceCreatedCallback(int32_t uid) {
   if (uid <= 0) {
     return;
   }
-  std::scoped_lock lock(m_mutex);
-  m_deviceCreated.Cancel(uid);
+  impl::RetiredSimCallbacks retired;
+  {
+    std::scoped_lock lock(m_mutex);
+    retired = m_deviceCreated.Cancel(uid);
+  }
+  impl::RetireSimCallbacks(std::move(retired));
 }
 
 int32_t SimDeviceData::RegisterDeviceFreedCallback(
@@ -301,8 +325,12 @@ void SimDeviceData::CancelDeviceFreedCallback(int32_t uid) {
   if (uid <= 0) {
     return;
   }
-  std::scoped_lock lock(m_mutex);
-  m_deviceFreed.Cancel(uid);
+  impl::RetiredSimCallbacks retired;
+  {
+    std::scoped_lock lock(m_mutex);
+    retired = m_deviceFreed.Cancel(uid);
+  }
+  impl::RetireSimCallbacks(std::move(retired));
 }
 
 HAL_SimDeviceHandle SimDeviceData::GetDeviceHandle(const char* name) {
@@ -368,12 +396,16 @@ void SimDeviceData::CancelValueCreatedCallback(int32_t uid) {
   if (uid <= 0) {
     return;
   }
-  std::scoped_lock lock(m_mutex);
-  Device* deviceImpl = LookupDevice(uid >> 16);
-  if (!deviceImpl) {
-    return;
+  impl::RetiredSimCallbacks retired;
+  {
+    std::scoped_lock lock(m_mutex);
+    Device* deviceImpl = LookupDevice(uid >> 16);
+    if (!deviceImpl) {
+      return;
+    }
+    retired = deviceImpl->valueCreated.Cancel(uid & 0xffff);
   }
-  deviceImpl->valueCreated.Cancel(uid & 0xffff);
+  impl::RetireSimCallbacks(std::move(retired));
 }
 
 int32_t SimDeviceData::RegisterValueChangedCallback(
@@ -403,12 +435,16 @@ void SimDeviceData::CancelValueChangedCallback(int32_t uid) {
   if (uid <= 0) {
     return;
   }
-  std::scoped_lock lock(m_mutex);
-  Value* valueImpl = LookupValue(((uid >> 19) << 16) | ((uid >> 7) & 0xfff));
-  if (!valueImpl) {
-    return;
+  impl::RetiredSimCallbacks retired;
+  {
+    std::scoped_lock lock(m_mutex);
+    Value* valueImpl = LookupValue(((uid >> 19) << 16) | ((uid >> 7) & 0xfff));
+    if (!valueImpl) {
+      return;
+    }
+    retired = valueImpl->changed.Cancel(uid & 0x7f);
   }
-  valueImpl->changed.Cancel(uid & 0x7f);
+  impl::RetireSimCallbacks(std::move(retired));
 }
 
 int32_t SimDeviceData::RegisterValueResetCallback(
@@ -432,12 +468,16 @@ void SimDeviceData::CancelValueResetCallback(int32_t uid) {
   if (uid <= 0) {
     return;
   }
-  std::scoped_lock lock(m_mutex);
-  Value* valueImpl = LookupValue(((uid >> 19) << 16) | ((uid >> 7) & 0xfff));
-  if (!valueImpl) {
-    return;
+  impl::RetiredSimCallbacks retired;
+  {
+    std::scoped_lock lock(m_mutex);
+    Value* valueImpl = LookupValue(((uid >> 19) << 16) | ((uid >> 7) & 0xfff));
+    if (!valueImpl) {
+      return;
+    }
+    retired = valueImpl->reset.Cancel(uid & 0x7f);
   }
-  valueImpl->reset.Cancel(uid & 0x7f);
+  impl::RetireSimCallbacks(std::move(retired));
 }
 
 HAL_SimValueHandle SimDeviceData::GetValueHandle(HAL_SimDeviceHandle device,
@@ -505,13 +545,57 @@ const double* SimDeviceData::GetValueEnumDoubleValues(HAL_SimValueHandle handle,
   return optionValues.data();
 }
 
-void SimDeviceData::ResetData() {
+void SimDeviceData::SaveSnapshot(SimSnapshotWriter& writer) {
+  std::scoped_lock lock(m_mutex);
+  std::vector<const Value*> values;
+  for (auto&& device : m_devices) {
+    for (auto&& value : device->values) {
+      values.emplace_back(value.get());
+    }
+  }
+  writer.Write(static_cast<int32_t>(values.size()));
+  for (auto value : values) {
+    writer.Write(value->handle);
+    writer.Write(value->value);
+  }
+}
+
+void SimDeviceData::RestoreSnapshot(SimSnapshotReader& reader) {
+  int32_t count;
+  if (!reader.Read(&count)) {
+    return;
+  }
   std::scoped_lock lock(m_mutex);
-  m_devices.clear();
-  m_deviceMap.clear();
-  m_prefixEnabled.clear();
-  m_deviceCreated.Reset();
-  m_deviceFreed.Reset();
+  for (int32_t i = 0; i < count; ++i) {
+    HAL_SimValueHandle handle;
+    HAL_Value value;
+    if (!reader.Read(&handle) || !reader.Read(&value)) {
+      return;
+    }
+    if (!reader.IsApplying()) {
+      continue;
+    }
+    // Values created after the snapshot keep their value
+    Value* valueImpl = LookupValue(handle);
+    if (valueImpl && valueImpl->value.type == value.type) {
+      valueImpl->value = value;
+    }
+  }
+}
+
+void SimDeviceData::ResetData() {
+  impl::RetiredSimCallbacks retiredCreated;
+  impl::RetiredSimCallbacks retiredFreed;
+  {
+    std::scoped_lock lock(m_mutex);
+    m_devices.clear();
+    m_deviceMap.clear();
+    m_prefixEnabled.clear();
+    retiredCreated = m_deviceCreated.Reset();
+    retiredFreed = m_deviceFreed.Reset();
+  }
+  impl::RetireSimCallbacks(std::move(retiredCreated));
+  impl::RetireSimCallbacks(std::move(retiredFreed));
 }
 
 extern "C" {
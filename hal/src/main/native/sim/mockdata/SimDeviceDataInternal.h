@@ -16,52 +16,49 @@
 #include <wpi/UidVector.h>
 #include <wpi/spinlock.h>
 
+#include "../SimContextInternal.h"
 #include "hal/Value.h"
 #include "hal/simulation/SimCallbackRegistry.h"
 #include "hal/simulation/SimDeviceData.h"
 
 namespace hal {
+class SimSnapshotReader;
+class SimSnapshotWriter;
 
 namespace impl {
 
+// Cancel() and Reset() of these registries must be called with the
+// SimDeviceData lock held; pass their results to RetireSimCallbacks() after
+// releasing it.
 template <typename CallbackFunction>
 class SimUnnamedCallbackRegistry {
  public:
   using RawFunctor = void (*)();
 
  protected:
-  using CallbackVector = wpi::UidVector<HalCallbackListener<RawFunctor>, 4>;
+  using CallbackList = SimCallbackList<HalCallbackListener<RawFunctor>>;
 
  public:
-  void Cancel(int32_t uid) {
-    if (m_callbacks) {
-      m_callbacks->erase(uid - 1);
-    }
+  [[nodiscard]] RetiredSimCallbacks Cancel(int32_t uid) {
+    return m_callbacks.Erase(uid - 1);
   }
 
-  void Reset() {
-    if (m_callbacks) {
-      m_callbacks->clear();
-    }
-  }
+  [[nodiscard]] RetiredSimCallbacks Reset() { return m_callbacks.Clear(); }
 
   int32_t Register(CallbackFunction callback, void* param) {
     // Must return -1 on a null callback for error handling
     if (callback == nullptr) {
       return -1;
     }
-    if (!m_callbacks) {
-      m_callbacks = std::make_unique<CallbackVector>();
-    }
-    return m_callbacks->emplace_back(param,
-                                     reinterpret_cast<RawFunctor>(callback)) +
+    return m_callbacks.Emplace(param, reinterpret_cast<RawFunctor>(callback)) +
            1;
   }
 
   template <typename... U>
   void Invoke(const char* name, U&&... u) const {
-    if (m_callbacks) {
-      for (auto&& cb : *m_callbacks) {
+    typename CallbackList::Snapshot callbacks{m_callbacks};
+    if (callbacks) {
+      for (auto&& cb : callbacks) {
         reinterpret_cast<CallbackFunction>(cb.callback)(name, cb.param,
                                                         std::forward<U>(u)...);
       }
@@ -74,7 +71,7 @@ class SimUnnamedCallbackRegistry {
   }
 
  private:
-  std::unique_ptr<CallbackVector> m_callbacks;
+  CallbackList m_callbacks;
 };
 
 template <typename CallbackFunction>
@@ -89,36 +86,28 @@ class SimPrefixCallbackRegistry {
 
     explicit operator bool() const { return callback != nullptr; }
   };
-  using CallbackVector = wpi::UidVector<CallbackData, 4>;
+  using CallbackList = SimCallbackList<CallbackData>;
 
  public:
-  void Cancel(int32_t uid) {
-    if (m_callbacks) {
-      m_callbacks->erase(uid - 1);
-    }
+  [[nodiscard]] RetiredSimCallbacks Cancel(int32_t uid) {
+    return m_callbacks.Erase(uid - 1);
   }
 
-  void Reset() {
-    if (m_callbacks) {
-      m_callbacks->clear();
-    }
-  }
+  [[nodiscard]] RetiredSimCallbacks Reset() { return m_callbacks.Clear(); }
 
   int32_t Register(const char* prefix, void* param, CallbackFunction callback) {
     // Must return -1 on a null callback for error handling
     if (callback == nullptr) {
       return -1;
     }
-    if (!m_callbacks) {
-      m_callbacks = std::make_unique<CallbackVector>();
-    }
-    return m_callbacks->emplace_back(prefix, param, callback) + 1;
+    return m_callbacks.Emplace(prefix, param, callback) + 1;
   }
 
   template <typename... U>
   void Invoke(const char* name, U&&... u) const {
-    if (m_callbacks) {
-      for (auto&& cb : *m_callbacks) {
+    typename CallbackList::Snapshot callbacks{m_callbacks};
+    if (callbacks) {
+      for (auto&& cb : callbacks) {
         if (wpi::starts_with(name, cb.prefix)) {
           cb.callback(name, cb.param, std::forward<U>(u)...);
         }
@@ -132,7 +121,7 @@ class SimPrefixCallbackRegistry {
   }
 
  private:
-  std::unique_ptr<CallbackVector> m_callbacks;
+  CallbackList m_callbacks;
 };
 
 }  // namespace impl
@@ -147,6 +136,8 @@ class SimDeviceData {
     std::string name;
     int32_t direction;
     HAL_Value value;
+    // changes not yet notified (guarded by m_mutex); nonzero while notifying
+    uint32_t pendingNotify{0};
     std::vector<std::string> enumOptions;
     std::vector<const char*> cstrEnumOptions;
     std::vector<double> enumOptionValues;
@@ -240,6 +231,10 @@ class SimDeviceData {
                                          int32_t* numOptions);
 
   void ResetData();
+
+  // Saves and restores the state that isn't in SimDataValues
+  void SaveSnapshot(SimSnapshotWriter& writer);
+  void RestoreSnapshot(SimSnapshotReader& reader);
 };
-extern SimDeviceData* SimSimDeviceData;
+extern SimContextLocal<SimDeviceData> SimSimDeviceData;
 }  // namespace hal
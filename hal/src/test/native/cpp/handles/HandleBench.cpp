@@ -0,0 +1,130 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "hal/DIO.h"
+#include "hal/HAL.h"
+#include "hal/PWM.h"
+#include "hal/handles/DigitalHandleResource.h"
+#include "hal/handles/IndexedHandleResource.h"
+#include "hal/handles/UnlimitedHandleResource.h"
+
+using std::chrono::duration_cast;
+using std::chrono::high_resolution_clock;
+using std::chrono::nanoseconds;
+
+namespace hal {
+
+namespace {
+
+constexpr int kCalls = 1000000;
+
+struct TestStruct {
+  int value = 1;
+};
+
+// Calls func from each thread at the same time and returns the average time
+// per call
+template <typename F>
+double TimeNsPerCall(int threads, F&& func) {
+  std::atomic<int> ready{0};
+  std::atomic<int64_t> totalNs{0};
+  std::vector<std::thread> workers;
+  for (int i = 0; i < threads; ++i) {
+    workers.emplace_back([&] {
+      ++ready;
+      while (ready < threads) {
+        std::this_thread::yield();
+      }
+      auto start = high_resolution_clock::now();
+      for (int j = 0; j < kCalls; ++j) {
+        func();
+      }
+      auto stop = high_resolution_clock::now();
+      totalNs += duration_cast<nanoseconds>(stop - start).count();
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  return static_cast<double>(totalNs) / kCalls / threads;
+}
+
+}  // namespace
+
+// Disabled by default as it only reports timings; run with
+// --gtest_also_run_disabled_tests --gtest_filter='*Benchmark*'
+TEST(HandleBenchmark, DISABLED_PerCallOverhead) {
+  // static like the HAL's resources, which rely on being zero initialized
+  static IndexedHandleResource<HAL_Handle, TestStruct, 8,
+                               HAL_HandleEnum::Vendor>
+      indexed;
+  HAL_Handle indexedHandle;
+  int32_t status = 0;
+  indexed.Allocate(0, &indexedHandle, &status);
+  static UnlimitedHandleResource<HAL_Handle, TestStruct,
+                                 HAL_HandleEnum::Vendor>
+      unlimited;
+  HAL_Handle unlimitedHandle =
+      unlimited.Allocate(std::make_shared<TestStruct>());
+  static DigitalHandleResource<HAL_Handle, TestStruct, 8> digital;
+  HAL_Handle digitalHandle;
+  digital.Allocate(0, HAL_HandleEnum::Vendor, &digitalHandle, &status);
+
+  HAL_DigitalHandle dio =
+      HAL_InitializeDIOPort(HAL_GetPort(0), true, nullptr, &status);
+  HAL_DigitalHandle pwm =
+      HAL_InitializePWMPort(HAL_GetPort(0), nullptr, &status);
+  ASSERT_EQ(0, status);
+
+  for (int threads : {1, 2, 4}) {
+    std::cout << threads << " threads\n";
+    std::cout << "  IndexedHandleResource::Get(): "
+              << TimeNsPerCall(threads, [&] {
+                   EXPECT_EQ(1, indexed.Get(indexedHandle)->value);
+                 })
+              << " ns\n";
+    std::cout << "  UnlimitedHandleResource::Get(): "
+              << TimeNsPerCall(threads, [&] {
+                   EXPECT_EQ(1, unlimited.Get(unlimitedHandle)->value);
+                 })
+              << " ns\n";
+    std::cout << "  DigitalHandleResource::Get(): "
+              << TimeNsPerCall(threads, [&] {
+                   EXPECT_EQ(1, digital.Get(digitalHandle,
+                                            HAL_HandleEnum::Vendor)
+                                    ->value);
+                 })
+              << " ns\n";
+    std::cout << "  DigitalHandleResource::Borrow(): "
+              << TimeNsPerCall(threads, [&] {
+                   EXPECT_EQ(1, digital.Borrow(digitalHandle,
+                                               HAL_HandleEnum::Vendor)
+                                    ->value);
+                 })
+              << " ns\n";
+    std::cout << "  HAL_GetDIO(): " << TimeNsPerCall(threads, [&] {
+      int32_t status = 0;
+      HAL_GetDIO(dio, &status);
+    }) << " ns\n";
+    std::cout << "  HAL_SetPWMSpeed(): " << TimeNsPerCall(threads, [&] {
+      int32_t status = 0;
+      HAL_SetPWMSpeed(pwm, 0.5, &status);
+    }) << " ns\n";
+  }
+
+  HAL_FreePWMPort(pwm, &status);
+  HAL_FreeDIOPort(dio);
+  digital.Free(digitalHandle, HAL_HandleEnum::Vendor);
+  indexed.Free(indexedHandle);
+  unlimited.Free(unlimitedHandle);
+}
+
+}  // namespace hal
@@ -2,14 +2,30 @@
 // Open Source Software; you can modify and/or share it under the terms of
 // the WPILib BSD license file in the root directory of this project.
 
+#include <atomic>
+#include <memory>
+#include <thread>
+
 #include "gtest/gtest.h"
 #include "hal/HAL.h"
+#include "hal/handles/DigitalHandleResource.h"
 #include "hal/handles/IndexedClassedHandleResource.h"
+#include "hal/handles/UnlimitedHandleResource.h"
 
 #define HAL_TestHandle HAL_Handle
 
 namespace {
 class MyTestClass {};
+
+struct CountedStruct {
+  static inline std::atomic<int> count{0};
+  int value = 42;
+  CountedStruct() { ++count; }
+  ~CountedStruct() {
+    value = 0;
+    --count;
+  }
+};
 }  // namespace
 
 namespace hal {
@@ -22,4 +38,95 @@ TEST(HandleTests, ClassedHandleTest) {
   EXPECT_EQ(0, status);
 }
 
+TEST(HandleTests, GetWhileFreeing) {
+  static hal::UnlimitedHandleResource<HAL_TestHandle, CountedStruct,
+                                      HAL_HandleEnum::Vendor>
+      testResource;
+  HAL_TestHandle handle =
+      testResource.Allocate(std::make_shared<CountedStruct>());
+
+  // readers only ever see live structures while the handle is freed and
+  // reallocated
+  std::atomic<bool> done{false};
+  std::thread reader{[&] {
+    while (!done) {
+      if (auto structure = testResource.Get(handle)) {
+        EXPECT_EQ(42, structure->value);
+      }
+    }
+  }};
+  for (int i = 0; i < 10000; ++i) {
+    testResource.Free(handle);
+    EXPECT_EQ(handle, testResource.Allocate(std::make_shared<CountedStruct>()));
+  }
+  done = true;
+  reader.join();
+
+  // freeing destroys the structure once nothing else holds it
+  EXPECT_EQ(1, CountedStruct::count);
+  testResource.Free(handle);
+  EXPECT_EQ(0, CountedStruct::count);
+  EXPECT_EQ(nullptr, testResource.Get(handle));
+}
+
+TEST(HandleTests, BorrowWhileFreeing) {
+  static hal::DigitalHandleResource<HAL_TestHandle, CountedStruct, 8>
+      testResource;
+  int32_t status = 0;
+  HAL_TestHandle handle;
+  testResource.Allocate(1, HAL_HandleEnum::Vendor, &handle, &status);
+  ASSERT_EQ(0, status);
+
+  // a borrowed structure isn't destroyed until the borrow ends
+  std::atomic<bool> done{false};
+  std::thread reader{[&] {
+    while (!done) {
+      auto structure = testResource.Borrow(handle, HAL_HandleEnum::Vendor);
+      if (structure) {
+        std::this_thread::yield();
+        EXPECT_EQ(42, structure->value);
+      }
+    }
+  }};
+  for (int i = 0; i < 1000; ++i) {
+    testResource.Free(handle, HAL_HandleEnum::Vendor);
+    testResource.Allocate(1, HAL_HandleEnum::Vendor, &handle, &status);
+  }
+  done = true;
+  reader.join();
+
+  testResource.Free(handle, HAL_HandleEnum::Vendor);
+  EXPECT_EQ(0, CountedStruct::count);
+  EXPECT_FALSE(testResource.Borrow(handle, HAL_HandleEnum::Vendor));
+}
+
+TEST(HandleTests, NestedBorrows) {
+  static hal::DigitalHandleResource<HAL_TestHandle, CountedStruct, 8>
+      testResource;
+  int32_t status = 0;
+  HAL_TestHandle handles[6];
+  for (int i = 0; i < 6; ++i) {
+    testResource.Allocate(i, HAL_HandleEnum::Vendor, &handles[i], &status);
+  }
+
+  // borrows past the thread's hazard pointers hold a reference instead
+  {
+    auto b0 = testResource.Borrow(handles[0], HAL_HandleEnum::Vendor);
+    auto b1 = testResource.Borrow(handles[1], HAL_HandleEnum::Vendor);
+    auto b2 = testResource.Borrow(handles[2], HAL_HandleEnum::Vendor);
+    auto b3 = testResource.Borrow(handles[3], HAL_HandleEnum::Vendor);
+    auto b4 = testResource.Borrow(handles[4], HAL_HandleEnum::Vendor);
+    EXPECT_EQ(42, testResource.Get(handles[5], HAL_HandleEnum::Vendor)->value);
+    for (auto b : {b0.get(), b1.get(), b2.get(), b3.get(), b4.get()}) {
+      EXPECT_EQ(42, b->value);
+    }
+  }
+
+  // all of the hazard pointers were released, so freeing doesn't wait
+  for (int i = 0; i < 6; ++i) {
+    testResource.Free(handles[i], HAL_HandleEnum::Vendor);
+  }
+  EXPECT_EQ(0, CountedStruct::count);
+}
+
 }  // namespace hal
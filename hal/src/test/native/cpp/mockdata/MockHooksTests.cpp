@@ -0,0 +1,98 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <chrono>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <wpi/mutex.h>
+
+#include "gtest/gtest.h"
+#include "hal/HAL.h"
+#include "hal/Notifier.h"
+#include "hal/handles/HandlesInternal.h"
+#include "hal/simulation/MockHooks.h"
+
+namespace hal {
+
+namespace {
+struct Event {
+  uint64_t time;
+  int32_t index;
+
+  bool operator==(const Event& rhs) const {
+    return time == rhs.time && index == rhs.index;
+  }
+};
+
+// Runs notifiers with 20, 20, and 10 ms periods for the given simulated time
+// and returns when each of them ran
+std::vector<Event> RunNotifiers(uint64_t duration) {
+  HALSIM_SetFastTiming(true);
+  int32_t status = 0;
+  uint64_t start = HAL_GetFPGATime(&status);
+
+  wpi::mutex mutex;
+  std::vector<Event> events;
+  // Create all of the notifiers first so time can't advance past an alarm
+  // before its notifier exists
+  std::vector<std::pair<HAL_NotifierHandle, uint64_t>> notifiers;
+  for (uint64_t period : {20000, 20000, 10000}) {
+    notifiers.emplace_back(HAL_InitializeNotifier(&status), period);
+    EXPECT_EQ(0, status);
+  }
+
+  std::vector<std::thread> threads;
+  for (auto& notifier : notifiers) {
+    HAL_NotifierHandle handle = notifier.first;
+    uint64_t period = notifier.second;
+    threads.emplace_back([=, &mutex, &events] {
+      int32_t status = 0;
+      for (uint64_t t = start + period; t <= start + duration; t += period) {
+        HAL_UpdateNotifierAlarm(handle, t, &status);
+        uint64_t time = HAL_WaitForNotifierAlarm(handle, &status);
+        std::scoped_lock lock(mutex);
+        events.push_back({time - start, getHandleIndex(handle)});
+      }
+      HAL_StopNotifier(handle, &status);
+      HAL_CleanNotifier(handle, &status);
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  HALSIM_SetFastTiming(false);
+  return events;
+}
+}  // namespace
+
+TEST(MockHooksTests, FastTiming) {
+  constexpr uint64_t kDuration = 30000000;
+
+  auto begin = std::chrono::steady_clock::now();
+  auto events = RunNotifiers(kDuration);
+  auto elapsed = std::chrono::steady_clock::now() - begin;
+
+  EXPECT_FALSE(HALSIM_IsFastTiming());
+  EXPECT_LT(elapsed, std::chrono::microseconds(kDuration));
+
+  // Every alarm runs at exactly its time, and notifiers with the same alarm
+  // run in handle order
+  ASSERT_EQ(kDuration / 20000 * 2 + kDuration / 10000, events.size());
+  for (size_t i = 0; i < events.size(); ++i) {
+    EXPECT_EQ(0u, events[i].time % 10000);
+    if (i > 0) {
+      EXPECT_TRUE(events[i - 1].time < events[i].time ||
+                  (events[i - 1].time == events[i].time &&
+                   events[i - 1].index < events[i].index));
+    }
+  }
+  EXPECT_EQ(kDuration, events.back().time);
+
+  EXPECT_EQ(events, RunNotifiers(kDuration));
+}
+
+}  // namespace hal
@@ -2,6 +2,9 @@
 // Open Source Software; you can modify and/or share it under the terms of
 // the WPILib BSD license file in the root directory of this project.
 
+#include <thread>
+#include <vector>
+
 #include "gtest/gtest.h"
 #include "hal/HAL.h"
 #include "hal/PWM.h"
@@ -76,4 +79,29 @@ TEST(PWMSimTests, TestPwmInitialization) {
   EXPECT_STREQ("Initialized", gTestPwmCallbackName.c_str());
   HALSIM_CancelPWMInitializedCallback(INDEX_TO_TEST, callbackId);
 }
+
+TEST(PWMSimTests, SetDuringCallbackNotifiesInOrder) {
+  const int INDEX_TO_TEST = 6;
+
+  std::vector<double> speeds;
+  int callbackId = HALSIM_RegisterPWMSpeedCallback(
+      INDEX_TO_TEST,
+      [](const char* name, void* param, const struct HAL_Value* value) {
+        if (value->data.v_double == 0.5) {
+          // the other thread's change is notified after this one
+          std::thread thread{[] { HALSIM_SetPWMSpeed(INDEX_TO_TEST, -0.5); }};
+          thread.join();
+        }
+        static_cast<std::vector<double>*>(param)->emplace_back(
+            value->data.v_double);
+      },
+      &speeds, false);
+
+  HALSIM_SetPWMSpeed(INDEX_TO_TEST, 0.5);
+  EXPECT_EQ((std::vector<double>{0.5, -0.5}), speeds);
+  EXPECT_EQ(-0.5, HALSIM_GetPWMSpeed(INDEX_TO_TEST));
+
+  HALSIM_CancelPWMSpeedCallback(INDEX_TO_TEST, callbackId);
+  HALSIM_ResetPWMData(INDEX_TO_TEST);
+}
 }  // namespace hal
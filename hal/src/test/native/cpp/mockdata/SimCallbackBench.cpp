@@ -0,0 +1,89 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "hal/SimDevice.h"
+#include "hal/simulation/SimDeviceData.h"
+
+using std::chrono::duration_cast;
+using std::chrono::high_resolution_clock;
+using std::chrono::nanoseconds;
+
+namespace hal {
+
+namespace {
+
+constexpr int kSets = 2000;
+
+// Stands in for a listener that does real work, like serializing JSON
+void SlowListener(const char* name, void* param, HAL_SimValueHandle handle,
+                  int32_t direction, const HAL_Value* value) {
+  auto end = high_resolution_clock::now() + std::chrono::microseconds(5);
+  while (high_resolution_clock::now() < end) {
+  }
+}
+
+}  // namespace
+
+// Disabled by default as it only reports timings; run with
+// --gtest_also_run_disabled_tests --gtest_filter='*Benchmark*'
+TEST(SimCallbackBenchmark, DISABLED_SetWhileListenersRun) {
+  for (int listeners : {1, 8, 32}) {
+    HAL_SimDeviceHandle dev =
+        HAL_CreateSimDevice(("Bench" + std::to_string(listeners)).c_str());
+    HAL_SimValueHandle watched =
+        HAL_CreateSimValueDouble(dev, "watched", HAL_SimValueOutput, 0.0);
+    HAL_SimValueHandle unwatched =
+        HAL_CreateSimValueDouble(dev, "unwatched", HAL_SimValueOutput, 0.0);
+    std::vector<int32_t> uids;
+    for (int i = 0; i < listeners; ++i) {
+      uids.emplace_back(HALSIM_RegisterSimValueChangedCallback(
+          watched, nullptr, SlowListener, false));
+    }
+
+    // Keep the listeners busy from another thread, and time setting another
+    // value of the same device
+    std::atomic<bool> started{false};
+    std::atomic<bool> done{false};
+    std::thread writer{[&] {
+      for (double value = 1.0; !done; value += 1.0) {
+        HAL_SetSimValueDouble(watched, value);
+        started = true;
+      }
+    }};
+    while (!started) {
+      std::this_thread::yield();
+    }
+    int64_t maxNs = 0;
+    int64_t totalNs = 0;
+    for (int i = 0; i < kSets; ++i) {
+      auto start = high_resolution_clock::now();
+      HAL_SetSimValueDouble(unwatched, i);
+      auto stop = high_resolution_clock::now();
+      int64_t ns = duration_cast<nanoseconds>(stop - start).count();
+      maxNs = std::max(maxNs, ns);
+      totalNs += ns;
+    }
+    done = true;
+    writer.join();
+
+    for (int32_t uid : uids) {
+      HALSIM_CancelSimValueChangedCallback(uid);
+    }
+    HAL_FreeSimDevice(dev);
+
+    std::cout << listeners << " listeners Set() mean: " << totalNs / kSets
+              << " ns max: " << maxNs << " ns\n";
+  }
+}
+
+}  // namespace hal
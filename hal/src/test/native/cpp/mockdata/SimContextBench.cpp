@@ -0,0 +1,74 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "hal/DIO.h"
+#include "hal/HAL.h"
+#include "hal/Notifier.h"
+#include "hal/simulation/MockHooks.h"
+
+using std::chrono::duration;
+using std::chrono::high_resolution_clock;
+
+namespace hal {
+
+namespace {
+
+constexpr uint64_t kPeriod = 20000;
+constexpr int kLoops = 5000;
+
+// Runs a robot with a 20 ms loop in its own sim context as fast as possible
+void RunRobot() {
+  int32_t context = HALSIM_CreateSimContext();
+  HALSIM_SetThreadSimContext(context);
+  HALSIM_SetFastTiming(true);
+  int32_t status = 0;
+  HAL_DigitalHandle dio =
+      HAL_InitializeDIOPort(HAL_GetPort(0), false, nullptr, &status);
+  HAL_NotifierHandle notifier = HAL_InitializeNotifier(&status);
+  uint64_t start = HAL_GetFPGATime(&status);
+  for (int i = 1; i <= kLoops; ++i) {
+    HAL_UpdateNotifierAlarm(notifier, start + i * kPeriod, &status);
+    if (HAL_WaitForNotifierAlarm(notifier, &status) == 0) {
+      break;
+    }
+    HAL_SimPeriodicBefore();
+    HAL_SetDIO(dio, i % 2, &status);
+    HAL_SimPeriodicAfter();
+  }
+  HAL_StopNotifier(notifier, &status);
+  HAL_CleanNotifier(notifier, &status);
+  HALSIM_SetFastTiming(false);
+  HALSIM_DestroySimContext(context);
+}
+
+}  // namespace
+
+// Disabled by default as it only reports timings; run with
+// --gtest_also_run_disabled_tests --gtest_filter='*Benchmark*'
+TEST(SimContextBenchmark, DISABLED_RobotsPerProcess) {
+  for (int robots : {1, 2, 4, 8}) {
+    auto start = high_resolution_clock::now();
+    std::vector<std::thread> threads;
+    for (int i = 0; i < robots; ++i) {
+      threads.emplace_back(RunRobot);
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    double seconds =
+        duration<double>(high_resolution_clock::now() - start).count();
+    double simSeconds = robots * kLoops * kPeriod * 1.0e-6;
+    std::cout << robots << " robots: " << simSeconds / seconds
+              << " simulated s per s, " << robots * kLoops / seconds
+              << " loops per s\n";
+  }
+}
+
+}  // namespace hal
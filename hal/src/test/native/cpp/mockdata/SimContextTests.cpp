@@ -0,0 +1,128 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "hal/DIO.h"
+#include "hal/HAL.h"
+#include "hal/Notifier.h"
+#include "hal/simulation/DIOData.h"
+#include "hal/simulation/MockHooks.h"
+
+namespace hal {
+
+TEST(SimContextTests, IndependentRobots) {
+  constexpr int32_t kChannel = 7;
+
+  int32_t contexts[] = {HALSIM_CreateSimContext(), HALSIM_CreateSimContext()};
+  EXPECT_NE(0, contexts[0]);
+  EXPECT_NE(contexts[0], contexts[1]);
+
+  // Each robot can allocate the same channel and has its own time
+  for (int i = 0; i < 2; ++i) {
+    HALSIM_SetThreadSimContext(contexts[i]);
+    EXPECT_EQ(contexts[i], HALSIM_GetThreadSimContext());
+    int32_t status = 0;
+    HAL_DigitalHandle handle =
+        HAL_InitializeDIOPort(HAL_GetPort(kChannel), false, nullptr, &status);
+    EXPECT_NE(HAL_kInvalidHandle, handle);
+    EXPECT_EQ(0, status);
+    HAL_SetDIO(handle, i == 0, &status);
+    HALSIM_PauseTiming();
+    HALSIM_RestartTiming();
+    HALSIM_StepTiming(1000000 * (i + 1));
+  }
+  for (int i = 0; i < 2; ++i) {
+    HALSIM_SetThreadSimContext(contexts[i]);
+    int32_t status = 0;
+    EXPECT_TRUE(HALSIM_GetDIOInitialized(kChannel));
+    EXPECT_EQ(i == 0, HALSIM_GetDIOValue(kChannel));
+    EXPECT_EQ(1000000u * (i + 1), HAL_GetFPGATime(&status));
+  }
+
+  // The default robot is unaffected
+  HALSIM_SetThreadSimContext(0);
+  EXPECT_EQ(0, HALSIM_GetThreadSimContext());
+  EXPECT_FALSE(HALSIM_GetDIOInitialized(kChannel));
+  EXPECT_FALSE(HALSIM_IsTimingPaused());
+
+  HALSIM_SetThreadSimContext(contexts[0]);
+  EXPECT_TRUE(HALSIM_DestroySimContext(contexts[0]));
+  EXPECT_EQ(0, HALSIM_GetThreadSimContext());
+  EXPECT_TRUE(HALSIM_DestroySimContext(contexts[1]));
+  EXPECT_FALSE(HALSIM_DestroySimContext(contexts[1]));
+}
+
+TEST(SimContextTests, DestroyBoundToOtherThread) {
+  int32_t context = HALSIM_CreateSimContext();
+  std::mutex mutex;
+  std::condition_variable cond;
+  int step = 0;
+  auto waitFor = [&](int s) {
+    std::unique_lock lock(mutex);
+    cond.wait(lock, [&] { return step == s; });
+  };
+  auto advance = [&] {
+    std::scoped_lock lock(mutex);
+    ++step;
+    cond.notify_all();
+  };
+
+  std::thread thread{[&] {
+    HALSIM_SetThreadSimContext(context);
+    EXPECT_FALSE(HALSIM_GetDIOInitialized(0));
+    advance();
+    waitFor(2);
+  }};
+
+  // The context isn't destroyed while the other thread uses it
+  waitFor(1);
+  EXPECT_FALSE(HALSIM_DestroySimContext(context));
+  advance();
+  thread.join();
+
+  // Exiting unbinds the thread
+  EXPECT_TRUE(HALSIM_DestroySimContext(context));
+}
+
+TEST(SimContextTests, FastTimingPerRobot) {
+  constexpr uint64_t kPeriod = 20000;
+  constexpr int kLoops = 500;
+
+  // Each thread runs a robot with its own fast timing
+  std::vector<uint64_t> times(2);
+  std::vector<std::thread> threads;
+  for (auto& time : times) {
+    threads.emplace_back([&time] {
+      int32_t context = HALSIM_CreateSimContext();
+      HALSIM_SetThreadSimContext(context);
+      HALSIM_SetFastTiming(true);
+      int32_t status = 0;
+      uint64_t start = HAL_GetFPGATime(&status);
+      HAL_NotifierHandle notifier = HAL_InitializeNotifier(&status);
+      for (int i = 1; i <= kLoops; ++i) {
+        HAL_UpdateNotifierAlarm(notifier, start + i * kPeriod, &status);
+        time = HAL_WaitForNotifierAlarm(notifier, &status) - start;
+      }
+      HAL_StopNotifier(notifier, &status);
+      HAL_CleanNotifier(notifier, &status);
+      HALSIM_SetFastTiming(false);
+      HALSIM_DestroySimContext(context);
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (auto time : times) {
+    EXPECT_EQ(kLoops * kPeriod, time);
+  }
+  EXPECT_FALSE(HALSIM_IsFastTiming());
+}
+
+}  // namespace hal
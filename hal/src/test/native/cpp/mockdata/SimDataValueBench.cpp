@@ -0,0 +1,86 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "hal/Value.h"
+#include "hal/simulation/SimDataValue.h"
+
+using std::chrono::duration_cast;
+using std::chrono::high_resolution_clock;
+using std::chrono::nanoseconds;
+
+namespace hal {
+
+namespace {
+
+HAL_SIMDATAVALUE_DEFINE_NAME(Voltage)
+
+using VoltageValue = SimDataValue<double, HAL_MakeDouble, GetVoltageName>;
+
+constexpr int kReads = 1000000;
+
+// Reads the value from each reader thread while another thread keeps setting
+// it, like robot code reading a value a physics sim is updating, and returns
+// the average time per read
+template <typename F>
+double TimeNsPerRead(VoltageValue& value, int readers, F&& read) {
+  std::atomic<bool> done{false};
+  std::thread writer{[&] {
+    double voltage = 0.0;
+    while (!done) {
+      value = voltage;
+      voltage += 0.01;
+    }
+  }};
+
+  std::vector<std::thread> threads;
+  std::atomic<int64_t> totalNs{0};
+  for (int i = 0; i < readers; ++i) {
+    threads.emplace_back([&] {
+      double sum = 0.0;
+      auto start = high_resolution_clock::now();
+      for (int j = 0; j < kReads; ++j) {
+        sum += read();
+      }
+      auto stop = high_resolution_clock::now();
+      EXPECT_GE(sum, 0.0);
+      totalNs += duration_cast<nanoseconds>(stop - start).count();
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  done = true;
+  writer.join();
+
+  return static_cast<double>(totalNs) / kReads / readers;
+}
+
+}  // namespace
+
+// Disabled by default as it only reports timings; run with
+// --gtest_also_run_disabled_tests --gtest_filter='*Benchmark*'
+TEST(SimDataValueBenchmark, DISABLED_ContendedGet) {
+  VoltageValue value{0.0};
+
+  for (int readers : {1, 2, 4}) {
+    double getNs = TimeNsPerRead(value, readers, [&] { return value.Get(); });
+    // Taking the lock for every read, which is what Get() used to do
+    double lockedNs = TimeNsPerRead(value, readers, [&] {
+      std::scoped_lock lock(value.GetMutex());
+      return value.Get();
+    });
+    std::cout << readers << " readers Get(): " << getNs
+              << " ns locked: " << lockedNs << " ns\n";
+  }
+}
+
+}  // namespace hal
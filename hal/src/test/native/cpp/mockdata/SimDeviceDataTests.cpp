@@ -2,6 +2,9 @@
 // Open Source Software; you can modify and/or share it under the terms of
 // the WPILib BSD license file in the root directory of this project.
 
+#include <thread>
+#include <vector>
+
 #include "gtest/gtest.h"
 #include "hal/SimDevice.h"
 #include "hal/simulation/SimDeviceData.h"
@@ -19,4 +22,93 @@ TEST(SimDeviceSimTests, TestEnabled) {
   ASSERT_EQ(HAL_CreateSimDevice("foo"), 0);
 }
 
+namespace {
+struct CallbackState {
+  HAL_SimValueHandle other;
+  double otherValue = 0.0;
+  int32_t uid = 0;
+  int count = 0;
+  std::vector<double> values;
+};
+}  // namespace
+
+TEST(SimDeviceSimTests, CallbackUsesDeviceFromOtherThread) {
+  HAL_SimDeviceHandle dev = HAL_CreateSimDevice("CallbackThread");
+  HAL_SimValueHandle a =
+      HAL_CreateSimValueDouble(dev, "a", HAL_SimValueOutput, 0.0);
+  CallbackState state;
+  state.other = HAL_CreateSimValueDouble(dev, "b", HAL_SimValueInput, 2.0);
+
+  // Callbacks don't hold the device lock, so another thread can use the
+  // device while they run
+  int32_t uid = HALSIM_RegisterSimValueChangedCallback(
+      a, &state,
+      [](const char* name, void* param, HAL_SimValueHandle handle,
+         int32_t direction, const HAL_Value* value) {
+        auto state = static_cast<CallbackState*>(param);
+        std::thread thread{[=] {
+          state->otherValue = HAL_GetSimValueDouble(state->other);
+          HAL_SetSimValueDouble(state->other, 3.0);
+        }};
+        thread.join();
+        ++state->count;
+      },
+      false);
+
+  HAL_SetSimValueDouble(a, 1.0);
+  EXPECT_EQ(1, state.count);
+  EXPECT_EQ(2.0, state.otherValue);
+  EXPECT_EQ(3.0, HAL_GetSimValueDouble(state.other));
+
+  HALSIM_CancelSimValueChangedCallback(uid);
+  HAL_FreeSimDevice(dev);
+}
+
+TEST(SimDeviceSimTests, CallbackCancelsItself) {
+  HAL_SimDeviceHandle dev = HAL_CreateSimDevice("CallbackCancel");
+  HAL_SimValueHandle a =
+      HAL_CreateSimValueDouble(dev, "a", HAL_SimValueOutput, 0.0);
+  CallbackState state;
+  state.uid = HALSIM_RegisterSimValueChangedCallback(
+      a, &state,
+      [](const char* name, void* param, HAL_SimValueHandle handle,
+         int32_t direction, const HAL_Value* value) {
+        auto state = static_cast<CallbackState*>(param);
+        ++state->count;
+        HALSIM_CancelSimValueChangedCallback(state->uid);
+      },
+      false);
+
+  HAL_SetSimValueDouble(a, 1.0);
+  HAL_SetSimValueDouble(a, 2.0);
+  EXPECT_EQ(1, state.count);
+
+  HAL_FreeSimDevice(dev);
+}
+
+TEST(SimDeviceSimTests, SetDuringCallbackNotifiesInOrder) {
+  HAL_SimDeviceHandle dev = HAL_CreateSimDevice("CallbackOrder");
+  CallbackState state;
+  state.other = HAL_CreateSimValueDouble(dev, "a", HAL_SimValueOutput, 0.0);
+  int32_t uid = HALSIM_RegisterSimValueChangedCallback(
+      state.other, &state,
+      [](const char* name, void* param, HAL_SimValueHandle handle,
+         int32_t direction, const HAL_Value* value) {
+        auto state = static_cast<CallbackState*>(param);
+        if (value->data.v_double == 1.0) {
+          // the other thread's change is notified after this one
+          std::thread thread{[=] { HAL_SetSimValueDouble(handle, 2.0); }};
+          thread.join();
+        }
+        state->values.emplace_back(value->data.v_double);
+      },
+      false);
+
+  HAL_SetSimValueDouble(state.other, 1.0);
+  EXPECT_EQ((std::vector<double>{1.0, 2.0}), state.values);
+
+  HALSIM_CancelSimValueChangedCallback(uid);
+  HAL_FreeSimDevice(dev);
+}
+
 }  // namespace hal
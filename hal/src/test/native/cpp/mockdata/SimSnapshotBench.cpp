@@ -0,0 +1,99 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "hal/HAL.h"
+#include "hal/Ports.h"
+#include "hal/simulation/AnalogInData.h"
+#include "hal/simulation/DIOData.h"
+#include "hal/simulation/DriverStationData.h"
+#include "hal/simulation/EncoderData.h"
+#include "hal/simulation/MockHooks.h"
+#include "hal/simulation/PWMData.h"
+#include "hal/simulation/RelayData.h"
+#include "hal/simulation/SimSnapshot.h"
+
+using std::chrono::duration_cast;
+using std::chrono::high_resolution_clock;
+using std::chrono::nanoseconds;
+
+namespace hal {
+
+namespace {
+
+constexpr int kRuns = 1000;
+
+void NoopCallback(const char* name, void* param, const HAL_Value* value) {}
+
+// Resets the data of the most common device types one at a time
+void ResetData() {
+  for (int32_t i = 0; i < HAL_GetNumDigitalChannels(); ++i) {
+    HALSIM_ResetDIOData(i);
+  }
+  for (int32_t i = 0; i < HAL_GetNumPWMChannels(); ++i) {
+    HALSIM_ResetPWMData(i);
+  }
+  for (int32_t i = 0; i < HAL_GetNumAnalogInputs(); ++i) {
+    HALSIM_ResetAnalogInData(i);
+  }
+  for (int32_t i = 0; i < HAL_GetNumEncoders(); ++i) {
+    HALSIM_ResetEncoderData(i);
+  }
+  for (int32_t i = 0; i < HAL_GetNumRelayHeaders(); ++i) {
+    HALSIM_ResetRelayData(i);
+  }
+  HALSIM_ResetDriverStationData();
+}
+
+}  // namespace
+
+// Disabled by default as it only reports timings; run with
+// --gtest_also_run_disabled_tests --gtest_filter='*Benchmark*'
+TEST(SimSnapshotBenchmark, DISABLED_RestoreVersusReset) {
+  int32_t context = HALSIM_CreateSimContext();
+  HALSIM_SetThreadSimContext(context);
+
+  // Restoring keeps the callbacks, while resetting drops them, so only the
+  // restore has to skip them
+  for (int32_t i = 0; i < HAL_GetNumDigitalChannels(); ++i) {
+    HALSIM_RegisterDIOValueCallback(i, NoopCallback, nullptr, false);
+  }
+  std::vector<uint8_t> snapshot(HALSIM_SaveSimSnapshot(nullptr, 0));
+  HALSIM_SaveSimSnapshot(snapshot.data(), snapshot.size());
+
+  auto start = high_resolution_clock::now();
+  for (int i = 0; i < kRuns; ++i) {
+    HALSIM_SaveSimSnapshot(snapshot.data(), snapshot.size());
+  }
+  auto saveNs =
+      duration_cast<nanoseconds>(high_resolution_clock::now() - start).count();
+
+  start = high_resolution_clock::now();
+  for (int i = 0; i < kRuns; ++i) {
+    HALSIM_RestoreSimSnapshot(snapshot.data(), snapshot.size());
+  }
+  auto restoreNs =
+      duration_cast<nanoseconds>(high_resolution_clock::now() - start).count();
+
+  start = high_resolution_clock::now();
+  for (int i = 0; i < kRuns; ++i) {
+    ResetData();
+  }
+  auto resetNs =
+      duration_cast<nanoseconds>(high_resolution_clock::now() - start).count();
+
+  std::cout << "snapshot: " << snapshot.size() << " bytes\n"
+            << "save: " << saveNs / kRuns << " ns\n"
+            << "restore: " << restoreNs / kRuns << " ns\n"
+            << "reset common data: " << resetNs / kRuns << " ns\n";
+
+  HALSIM_SetThreadSimContext(0);
+  HALSIM_DestroySimContext(context);
+}
+
+}  // namespace hal
@@ -0,0 +1,97 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "hal/HAL.h"
+#include "hal/SimDevice.h"
+#include "hal/simulation/DIOData.h"
+#include "hal/simulation/DriverStationData.h"
+#include "hal/simulation/MockHooks.h"
+#include "hal/simulation/PWMData.h"
+#include "hal/simulation/SimDeviceData.h"
+#include "hal/simulation/SimSnapshot.h"
+
+namespace hal {
+
+namespace {
+std::vector<uint8_t> SaveSnapshot() {
+  std::vector<uint8_t> snapshot(HALSIM_SaveSimSnapshot(nullptr, 0));
+  EXPECT_EQ(static_cast<int32_t>(snapshot.size()),
+            HALSIM_SaveSimSnapshot(snapshot.data(), snapshot.size()));
+  return snapshot;
+}
+
+void CountCallback(const char* name, void* param, const HAL_Value* value) {
+  ++*static_cast<int*>(param);
+}
+
+void CountRestored(void* param) {
+  ++*static_cast<int*>(param);
+}
+}  // namespace
+
+TEST(SimSnapshotTests, SaveRestore) {
+  // Run in a new sim context so other tests don't see the changes
+  int32_t context = HALSIM_CreateSimContext();
+  HALSIM_SetThreadSimContext(context);
+  HALSIM_PauseTiming();
+
+  HAL_SimDeviceHandle dev = HAL_CreateSimDevice("SnapshotDevice");
+  HAL_SimValueHandle value =
+      HAL_CreateSimValueDouble(dev, "value", HAL_SimValueInput, 1.0);
+  HALSIM_SetDIOValue(2, false);
+  HALSIM_SetPWMSpeed(3, 0.5);
+  HAL_JoystickAxes axes{};
+  axes.count = 2;
+  axes.axes[1] = 0.25f;
+  HALSIM_SetJoystickAxes(1, &axes);
+  int32_t status = 0;
+  uint64_t time = HAL_GetFPGATime(&status);
+
+  auto snapshot = SaveSnapshot();
+
+  HAL_SetSimValueDouble(value, 2.0);
+  HALSIM_SetDIOValue(2, true);
+  HALSIM_SetPWMSpeed(3, -1.0);
+  axes.axes[1] = -1.0f;
+  HALSIM_SetJoystickAxes(1, &axes);
+  HALSIM_StepTiming(1000000);
+
+  int callbacks = 0;
+  int restored = 0;
+  int32_t callbackUid =
+      HALSIM_RegisterDIOValueCallback(2, CountCallback, &callbacks, false);
+  int32_t restoredUid =
+      HALSIM_RegisterSimSnapshotRestoredCallback(CountRestored, &restored);
+
+  // An invalid snapshot changes nothing
+  EXPECT_FALSE(HALSIM_RestoreSimSnapshot(snapshot.data(), snapshot.size() - 1));
+  EXPECT_TRUE(HALSIM_GetDIOValue(2));
+  EXPECT_EQ(0, restored);
+
+  EXPECT_TRUE(HALSIM_RestoreSimSnapshot(snapshot.data(), snapshot.size()));
+  EXPECT_EQ(1.0, HAL_GetSimValueDouble(value));
+  EXPECT_FALSE(HALSIM_GetDIOValue(2));
+  EXPECT_EQ(0.5, HALSIM_GetPWMSpeed(3));
+  HALSIM_GetJoystickAxes(1, &axes);
+  EXPECT_EQ(0.25f, axes.axes[1]);
+  EXPECT_EQ(time, HAL_GetFPGATime(&status));
+  EXPECT_TRUE(HALSIM_IsTimingPaused());
+
+  // Values are restored without their callbacks, which are kept
+  EXPECT_EQ(0, callbacks);
+  EXPECT_EQ(1, restored);
+  HALSIM_SetDIOValue(2, true);
+  EXPECT_EQ(1, callbacks);
+
+  HALSIM_CancelDIOValueCallback(2, callbackUid);
+  HALSIM_CancelSimSnapshotRestoredCallback(restoredUid);
+  HAL_FreeSimDevice(dev);
+  HALSIM_SetThreadSimContext(0);
+  HALSIM_DestroySimContext(context);
+}
+
+}  // namespace hal
@@ -11,6 +11,7 @@
 #include <wpi/StringExtras.h>
 #include <wpi/TCPAcceptor.h>
 #include <wpi/TCPConnector.h>
+#include <wpi/Trace.h>
 #include <wpi/timestamp.h>
 
 #include "IConnectionNotifier.h"
@@ -318,6 +319,7 @@ void DispatcherBase::ClearConnectorOverride() {
 }
 
 void DispatcherBase::DispatchThreadMain() {
+  wpi::trace::SetThreadName("NT dispatch");
   auto timeout_time = std::chrono::steady_clock::now();
 
   static const auto save_delta_time = std::chrono::seconds(1);
@@ -343,6 +345,8 @@ void DispatcherBase::DispatchThreadMain() {
       break;  // in case we were woken up to terminate
     }
 
+    WPI_TRACE_SCOPE("NT dispatch");
+
     // perform periodic persistent save
     if ((m_networkMode & NT_NET_MODE_SERVER) != 0 &&
         !m_persist_filename.empty() && start > next_save_time) {
@@ -399,11 +399,11 @@ void Storage::GetInitialAssignments(
   std::scoped_lock lock(m_mutex);
   conn.set_state(INetworkConnection::kSynchronized);
   for (auto& i : m_entries) {
-    Entry* entry = i.getValue();
+    Entry* entry = i.second;
     if (!entry->value) {
       continue;
     }
-    msgs->emplace_back(Message::EntryAssign(i.getKey(), entry->id,
+    msgs->emplace_back(Message::EntryAssign(i.first, entry->id,
                                             entry->seq_num.value(),
                                             entry->value, entry->flags));
   }
@@ -423,7 +423,7 @@ void Storage::ApplyInitialAssignments(
 
   // clear existing id's
   for (auto& i : m_entries) {
-    i.getValue()->id = 0xffff;
+    i.second->id = 0xffff;
   }
 
   // clear existing idmap
@@ -516,7 +516,7 @@ std::shared_ptr<Value> Storage::GetEntryValue(std::string_view name) const {
   if (i == m_entries.end()) {
     return nullptr;
   }
-  return i->getValue()->value;
+  return i->second->value;
 }
 
 std::shared_ptr<Value> Storage::GetEntryValue(unsigned int local_id) const {
@@ -706,7 +706,7 @@ void Storage::SetEntryFlags(std::string_view name, unsigned int flags) {
   if (i == m_entries.end()) {
     return;
   }
-  SetEntryFlagsImpl(i->getValue(), flags, lock, true);
+  SetEntryFlagsImpl(i->second, flags, lock, true);
 }
 
 void Storage::SetEntryFlags(unsigned int id_local, unsigned int flags) {
@@ -755,7 +755,7 @@ unsigned int Storage::GetEntryFlags(std::string_view name) const {
   if (i == m_entries.end()) {
     return 0;
   }
-  return i->getValue()->flags;
+  return i->second->flags;
 }
 
 unsigned int Storage::GetEntryFlags(unsigned int local_id) const {
@@ -772,7 +772,7 @@ void Storage::DeleteEntry(std::string_view name) {
   if (i == m_entries.end()) {
     return;
   }
-  DeleteEntryImpl(i->getValue(), lock, true);
+  DeleteEntryImpl(i->second, lock, true);
 }
 
 void Storage::DeleteEntry(unsigned int local_id) {
@@ -835,10 +835,10 @@ void Storage::DeleteEntryImpl(Entry* entry, std::unique_lock<wpi::mutex>& lock,
 template <typename F>
 void Storage::DeleteAllEntriesImpl(bool local, F should_delete) {
   for (auto& i : m_entries) {
-    Entry* entry = i.getValue();
+    Entry* entry = i.second;
     if (entry->value && should_delete(entry)) {
       // notify it's being deleted
-      m_notifier.NotifyEntry(entry->local_id, i.getKey(), entry->value,
+      m_notifier.NotifyEntry(entry->local_id, i.first, entry->value,
                              NT_NOTIFY_DELETE | (local ? NT_NOTIFY_LOCAL : 0));
       // remove it from idmap
       if (entry->id < m_idmap.size()) {
@@ -898,9 +898,9 @@ std::vector<unsigned int> Storage::GetEntries(std::string_view prefix,
   std::scoped_lock lock(m_mutex);
   std::vector<unsigned int> ids;
   for (auto& i : m_entries) {
-    Entry* entry = i.getValue();
+    Entry* entry = i.second;
     auto value = entry->value.get();
-    if (!value || !wpi::starts_with(i.getKey(), prefix)) {
+    if (!value || !wpi::starts_with(i.first, prefix)) {
       continue;
     }
     if (types != 0 && (types & value->type()) == 0) {
@@ -972,9 +972,9 @@ std::vector<EntryInfo> Storage::GetEntryInfo(int inst, std::string_view prefix,
   std::scoped_lock lock(m_mutex);
   std::vector<EntryInfo> infos;
   for (auto& i : m_entries) {
-    Entry* entry = i.getValue();
+    Entry* entry = i.second;
     auto value = entry->value.get();
-    if (!value || !wpi::starts_with(i.getKey(), prefix)) {
+    if (!value || !wpi::starts_with(i.first, prefix)) {
       continue;
     }
     if (types != 0 && (types & value->type()) == 0) {
@@ -982,7 +982,7 @@ std::vector<EntryInfo> Storage::GetEntryInfo(int inst, std::string_view prefix,
     }
     EntryInfo info;
     info.entry = Handle(inst, entry->local_id, Handle::kEntry);
-    info.name = i.getKey();
+    info.name = i.first;
     info.type = value->type();
     info.flags = entry->flags;
     info.last_change = value->last_change();
@@ -1000,11 +1000,11 @@ unsigned int Storage::AddListener(
   // perform immediate notifications
   if ((flags & NT_NOTIFY_IMMEDIATE) != 0 && (flags & NT_NOTIFY_NEW) != 0) {
     for (auto& i : m_entries) {
-      Entry* entry = i.getValue();
-      if (!entry->value || !wpi::starts_with(i.getKey(), prefix)) {
+      Entry* entry = i.second;
+      if (!entry->value || !wpi::starts_with(i.first, prefix)) {
         continue;
       }
-      m_notifier.NotifyEntry(entry->local_id, i.getKey(), entry->value,
+      m_notifier.NotifyEntry(entry->local_id, i.first, entry->value,
                              NT_NOTIFY_IMMEDIATE | NT_NOTIFY_NEW, uid);
     }
   }
@@ -1037,14 +1037,14 @@ unsigned int Storage::AddPolledListener(unsigned int poller,
   // perform immediate notifications
   if ((flags & NT_NOTIFY_IMMEDIATE) != 0 && (flags & NT_NOTIFY_NEW) != 0) {
     for (auto& i : m_entries) {
-      if (!wpi::starts_with(i.getKey(), prefix)) {
+      if (!wpi::starts_with(i.first, prefix)) {
         continue;
       }
-      Entry* entry = i.getValue();
+      Entry* entry = i.second;
       if (!entry->value) {
         continue;
       }
-      m_notifier.NotifyEntry(entry->local_id, i.getKey(), entry->value,
+      m_notifier.NotifyEntry(entry->local_id, i.first, entry->value,
                              NT_NOTIFY_IMMEDIATE | NT_NOTIFY_NEW, uid);
     }
   }
@@ -1083,12 +1083,12 @@ bool Storage::GetPersistentEntries(
     m_persistent_dirty = false;
     entries->reserve(m_entries.size());
     for (auto& i : m_entries) {
-      Entry* entry = i.getValue();
+      Entry* entry = i.second;
       // only write persistent-flagged values
       if (!entry->value || !entry->IsPersistent()) {
         continue;
       }
-      entries->emplace_back(i.getKey(), entry->value);
+      entries->emplace_back(i.first, entry->value);
     }
   }
 
@@ -1110,12 +1110,12 @@ bool Storage::GetEntries(
     std::scoped_lock lock(m_mutex);
     entries->reserve(m_entries.size());
     for (auto& i : m_entries) {
-      Entry* entry = i.getValue();
+      Entry* entry = i.second;
       // only write values with given prefix
-      if (!entry->value || !wpi::starts_with(i.getKey(), prefix)) {
+      if (!entry->value || !wpi::starts_with(i.first, prefix)) {
         continue;
       }
-      entries->emplace_back(i.getKey(), entry->value);
+      entries->emplace_back(i.first, entry->value);
     }
   }
 
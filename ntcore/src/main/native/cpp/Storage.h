@@ -17,8 +17,8 @@
 #include <vector>
 
 #include <wpi/DenseMap.h>
+#include <wpi/FlatHashMap.h>
 #include <wpi/SmallSet.h>
-#include <wpi/StringMap.h>
 #include <wpi/condition_variable.h>
 #include <wpi/mutex.h>
 #include <wpi/span.h>
@@ -197,7 +197,7 @@ class Storage : public IStorage {
     unsigned int rpc_call_uid{0};
   };
 
-  using EntriesMap = wpi::StringMap<Entry*>;
+  using EntriesMap = wpi::FlatStringMap<Entry*>;
   using IdMap = std::vector<Entry*>;
   using LocalMap = std::vector<std::unique_ptr<Entry>>;
   using RpcIdPair = std::pair<unsigned int, unsigned int>;
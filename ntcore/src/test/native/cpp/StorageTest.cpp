@@ -559,7 +559,7 @@ TEST_P(StorageTestPersistent, SavePersistentEmpty) {
 
 TEST_P(StorageTestPersistent, SavePersistent) {
   for (auto& i : entries()) {
-    i.getValue()->flags = NT_PERSISTENT;
+    i.second->flags = NT_PERSISTENT;
   }
   wpi::SmallString<256> buf;
   wpi::raw_svector_ostream oss(buf);
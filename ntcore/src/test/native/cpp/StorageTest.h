@@ -26,7 +26,7 @@ class StorageTest {
 
   Storage::Entry* GetEntry(std::string_view name) {
     auto i = storage.m_entries.find(name);
-    return i == storage.m_entries.end() ? &tmp_entry : i->getValue();
+    return i == storage.m_entries.end() ? &tmp_entry : i->second;
   }
 
   void HookOutgoing(bool server) { storage.SetDispatcher(&dispatcher, server); }
@@ -0,0 +1,240 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "HALSimShm.h"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+#include <hal/DriverStationTypes.h>
+#include <hal/HALBase.h>
+#include <hal/Ports.h>
+#include <hal/simulation/AnalogInData.h>
+#include <hal/simulation/DIOData.h>
+#include <hal/simulation/DriverStationData.h>
+#include <hal/simulation/EncoderData.h>
+#include <hal/simulation/MockHooks.h>
+#include <hal/simulation/PWMData.h>
+#include <hal/simulation/RelayData.h>
+
+using namespace halsimshm;
+
+static_assert(HALSIMSHM_MAX_JOYSTICK_AXES == HAL_kMaxJoystickAxes);
+static_assert(HALSIMSHM_MAX_JOYSTICK_POVS == HAL_kMaxJoystickPOVs);
+
+static constexpr uint32_t Bit(int32_t index) {
+  return 1u << index;
+}
+
+// Joystick events come from another process, so their index is untrusted
+static constexpr bool IsJoystickIndex(int32_t index) {
+  return index >= 0 && index < HAL_kMaxJoysticks;
+}
+
+HALSimShm::~HALSimShm() {
+  if (m_region) {
+    HALSIM_CancelSimPeriodicBeforeCallback(m_beforeCallback);
+    HALSIM_CancelSimPeriodicAfterCallback(m_afterCallback);
+    m_region->magic.store(0, std::memory_order_release);
+  }
+}
+
+bool HALSimShm::Initialize(std::string_view name) {
+  m_memory = SharedMemory::Create(name, sizeof(Region));
+  if (!m_memory) {
+    return false;
+  }
+  std::memset(m_memory->GetData(), 0, sizeof(Region));
+  m_region = new (m_memory->GetData()) Region;
+  m_region->version = kVersion;
+  m_region->size = sizeof(Region);
+  m_region->magic.store(kMagic, std::memory_order_release);
+
+  m_beforeCallback = HALSIM_RegisterSimPeriodicBeforeCallback(
+      [](void* param) { static_cast<HALSimShm*>(param)->ApplyInputs(); },
+      this);
+  m_afterCallback = HALSIM_RegisterSimPeriodicAfterCallback(
+      [](void* param) { static_cast<HALSimShm*>(param)->PublishOutputs(); },
+      this);
+  return true;
+}
+
+void HALSimShm::ApplyInputs() {
+  HALSIMSHM_Event event;
+  while (m_region->toRobot.Pop(&event)) {
+    HandleEvent(event);
+  }
+
+  // Skip the inputs for this tick if the client is stuck mid-update
+  HALSIMSHM_Inputs inputs;
+  if (!m_region->inputs.Read(&inputs)) {
+    return;
+  }
+  int32_t numDIO = std::min(HAL_GetNumDigitalChannels(), HALSIMSHM_MAX_DIO);
+  for (int32_t i = 0; i < numDIO; ++i) {
+    if (inputs.dioMask & Bit(i)) {
+      HALSIM_SetDIOValue(i, (inputs.dioValue & Bit(i)) != 0);
+    }
+  }
+  int32_t numAnalogIn =
+      std::min(HAL_GetNumAnalogInputs(), HALSIMSHM_MAX_ANALOG_IN);
+  for (int32_t i = 0; i < numAnalogIn; ++i) {
+    if (inputs.analogInMask & Bit(i)) {
+      HALSIM_SetAnalogInVoltage(i, inputs.analogInVoltage[i]);
+    }
+  }
+  int32_t numEncoders = std::min(HAL_GetNumEncoders(), HALSIMSHM_MAX_ENCODERS);
+  for (int32_t i = 0; i < numEncoders; ++i) {
+    if (inputs.encoderMask & Bit(i)) {
+      HALSIM_SetEncoderCount(i, inputs.encoderCount[i]);
+      HALSIM_SetEncoderPeriod(i, inputs.encoderPeriod[i]);
+    }
+  }
+}
+
+void HALSimShm::HandleEvent(const HALSIMSHM_Event& event) {
+  switch (event.type) {
+    case HALSIMSHM_kSetEnabled:
+      HALSIM_SetDriverStationEnabled(event.value);
+      break;
+    case HALSIMSHM_kSetAutonomous:
+      HALSIM_SetDriverStationAutonomous(event.value);
+      break;
+    case HALSIMSHM_kSetTest:
+      HALSIM_SetDriverStationTest(event.value);
+      break;
+    case HALSIMSHM_kSetEStop:
+      HALSIM_SetDriverStationEStop(event.value);
+      break;
+    case HALSIMSHM_kSetDSAttached:
+      HALSIM_SetDriverStationDsAttached(event.value);
+      break;
+    case HALSIMSHM_kSetJoystickAxes: {
+      if (!IsJoystickIndex(event.index)) {
+        break;
+      }
+      HAL_JoystickAxes axes{};
+      axes.count = std::clamp(event.count, 0, HAL_kMaxJoystickAxes);
+      std::copy_n(event.data.axes, axes.count, axes.axes);
+      HALSIM_SetJoystickAxes(event.index, &axes);
+      break;
+    }
+    case HALSIMSHM_kSetJoystickButtons: {
+      if (!IsJoystickIndex(event.index)) {
+        break;
+      }
+      HAL_JoystickButtons buttons{};
+      buttons.count = std::clamp(event.count, 0, 32);
+      buttons.buttons = event.value;
+      HALSIM_SetJoystickButtons(event.index, &buttons);
+      break;
+    }
+    case HALSIMSHM_kSetJoystickPOVs: {
+      if (!IsJoystickIndex(event.index)) {
+        break;
+      }
+      HAL_JoystickPOVs povs{};
+      povs.count = std::clamp(event.count, 0, HAL_kMaxJoystickPOVs);
+      std::copy_n(event.data.povs, povs.count, povs.povs);
+      HALSIM_SetJoystickPOVs(event.index, &povs);
+      break;
+    }
+    case HALSIMSHM_kNotifyNewData:
+      HALSIM_NotifyDriverStationNewData();
+      break;
+    default:
+      break;
+  }
+}
+
+void HALSimShm::PublishOutputs() {
+  HALSIMSHM_Outputs outputs{};
+  outputs.tick = m_outputs.tick + 1;
+  int32_t status = 0;
+  outputs.time = HAL_GetFPGATime(&status);
+  outputs.controlWord =
+      (HALSIM_GetDriverStationEnabled() ? HALSIMSHM_kEnabled : 0) |
+      (HALSIM_GetDriverStationAutonomous() ? HALSIMSHM_kAutonomous : 0) |
+      (HALSIM_GetDriverStationTest() ? HALSIMSHM_kTest : 0) |
+      (HALSIM_GetDriverStationEStop() ? HALSIMSHM_kEStop : 0) |
+      (HALSIM_GetDriverStationFmsAttached() ? HALSIMSHM_kFMSAttached : 0) |
+      (HALSIM_GetDriverStationDsAttached() ? HALSIMSHM_kDSAttached : 0);
+
+  int32_t numPWM = std::min(HAL_GetNumPWMChannels(), HALSIMSHM_MAX_PWM);
+  for (int32_t i = 0; i < numPWM; ++i) {
+    if (HALSIM_GetPWMInitialized(i)) {
+      outputs.pwmInitialized |= Bit(i);
+      outputs.pwmSpeed[i] = HALSIM_GetPWMSpeed(i);
+    }
+  }
+  int32_t numDIO = std::min(HAL_GetNumDigitalChannels(), HALSIMSHM_MAX_DIO);
+  for (int32_t i = 0; i < numDIO; ++i) {
+    if (HALSIM_GetDIOInitialized(i)) {
+      outputs.dioInitialized |= Bit(i);
+      outputs.dioIsInput |= HALSIM_GetDIOIsInput(i) ? Bit(i) : 0;
+      outputs.dioValue |= HALSIM_GetDIOValue(i) ? Bit(i) : 0;
+    }
+  }
+  int32_t numAnalogIn =
+      std::min(HAL_GetNumAnalogInputs(), HALSIMSHM_MAX_ANALOG_IN);
+  for (int32_t i = 0; i < numAnalogIn; ++i) {
+    if (HALSIM_GetAnalogInInitialized(i)) {
+      outputs.analogInInitialized |= Bit(i);
+    }
+  }
+  int32_t numEncoders = std::min(HAL_GetNumEncoders(), HALSIMSHM_MAX_ENCODERS);
+  for (int32_t i = 0; i < numEncoders; ++i) {
+    if (HALSIM_GetEncoderInitialized(i)) {
+      outputs.encoderInitialized |= Bit(i);
+      outputs.encoderChannelA[i] = HALSIM_GetEncoderDigitalChannelA(i);
+      outputs.encoderChannelB[i] = HALSIM_GetEncoderDigitalChannelB(i);
+    }
+  }
+  int32_t numRelays = std::min(HAL_GetNumRelayHeaders(), HALSIMSHM_MAX_RELAYS);
+  for (int32_t i = 0; i < numRelays; ++i) {
+    if (HALSIM_GetRelayInitializedForward(i)) {
+      outputs.relayInitializedForward |= Bit(i);
+      outputs.relayForward |= HALSIM_GetRelayForward(i) ? Bit(i) : 0;
+    }
+    if (HALSIM_GetRelayInitializedReverse(i)) {
+      outputs.relayInitializedReverse |= Bit(i);
+      outputs.relayReverse |= HALSIM_GetRelayReverse(i) ? Bit(i) : 0;
+    }
+  }
+
+  m_region->outputs.Write(outputs);
+
+  SendDeviceEvents(HALSIMSHM_kPWM, m_outputs.pwmInitialized,
+                   outputs.pwmInitialized);
+  SendDeviceEvents(HALSIMSHM_kDIO, m_outputs.dioInitialized,
+                   outputs.dioInitialized);
+  SendDeviceEvents(HALSIMSHM_kAnalogIn, m_outputs.analogInInitialized,
+                   outputs.analogInInitialized);
+  SendDeviceEvents(HALSIMSHM_kEncoder, m_outputs.encoderInitialized,
+                   outputs.encoderInitialized);
+  SendDeviceEvents(
+      HALSIMSHM_kRelay,
+      m_outputs.relayInitializedForward | m_outputs.relayInitializedReverse,
+      outputs.relayInitializedForward | outputs.relayInitializedReverse);
+  m_outputs = outputs;
+
+  m_region->tick.store(outputs.tick, std::memory_order_release);
+}
+
+void HALSimShm::SendDeviceEvents(HALSIMSHM_DeviceType type, uint32_t previous,
+                                 uint32_t current) {
+  uint32_t changed = previous ^ current;
+  for (int32_t i = 0; i < 32; ++i) {
+    if (changed & Bit(i)) {
+      HALSIMSHM_Event event{};
+      event.type = (current & Bit(i)) ? HALSIMSHM_kDeviceInitialized
+                                      : HALSIMSHM_kDeviceFreed;
+      event.index = i;
+      event.value = type;
+      // Dropped if the client isn't reading events
+      m_region->toClient.Push(event);
+    }
+  }
+}
@@ -0,0 +1,36 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+
+#include <hal/Extensions.h>
+
+#include "HALSimShm.h"
+
+using namespace halsimshm;
+
+static std::unique_ptr<HALSimShm> gShm;
+
+extern "C" {
+#if defined(WIN32) || defined(_WIN32)
+__declspec(dllexport)
+#endif
+    int HALSIM_InitExtension(void) {
+  std::puts("Shared Memory Sim Initializing.");
+
+  HAL_OnShutdown(nullptr, [](void*) { gShm.reset(); });
+
+  const char* name = std::getenv("HALSIMSHM_NAME");
+  gShm = std::make_unique<HALSimShm>();
+  if (!gShm->Initialize(name ? name : kDefaultName)) {
+    std::fputs("Error: could not create the sim shared memory.\n", stderr);
+    return -1;
+  }
+
+  std::puts("Shared Memory Sim Initialized!");
+  return 0;
+}
+}  // extern "C"
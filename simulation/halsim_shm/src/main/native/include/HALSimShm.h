@@ -0,0 +1,51 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <memory>
+#include <string_view>
+
+#include "HALSimShmClient.h"
+#include "ShmRegion.h"
+
+namespace halsimshm {
+
+/**
+ * Exchanges HAL device state with a client process through shared memory.
+ * Client inputs and commands are applied before each sim tick, and robot
+ * outputs are published after it.
+ */
+class HALSimShm {
+ public:
+  HALSimShm() = default;
+  HALSimShm(const HALSimShm&) = delete;
+  HALSimShm& operator=(const HALSimShm&) = delete;
+  ~HALSimShm();
+
+  /**
+   * Creates the shared memory and registers the sim periodic callbacks.
+   *
+   * @param name shared memory name
+   * @return false if the shared memory couldn't be created
+   */
+  bool Initialize(std::string_view name);
+
+ private:
+  void ApplyInputs();
+  void PublishOutputs();
+  void HandleEvent(const HALSIMSHM_Event& event);
+  void SendDeviceEvents(HALSIMSHM_DeviceType type, uint32_t previous,
+                        uint32_t current);
+
+  std::unique_ptr<SharedMemory> m_memory;
+  Region* m_region = nullptr;
+  HALSIMSHM_Outputs m_outputs{};
+  int32_t m_beforeCallback = 0;
+  int32_t m_afterCallback = 0;
+};
+
+}  // namespace halsimshm
@@ -0,0 +1,142 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <chrono>
+
+#include <hal/DIO.h>
+#include <hal/HALBase.h>
+#include <hal/PWM.h>
+#include <hal/simulation/DIOData.h>
+#include <hal/simulation/DriverStationData.h>
+#include <hal/simulation/PWMData.h>
+
+#include "HALSimShm.h"
+#include "HALSimShmClient.h"
+#include "gtest/gtest.h"
+
+using namespace halsimshm;
+
+TEST(HALSimShmTest, ExchangeOutputsAndInputs) {
+  HALSimShm shm;
+  ASSERT_TRUE(shm.Initialize("halsim_shm_test"));
+  HALSIMSHM_Client* client = HALSIMSHM_Connect("halsim_shm_test");
+  ASSERT_NE(nullptr, client);
+  EXPECT_TRUE(HALSIMSHM_IsConnected(client));
+
+  int32_t status = 0;
+  HAL_DigitalHandle pwm =
+      HAL_InitializePWMPort(HAL_GetPort(3), nullptr, &status);
+  HAL_DigitalHandle dio =
+      HAL_InitializeDIOPort(HAL_GetPort(5), true, nullptr, &status);
+  ASSERT_EQ(0, status);
+  HAL_SetPWMSpeed(pwm, 0.5, &status);
+  HALSIM_SetDIOValue(5, false);
+
+  // Robot outputs are published after each tick
+  HAL_SimPeriodicBefore();
+  HAL_SimPeriodicAfter();
+  EXPECT_EQ(1u, HALSIMSHM_WaitForTick(client, 0, 0));
+  HALSIMSHM_Outputs outputs;
+  ASSERT_TRUE(HALSIMSHM_ReadOutputs(client, &outputs));
+  EXPECT_EQ(1u, outputs.tick);
+  EXPECT_EQ(1u << 3, outputs.pwmInitialized);
+  EXPECT_EQ(0.5, outputs.pwmSpeed[3]);
+  EXPECT_EQ(1u << 5, outputs.dioInitialized & outputs.dioIsInput);
+
+  HALSIMSHM_Event event;
+  ASSERT_TRUE(HALSIMSHM_ReadEvent(client, &event));
+  EXPECT_EQ(HALSIMSHM_kDeviceInitialized, event.type);
+  EXPECT_EQ(HALSIMSHM_kPWM, event.value);
+  EXPECT_EQ(3, event.index);
+  ASSERT_TRUE(HALSIMSHM_ReadEvent(client, &event));
+  EXPECT_EQ(HALSIMSHM_kDIO, event.value);
+  EXPECT_EQ(5, event.index);
+  EXPECT_FALSE(HALSIMSHM_ReadEvent(client, &event));
+
+  // Client inputs and commands are applied before the next tick
+  HALSIMSHM_Inputs inputs{};
+  inputs.dioMask = 1u << 5;
+  inputs.dioValue = 1u << 5;
+  HALSIMSHM_WriteInputs(client, &inputs);
+  event = HALSIMSHM_Event{};
+  event.type = HALSIMSHM_kSetEnabled;
+  event.value = 1;
+  ASSERT_TRUE(HALSIMSHM_SendEvent(client, &event));
+  EXPECT_FALSE(HAL_GetDIO(dio, &status));
+
+  HAL_SimPeriodicBefore();
+  EXPECT_TRUE(HAL_GetDIO(dio, &status));
+  EXPECT_TRUE(HALSIM_GetDriverStationEnabled());
+  HAL_SimPeriodicAfter();
+
+  // Freed devices are reported too
+  HAL_FreePWMPort(pwm, &status);
+  HAL_FreeDIOPort(dio);
+  HAL_SimPeriodicBefore();
+  HAL_SimPeriodicAfter();
+  ASSERT_TRUE(HALSIMSHM_ReadEvent(client, &event));
+  EXPECT_EQ(HALSIMSHM_kDeviceFreed, event.type);
+  EXPECT_EQ(3, event.index);
+
+  HALSIMSHM_Disconnect(client);
+  HALSIM_ResetDriverStationData();
+  HALSIM_ResetPWMData(3);
+  HALSIM_ResetDIOData(5);
+}
+
+TEST(HALSimShmTest, ConnectWithoutRobot) {
+  EXPECT_EQ(nullptr, HALSIMSHM_Connect("halsim_shm_missing"));
+}
+
+TEST(HALSimShmTest, JoystickIndexOutOfRange) {
+  HALSimShm shm;
+  ASSERT_TRUE(shm.Initialize("halsim_shm_test"));
+  HALSIMSHM_Client* client = HALSIMSHM_Connect("halsim_shm_test");
+  ASSERT_NE(nullptr, client);
+
+  HALSIMSHM_Event event{};
+  event.type = HALSIMSHM_kSetJoystickAxes;
+  event.count = 1;
+  event.data.axes[0] = 0.5f;
+  for (int32_t index : {-1, HAL_kMaxJoysticks, 0}) {
+    event.index = index;
+    ASSERT_TRUE(HALSIMSHM_SendEvent(client, &event));
+  }
+  HAL_SimPeriodicBefore();
+  HAL_JoystickAxes axes;
+  HALSIM_GetJoystickAxes(0, &axes);
+  EXPECT_EQ(1, axes.count);
+  EXPECT_EQ(0.5f, axes.axes[0]);
+
+  HALSIMSHM_Disconnect(client);
+  HALSIM_ResetDriverStationData();
+}
+
+TEST(HALSimShmTest, NullClient) {
+  HALSIMSHM_Outputs outputs;
+  HALSIMSHM_Inputs inputs{};
+  HALSIMSHM_Event event{};
+  EXPECT_FALSE(HALSIMSHM_IsConnected(nullptr));
+  EXPECT_EQ(5u, HALSIMSHM_WaitForTick(nullptr, 5, 1.0));
+  EXPECT_FALSE(HALSIMSHM_ReadOutputs(nullptr, &outputs));
+  HALSIMSHM_WriteInputs(nullptr, &inputs);
+  EXPECT_FALSE(HALSIMSHM_SendEvent(nullptr, &event));
+  EXPECT_FALSE(HALSIMSHM_ReadEvent(nullptr, &event));
+  HALSIMSHM_Disconnect(nullptr);
+}
+
+TEST(HALSimShmTest, WaitForTickTimeout) {
+  HALSimShm shm;
+  ASSERT_TRUE(shm.Initialize("halsim_shm_test"));
+  HALSIMSHM_Client* client = HALSIMSHM_Connect("halsim_shm_test");
+  ASSERT_NE(nullptr, client);
+
+  auto start = std::chrono::steady_clock::now();
+  EXPECT_EQ(0u, HALSIMSHM_WaitForTick(client, 0, 0.05));
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  EXPECT_GE(elapsed, std::chrono::milliseconds{50});
+  EXPECT_LT(elapsed, std::chrono::seconds{1});
+
+  HALSIMSHM_Disconnect(client);
+}
@@ -0,0 +1,143 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <cstdio>
+
+#include "ShmRegion.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace halsimshm;
+
+#ifdef _WIN32
+
+std::unique_ptr<SharedMemory> SharedMemory::Create(std::string_view name,
+                                                   size_t size) {
+  char path[256];
+  std::snprintf(path, sizeof(path), "Local\\%.*s",
+                static_cast<int>(name.size()), name.data());
+  HANDLE handle = CreateFileMappingA(
+      INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+      static_cast<DWORD>(static_cast<uint64_t>(size) >> 32),
+      static_cast<DWORD>(size), path);
+  if (!handle) {
+    return nullptr;
+  }
+  // Like O_EXCL on other platforms, fail rather than share memory with another
+  // robot program. Unlike those, memory can't be removed while mapped, so this
+  // also fails while a client of a robot program that didn't exit cleanly
+  // still has it open.
+  if (GetLastError() == ERROR_ALREADY_EXISTS) {
+    CloseHandle(handle);
+    return nullptr;
+  }
+  void* data = MapViewOfFile(handle, FILE_MAP_ALL_ACCESS, 0, 0, size);
+  if (!data) {
+    CloseHandle(handle);
+    return nullptr;
+  }
+  std::unique_ptr<SharedMemory> memory{new SharedMemory};
+  memory->m_data = data;
+  memory->m_size = size;
+  memory->m_handle = handle;
+  return memory;
+}
+
+std::unique_ptr<SharedMemory> SharedMemory::Open(std::string_view name,
+                                                 size_t size) {
+  char path[256];
+  std::snprintf(path, sizeof(path), "Local\\%.*s",
+                static_cast<int>(name.size()), name.data());
+  HANDLE handle = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, path);
+  if (!handle) {
+    return nullptr;
+  }
+  void* data = MapViewOfFile(handle, FILE_MAP_ALL_ACCESS, 0, 0, size);
+  if (!data) {
+    CloseHandle(handle);
+    return nullptr;
+  }
+  std::unique_ptr<SharedMemory> memory{new SharedMemory};
+  memory->m_data = data;
+  memory->m_size = size;
+  memory->m_handle = handle;
+  return memory;
+}
+
+SharedMemory::~SharedMemory() {
+  UnmapViewOfFile(m_data);
+  CloseHandle(m_handle);
+}
+
+#else
+
+std::unique_ptr<SharedMemory> SharedMemory::Create(std::string_view name,
+                                                   size_t size) {
+  std::unique_ptr<SharedMemory> memory{new SharedMemory};
+  std::snprintf(memory->m_name, sizeof(memory->m_name), "/%.*s",
+                static_cast<int>(name.size()), name.data());
+  // Remove memory left over by a robot program that didn't exit cleanly, so
+  // clients still mapping it see it as disconnected
+  shm_unlink(memory->m_name);
+  int fd = shm_open(memory->m_name, O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd < 0) {
+    return nullptr;
+  }
+  if (ftruncate(fd, size) != 0) {
+    close(fd);
+    shm_unlink(memory->m_name);
+    return nullptr;
+  }
+  void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) {
+    shm_unlink(memory->m_name);
+    return nullptr;
+  }
+  memory->m_data = data;
+  memory->m_size = size;
+  memory->m_owner = true;
+  return memory;
+}
+
+std::unique_ptr<SharedMemory> SharedMemory::Open(std::string_view name,
+                                                 size_t size) {
+  std::unique_ptr<SharedMemory> memory{new SharedMemory};
+  std::snprintf(memory->m_name, sizeof(memory->m_name), "/%.*s",
+                static_cast<int>(name.size()), name.data());
+  int fd = shm_open(memory->m_name, O_RDWR, 0);
+  if (fd < 0) {
+    return nullptr;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < size) {
+    close(fd);
+    return nullptr;
+  }
+  void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) {
+    return nullptr;
+  }
+  memory->m_data = data;
+  memory->m_size = size;
+  return memory;
+}
+
+SharedMemory::~SharedMemory() {
+  munmap(m_data, m_size);
+  if (m_owner) {
+    shm_unlink(m_name);
+  }
+}
+
+#endif
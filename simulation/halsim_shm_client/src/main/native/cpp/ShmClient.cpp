@@ -0,0 +1,108 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <algorithm>
+#include <chrono>
+#include <new>
+#include <thread>
+
+#include "HALSimShmClient.h"
+#include "ShmRegion.h"
+
+using namespace halsimshm;
+
+struct HALSIMSHM_Client {
+  std::unique_ptr<SharedMemory> memory;
+  Region* region;
+};
+
+extern "C" {
+
+HALSIMSHM_Client* HALSIMSHM_Connect(const char* name) {
+  auto memory =
+      SharedMemory::Open(name ? name : kDefaultName, sizeof(Region));
+  if (!memory) {
+    return nullptr;
+  }
+  auto region = static_cast<Region*>(memory->GetData());
+  if (region->magic.load(std::memory_order_acquire) != kMagic ||
+      region->version != kVersion || region->size != sizeof(Region)) {
+    return nullptr;
+  }
+  return new (std::nothrow) HALSIMSHM_Client{std::move(memory), region};
+}
+
+void HALSIMSHM_Disconnect(HALSIMSHM_Client* client) {
+  delete client;
+}
+
+int HALSIMSHM_IsConnected(HALSIMSHM_Client* client) {
+  return client &&
+         client->region->magic.load(std::memory_order_acquire) == kMagic;
+}
+
+uint64_t HALSIMSHM_WaitForTick(HALSIMSHM_Client* client, uint64_t lastTick,
+                               double timeout) {
+  using Clock = std::chrono::steady_clock;
+  if (!client) {
+    return lastTick;
+  }
+  // Also catches NaN; a week is short enough to not overflow the clock
+  timeout = timeout > 0.0 ? std::min(timeout, 604800.0) : 0.0;
+  auto start = Clock::now();
+  auto end = start + std::chrono::duration_cast<Clock::duration>(
+                         std::chrono::duration<double>(timeout));
+  // Ticks of a fast-stepping robot may be only microseconds apart, so spin
+  // briefly before backing off to sleeps, which don't tie up a core while the
+  // robot is stalled or slow
+  auto spinEnd = start + std::chrono::microseconds{100};
+  Clock::duration sleep = std::chrono::microseconds{10};
+  while (true) {
+    uint64_t tick = client->region->tick.load(std::memory_order_acquire);
+    auto now = Clock::now();
+    if (tick != lastTick || !HALSIMSHM_IsConnected(client) || now >= end) {
+      return tick;
+    }
+    if (now < spinEnd) {
+      std::this_thread::yield();
+    } else {
+      std::this_thread::sleep_for(std::min(sleep, end - now));
+      sleep =
+          std::min<Clock::duration>(sleep * 2, std::chrono::milliseconds{1});
+    }
+  }
+}
+
+int HALSIMSHM_ReadOutputs(HALSIMSHM_Client* client,
+                          HALSIMSHM_Outputs* outputs) {
+  if (!client) {
+    return 0;
+  }
+  return client->region->outputs.Read(outputs);
+}
+
+void HALSIMSHM_WriteInputs(HALSIMSHM_Client* client,
+                           const HALSIMSHM_Inputs* inputs) {
+  if (!client) {
+    return;
+  }
+  client->region->inputs.Write(*inputs);
+}
+
+int HALSIMSHM_SendEvent(HALSIMSHM_Client* client,
+                        const HALSIMSHM_Event* event) {
+  if (!client) {
+    return 0;
+  }
+  return client->region->toRobot.Push(*event);
+}
+
+int HALSIMSHM_ReadEvent(HALSIMSHM_Client* client, HALSIMSHM_Event* event) {
+  if (!client) {
+    return 0;
+  }
+  return client->region->toClient.Pop(event);
+}
+
+}  // extern "C"
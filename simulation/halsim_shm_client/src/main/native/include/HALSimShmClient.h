@@ -0,0 +1,232 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @defgroup halsimshm_client Shared Memory Sim Client
+ * @{
+ *
+ * C API for processes exchanging robot outputs and sensor inputs with the
+ * halsim_shm extension through shared memory, e.g. a local physics engine
+ * stepping with the robot.
+ *
+ * Every function accepts a NULL client, e.g. from a failed HALSIMSHM_Connect(),
+ * and then does nothing and reports being disconnected.
+ */
+
+#define HALSIMSHM_MAX_PWM 20
+#define HALSIMSHM_MAX_DIO 32
+#define HALSIMSHM_MAX_ANALOG_IN 8
+#define HALSIMSHM_MAX_ENCODERS 8
+#define HALSIMSHM_MAX_RELAYS 8
+#define HALSIMSHM_MAX_JOYSTICK_AXES 12
+#define HALSIMSHM_MAX_JOYSTICK_POVS 12
+
+/** Bits of HALSIMSHM_Outputs::controlWord. */
+enum HALSIMSHM_ControlWordBits {
+  HALSIMSHM_kEnabled = 1,
+  HALSIMSHM_kAutonomous = 2,
+  HALSIMSHM_kTest = 4,
+  HALSIMSHM_kEStop = 8,
+  HALSIMSHM_kFMSAttached = 16,
+  HALSIMSHM_kDSAttached = 32
+};
+
+/**
+ * Robot outputs, published by the extension after every sim tick. Bit n of
+ * each mask is channel n.
+ */
+struct HALSIMSHM_Outputs {
+  /** Number of sim ticks published so far */
+  uint64_t tick;
+  /** FPGA time in microseconds */
+  uint64_t time;
+  /** HALSIMSHM_ControlWordBits */
+  uint32_t controlWord;
+  uint32_t pwmInitialized;
+  uint32_t dioInitialized;
+  uint32_t dioIsInput;
+  uint32_t dioValue;
+  uint32_t analogInInitialized;
+  uint32_t encoderInitialized;
+  uint32_t relayInitializedForward;
+  uint32_t relayInitializedReverse;
+  uint32_t relayForward;
+  uint32_t relayReverse;
+  /** Motor controller speeds, from -1 to 1 */
+  double pwmSpeed[HALSIMSHM_MAX_PWM];
+  /** Digital channels of the encoders, to map encoders to sensors */
+  int32_t encoderChannelA[HALSIMSHM_MAX_ENCODERS];
+  int32_t encoderChannelB[HALSIMSHM_MAX_ENCODERS];
+};
+
+/**
+ * Sensor inputs, written by the client and applied before every sim tick.
+ * Only channels with their bit set in the matching mask are applied, so the
+ * robot keeps control of the others.
+ */
+struct HALSIMSHM_Inputs {
+  uint32_t dioMask;
+  uint32_t dioValue;
+  uint32_t analogInMask;
+  uint32_t encoderMask;
+  /** Analog input voltages */
+  double analogInVoltage[HALSIMSHM_MAX_ANALOG_IN];
+  /** Encoder counts */
+  int32_t encoderCount[HALSIMSHM_MAX_ENCODERS];
+  /** Encoder periods in seconds */
+  double encoderPeriod[HALSIMSHM_MAX_ENCODERS];
+};
+
+/** Type of a HALSIMSHM_Event. */
+enum HALSIMSHM_EventType {
+  /* Client to robot, applied before the next sim tick */
+
+  /** Sets the enabled state to value */
+  HALSIMSHM_kSetEnabled = 1,
+  /** Sets the autonomous state to value */
+  HALSIMSHM_kSetAutonomous,
+  /** Sets the test state to value */
+  HALSIMSHM_kSetTest,
+  /** Sets the e-stop state to value */
+  HALSIMSHM_kSetEStop,
+  /** Sets the DS attached state to value */
+  HALSIMSHM_kSetDSAttached,
+  /**
+   * Sets count axes of joystick index from data.axes. Events for a joystick
+   * index out of range are ignored, as are the other joystick events.
+   */
+  HALSIMSHM_kSetJoystickAxes,
+  /** Sets count buttons of joystick index from the bits of value */
+  HALSIMSHM_kSetJoystickButtons,
+  /** Sets count POVs of joystick index from data.povs */
+  HALSIMSHM_kSetJoystickPOVs,
+  /** Notifies the robot that new DS data is available */
+  HALSIMSHM_kNotifyNewData,
+
+  /* Robot to client, sent after the sim tick that changed the device */
+
+  /** The device of HALSIMSHM_DeviceType value at channel index was
+      initialized */
+  HALSIMSHM_kDeviceInitialized = 100,
+  /** The device of HALSIMSHM_DeviceType value at channel index was freed */
+  HALSIMSHM_kDeviceFreed
+};
+
+/** Device types of HALSIMSHM_kDeviceInitialized and HALSIMSHM_kDeviceFreed. */
+enum HALSIMSHM_DeviceType {
+  HALSIMSHM_kPWM,
+  HALSIMSHM_kDIO,
+  HALSIMSHM_kAnalogIn,
+  HALSIMSHM_kEncoder,
+  HALSIMSHM_kRelay
+};
+
+/** A command or notification sent through one of the event queues. */
+struct HALSIMSHM_Event {
+  /** HALSIMSHM_EventType */
+  int32_t type;
+  int32_t index;
+  int32_t count;
+  int32_t value;
+  union {
+    float axes[HALSIMSHM_MAX_JOYSTICK_AXES];
+    int16_t povs[HALSIMSHM_MAX_JOYSTICK_POVS];
+  } data;
+};
+
+struct HALSIMSHM_Client;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Connects to the shared memory of a running robot program.
+ *
+ * @param name the HALSIMSHM_NAME of the robot program, or NULL for the default
+ * @return the client, or NULL if no robot program is running or it uses a
+ *         different version of the extension
+ */
+struct HALSIMSHM_Client* HALSIMSHM_Connect(const char* name);
+
+/**
+ * Disconnects from the shared memory.
+ *
+ * @param client the client
+ */
+void HALSIMSHM_Disconnect(struct HALSIMSHM_Client* client);
+
+/**
+ * Returns whether the robot program is still publishing; it stops when the
+ * robot program exits.
+ *
+ * @param client the client
+ * @return 1 if connected, 0 otherwise
+ */
+int HALSIMSHM_IsConnected(struct HALSIMSHM_Client* client);
+
+/**
+ * Waits until a sim tick after lastTick has been published. The wait spins
+ * briefly, as ticks of a fast-stepping robot may be microseconds apart, and
+ * then sleeps for increasing intervals of up to 1 ms.
+ *
+ * @param client the client
+ * @param lastTick the last tick seen, e.g. from HALSIMSHM_Outputs::tick
+ * @param timeout timeout in seconds; 0 to not wait
+ * @return the latest tick, which equals lastTick on timeout or if the client
+ *         is NULL
+ */
+uint64_t HALSIMSHM_WaitForTick(struct HALSIMSHM_Client* client,
+                               uint64_t lastTick, double timeout);
+
+/**
+ * Reads a consistent copy of the robot outputs of the latest sim tick.
+ *
+ * @param client the client
+ * @param outputs outputs (output parameter)
+ * @return 1 if read, 0 if the robot was publishing for too long
+ */
+int HALSIMSHM_ReadOutputs(struct HALSIMSHM_Client* client,
+                          struct HALSIMSHM_Outputs* outputs);
+
+/**
+ * Writes the sensor inputs applied before the next sim tick. Only one client
+ * may write inputs.
+ *
+ * @param client the client
+ * @param inputs inputs
+ */
+void HALSIMSHM_WriteInputs(struct HALSIMSHM_Client* client,
+                           const struct HALSIMSHM_Inputs* inputs);
+
+/**
+ * Sends a command to the robot, applied before the next sim tick. Only one
+ * client may send events.
+ *
+ * @param client the client
+ * @param event event
+ * @return 1 if sent, 0 if the queue is full
+ */
+int HALSIMSHM_SendEvent(struct HALSIMSHM_Client* client,
+                        const struct HALSIMSHM_Event* event);
+
+/**
+ * Reads the next notification from the robot. The robot drops notifications
+ * while the queue is full.
+ *
+ * @param client the client
+ * @param event event (output parameter)
+ * @return 1 if read, 0 if there are none
+ */
+int HALSIMSHM_ReadEvent(struct HALSIMSHM_Client* client,
+                        struct HALSIMSHM_Event* event);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+/** @} */
@@ -0,0 +1,161 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+
+#include "HALSimShmClient.h"
+
+namespace halsimshm {
+
+/**
+ * A value with a single writer and any number of readers. Readers copy the
+ * value and retry if the writer changed it meanwhile, so neither side ever
+ * blocks, even if the other process dies mid-update.
+ */
+template <typename T>
+struct SeqLocked {
+  static_assert(std::is_trivially_copyable_v<T>);
+
+  // Odd while the writer is updating value
+  std::atomic<uint32_t> sequence;
+  T value;
+
+  void Write(const T& newValue) {
+    uint32_t seq = sequence.load(std::memory_order_relaxed);
+    sequence.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(&value, &newValue, sizeof(T));
+    sequence.store(seq + 2, std::memory_order_release);
+  }
+
+  // Returns false if the writer was updating the value for all attempts
+  bool Read(T* out, int attempts = 1000) const {
+    for (int i = 0; i < attempts; ++i) {
+      uint32_t seq = sequence.load(std::memory_order_acquire);
+      if ((seq & 1) != 0) {
+        continue;
+      }
+      std::memcpy(out, &value, sizeof(T));
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (sequence.load(std::memory_order_relaxed) == seq) {
+        return true;
+      }
+    }
+    return false;
+  }
+};
+
+/**
+ * A queue with a single producer and a single consumer.
+ */
+template <typename T, uint32_t Size>
+struct EventQueue {
+  static_assert((Size & (Size - 1)) == 0, "Size must be a power of two");
+  static_assert(std::is_trivially_copyable_v<T>);
+
+  std::atomic<uint32_t> head;  // next write
+  std::atomic<uint32_t> tail;  // next read
+  T events[Size];
+
+  // Returns false if the queue is full
+  bool Push(const T& event) {
+    uint32_t h = head.load(std::memory_order_relaxed);
+    if (h - tail.load(std::memory_order_acquire) == Size) {
+      return false;
+    }
+    events[h % Size] = event;
+    head.store(h + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Returns false if the queue is empty
+  bool Pop(T* event) {
+    uint32_t t = tail.load(std::memory_order_relaxed);
+    if (t == head.load(std::memory_order_acquire)) {
+      return false;
+    }
+    *event = events[t % Size];
+    tail.store(t + 1, std::memory_order_release);
+    return true;
+  }
+};
+
+inline constexpr uint32_t kMagic = 0x4d485348;  // "HSHM"
+inline constexpr uint32_t kVersion = 1;
+inline constexpr uint32_t kQueueSize = 256;
+inline constexpr std::string_view kDefaultName = "halsim";
+
+/**
+ * The layout of the shared memory. The extension zeroes it and sets magic
+ * last, and clears magic again when the robot program exits.
+ */
+struct Region {
+  std::atomic<uint32_t> magic;
+  uint32_t version;
+  uint32_t size;
+  std::atomic<uint64_t> tick;
+  SeqLocked<HALSIMSHM_Outputs> outputs;
+  SeqLocked<HALSIMSHM_Inputs> inputs;
+  EventQueue<HALSIMSHM_Event, kQueueSize> toRobot;
+  EventQueue<HALSIMSHM_Event, kQueueSize> toClient;
+};
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free &&
+                  std::atomic<uint64_t>::is_always_lock_free,
+              "shared memory atomics must be lock free");
+static_assert(std::is_standard_layout_v<Region>);
+
+/**
+ * A named shared memory mapping.
+ */
+class SharedMemory {
+ public:
+  /**
+   * Creates the shared memory, replacing any left over from a previous run.
+   *
+   * @param name name without any platform prefix
+   * @param size size in bytes
+   * @return the mapping, or nullptr on failure
+   */
+  static std::unique_ptr<SharedMemory> Create(std::string_view name,
+                                              size_t size);
+
+  /**
+   * Opens existing shared memory.
+   *
+   * @param name name without any platform prefix
+   * @param size size in bytes
+   * @return the mapping, or nullptr if it doesn't exist or is too small
+   */
+  static std::unique_ptr<SharedMemory> Open(std::string_view name,
+                                            size_t size);
+
+  SharedMemory(const SharedMemory&) = delete;
+  SharedMemory& operator=(const SharedMemory&) = delete;
+  ~SharedMemory();
+
+  void* GetData() const { return m_data; }
+
+ private:
+  SharedMemory() = default;
+
+  void* m_data = nullptr;
+  size_t m_size = 0;
+#ifdef _WIN32
+  void* m_handle = nullptr;
+#else
+  bool m_owner = false;
+  char m_name[256] = {};
+#endif
+};
+
+}  // namespace halsimshm
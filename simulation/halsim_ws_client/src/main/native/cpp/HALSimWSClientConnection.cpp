@@ -75,10 +75,7 @@ void HALSimWSClientConnection::OnSimValueChanged(const wpi::json& msg) {
     return;
   }
   wpi::SmallVector<uv::Buffer, 4> sendBufs;
-  wpi::raw_uv_ostream os{sendBufs, [this]() -> uv::Buffer {
-                           std::lock_guard lock(m_buffers_mutex);
-                           return m_buffers.Allocate();
-                         }};
+  wpi::raw_uv_ostream os{sendBufs, 128};
 
   os << msg;
 
@@ -86,9 +83,8 @@ void HALSimWSClientConnection::OnSimValueChanged(const wpi::json& msg) {
   m_client->GetExec().Send([self = shared_from_this(), sendBufs] {
     self->m_websocket->SendText(sendBufs,
                                 [self](auto bufs, wpi::uv::Error err) {
-                                  {
-                                    std::lock_guard lock(self->m_buffers_mutex);
-                                    self->m_buffers.Release(bufs);
+                                  for (auto&& buf : bufs) {
+                                    buf.Deallocate();
                                   }
 
                                   if (err) {
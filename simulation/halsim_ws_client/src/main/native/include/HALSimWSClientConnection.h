@@ -9,7 +9,6 @@
 
 #include <HALSimBaseWebSocketConnection.h>
 #include <wpi/WebSocket.h>
-#include <wpi/mutex.h>
 #include <wpi/uv/Buffer.h>
 #include <wpi/uv/Stream.h>
 
@@ -30,8 +29,7 @@ class HALSimWSClientConnection
   explicit HALSimWSClientConnection(std::shared_ptr<HALSimWS> client,
                                     std::shared_ptr<wpi::uv::Stream> stream)
       : m_client(std::move(client)),
-        m_stream(std::move(stream)),
-        m_buffers(128) {}
+        m_stream(std::move(stream)) {}
 
  public:
   void OnSimValueChanged(const wpi::json& msg) override;
@@ -43,9 +41,6 @@ class HALSimWSClientConnection
 
   bool m_ws_connected = false;
   wpi::WebSocket* m_websocket = nullptr;
-
-  wpi::uv::SimpleBufferPool<4> m_buffers;
-  std::mutex m_buffers_mutex;
 };
 
 }  // namespace wpilibws
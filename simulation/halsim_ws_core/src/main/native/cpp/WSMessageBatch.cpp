@@ -0,0 +1,81 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "WSMessageBatch.h"
+
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include <wpi/SmallString.h>
+#include <wpi/raw_ostream.h>
+
+namespace wpilibws {
+
+std::optional<WSEncoding> GetBatchEncoding(std::string_view protocol) {
+  if (protocol == kBatchJsonProtocol) {
+    return WSEncoding::kJson;
+  } else if (protocol == kBatchCborProtocol) {
+    return WSEncoding::kCbor;
+  } else if (protocol == kBatchMsgPackProtocol) {
+    return WSEncoding::kMsgPack;
+  }
+  return std::nullopt;
+}
+
+void EncodeMessage(wpi::raw_ostream& os, const wpi::json& msg,
+                   WSEncoding encoding) {
+  switch (encoding) {
+    case WSEncoding::kCbor:
+      wpi::json::to_cbor(os, msg);
+      break;
+    case WSEncoding::kMsgPack:
+      wpi::json::to_msgpack(os, msg);
+      break;
+    default:
+      msg.dump(os);
+      break;
+  }
+}
+
+wpi::json DecodeMessage(wpi::span<const uint8_t> data, WSEncoding encoding) {
+  switch (encoding) {
+    case WSEncoding::kCbor:
+      return wpi::json::from_cbor(data);
+    case WSEncoding::kMsgPack:
+      return wpi::json::from_msgpack(data);
+    default:
+      return wpi::json::parse(std::string_view{
+          reinterpret_cast<const char*>(data.data()), data.size()});
+  }
+}
+
+bool WSMessageBatch::Add(const wpi::json& msg) {
+  auto& type = msg.at("type").get_ref<const std::string&>();
+  auto& device = msg.at("device").get_ref<const std::string&>();
+  wpi::SmallString<64> key;
+  key.append(type);
+  key.append("/");
+  key.append(device);
+
+  std::scoped_lock lock(m_mutex);
+  bool first = m_messages.empty();
+  auto [it, inserted] = m_indices.try_emplace(key.str(), m_messages.size());
+  if (inserted) {
+    m_messages.push_back(msg);
+  } else {
+    m_messages[it->second]["data"].update(msg.at("data"));
+  }
+  return first;
+}
+
+wpi::json WSMessageBatch::Take() {
+  wpi::json messages = wpi::json::array();
+  std::scoped_lock lock(m_mutex);
+  std::swap(messages, m_messages);
+  m_indices.clear();
+  return messages;
+}
+
+}  // namespace wpilibws
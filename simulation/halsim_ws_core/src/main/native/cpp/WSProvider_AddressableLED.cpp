@@ -43,15 +43,30 @@ void HALSimWSProviderAddressableLED::RegisterCallbacks() {
         const HAL_AddressableLEDData* data =
             reinterpret_cast<const HAL_AddressableLEDData*>(buffer);
 
-        std::vector<wpi::json> jsonData;
-
-        for (size_t i = 0; i < numLeds; ++i) {
-          jsonData.push_back(
-              {{"r", data[i].r}, {"g", data[i].g}, {"b", data[i].b}});
+        auto ws = provider->m_ws.lock();
+        if (!ws) {
+          return;
         }
 
         wpi::json payload;
-        payload[">data"] = jsonData;
+        if (ws->UseRawBuffers()) {
+          // r, g, b bytes of each LED
+          std::vector<uint8_t> bytes;
+          bytes.reserve(numLeds * 3);
+          for (size_t i = 0; i < numLeds; ++i) {
+            bytes.insert(bytes.end(), {data[i].r, data[i].g, data[i].b});
+          }
+          payload[">data"] = bytes;
+        } else {
+          std::vector<wpi::json> jsonData;
+
+          for (size_t i = 0; i < numLeds; ++i) {
+            jsonData.push_back(
+                {{"r", data[i].r}, {"g", data[i].g}, {"b", data[i].b}});
+          }
+
+          payload[">data"] = jsonData;
+        }
 
         provider->ProcessHalCallback(payload);
       },
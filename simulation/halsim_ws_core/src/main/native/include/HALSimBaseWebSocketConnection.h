@@ -14,6 +14,10 @@ class HALSimBaseWebSocketConnection {
  public:
   virtual void OnSimValueChanged(const wpi::json& msg) = 0;
 
+  // Whether the peer wants bulk data like LED buffers as flat arrays of bytes
+  // instead of arrays of objects
+  virtual bool UseRawBuffers() const { return false; }
+
  protected:
   virtual ~HALSimBaseWebSocketConnection() = default;
 };
@@ -0,0 +1,63 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <optional>
+#include <string_view>
+
+#include <wpi/StringMap.h>
+#include <wpi/json.h>
+#include <wpi/mutex.h>
+#include <wpi/span.h>
+
+namespace wpi {
+class raw_ostream;
+}  // namespace wpi
+
+namespace wpilibws {
+
+// Encodings of the batched protocol
+enum class WSEncoding { kJson, kCbor, kMsgPack };
+
+// WebSocket subprotocols a peer can request to get all of the changes of a sim
+// tick as a single array of messages, in the given encoding. Peers that don't
+// request one of these get one JSON text message per change.
+inline constexpr std::string_view kBatchJsonProtocol = "wpilibws.batch.json";
+inline constexpr std::string_view kBatchCborProtocol = "wpilibws.batch.cbor";
+inline constexpr std::string_view kBatchMsgPackProtocol =
+    "wpilibws.batch.msgpack";
+
+// Returns the encoding of a batched protocol, or nullopt for any other
+// protocol
+std::optional<WSEncoding> GetBatchEncoding(std::string_view protocol);
+
+// Encodes a message as JSON text or as a CBOR or MessagePack binary message
+void EncodeMessage(wpi::raw_ostream& os, const wpi::json& msg,
+                   WSEncoding encoding);
+
+// Decodes a CBOR or MessagePack binary message; throws wpi::json::exception
+wpi::json DecodeMessage(wpi::span<const uint8_t> data, WSEncoding encoding);
+
+// Collects the messages of one sim tick. Messages for the same device are
+// merged, so only the last value of each data key is sent.
+class WSMessageBatch {
+ public:
+  // callable from any thread; returns true if this started a new batch
+  bool Add(const wpi::json& msg);
+
+  // Returns the collected messages as an array and starts a new batch; the
+  // array is empty if nothing changed
+  wpi::json Take();
+
+ private:
+  wpi::mutex m_mutex;
+  wpi::json m_messages = wpi::json::array();
+  // index in m_messages of each type/device
+  wpi::StringMap<size_t> m_indices;
+};
+
+}  // namespace wpilibws
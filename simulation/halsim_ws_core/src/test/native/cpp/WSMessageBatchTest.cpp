@@ -0,0 +1,73 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <string>
+#include <vector>
+
+#include <wpi/SmallString.h>
+#include <wpi/raw_ostream.h>
+
+#include "WSMessageBatch.h"
+#include "gtest/gtest.h"
+
+namespace wpilibws {
+
+TEST(WSMessageBatchTest, GetBatchEncoding) {
+  EXPECT_EQ(WSEncoding::kJson, GetBatchEncoding("wpilibws.batch.json"));
+  EXPECT_EQ(WSEncoding::kCbor, GetBatchEncoding("wpilibws.batch.cbor"));
+  EXPECT_EQ(WSEncoding::kMsgPack, GetBatchEncoding("wpilibws.batch.msgpack"));
+  EXPECT_FALSE(GetBatchEncoding(""));
+  EXPECT_FALSE(GetBatchEncoding("wpilibws"));
+}
+
+TEST(WSMessageBatchTest, MergesDevices) {
+  WSMessageBatch batch;
+  EXPECT_TRUE(batch.Add(
+      {{"type", "PWM"}, {"device", "0"}, {"data", {{"<speed", 0.5}}}}));
+  EXPECT_FALSE(batch.Add(
+      {{"type", "DIO"}, {"device", "0"}, {"data", {{"<>value", true}}}}));
+  batch.Add({{"type", "PWM"},
+             {"device", "0"},
+             {"data", {{"<speed", 1.0}, {"<position", 0.25}}}});
+  batch.Add({{"type", "PWM"}, {"device", "1"}, {"data", {{"<speed", 0.0}}}});
+
+  wpi::json expected = {
+      {{"type", "PWM"},
+       {"device", "0"},
+       {"data", {{"<speed", 1.0}, {"<position", 0.25}}}},
+      {{"type", "DIO"}, {"device", "0"}, {"data", {{"<>value", true}}}},
+      {{"type", "PWM"}, {"device", "1"}, {"data", {{"<speed", 0.0}}}}};
+  EXPECT_EQ(expected, batch.Take());
+
+  // the next tick starts empty
+  EXPECT_TRUE(batch.Take().empty());
+  EXPECT_TRUE(batch.Add(
+      {{"type", "PWM"}, {"device", "0"}, {"data", {{"<speed", 0.5}}}}));
+  EXPECT_EQ(1u, batch.Take().size());
+}
+
+TEST(WSMessageBatchTest, EncodeDecode) {
+  wpi::json msgs = {{{"type", "AddressableLED"},
+                     {"device", "0"},
+                     {"data", {{">data", std::vector<uint8_t>{255, 0, 16}}}}}};
+
+  for (auto encoding : {WSEncoding::kCbor, WSEncoding::kMsgPack}) {
+    wpi::SmallString<128> buf;
+    wpi::raw_svector_ostream os{buf};
+    EncodeMessage(os, msgs, encoding);
+    // smaller than the JSON text
+    EXPECT_LT(buf.size(), msgs.dump().size());
+    EXPECT_EQ(msgs, DecodeMessage(
+                        {reinterpret_cast<const uint8_t*>(buf.data()),
+                         buf.size()},
+                        encoding));
+  }
+
+  wpi::SmallString<128> buf;
+  wpi::raw_svector_ostream os{buf};
+  EncodeMessage(os, msgs, WSEncoding::kJson);
+  EXPECT_EQ(msgs.dump(), buf.str());
+}
+
+}  // namespace wpilibws
@@ -7,14 +7,15 @@
 #include <uv.h>
 
 #include <string_view>
+#include <utility>
 
 #include <fmt/format.h>
+#include <hal/simulation/MockHooks.h>
 #include <wpi/MimeTypes.h>
 #include <wpi/SmallVector.h>
 #include <wpi/StringExtras.h>
 #include <wpi/UrlParser.h>
 #include <wpi/fs.h>
-#include <wpi/raw_istream.h>
 #include <wpi/raw_uv_ostream.h>
 #include <wpi/uv/Request.h>
 
@@ -22,6 +23,8 @@ namespace uv = wpi::uv;
 
 using namespace wpilibws;
 
+static constexpr uv::Timer::Time kBatchFlushDelay{20};
+
 bool HALSimHttpConnection::IsValidWsUpgrade(std::string_view protocol) {
   if (m_request.GetUrl() != m_server->GetServerUri()) {
     MySendError(404, "invalid websocket address");
@@ -31,7 +34,18 @@ bool HALSimHttpConnection::IsValidWsUpgrade(std::string_view protocol) {
   return true;
 }
 
+HALSimHttpConnection::~HALSimHttpConnection() {
+  if (m_simPeriodicCbKey != 0) {
+    HALSIM_CancelSimPeriodicAfterCallback(m_simPeriodicCbKey);
+  }
+  if (m_flushTimer) {
+    m_flushTimer->Close();
+  }
+}
+
 void HALSimHttpConnection::ProcessWsUpgrade() {
+  m_encoding = GetBatchEncoding(m_websocket->GetProtocol());
+
   m_websocket->open.connect_extended([this](auto conn, auto) {
     conn.disconnect();  // one-shot
 
@@ -44,6 +58,21 @@ void HALSimHttpConnection::ProcessWsUpgrade() {
     Log(200);
     m_isWsConnected = true;
     std::fputs("HALWebSim: websocket connected\n", stderr);
+
+    // send the changes of each sim tick once the robot loop is done with it
+    if (m_encoding) {
+      m_simPeriodicCbKey = HALSIM_RegisterSimPeriodicAfterCallback(
+          [](void* param) {
+            static_cast<HALSimHttpConnection*>(param)->SendBatch();
+          },
+          this);
+      m_flushTimer = uv::Timer::Create(m_server->GetLoop());
+      m_flushTimer->timeout.connect([weak = weak_from_this()] {
+        if (auto self = weak.lock()) {
+          self->SendBatch();
+        }
+      });
+    }
   });
 
   // parse incoming JSON, dispatch to parent
@@ -64,89 +93,111 @@ void HALSimHttpConnection::ProcessWsUpgrade() {
     m_server->OnNetValueChanged(j);
   });
 
+  // binary messages are only used by the CBOR and MessagePack protocols
+  m_websocket->binary.connect([this](auto data, bool) {
+    if (!m_isWsConnected || !m_encoding ||
+        *m_encoding == WSEncoding::kJson) {
+      return;
+    }
+
+    wpi::json j;
+    try {
+      j = DecodeMessage(data, *m_encoding);
+    } catch (const wpi::json::exception& e) {
+      std::string err("Message decode failed: ");
+      err += e.what();
+      m_websocket->Fail(400, err);
+      return;
+    }
+    m_server->OnNetValueChanged(j);
+  });
+
   m_websocket->closed.connect([this](uint16_t, auto) {
     // unset the global, allow another websocket to connect
     if (m_isWsConnected) {
       std::fputs("HALWebSim: websocket disconnected\n", stderr);
       m_isWsConnected = false;
 
+      if (m_simPeriodicCbKey != 0) {
+        HALSIM_CancelSimPeriodicAfterCallback(m_simPeriodicCbKey);
+        m_simPeriodicCbKey = 0;
+      }
+      if (m_flushTimer) {
+        m_flushTimer->Close();
+        m_flushTimer.reset();
+      }
+
       m_server->CloseWebsocket(shared_from_this());
     }
   });
 }
 
 void HALSimHttpConnection::OnSimValueChanged(const wpi::json& msg) {
+  if (m_encoding) {
+    if (m_batch.Add(msg)) {
+      // arm the fallback flush on the uv loop
+      auto self = weak_from_this().lock();
+      if (self) {
+        m_server->GetExec().Send([self] {
+          if (self->m_flushTimer && !self->m_flushTimer->IsActive()) {
+            self->m_flushTimer->Start(kBatchFlushDelay);
+          }
+        });
+      }
+    }
+    return;
+  }
+
   // render json to buffers
   wpi::SmallVector<uv::Buffer, 4> sendBufs;
-  wpi::raw_uv_ostream os{sendBufs, [this]() -> uv::Buffer {
-                           std::lock_guard lock(m_buffers_mutex);
-                           return m_buffers.Allocate();
-                         }};
+  wpi::raw_uv_ostream os{sendBufs, 128};
   os << msg;
 
-  // call the websocket send function on the uv loop
-  m_server->GetExec().Send([self = shared_from_this(), sendBufs] {
-    self->m_websocket->SendText(sendBufs,
-                                [self](auto bufs, wpi::uv::Error err) {
-                                  {
-                                    std::lock_guard lock(self->m_buffers_mutex);
-                                    self->m_buffers.Release(bufs);
-                                  }
-
-                                  if (err) {
-                                    fmt::print(stderr, "{}\n", err.str());
-                                    std::fflush(stderr);
-                                  }
-                                });
-  });
+  Send(std::move(sendBufs), false);
 }
 
-void HALSimHttpConnection::SendFileResponse(int code, std::string_view codeText,
-                                            std::string_view contentType,
-                                            std::string_view filename,
-                                            std::string_view extraHeader) {
-  std::error_code ec;
-
-  // get file size
-  auto size = fs::file_size(filename, ec);
-  if (ec) {
-    MySendError(404, "error getting file size");
-    return;
-  }
-
-  // open file
-  wpi::raw_fd_istream is{filename, ec, true};
-  if (ec) {
-    MySendError(404, "error opening file");
+void HALSimHttpConnection::SendBatch() {
+  wpi::json msgs = m_batch.Take();
+  if (msgs.empty()) {
     return;
   }
 
-  wpi::SmallVector<uv::Buffer, 4> toSend;
-  wpi::raw_uv_ostream os{toSend, 4096};
-  BuildHeader(os, code, codeText, contentType, size, extraHeader);
-  SendData(os.bufs(), false);
-
-  Log(code);
-
-  // Read the file byte by byte
-  wpi::SmallVector<uv::Buffer, 4> bodyData;
-  wpi::raw_uv_ostream bodyOs{bodyData, 4096};
+  wpi::SmallVector<uv::Buffer, 4> sendBufs;
+  wpi::raw_uv_ostream os{sendBufs, 1024};
+  EncodeMessage(os, msgs, *m_encoding);
 
-  std::string fileBuf;
-  size_t oldSize = 0;
+  Send(std::move(sendBufs), *m_encoding != WSEncoding::kJson);
+}
 
-  while (fileBuf.size() < size) {
-    oldSize = fileBuf.size();
-    fileBuf.resize(oldSize + 1);
-    is.read(&(*fileBuf.begin()) + oldSize, 1);
+void HALSimHttpConnection::Send(wpi::SmallVector<uv::Buffer, 4> bufs,
+                                bool binary) {
+  // the connection may be going away if this is called from a sim tick
+  auto self = weak_from_this().lock();
+  if (!self) {
+    for (auto&& buf : bufs) {
+      buf.Deallocate();
+    }
+    return;
   }
 
-  bodyOs << fileBuf;
-
-  SendData(bodyOs.bufs(), false);
-  if (!m_keepAlive) {
-    m_stream.Close();
-  }
+  // call the websocket send function on the uv loop
+  m_server->GetExec().Send([self, sendBufs = std::move(bufs), binary] {
+    auto callback = [self](auto bufs, wpi::uv::Error err) {
+      for (auto&& buf : bufs) {
+        buf.Deallocate();
+      }
+
+      if (err) {
+        fmt::print(stderr, "{}\n", err.str());
+        std::fflush(stderr);
+      }
+    };
+    if (binary) {
+      self->m_websocket->SendBinary(sendBufs, callback);
+    } else {
+      self->m_websocket->SendText(sendBufs, callback);
+    }
+  });
 }
 
 void HALSimHttpConnection::ProcessRequest() {
@@ -192,8 +243,18 @@ void HALSimHttpConnection::ProcessRequest() {
   }
 }
 
-void HALSimHttpConnection::MySendError(int code, std::string_view message) {
+void HALSimHttpConnection::BuildHeader(wpi::raw_ostream& os, int code,
+                                       std::string_view codeText,
+                                       std::string_view contentType,
+                                       uint64_t contentLength,
+                                       std::string_view extra) {
+  // log the status that is actually sent (e.g. 304 or 404 for a file)
   Log(code);
+  wpi::HttpServerConnection::BuildHeader(os, code, codeText, contentType,
+                                         contentLength, extra);
+}
+
+void HALSimHttpConnection::MySendError(int code, std::string_view message) {
   SendError(code, message);
 }
 
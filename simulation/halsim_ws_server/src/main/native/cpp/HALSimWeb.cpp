@@ -135,6 +135,14 @@ void HALSimWeb::CloseWebsocket(
 }
 
 void HALSimWeb::OnNetValueChanged(const wpi::json& msg) {
+  // batched protocols send arrays of messages
+  if (msg.is_array()) {
+    for (auto&& m : msg) {
+      OnNetValueChanged(m);
+    }
+    return;
+  }
+
   // Look for "type" and "device" fields so that we can
   // generate the key
 
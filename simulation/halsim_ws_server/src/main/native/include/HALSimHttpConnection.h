@@ -6,14 +6,17 @@
 
 #include <cinttypes>
 #include <memory>
+#include <optional>
 #include <string_view>
 #include <utility>
 
 #include <HALSimBaseWebSocketConnection.h>
+#include <WSMessageBatch.h>
+#include <wpi/SmallVector.h>
 #include <wpi/HttpWebSocketServerConnection.h>
-#include <wpi/mutex.h>
 #include <wpi/uv/AsyncFunction.h>
 #include <wpi/uv/Buffer.h>
+#include <wpi/uv/Timer.h>
 
 #include "HALSimWeb.h"
 
@@ -29,34 +32,46 @@ class HALSimHttpConnection
  public:
   HALSimHttpConnection(std::shared_ptr<HALSimWeb> server,
                        std::shared_ptr<wpi::uv::Stream> stream)
-      : wpi::HttpWebSocketServerConnection<HALSimHttpConnection>(stream, {}),
-        m_server(std::move(server)),
-        m_buffers(128) {}
+      : wpi::HttpWebSocketServerConnection<HALSimHttpConnection>(
+            stream, {kBatchJsonProtocol, kBatchCborProtocol,
+                     kBatchMsgPackProtocol}),
+        m_server(std::move(server)) {}
+  ~HALSimHttpConnection() override;
 
  public:
   // callable from any thread
   void OnSimValueChanged(const wpi::json& msg) override;
+  bool UseRawBuffers() const override { return m_encoding.has_value(); }
 
  protected:
   void ProcessRequest() override;
   bool IsValidWsUpgrade(std::string_view protocol) override;
   void ProcessWsUpgrade() override;
-  void SendFileResponse(int code, std::string_view codeText,
-                        std::string_view contentType, std::string_view filename,
-                        std::string_view extraHeader = {});
+  void BuildHeader(wpi::raw_ostream& os, int code, std::string_view codeText,
+                   std::string_view contentType, uint64_t contentLength,
+                   std::string_view extra = {}) override;
 
   void MySendError(int code, std::string_view message);
   void Log(int code);
 
  private:
+  // sends the messages batched since the last sim tick
+  void SendBatch();
+  void Send(wpi::SmallVector<wpi::uv::Buffer, 4> bufs, bool binary);
+
   std::shared_ptr<HALSimWeb> m_server;
 
   // is the websocket connected?
   bool m_isWsConnected = false;
 
-  // these are only valid if the websocket is connected
-  wpi::uv::SimpleBufferPool<4> m_buffers;
-  std::mutex m_buffers_mutex;
+  // encoding of the batched protocol, or nullopt to send each change as its
+  // own JSON message
+  std::optional<WSEncoding> m_encoding;
+  WSMessageBatch m_batch;
+  int32_t m_simPeriodicCbKey = 0;
+  // sends the batch if no sim tick does so soon after a change, e.g. when the
+  // sim is paused or the change is made outside of the robot loop
+  std::shared_ptr<wpi::uv::Timer> m_flushTimer;
 };
 
 }  // namespace wpilibws
@@ -14,8 +14,9 @@
 #include <hal/HALBase.h>
 #include <networktables/NTSendableBuilder.h>
 #include <networktables/NetworkTableEntry.h>
-#include <wpi/DenseMap.h>
+#include <wpi/FlatHashMap.h>
 #include <wpi/SmallVector.h>
+#include <wpi/Trace.h>
 #include <wpi/sendable/SendableRegistry.h>
 
 #include "frc2/command/CommandGroupBase.h"
@@ -28,15 +29,15 @@ class CommandScheduler::Impl {
  public:
   // A map from commands to their scheduling state.  Also used as a set of the
   // currently-running commands.
-  wpi::DenseMap<Command*, CommandState> scheduledCommands;
+  wpi::FlatHashMap<Command*, CommandState> scheduledCommands;
 
   // A map from required subsystems to their requiring commands.  Also used as a
   // set of the currently-required subsystems.
-  wpi::DenseMap<Subsystem*, Command*> requirements;
+  wpi::FlatHashMap<Subsystem*, Command*> requirements;
 
   // A map from subsystems registered with the scheduler to their default
   // commands.  Also used as a list of currently-registered subsystems.
-  wpi::DenseMap<Subsystem*, std::unique_ptr<Command>> subsystems;
+  wpi::FlatHashMap<Subsystem*, std::unique_ptr<Command>> subsystems;
 
   // The set of currently-registered buttons that will be polled every
   // iteration.
@@ -55,7 +56,7 @@ class CommandScheduler::Impl {
   // scheduled/canceled during run
 
   bool inRunLoop = false;
-  wpi::DenseMap<Command*, bool> toSchedule;
+  wpi::FlatHashMap<Command*, bool> toSchedule;
   wpi::SmallVector<Command*, 4> toCancel;
 };
 
@@ -189,13 +190,15 @@ void CommandScheduler::Run() {
     return;
   }
 
+  WPI_TRACE_SCOPE("CommandScheduler::Run");
+
   m_watchdog.Reset();
 
   // Run the periodic method of all registered subsystems.
   for (auto&& subsystem : m_impl->subsystems) {
-    subsystem.getFirst()->Periodic();
+    subsystem.first->Periodic();
     if constexpr (frc::RobotBase::IsSimulation()) {
-      subsystem.getFirst()->SimulationPeriodic();
+      subsystem.first->SimulationPeriodic();
     }
     m_watchdog.AddEpoch("Subsystem Periodic()");
   }
@@ -210,7 +213,7 @@ void CommandScheduler::Run() {
   // Run scheduled commands, remove finished commands.
   for (auto iterator = m_impl->scheduledCommands.begin();
        iterator != m_impl->scheduledCommands.end(); iterator++) {
-    Command* command = iterator->getFirst();
+    Command* command = iterator->first;
 
     if (!command->RunsWhenDisabled() && frc::RobotState::IsDisabled()) {
       Cancel(command);
@@ -252,9 +255,9 @@ void CommandScheduler::Run() {
 
   // Add default commands for un-required registered subsystems.
   for (auto&& subsystem : m_impl->subsystems) {
-    auto s = m_impl->requirements.find(subsystem.getFirst());
-    if (s == m_impl->requirements.end() && subsystem.getSecond()) {
-      Schedule({subsystem.getSecond().get()});
+    auto s = m_impl->requirements.find(subsystem.first);
+    if (s == m_impl->requirements.end() && subsystem.second) {
+      Schedule({subsystem.second.get()});
     }
   }
 
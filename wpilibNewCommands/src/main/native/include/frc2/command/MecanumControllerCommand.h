@@ -425,6 +425,7 @@ class MecanumControllerCommand
 
  private:
   frc::Trajectory m_trajectory;
+  frc::Trajectory::Sampler m_sampler;
   std::function<frc::Pose2d()> m_pose;
   frc::SimpleMotorFeedforward<units::meters> m_feedforward;
   frc::MecanumDriveKinematics m_kinematics;
@@ -174,6 +174,7 @@ class RamseteCommand : public CommandHelper<CommandBase, RamseteCommand> {
 
  private:
   frc::Trajectory m_trajectory;
+  frc::Trajectory::Sampler m_sampler;
   std::function<frc::Pose2d()> m_pose;
   frc::RamseteController m_controller;
   frc::SimpleMotorFeedforward<units::meters> m_feedforward;
@@ -217,6 +217,7 @@ class SwerveControllerCommand
 
  private:
   frc::Trajectory m_trajectory;
+  frc::Trajectory::Sampler m_sampler;
   std::function<frc::Pose2d()> m_pose;
   frc::SwerveDriveKinematics<NumModules> m_kinematics;
   frc::HolonomicDriveController m_controller;
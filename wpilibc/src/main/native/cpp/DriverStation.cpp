@@ -19,6 +19,7 @@
 #include <hal/DriverStationTypes.h>
 #include <hal/HALBase.h>
 #include <hal/Power.h>
+#include <hal/simulation/SimSnapshot.h>
 #include <networktables/NetworkTable.h>
 #include <networktables/NetworkTableEntry.h>
 #include <networktables/NetworkTableInstance.h>
@@ -86,18 +87,47 @@ struct MatchDataSender {
   MatchDataSenderEntry<double> controlWord{table, "FMSControlData", 0.0};
 };
 
+// A copy of all joystick, match and control data, taken when new data
+// arrives from the DS
+struct DataCache {
+  // Odd while the cache is being written
+  std::atomic<uint32_t> sequence{0};
+
+  std::array<HAL_JoystickAxes, DriverStation::kJoystickPorts> axes;
+  std::array<HAL_JoystickPOVs, DriverStation::kJoystickPorts> povs;
+  std::array<HAL_JoystickButtons, DriverStation::kJoystickPorts> buttons;
+  std::array<HAL_JoystickDescriptor, DriverStation::kJoystickPorts>
+      descriptors;
+  HAL_MatchInfo matchInfo;
+  HAL_ControlWord controlWord;
+  HAL_AllianceStationID allianceStation;
+};
+
 struct Instance {
   Instance();
   ~Instance();
 
+  void UpdateCache();
+
   MatchDataSender matchDataSender;
 
-  // Joystick button rising/falling edge flags
-  wpi::mutex buttonEdgeMutex;
-  std::array<HAL_JoystickButtons, DriverStation::kJoystickPorts>
-      previousButtonStates;
-  std::array<uint32_t, DriverStation::kJoystickPorts> joystickButtonsPressed;
-  std::array<uint32_t, DriverStation::kJoystickPorts> joystickButtonsReleased;
+  // Double-buffered DS data. Writers always write to the cache that isn't
+  // current, so readers only retry if a read overlaps two updates.
+  std::array<DataCache, 2> caches{};
+  std::atomic<int> currentCache{0};
+  // Serializes the DS thread and simulation refreshes updating the cache
+  wpi::mutex cacheMutex;
+
+  // In simulation, DS data can also change without new DS data arriving, so
+  // DriverStationSim refreshes the cache and so does restoring a snapshot
+  int32_t simSnapshotCallback = 0;
+
+  // Joystick button rising/falling edge flags, set by the DS thread and
+  // cleared by the first read
+  std::array<std::atomic<uint32_t>, DriverStation::kJoystickPorts>
+      joystickButtonsPressed{};
+  std::array<std::atomic<uint32_t>, DriverStation::kJoystickPorts>
+      joystickButtonsReleased{};
 
   // Internal Driver Station thread
   std::thread dsThread;
@@ -127,7 +157,30 @@ static Instance& GetInstance() {
 }
 
 static void Run();
-static void SendMatchData();
+static void SendMatchData(const DataCache& cache);
+
+/**
+ * Reads from the current DS data cache without locking.
+ *
+ * @param func function that copies the wanted data out of the cache; it may
+ *             be called more than once
+ */
+template <typename F>
+static auto ReadCache(F&& func) {
+  auto& inst = GetInstance();
+  while (true) {
+    const DataCache& cache =
+        inst.caches[inst.currentCache.load(std::memory_order_acquire)];
+    uint32_t sequence = cache.sequence.load(std::memory_order_acquire);
+    if ((sequence & 1) == 0) {
+      auto value = func(cache);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (cache.sequence.load(std::memory_order_relaxed) == sequence) {
+        return value;
+      }
+    }
+  }
+}
 
 /**
  * Reports errors related to unplugged joysticks.
@@ -171,25 +224,68 @@ static int& GetDSLastCount() {
 Instance::Instance() {
   HAL_Initialize(500, 0);
 
-  // All joysticks should default to having zero axes, povs and buttons, so
-  // uninitialized memory doesn't get sent to speed controllers.
-  for (unsigned int i = 0; i < DriverStation::kJoystickPorts; i++) {
-    joystickButtonsPressed[i] = 0;
-    joystickButtonsReleased[i] = 0;
-    previousButtonStates[i].count = 0;
-    previousButtonStates[i].buttons = 0;
-  }
+  // The caches start zeroed, so all joysticks default to having zero axes,
+  // povs and buttons and uninitialized memory doesn't get sent to speed
+  // controllers.
+  UpdateCache();
+
+  simSnapshotCallback = HALSIM_RegisterSimSnapshotRestoredCallback(
+      [](void* param) { static_cast<Instance*>(param)->UpdateCache(); }, this);
 
   dsThread = std::thread(&Run);
 }
 
 Instance::~Instance() {
+  HALSIM_CancelSimSnapshotRestoredCallback(simSnapshotCallback);
+
   isRunning = false;
   // Trigger a DS mutex release in case there is no driver station running.
   HAL_ReleaseDSMutex();
   dsThread.join();
 }
 
+void Instance::UpdateCache() {
+  std::scoped_lock lock(cacheMutex);
+  int current = currentCache.load(std::memory_order_relaxed);
+  const DataCache& previous = caches[current];
+  DataCache& cache = caches[current ^ 1];
+
+  cache.sequence.fetch_add(1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  for (int32_t i = 0; i < DriverStation::kJoystickPorts; i++) {
+    HAL_GetJoystickAxes(i, &cache.axes[i]);
+    HAL_GetJoystickPOVs(i, &cache.povs[i]);
+    HAL_GetJoystickButtons(i, &cache.buttons[i]);
+    HAL_GetJoystickDescriptor(i, &cache.descriptors[i]);
+  }
+  HAL_GetMatchInfo(&cache.matchInfo);
+  HAL_GetControlWord(&cache.controlWord);
+  int32_t status = 0;
+  cache.allianceStation = HAL_GetAllianceStation(&status);
+  cache.sequence.fetch_add(1, std::memory_order_release);
+  currentCache.store(current ^ 1, std::memory_order_release);
+
+  // Compute the pressed and released buttons against the previous cache
+  for (int32_t i = 0; i < DriverStation::kJoystickPorts; i++) {
+    uint32_t previousButtons = previous.buttons[i].buttons;
+    uint32_t currentButtons = cache.buttons[i].buttons;
+
+    // If buttons weren't pressed and are now, set flags in m_buttonsPressed
+    joystickButtonsPressed[i].fetch_or(~previousButtons & currentButtons);
+
+    // If buttons were pressed and aren't now, set flags in m_buttonsReleased
+    joystickButtonsReleased[i].fetch_or(previousButtons & ~currentButtons);
+  }
+}
+
+static HAL_ControlWord GetCachedControlWord() {
+  return ReadCache([](const DataCache& cache) { return cache.controlWord; });
+}
+
+static HAL_MatchInfo GetCachedMatchInfo() {
+  return ReadCache([](const DataCache& cache) { return cache.matchInfo; });
+}
+
 DriverStation& DriverStation::GetInstance() {
   ::GetInstance();
   static DriverStation instance;
@@ -207,8 +303,8 @@ bool DriverStation::GetStickButton(int stick, int button) {
     return false;
   }
 
-  HAL_JoystickButtons buttons;
-  HAL_GetJoystickButtons(stick, &buttons);
+  HAL_JoystickButtons buttons = ReadCache(
+      [&](const DataCache& cache) { return cache.buttons[stick]; });
 
   if (button > buttons.count) {
     ReportJoystickUnpluggedWarning(
@@ -232,8 +328,8 @@ bool DriverStation::GetStickButtonPressed(int stick, int button) {
     return false;
   }
 
-  HAL_JoystickButtons buttons;
-  HAL_GetJoystickButtons(stick, &buttons);
+  HAL_JoystickButtons buttons = ReadCache(
+      [&](const DataCache& cache) { return cache.buttons[stick]; });
 
   if (button > buttons.count) {
     ReportJoystickUnpluggedWarning(
@@ -242,14 +338,9 @@ bool DriverStation::GetStickButtonPressed(int stick, int button) {
         button, buttons.count);
     return false;
   }
-  auto& inst = ::GetInstance();
-  std::unique_lock lock(inst.buttonEdgeMutex);
   // If button was pressed, clear flag and return true
-  if (inst.joystickButtonsPressed[stick] & 1 << (button - 1)) {
-    inst.joystickButtonsPressed[stick] &= ~(1 << (button - 1));
-    return true;
-  }
-  return false;
+  uint32_t mask = 1u << (button - 1);
+  return ::GetInstance().joystickButtonsPressed[stick].fetch_and(~mask) & mask;
 }
 
 bool DriverStation::GetStickButtonReleased(int stick, int button) {
@@ -263,8 +354,8 @@ bool DriverStation::GetStickButtonReleased(int stick, int button) {
     return false;
   }
 
-  HAL_JoystickButtons buttons;
-  HAL_GetJoystickButtons(stick, &buttons);
+  HAL_JoystickButtons buttons = ReadCache(
+      [&](const DataCache& cache) { return cache.buttons[stick]; });
 
   if (button > buttons.count) {
     ReportJoystickUnpluggedWarning(
@@ -273,14 +364,9 @@ bool DriverStation::GetStickButtonReleased(int stick, int button) {
         button, buttons.count);
     return false;
   }
-  auto& inst = ::GetInstance();
-  std::unique_lock lock(inst.buttonEdgeMutex);
   // If button was released, clear flag and return true
-  if (inst.joystickButtonsReleased[stick] & 1 << (button - 1)) {
-    inst.joystickButtonsReleased[stick] &= ~(1 << (button - 1));
-    return true;
-  }
-  return false;
+  uint32_t mask = 1u << (button - 1);
+  return ::GetInstance().joystickButtonsReleased[stick].fetch_and(~mask) & mask;
 }
 
 double DriverStation::GetStickAxis(int stick, int axis) {
@@ -293,8 +379,8 @@ double DriverStation::GetStickAxis(int stick, int axis) {
     return 0.0;
   }
 
-  HAL_JoystickAxes axes;
-  HAL_GetJoystickAxes(stick, &axes);
+  HAL_JoystickAxes axes = ReadCache(
+      [&](const DataCache& cache) { return cache.axes[stick]; });
 
   if (axis >= axes.count) {
     ReportJoystickUnpluggedWarning(
@@ -317,8 +403,8 @@ int DriverStation::GetStickPOV(int stick, int pov) {
     return -1;
   }
 
-  HAL_JoystickPOVs povs;
-  HAL_GetJoystickPOVs(stick, &povs);
+  HAL_JoystickPOVs povs = ReadCache(
+      [&](const DataCache& cache) { return cache.povs[stick]; });
 
   if (pov >= povs.count) {
     ReportJoystickUnpluggedWarning(
@@ -337,8 +423,8 @@ int DriverStation::GetStickButtons(int stick) {
     return 0;
   }
 
-  HAL_JoystickButtons buttons;
-  HAL_GetJoystickButtons(stick, &buttons);
+  HAL_JoystickButtons buttons = ReadCache(
+      [&](const DataCache& cache) { return cache.buttons[stick]; });
 
   return buttons.buttons;
 }
@@ -349,8 +435,8 @@ int DriverStation::GetStickAxisCount(int stick) {
     return 0;
   }
 
-  HAL_JoystickAxes axes;
-  HAL_GetJoystickAxes(stick, &axes);
+  HAL_JoystickAxes axes = ReadCache(
+      [&](const DataCache& cache) { return cache.axes[stick]; });
 
   return axes.count;
 }
@@ -361,8 +447,8 @@ int DriverStation::GetStickPOVCount(int stick) {
     return 0;
   }
 
-  HAL_JoystickPOVs povs;
-  HAL_GetJoystickPOVs(stick, &povs);
+  HAL_JoystickPOVs povs = ReadCache(
+      [&](const DataCache& cache) { return cache.povs[stick]; });
 
   return povs.count;
 }
@@ -373,8 +459,8 @@ int DriverStation::GetStickButtonCount(int stick) {
     return 0;
   }
 
-  HAL_JoystickButtons buttons;
-  HAL_GetJoystickButtons(stick, &buttons);
+  HAL_JoystickButtons buttons = ReadCache(
+      [&](const DataCache& cache) { return cache.buttons[stick]; });
 
   return buttons.count;
 }
@@ -385,8 +471,8 @@ bool DriverStation::GetJoystickIsXbox(int stick) {
     return false;
   }
 
-  HAL_JoystickDescriptor descriptor;
-  HAL_GetJoystickDescriptor(stick, &descriptor);
+  HAL_JoystickDescriptor descriptor = ReadCache(
+      [&](const DataCache& cache) { return cache.descriptors[stick]; });
 
   return static_cast<bool>(descriptor.isXbox);
 }
@@ -397,8 +483,8 @@ int DriverStation::GetJoystickType(int stick) {
     return -1;
   }
 
-  HAL_JoystickDescriptor descriptor;
-  HAL_GetJoystickDescriptor(stick, &descriptor);
+  HAL_JoystickDescriptor descriptor = ReadCache(
+      [&](const DataCache& cache) { return cache.descriptors[stick]; });
 
   return static_cast<int>(descriptor.type);
 }
@@ -408,8 +494,8 @@ std::string DriverStation::GetJoystickName(int stick) {
     FRC_ReportError(warn::BadJoystickIndex, "stick {} out of range", stick);
   }
 
-  HAL_JoystickDescriptor descriptor;
-  HAL_GetJoystickDescriptor(stick, &descriptor);
+  HAL_JoystickDescriptor descriptor = ReadCache(
+      [&](const DataCache& cache) { return cache.descriptors[stick]; });
 
   return descriptor.name;
 }
@@ -420,8 +506,8 @@ int DriverStation::GetJoystickAxisType(int stick, int axis) {
     return -1;
   }
 
-  HAL_JoystickDescriptor descriptor;
-  HAL_GetJoystickDescriptor(stick, &descriptor);
+  HAL_JoystickDescriptor descriptor = ReadCache(
+      [&](const DataCache& cache) { return cache.descriptors[stick]; });
 
   return static_cast<bool>(descriptor.axisTypes);
 }
@@ -432,56 +518,47 @@ bool DriverStation::IsJoystickConnected(int stick) {
 }
 
 bool DriverStation::IsEnabled() {
-  HAL_ControlWord controlWord;
-  HAL_GetControlWord(&controlWord);
+  HAL_ControlWord controlWord = GetCachedControlWord();
   return controlWord.enabled && controlWord.dsAttached;
 }
 
 bool DriverStation::IsDisabled() {
-  HAL_ControlWord controlWord;
-  HAL_GetControlWord(&controlWord);
+  HAL_ControlWord controlWord = GetCachedControlWord();
   return !(controlWord.enabled && controlWord.dsAttached);
 }
 
 bool DriverStation::IsEStopped() {
-  HAL_ControlWord controlWord;
-  HAL_GetControlWord(&controlWord);
+  HAL_ControlWord controlWord = GetCachedControlWord();
   return controlWord.eStop;
 }
 
 bool DriverStation::IsAutonomous() {
-  HAL_ControlWord controlWord;
-  HAL_GetControlWord(&controlWord);
+  HAL_ControlWord controlWord = GetCachedControlWord();
   return controlWord.autonomous;
 }
 
 bool DriverStation::IsAutonomousEnabled() {
-  HAL_ControlWord controlWord;
-  HAL_GetControlWord(&controlWord);
+  HAL_ControlWord controlWord = GetCachedControlWord();
   return controlWord.autonomous && controlWord.enabled;
 }
 
 bool DriverStation::IsOperatorControl() {
-  HAL_ControlWord controlWord;
-  HAL_GetControlWord(&controlWord);
+  HAL_ControlWord controlWord = GetCachedControlWord();
   return !(controlWord.autonomous || controlWord.test);
 }
 
 bool DriverStation::IsOperatorControlEnabled() {
-  HAL_ControlWord controlWord;
-  HAL_GetControlWord(&controlWord);
+  HAL_ControlWord controlWord = GetCachedControlWord();
   return !controlWord.autonomous && !controlWord.test && controlWord.enabled;
 }
 
 bool DriverStation::IsTest() {
-  HAL_ControlWord controlWord;
-  HAL_GetControlWord(&controlWord);
+  HAL_ControlWord controlWord = GetCachedControlWord();
   return controlWord.test;
 }
 
 bool DriverStation::IsDSAttached() {
-  HAL_ControlWord controlWord;
-  HAL_GetControlWord(&controlWord);
+  HAL_ControlWord controlWord = GetCachedControlWord();
   return controlWord.dsAttached;
 }
 
@@ -498,45 +575,39 @@ bool DriverStation::IsNewControlData() {
 }
 
 bool DriverStation::IsFMSAttached() {
-  HAL_ControlWord controlWord;
-  HAL_GetControlWord(&controlWord);
+  HAL_ControlWord controlWord = GetCachedControlWord();
   return controlWord.fmsAttached;
 }
 
 std::string DriverStation::GetGameSpecificMessage() {
-  HAL_MatchInfo info;
-  HAL_GetMatchInfo(&info);
+  HAL_MatchInfo info = GetCachedMatchInfo();
   return std::string(reinterpret_cast<char*>(info.gameSpecificMessage),
                      info.gameSpecificMessageSize);
 }
 
 std::string DriverStation::GetEventName() {
-  HAL_MatchInfo info;
-  HAL_GetMatchInfo(&info);
+  HAL_MatchInfo info = GetCachedMatchInfo();
   return info.eventName;
 }
 
 DriverStation::MatchType DriverStation::GetMatchType() {
-  HAL_MatchInfo info;
-  HAL_GetMatchInfo(&info);
+  HAL_MatchInfo info = GetCachedMatchInfo();
   return static_cast<DriverStation::MatchType>(info.matchType);
 }
 
 int DriverStation::GetMatchNumber() {
-  HAL_MatchInfo info;
-  HAL_GetMatchInfo(&info);
+  HAL_MatchInfo info = GetCachedMatchInfo();
   return info.matchNumber;
 }
 
 int DriverStation::GetReplayNumber() {
-  HAL_MatchInfo info;
-  HAL_GetMatchInfo(&info);
+  HAL_MatchInfo info = GetCachedMatchInfo();
   return info.replayNumber;
 }
 
 DriverStation::Alliance DriverStation::GetAlliance() {
-  int32_t status = 0;
-  auto allianceStationID = HAL_GetAllianceStation(&status);
+  auto allianceStationID = ReadCache(
+      [](const DataCache& cache) { return cache.allianceStation; });
   switch (allianceStationID) {
     case HAL_AllianceStationID_kRed1:
     case HAL_AllianceStationID_kRed2:
@@ -552,8 +623,8 @@ DriverStation::Alliance DriverStation::GetAlliance() {
 }
 
 int DriverStation::GetLocation() {
-  int32_t status = 0;
-  auto allianceStationID = HAL_GetAllianceStation(&status);
+  auto allianceStationID = ReadCache(
+      [](const DataCache& cache) { return cache.allianceStation; });
   switch (allianceStationID) {
     case HAL_AllianceStationID_kRed1:
     case HAL_AllianceStationID_kBlue1:
@@ -628,6 +699,10 @@ void DriverStation::InTest(bool entering) {
   ::GetInstance().userInTest = entering;
 }
 
+void DriverStation::RefreshData() {
+  ::GetInstance().UpdateCache();
+}
+
 void DriverStation::WakeupWaitForData() {
   auto& inst = ::GetInstance();
   std::scoped_lock waitLock(inst.waitForDataMutex);
@@ -639,33 +714,15 @@ void DriverStation::WakeupWaitForData() {
 /**
  * Copy data from the DS task for the user.
  *
- * If no new data exists, it will just be returned, otherwise
- * the data will be copied from the DS polling loop.
+ * Called by the DS thread when new data arrives; the copy is published before
+ * any threads waiting for data are woken.
  */
 void GetData() {
   auto& inst = ::GetInstance();
-  {
-    // Compute the pressed and released buttons
-    HAL_JoystickButtons currentButtons;
-    std::unique_lock lock(inst.buttonEdgeMutex);
-
-    for (int32_t i = 0; i < DriverStation::kJoystickPorts; i++) {
-      HAL_GetJoystickButtons(i, &currentButtons);
-
-      // If buttons weren't pressed and are now, set flags in m_buttonsPressed
-      inst.joystickButtonsPressed[i] |=
-          ~inst.previousButtonStates[i].buttons & currentButtons.buttons;
-
-      // If buttons were pressed and aren't now, set flags in m_buttonsReleased
-      inst.joystickButtonsReleased[i] |=
-          inst.previousButtonStates[i].buttons & ~currentButtons.buttons;
-
-      inst.previousButtonStates[i] = currentButtons;
-    }
-  }
+  inst.UpdateCache();
 
   DriverStation::WakeupWaitForData();
-  SendMatchData();
+  SendMatchData(inst.caches[inst.currentCache.load()]);
 }
 
 void DriverStation::SilenceJoystickConnectionWarning(bool silence) {
@@ -729,9 +786,8 @@ void Run() {
   }
 }
 
-void SendMatchData() {
-  int32_t status = 0;
-  HAL_AllianceStationID alliance = HAL_GetAllianceStation(&status);
+void SendMatchData(const DataCache& cache) {
+  HAL_AllianceStationID alliance = cache.allianceStation;
   bool isRedAlliance = false;
   int stationNumber = 1;
   switch (alliance) {
@@ -761,23 +817,21 @@ void SendMatchData() {
       break;
   }
 
-  HAL_MatchInfo tmpDataStore;
-  HAL_GetMatchInfo(&tmpDataStore);
+  const HAL_MatchInfo& tmpDataStore = cache.matchInfo;
 
   auto& inst = GetInstance();
   inst.matchDataSender.alliance.Set(isRedAlliance);
   inst.matchDataSender.station.Set(stationNumber);
   inst.matchDataSender.eventName.Set(tmpDataStore.eventName);
   inst.matchDataSender.gameSpecificMessage.Set(
-      std::string(reinterpret_cast<char*>(tmpDataStore.gameSpecificMessage),
-                  tmpDataStore.gameSpecificMessageSize));
+      std::string(
+          reinterpret_cast<const char*>(tmpDataStore.gameSpecificMessage),
+          tmpDataStore.gameSpecificMessageSize));
   inst.matchDataSender.matchNumber.Set(tmpDataStore.matchNumber);
   inst.matchDataSender.replayNumber.Set(tmpDataStore.replayNumber);
   inst.matchDataSender.matchType.Set(static_cast<int>(tmpDataStore.matchType));
 
-  HAL_ControlWord ctlWord;
-  HAL_GetControlWord(&ctlWord);
   int32_t wordInt = 0;
-  std::memcpy(&wordInt, &ctlWord, sizeof(wordInt));
+  std::memcpy(&wordInt, &cache.controlWord, sizeof(wordInt));
   inst.matchDataSender.controlWord.Set(wordInt);
 }
@@ -11,6 +11,7 @@
 #include <hal/DriverStation.h>
 #include <hal/FRCUsageReporting.h>
 #include <hal/Notifier.h>
+#include <wpi/Trace.h>
 
 #include "frc/Errors.h"
 #include "frc/Timer.h"
@@ -45,6 +46,8 @@ void TimedRobot::StartCompetition() {
       break;
     }
 
+    WPI_TRACE_SCOPE("TimedRobot callbacks");
+
     callback.func();
 
     callback.expirationTime += callback.period;
@@ -30,6 +30,7 @@ bool DriverStationSim::GetEnabled() {
 
 void DriverStationSim::SetEnabled(bool enabled) {
   HALSIM_SetDriverStationEnabled(enabled);
+  DriverStation::RefreshData();
 }
 
 std::unique_ptr<CallbackStore> DriverStationSim::RegisterAutonomousCallback(
@@ -47,6 +48,7 @@ bool DriverStationSim::GetAutonomous() {
 
 void DriverStationSim::SetAutonomous(bool autonomous) {
   HALSIM_SetDriverStationAutonomous(autonomous);
+  DriverStation::RefreshData();
 }
 
 std::unique_ptr<CallbackStore> DriverStationSim::RegisterTestCallback(
@@ -64,6 +66,7 @@ bool DriverStationSim::GetTest() {
 
 void DriverStationSim::SetTest(bool test) {
   HALSIM_SetDriverStationTest(test);
+  DriverStation::RefreshData();
 }
 
 std::unique_ptr<CallbackStore> DriverStationSim::RegisterEStopCallback(
@@ -81,6 +84,7 @@ bool DriverStationSim::GetEStop() {
 
 void DriverStationSim::SetEStop(bool eStop) {
   HALSIM_SetDriverStationEStop(eStop);
+  DriverStation::RefreshData();
 }
 
 std::unique_ptr<CallbackStore> DriverStationSim::RegisterFmsAttachedCallback(
@@ -98,6 +102,7 @@ bool DriverStationSim::GetFmsAttached() {
 
 void DriverStationSim::SetFmsAttached(bool fmsAttached) {
   HALSIM_SetDriverStationFmsAttached(fmsAttached);
+  DriverStation::RefreshData();
 }
 
 std::unique_ptr<CallbackStore> DriverStationSim::RegisterDsAttachedCallback(
@@ -115,6 +120,7 @@ bool DriverStationSim::GetDsAttached() {
 
 void DriverStationSim::SetDsAttached(bool dsAttached) {
   HALSIM_SetDriverStationDsAttached(dsAttached);
+  DriverStation::RefreshData();
 }
 
 std::unique_ptr<CallbackStore>
@@ -134,6 +140,7 @@ HAL_AllianceStationID DriverStationSim::GetAllianceStationId() {
 void DriverStationSim::SetAllianceStationId(
     HAL_AllianceStationID allianceStationId) {
   HALSIM_SetDriverStationAllianceStationId(allianceStationId);
+  DriverStation::RefreshData();
 }
 
 std::unique_ptr<CallbackStore> DriverStationSim::RegisterMatchTimeCallback(
@@ -239,24 +246,30 @@ void DriverStationSim::SetJoystickAxisType(int stick, int axis, int type) {
 
 void DriverStationSim::SetGameSpecificMessage(const char* message) {
   HALSIM_SetGameSpecificMessage(message);
+  DriverStation::RefreshData();
 }
 
 void DriverStationSim::SetEventName(const char* name) {
   HALSIM_SetEventName(name);
+  DriverStation::RefreshData();
 }
 
 void DriverStationSim::SetMatchType(DriverStation::MatchType type) {
   HALSIM_SetMatchType(static_cast<HAL_MatchType>(static_cast<int>(type)));
+  DriverStation::RefreshData();
 }
 
 void DriverStationSim::SetMatchNumber(int matchNumber) {
   HALSIM_SetMatchNumber(matchNumber);
+  DriverStation::RefreshData();
 }
 
 void DriverStationSim::SetReplayNumber(int replayNumber) {
   HALSIM_SetReplayNumber(replayNumber);
+  DriverStation::RefreshData();
 }
 
 void DriverStationSim::ResetData() {
   HALSIM_ResetDriverStationData();
+  DriverStation::RefreshData();
 }
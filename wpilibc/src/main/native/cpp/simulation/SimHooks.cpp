@@ -48,4 +48,12 @@ void StepTimingAsync(units::second_t delta) {
   HALSIM_StepTimingAsync(static_cast<uint64_t>(delta.to<double>() * 1e6));
 }
 
+void SetFastTiming(bool fast) {
+  HALSIM_SetFastTiming(fast);
+}
+
+bool IsFastTiming() {
+  return HALSIM_IsFastTiming();
+}
+
 }  // namespace frc::sim
@@ -11,9 +11,19 @@
 
 namespace frc {
 
+namespace sim {
+class DriverStationSim;
+}  // namespace sim
+
 /**
  * Provide access to the network communication data to / from the Driver
  * Station.
+ *
+ * Joystick, match and control data are read from a copy taken each time new
+ * data arrives from the Driver Station, so they are consistent until the next
+ * packet and reading them doesn't lock. In simulation, DriverStationSim also
+ * refreshes the copy when it changes the control word, alliance station, match
+ * info or resets the data, as does restoring a sim snapshot.
  */
 class DriverStation {
  public:
@@ -411,7 +421,15 @@ class DriverStation {
   static bool IsJoystickConnectionWarningSilenced();
 
  private:
+  friend class sim::DriverStationSim;
+
   DriverStation() = default;
+
+  /**
+   * Refreshes the cached DS data from the HAL without waiting for new DS
+   * data, for simulation changes that don't notify new data.
+   */
+  static void RefreshData();
 };
 
 }  // namespace frc
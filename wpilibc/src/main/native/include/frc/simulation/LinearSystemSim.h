@@ -12,6 +12,7 @@
 
 #include "frc/RobotController.h"
 #include "frc/StateSpaceUtil.h"
+#include "frc/system/Discretization.h"
 #include "frc/system/LinearSystem.h"
 
 namespace frc::sim {
@@ -127,7 +128,7 @@ class LinearSystemSim {
   virtual Eigen::Matrix<double, States, 1> UpdateX(
       const Eigen::Matrix<double, States, 1>& currentXhat,
       const Eigen::Matrix<double, Inputs, 1>& u, units::second_t dt) {
-    return m_plant.CalculateX(currentXhat, u, dt);
+    return m_plant.CalculateX(currentXhat, u, dt, m_discCache);
   }
 
   /**
@@ -149,5 +150,8 @@ class LinearSystemSim {
   Eigen::Matrix<double, Outputs, 1> m_y;
   Eigen::Matrix<double, Inputs, 1> m_u;
   std::array<double, Outputs> m_measurementStdDevs;
+
+ private:
+  DiscretizationCache<States, Inputs> m_discCache;
 };
 }  // namespace frc::sim
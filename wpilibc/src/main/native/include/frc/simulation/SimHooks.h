@@ -60,4 +60,21 @@ void StepTiming(units::second_t delta);
  */
 void StepTimingAsync(units::second_t delta);
 
+/**
+ * Run the simulator time as fast as possible. Whenever all notifiers are
+ * waiting, time jumps to the next notifier alarm, and notifiers with the same
+ * alarm run one at a time, so results are the same on every run. Disabling
+ * this resumes real time.
+ *
+ * @param fast true to run as fast as possible
+ */
+void SetFastTiming(bool fast);
+
+/**
+ * Check if the simulator time is running as fast as possible.
+ *
+ * @return true if running as fast as possible
+ */
+bool IsFastTiming();
+
 }  // namespace frc::sim
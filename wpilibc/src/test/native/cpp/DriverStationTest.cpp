@@ -4,6 +4,9 @@
 
 #include <string>
 #include <tuple>
+#include <vector>
+
+#include <hal/simulation/SimSnapshot.h>
 
 #include "frc/DriverStation.h"
 #include "frc/Joystick.h"
@@ -73,3 +76,61 @@ INSTANTIATE_TEST_SUITE_P(
             true, false, false,
             "Warning: Joystick Button 1 missing (max 0), check if all "
             "controllers are plugged in\n")));
+
+TEST(DriverStationTest, ButtonPressedReleased) {
+  frc::sim::DriverStationSim::SetJoystickButtonCount(2, 2);
+  frc::sim::DriverStationSim::SetJoystickButton(2, 2, false);
+  frc::sim::DriverStationSim::NotifyNewData();
+  frc::DriverStation::GetStickButtonPressed(2, 2);
+  frc::DriverStation::GetStickButtonReleased(2, 2);
+
+  // Values only change when new data arrives
+  frc::sim::DriverStationSim::SetJoystickButton(2, 2, true);
+  EXPECT_FALSE(frc::DriverStation::GetStickButton(2, 2));
+  EXPECT_FALSE(frc::DriverStation::GetStickButtonPressed(2, 2));
+
+  // An edge is only reported once
+  frc::sim::DriverStationSim::NotifyNewData();
+  EXPECT_TRUE(frc::DriverStation::GetStickButton(2, 2));
+  EXPECT_TRUE(frc::DriverStation::GetStickButtonPressed(2, 2));
+  EXPECT_FALSE(frc::DriverStation::GetStickButtonPressed(2, 2));
+  EXPECT_FALSE(frc::DriverStation::GetStickButtonReleased(2, 2));
+
+  frc::sim::DriverStationSim::SetJoystickButton(2, 2, false);
+  frc::sim::DriverStationSim::NotifyNewData();
+  EXPECT_FALSE(frc::DriverStation::GetStickButton(2, 2));
+  EXPECT_TRUE(frc::DriverStation::GetStickButtonReleased(2, 2));
+  EXPECT_FALSE(frc::DriverStation::GetStickButtonReleased(2, 2));
+}
+
+TEST(DriverStationTest, ControlWordWithoutNewData) {
+  frc::sim::DriverStationSim::ResetData();
+  EXPECT_FALSE(frc::DriverStation::IsEnabled());
+
+  // Control data doesn't wait for new data in simulation
+  frc::sim::DriverStationSim::SetEnabled(true);
+  frc::sim::DriverStationSim::SetAutonomous(true);
+  EXPECT_TRUE(frc::DriverStation::IsEnabled());
+  EXPECT_TRUE(frc::DriverStation::IsAutonomous());
+
+  frc::sim::DriverStationSim::SetAllianceStationId(
+      HAL_AllianceStationID_kBlue2);
+  EXPECT_EQ(frc::DriverStation::kBlue, frc::DriverStation::GetAlliance());
+  EXPECT_EQ(2, frc::DriverStation::GetLocation());
+
+  frc::sim::DriverStationSim::ResetData();
+  EXPECT_FALSE(frc::DriverStation::IsEnabled());
+  EXPECT_FALSE(frc::DriverStation::IsAutonomous());
+}
+
+TEST(DriverStationTest, RestoreSnapshot) {
+  frc::sim::DriverStationSim::ResetData();
+  std::vector<uint8_t> snapshot(HALSIM_SaveSimSnapshot(nullptr, 0));
+  HALSIM_SaveSimSnapshot(snapshot.data(), snapshot.size());
+
+  frc::sim::DriverStationSim::SetEnabled(true);
+  EXPECT_TRUE(frc::DriverStation::IsEnabled());
+
+  ASSERT_TRUE(HALSIM_RestoreSimSnapshot(snapshot.data(), snapshot.size()));
+  EXPECT_FALSE(frc::DriverStation::IsEnabled());
+}
@@ -71,4 +71,24 @@ public final class SimHooks {
   public static void stepTimingAsync(double deltaSeconds) {
     SimulatorJNI.stepTimingAsync((long) (deltaSeconds * 1e6));
   }
+
+  /**
+   * Run the simulator time as fast as possible. Whenever all notifiers are waiting, time jumps to
+   * the next notifier alarm, and notifiers with the same alarm run one at a time, so results are
+   * the same on every run. Disabling this resumes real time.
+   *
+   * @param fast true to run as fast as possible
+   */
+  public static void setFastTiming(boolean fast) {
+    SimulatorJNI.setFastTiming(fast);
+  }
+
+  /**
+   * Check if the simulator time is running as fast as possible.
+   *
+   * @return true if running as fast as possible
+   */
+  public static boolean isFastTiming() {
+    return SimulatorJNI.isFastTiming();
+  }
 }
@@ -0,0 +1,121 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <chrono>
+#include <string_view>
+
+namespace frc::bench {
+
+/**
+ * Drives the timed loop of a benchmark. A benchmark does its setup, then runs
+ * the operation being measured once per KeepRunning() call:
+ *
+ * <pre>
+ * BENCHMARK(LinearFilter, MovingAverage) {
+ *   auto filter = frc::LinearFilter<double>::MovingAverage(10);
+ *   while (state.KeepRunning()) {
+ *     DoNotOptimize(filter.Calculate(1.0));
+ *   }
+ * }
+ * </pre>
+ *
+ * Only the loop is timed, and only heap allocations made in the loop are
+ * counted.
+ */
+class State {
+ public:
+  explicit State(uint64_t iterations) : m_iterations{iterations} {}
+
+  /**
+   * Returns true while the operation should be run again.
+   */
+  bool KeepRunning() {
+    if (m_remaining != 0) {
+      --m_remaining;
+      return true;
+    }
+    return StartOrStop();
+  }
+
+  /**
+   * Returns the number of times the operation runs.
+   */
+  uint64_t GetIterations() const { return m_iterations; }
+
+  /**
+   * Returns the time spent in the loop.
+   */
+  std::chrono::nanoseconds GetElapsed() const { return m_elapsed; }
+
+  /**
+   * Returns the number of heap allocations made in the loop.
+   */
+  uint64_t GetAllocations() const { return m_allocations; }
+
+ private:
+  bool StartOrStop();
+
+  uint64_t m_iterations;
+  uint64_t m_remaining = 0;
+  bool m_started = false;
+  std::chrono::steady_clock::time_point m_start;
+  std::chrono::nanoseconds m_elapsed{0};
+  uint64_t m_startAllocations = 0;
+  uint64_t m_allocations = 0;
+};
+
+using BenchmarkFunc = void (*)(State& state);
+
+/**
+ * Adds a benchmark to the list run by the benchmark executable. Use the
+ * BENCHMARK() macro instead of calling this directly.
+ *
+ * @param name The name of the benchmark.
+ * @param func The benchmark function.
+ * @return True, so registration can initialize a static variable.
+ */
+bool RegisterBenchmark(std::string_view name, BenchmarkFunc func);
+
+/**
+ * Returns true if heap allocations are counted on this platform.
+ */
+bool CountsAllocations();
+
+/**
+ * Returns the number of heap allocations made by the process so far.
+ */
+uint64_t GetAllocationCount();
+
+/**
+ * Keeps the compiler from optimizing away the computation of a value.
+ */
+template <typename T>
+void DoNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static const void* volatile sink;
+  sink = &value;
+#endif
+}
+
+}  // namespace frc::bench
+
+#define BENCHMARK_FUNC_NAME(suite, name) suite##_##name##_Benchmark
+
+/**
+ * Defines a benchmark named "suite.name". The body receives a
+ * frc::bench::State named state.
+ */
+#define BENCHMARK(suite, name)                                            \
+  static void BENCHMARK_FUNC_NAME(suite, name)(::frc::bench::State&);     \
+  static const bool suite##_##name##_registered =                         \
+      ::frc::bench::RegisterBenchmark(#suite "." #name,                   \
+                                      BENCHMARK_FUNC_NAME(suite, name));  \
+  static void BENCHMARK_FUNC_NAME(suite, name)(                           \
+      [[maybe_unused]] ::frc::bench::State & state)
@@ -0,0 +1,69 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "Benchmark.h"
+#include "Eigen/Core"
+#include "estimator/DrivetrainDynamics.h"
+#include "frc/estimator/MerweScaledSigmaPoints.h"
+#include "frc/estimator/UnscentedKalmanFilter.h"
+
+using frc::bench::DoNotOptimize;
+
+namespace {
+
+// The drivetrain observer from UnscentedKalmanFilterTest: the state is
+// [x, y, heading, left velocity, right velocity] and the measurements are
+// [heading, left distance, right distance]
+constexpr auto Dynamics = &frc::DrivetrainDynamics<double>;
+
+Eigen::Matrix<double, 3, 1> LocalMeasurementModel(
+    const Eigen::Matrix<double, 5, 1>& x, const Eigen::Matrix<double, 2, 1>&) {
+  return Eigen::Matrix<double, 3, 1>{x(2), x(3), x(4)};
+}
+
+frc::UnscentedKalmanFilter<5, 2, 3> MakeObserver() {
+  return {Dynamics,
+          LocalMeasurementModel,
+          {0.5, 0.5, 10.0, 1.0, 1.0},
+          {0.0001, 0.01, 0.01},
+          5_ms};
+}
+
+}  // namespace
+
+BENCHMARK(UnscentedKalmanFilter, Predict) {
+  auto observer = MakeObserver();
+  Eigen::Matrix<double, 5, 5> P = observer.P();
+  Eigen::Matrix<double, 2, 1> u{12.0, 12.0};
+  while (state.KeepRunning()) {
+    observer.Predict(u, 5_ms);
+    // Keep the estimate bounded over millions of iterations
+    observer.SetXhat(Eigen::Matrix<double, 5, 1>::Zero());
+    observer.SetP(P);
+  }
+  DoNotOptimize(observer.P());
+}
+
+BENCHMARK(UnscentedKalmanFilter, Correct) {
+  auto observer = MakeObserver();
+  Eigen::Matrix<double, 2, 1> u{12.0, 12.0};
+  observer.Predict(u, 5_ms);
+  Eigen::Matrix<double, 3, 1> y{0.0, 0.01, 0.01};
+  while (state.KeepRunning()) {
+    observer.Correct(u, y);
+  }
+  DoNotOptimize(observer.Xhat());
+}
+
+BENCHMARK(MerweScaledSigmaPoints, SigmaPoints) {
+  frc::MerweScaledSigmaPoints<5> sigmaPoints;
+  Eigen::Matrix<double, 5, 1> x;
+  x << 1.0, 2.0, 0.5, 1.5, 1.5;
+  Eigen::Matrix<double, 5, 1> variances;
+  variances << 0.25, 0.25, 0.1, 1.0, 1.0;
+  Eigen::Matrix<double, 5, 5> P = variances.asDiagonal();
+  while (state.KeepRunning()) {
+    DoNotOptimize(sigmaPoints.SigmaPoints(x, P));
+  }
+}
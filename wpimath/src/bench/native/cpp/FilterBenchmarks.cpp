@@ -0,0 +1,131 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <vector>
+
+#include "Benchmark.h"
+#include "Eigen/Core"
+#include "frc/filter/LinearFilter.h"
+#include "frc/filter/LinearFilterBank.h"
+#include "frc/filter/MedianFilter.h"
+#include "frc/filter/MedianFilterBank.h"
+
+using frc::bench::DoNotOptimize;
+
+BENCHMARK(LinearFilter, SinglePoleIIR) {
+  auto filter = frc::LinearFilter<double>::SinglePoleIIR(0.1, 5_ms);
+  double input = 0.0;
+  while (state.KeepRunning()) {
+    DoNotOptimize(filter.Calculate(input));
+    input += 0.001;
+  }
+}
+
+BENCHMARK(LinearFilter, MovingAverage) {
+  auto filter = frc::LinearFilter<double>::MovingAverage(10);
+  double input = 0.0;
+  while (state.KeepRunning()) {
+    DoNotOptimize(filter.Calculate(input));
+    input += 0.001;
+  }
+}
+
+// Filter banks against one filter per channel, for the module velocities of a
+// swerve drive and a larger set of sensor channels
+
+template <int Channels>
+static Eigen::Matrix<double, Channels, 1> MakeInput(int step) {
+  Eigen::Matrix<double, Channels, 1> input;
+  for (int i = 0; i < Channels; ++i) {
+    input(i) = (step * 7 + i * 13) % 31;
+  }
+  return input;
+}
+
+template <int Channels>
+static void LinearFilterChannels(frc::bench::State& state) {
+  std::vector<frc::LinearFilter<double>> filters(
+      Channels, frc::LinearFilter<double>::MovingAverage(8));
+  auto input = MakeInput<Channels>(0);
+  Eigen::Matrix<double, Channels, 1> output;
+  while (state.KeepRunning()) {
+    for (int i = 0; i < Channels; ++i) {
+      output(i) = filters[i].Calculate(input(i));
+    }
+    DoNotOptimize(output);
+  }
+}
+
+template <int Channels, int Taps>
+static void LinearFilterBankChannels(frc::bench::State& state) {
+  auto bank = frc::LinearFilterBank<Channels, Taps, 0>::MovingAverage(8);
+  auto input = MakeInput<Channels>(0);
+  while (state.KeepRunning()) {
+    DoNotOptimize(bank.Calculate(input));
+  }
+}
+
+BENCHMARK(LinearFilter, MovingAverage4Channels) {
+  LinearFilterChannels<4>(state);
+}
+
+BENCHMARK(LinearFilterBank, MovingAverage4Channels) {
+  LinearFilterBankChannels<4, Eigen::Dynamic>(state);
+}
+
+BENCHMARK(LinearFilterBank, MovingAverage4ChannelsFixedTaps) {
+  LinearFilterBankChannels<4, 8>(state);
+}
+
+BENCHMARK(LinearFilter, MovingAverage32Channels) {
+  LinearFilterChannels<32>(state);
+}
+
+BENCHMARK(LinearFilterBank, MovingAverage32Channels) {
+  LinearFilterBankChannels<32, Eigen::Dynamic>(state);
+}
+
+BENCHMARK(LinearFilterBank, MovingAverage32ChannelsFixedTaps) {
+  LinearFilterBankChannels<32, 8>(state);
+}
+
+template <int Channels>
+static void MedianFilterChannels(frc::bench::State& state, size_t size) {
+  std::vector<frc::MedianFilter<double>> filters(
+      Channels, frc::MedianFilter<double>{size});
+  int step = 0;
+  Eigen::Matrix<double, Channels, 1> output;
+  while (state.KeepRunning()) {
+    auto input = MakeInput<Channels>(step++);
+    for (int i = 0; i < Channels; ++i) {
+      output(i) = filters[i].Calculate(input(i));
+    }
+    DoNotOptimize(output);
+  }
+}
+
+template <int Channels>
+static void MedianFilterBankChannels(frc::bench::State& state, size_t size) {
+  frc::MedianFilterBank<Channels> bank{size};
+  int step = 0;
+  while (state.KeepRunning()) {
+    DoNotOptimize(bank.Calculate(MakeInput<Channels>(step++)));
+  }
+}
+
+BENCHMARK(MedianFilter, Window5) {
+  MedianFilterChannels<1>(state, 5);
+}
+
+BENCHMARK(MedianFilter, Window101) {
+  MedianFilterChannels<1>(state, 101);
+}
+
+BENCHMARK(MedianFilter, Window5x8Channels) {
+  MedianFilterChannels<8>(state, 5);
+}
+
+BENCHMARK(MedianFilterBank, Window5x8Channels) {
+  MedianFilterBankChannels<8>(state, 5);
+}
@@ -0,0 +1,36 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "Benchmark.h"
+#include "frc/kinematics/SwerveDriveKinematics.h"
+
+using frc::bench::DoNotOptimize;
+
+namespace {
+frc::SwerveDriveKinematics<4> MakeKinematics() {
+  return frc::SwerveDriveKinematics<4>{
+      frc::Translation2d{0.3_m, 0.3_m}, frc::Translation2d{0.3_m, -0.3_m},
+      frc::Translation2d{-0.3_m, 0.3_m}, frc::Translation2d{-0.3_m, -0.3_m}};
+}
+}  // namespace
+
+BENCHMARK(SwerveDriveKinematics, ToChassisSpeeds) {
+  auto kinematics = MakeKinematics();
+  wpi::array<frc::SwerveModuleState, 4> moduleStates{
+      frc::SwerveModuleState{2_mps, 10_deg},
+      frc::SwerveModuleState{2.1_mps, 12_deg},
+      frc::SwerveModuleState{1.9_mps, 8_deg},
+      frc::SwerveModuleState{2_mps, 11_deg}};
+  while (state.KeepRunning()) {
+    DoNotOptimize(kinematics.ToChassisSpeeds(moduleStates));
+  }
+}
+
+BENCHMARK(SwerveDriveKinematics, ToSwerveModuleStates) {
+  auto kinematics = MakeKinematics();
+  frc::ChassisSpeeds speeds{1.5_mps, 0.5_mps, 1_rad_per_s};
+  while (state.KeepRunning()) {
+    DoNotOptimize(kinematics.ToSwerveModuleStates(speeds));
+  }
+}
@@ -0,0 +1,67 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "Benchmark.h"
+#include "Eigen/Core"
+#include "drake/math/discrete_algebraic_riccati_equation.h"
+#include "estimator/DrivetrainDynamics.h"
+#include "frc/system/Discretization.h"
+#include "frc/system/NumericalJacobian.h"
+#include "frc/system/plant/DCMotor.h"
+#include "frc/system/plant/LinearSystemId.h"
+
+using frc::bench::DoNotOptimize;
+
+// These are also the native baseline for the matching WPIMathJNI entry points
+
+BENCHMARK(DARE, Elevator) {
+  auto plant = frc::LinearSystemId::ElevatorSystem(frc::DCMotor::NEO(2), 5_kg,
+                                                   0.0181864_m, 1.0);
+  Eigen::Matrix<double, 2, 2> A;
+  Eigen::Matrix<double, 2, 1> B;
+  frc::DiscretizeAB<2, 1>(plant.A(), plant.B(), 5_ms, &A, &B);
+  Eigen::Matrix<double, 2, 2> Q;
+  Q << 1.0 / (0.02 * 0.02), 0.0, 0.0, 1.0 / (0.4 * 0.4);
+  Eigen::Matrix<double, 1, 1> R;
+  R << 1.0 / (12.0 * 12.0);
+  while (state.KeepRunning()) {
+    DoNotOptimize(drake::math::DiscreteAlgebraicRiccatiEquation(A, B, Q, R));
+  }
+}
+
+BENCHMARK(DARE, DrivetrainVelocity) {
+  auto plant = frc::LinearSystemId::DrivetrainVelocitySystem(
+      frc::DCMotor::CIM(2), 63.503_kg, 0.0746125_m, 0.4191_m, 5.6_kg_sq_m,
+      7.08);
+  Eigen::Matrix<double, 2, 2> A;
+  Eigen::Matrix<double, 2, 2> B;
+  frc::DiscretizeAB<2, 2>(plant.A(), plant.B(), 5_ms, &A, &B);
+  Eigen::Matrix<double, 2, 2> Q =
+      Eigen::Matrix<double, 2, 2>::Identity() / (0.1 * 0.1);
+  Eigen::Matrix<double, 2, 2> R =
+      Eigen::Matrix<double, 2, 2>::Identity() / (12.0 * 12.0);
+  while (state.KeepRunning()) {
+    DoNotOptimize(drake::math::DiscreteAlgebraicRiccatiEquation(A, B, Q, R));
+  }
+}
+
+BENCHMARK(DiscretizeAQ, Drivetrain) {
+  // The linearized 5-state drivetrain model the EKF and UKF discretize
+  Eigen::Matrix<double, 5, 1> x;
+  x << 2.0, 1.0, 0.5, 1.5, 2.0;
+  Eigen::Matrix<double, 2, 1> u{6.0, 8.0};
+  Eigen::Matrix<double, 5, 5> contA = frc::NumericalJacobianX<5, 5, 2>(
+      frc::DrivetrainDynamics<double>, x, u);
+  Eigen::Matrix<double, 5, 1> stdDevs;
+  stdDevs << 0.5, 0.5, 10.0, 1.0, 1.0;
+  Eigen::Matrix<double, 5, 5> contQ =
+      stdDevs.array().square().matrix().asDiagonal();
+
+  Eigen::Matrix<double, 5, 5> discA;
+  Eigen::Matrix<double, 5, 5> discQ;
+  while (state.KeepRunning()) {
+    frc::DiscretizeAQ<5>(contA, contQ, 5_ms, &discA, &discQ);
+    DoNotOptimize(discQ);
+  }
+}
@@ -0,0 +1,37 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <vector>
+
+#include "Benchmark.h"
+#include "frc/trajectory/TrajectoryGenerator.h"
+#include "frc/trajectory/constraint/CentripetalAccelerationConstraint.h"
+
+using frc::bench::DoNotOptimize;
+
+BENCHMARK(TrajectoryGenerator, QuinticWaypoints) {
+  // An auto path across the field
+  std::vector<frc::Pose2d> waypoints{
+      frc::Pose2d{1_m, 1_m, 0_deg}, frc::Pose2d{4_m, 2_m, 30_deg},
+      frc::Pose2d{7_m, 2.5_m, -15_deg}, frc::Pose2d{11_m, 1_m, 0_deg}};
+  frc::TrajectoryConfig config{3_mps, 2_mps_sq};
+  config.AddConstraint(frc::CentripetalAccelerationConstraint{2_mps_sq});
+  while (state.KeepRunning()) {
+    DoNotOptimize(
+        frc::TrajectoryGenerator::GenerateTrajectory(waypoints, config));
+  }
+}
+
+BENCHMARK(TrajectoryGenerator, CubicInteriorWaypoints) {
+  frc::Pose2d start{1_m, 1_m, 0_deg};
+  std::vector<frc::Translation2d> interiorWaypoints{
+      frc::Translation2d{4_m, 2_m}, frc::Translation2d{7_m, 2.5_m}};
+  frc::Pose2d end{11_m, 1_m, 0_deg};
+  frc::TrajectoryConfig config{3_mps, 2_mps_sq};
+  config.AddConstraint(frc::CentripetalAccelerationConstraint{2_mps_sq});
+  while (state.KeepRunning()) {
+    DoNotOptimize(frc::TrajectoryGenerator::GenerateTrajectory(
+        start, interiorWaypoints, end, config));
+  }
+}
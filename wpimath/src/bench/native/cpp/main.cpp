@@ -0,0 +1,171 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+// Runs the wpimath benchmarks and reports the time and heap allocations per
+// operation.
+//
+// Usage: wpimath_bench [--min-time=<seconds>] [filter]
+//
+// Only benchmarks whose names contain the filter are run.
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Benchmark.h"
+
+using namespace frc::bench;
+
+static std::atomic<uint64_t> gAllocations{0};
+
+#ifdef __GLIBC__
+// Count every allocation in the process, including those made by wpimath and
+// Eigen, by interposing the glibc allocation functions
+extern "C" {
+void* __libc_malloc(size_t size) noexcept;
+void* __libc_calloc(size_t count, size_t size) noexcept;
+void* __libc_realloc(void* ptr, size_t size) noexcept;
+void* __libc_memalign(size_t alignment, size_t size) noexcept;
+
+void* malloc(size_t size) noexcept {
+  gAllocations.fetch_add(1, std::memory_order_relaxed);
+  return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) noexcept {
+  gAllocations.fetch_add(1, std::memory_order_relaxed);
+  return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, size_t size) noexcept {
+  gAllocations.fetch_add(1, std::memory_order_relaxed);
+  return __libc_realloc(ptr, size);
+}
+
+void* aligned_alloc(size_t alignment, size_t size) noexcept {
+  gAllocations.fetch_add(1, std::memory_order_relaxed);
+  return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void** ptr, size_t alignment, size_t size) noexcept {
+  gAllocations.fetch_add(1, std::memory_order_relaxed);
+  *ptr = __libc_memalign(alignment, size);
+  return *ptr ? 0 : ENOMEM;
+}
+}  // extern "C"
+#endif
+
+namespace {
+struct Benchmark {
+  std::string name;
+  BenchmarkFunc func;
+};
+
+std::vector<Benchmark>& GetBenchmarks() {
+  static std::vector<Benchmark> benchmarks;
+  return benchmarks;
+}
+}  // namespace
+
+bool State::StartOrStop() {
+  if (!m_started) {
+    m_started = true;
+    m_remaining = m_iterations - 1;
+    m_startAllocations = GetAllocationCount();
+    m_start = std::chrono::steady_clock::now();
+    return true;
+  }
+  m_elapsed = std::chrono::steady_clock::now() - m_start;
+  m_allocations = GetAllocationCount() - m_startAllocations;
+  return false;
+}
+
+bool frc::bench::RegisterBenchmark(std::string_view name,
+                                   BenchmarkFunc func) {
+  GetBenchmarks().emplace_back(Benchmark{std::string{name}, func});
+  return true;
+}
+
+bool frc::bench::CountsAllocations() {
+#ifdef __GLIBC__
+  return true;
+#else
+  return false;
+#endif
+}
+
+uint64_t frc::bench::GetAllocationCount() {
+  return gAllocations.load(std::memory_order_relaxed);
+}
+
+// Runs a benchmark with increasing iteration counts until one run takes at
+// least minTime, which also warms up caches and lazily initialized state
+static State Run(BenchmarkFunc func, std::chrono::nanoseconds minTime) {
+  uint64_t iterations = 1;
+  for (;;) {
+    State state{iterations};
+    func(state);
+    auto elapsed = state.GetElapsed();
+    if (elapsed >= minTime || iterations >= 1'000'000'000) {
+      return state;
+    }
+
+    // Aim 20% past the minimum time, growing by at most 10x per run
+    double scale = elapsed.count() > 0
+                       ? 1.2 * minTime.count() / elapsed.count()
+                       : 10.0;
+    iterations = std::max<uint64_t>(
+        iterations + 1, iterations * std::min(scale, 10.0));
+  }
+}
+
+int main(int argc, char** argv) {
+  std::string_view filter;
+  std::chrono::nanoseconds minTime = std::chrono::milliseconds{500};
+  for (int i = 1; i < argc; ++i) {
+    std::string_view arg{argv[i]};
+    if (arg.substr(0, 11) == "--min-time=") {
+      minTime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::duration<double>{std::atof(argv[i] + 11)});
+    } else if (arg.substr(0, 2) == "--") {
+      fmt::print(stderr, "Usage: {} [--min-time=<seconds>] [filter]\n",
+                 argv[0]);
+      return 1;
+    } else {
+      filter = arg;
+    }
+  }
+
+  auto& benchmarks = GetBenchmarks();
+  std::sort(benchmarks.begin(), benchmarks.end(),
+            [](const auto& a, const auto& b) { return a.name < b.name; });
+
+  fmt::print("{:<52} {:>12} {:>12} {:>12}\n", "Benchmark", "Iterations",
+             "ns/op", "allocs/op");
+  for (auto&& benchmark : benchmarks) {
+    if (benchmark.name.find(filter) == std::string::npos) {
+      continue;
+    }
+
+    auto state = Run(benchmark.func, minTime);
+    double iterations = state.GetIterations();
+    std::string allocs =
+        CountsAllocations()
+            ? fmt::format("{:.2f}", state.GetAllocations() / iterations)
+            : "-";
+    fmt::print("{:<52} {:>12} {:>12.1f} {:>12}\n", benchmark.name,
+               state.GetIterations(), state.GetElapsed().count() / iterations,
+               allocs);
+  }
+}
@@ -4,6 +4,9 @@
 
 #include "frc/estimator/DifferentialDrivePoseEstimator.h"
 
+#include <tuple>
+
+#include <wpi/SmallVector.h>
 #include <wpi/timestamp.h>
 
 #include "frc/StateSpaceUtil.h"
@@ -76,6 +79,66 @@ void DifferentialDrivePoseEstimator::AddVisionMeasurement(
       m_visionCorrect, timestamp);
 }
 
+void DifferentialDrivePoseEstimator::AddVisionMeasurements(
+    wpi::span<const std::pair<Pose2d, units::second_t>> visionMeasurements) {
+  if (visionMeasurements.size() == 1) {
+    // Skip copying the measurement into a batch
+    AddVisionMeasurement(visionMeasurements[0].first,
+                         visionMeasurements[0].second);
+    return;
+  }
+
+  wpi::SmallVector<std::pair<units::second_t, Eigen::Matrix<double, 3, 1>>, 4>
+      measurements;
+  for (auto&& [pose, timestamp] : visionMeasurements) {
+    measurements.emplace_back(timestamp, PoseTo3dVector(pose));
+  }
+  m_latencyCompensator.ApplyPastGlobalMeasurements<Eigen::Vector3d>(
+      &m_observer, m_nominalDt, measurements, m_visionCorrect);
+}
+
+void DifferentialDrivePoseEstimator::AddVisionMeasurements(
+    wpi::span<const std::tuple<Pose2d, units::second_t,
+                               wpi::array<double, 3>>>
+        visionMeasurements) {
+  if (visionMeasurements.empty()) {
+    return;
+  }
+  if (visionMeasurements.size() == 1) {
+    auto& [pose, timestamp, stdDevs] = visionMeasurements[0];
+    AddVisionMeasurement(pose, timestamp, stdDevs);
+    return;
+  }
+
+  // Each measurement carries its own vision measurement covariance
+  using VisionMeasurement =
+      std::pair<Eigen::Matrix<double, 3, 1>, Eigen::Matrix<double, 3, 3>>;
+  wpi::SmallVector<std::pair<units::second_t, VisionMeasurement>, 4>
+      measurements;
+  size_t newest = 0;
+  for (size_t i = 0; i < visionMeasurements.size(); ++i) {
+    auto& [pose, timestamp, stdDevs] = visionMeasurements[i];
+    if (timestamp >= std::get<1>(visionMeasurements[newest])) {
+      newest = i;
+    }
+    measurements.emplace_back(
+        timestamp,
+        VisionMeasurement{PoseTo3dVector(pose), frc::MakeCovMatrix(stdDevs)});
+  }
+  Eigen::Matrix<double, 3, 3> newestR = measurements[newest].second.second;
+
+  m_latencyCompensator.ApplyPastGlobalMeasurements<VisionMeasurement>(
+      &m_observer, m_nominalDt, measurements,
+      [&](const Eigen::Matrix<double, 3, 1>& u, const VisionMeasurement& y) {
+        m_visionContR = y.second;
+        m_visionCorrect(u, y.first);
+      });
+
+  // Like AddVisionMeasurement(), leave the newest standard deviations in
+  // effect for future measurements
+  m_visionContR = newestR;
+}
+
 Pose2d DifferentialDrivePoseEstimator::Update(
     const Rotation2d& gyroAngle,
     const DifferentialDriveWheelSpeeds& wheelSpeeds,
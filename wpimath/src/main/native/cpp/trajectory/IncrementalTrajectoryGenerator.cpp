@@ -0,0 +1,247 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc/trajectory/IncrementalTrajectoryGenerator.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "frc/spline/SplineHelper.h"
+#include "frc/trajectory/TrajectoryGenerator.h"
+
+using namespace frc;
+
+namespace {
+// Replaces the oldCount elements of vec starting at pos with newCount elements,
+// keeping the elements after them.
+template <typename T>
+void ResizeRange(std::vector<T>* vec, size_t pos, size_t oldCount,
+                 size_t newCount) {
+  if (newCount > oldCount) {
+    vec->insert(vec->begin() + pos + oldCount, newCount - oldCount, T{});
+  } else {
+    vec->erase(vec->begin() + pos + newCount, vec->begin() + pos + oldCount);
+  }
+}
+}  // namespace
+
+IncrementalTrajectoryGenerator::IncrementalTrajectoryGenerator(
+    std::vector<Pose2d> waypoints, TrajectoryConfig config)
+    : m_waypoints(std::move(waypoints)), m_config(std::move(config)) {
+  Regenerate(0, m_waypoints.size() - 2);
+}
+
+const Trajectory& IncrementalTrajectoryGenerator::SetWaypoint(
+    size_t index, const Pose2d& pose) {
+  m_waypoints[index] = pose;
+
+  // The splines before and after the waypoint
+  Regenerate(index == 0 ? 0 : index - 1,
+             std::min(index, m_waypoints.size() - 2));
+  return m_trajectory;
+}
+
+const Trajectory& IncrementalTrajectoryGenerator::SetWaypoints(
+    const std::vector<Pose2d>& waypoints) {
+  if (waypoints.size() != m_waypoints.size()) {
+    m_waypoints = waypoints;
+    m_points.clear();
+    Regenerate(0, m_waypoints.size() - 2);
+    return m_trajectory;
+  }
+
+  size_t first = 0;
+  while (first < waypoints.size() && waypoints[first] == m_waypoints[first]) {
+    ++first;
+  }
+  if (first == waypoints.size()) {
+    return m_trajectory;
+  }
+  size_t last = waypoints.size() - 1;
+  while (waypoints[last] == m_waypoints[last]) {
+    --last;
+  }
+
+  m_waypoints = waypoints;
+  Regenerate(first == 0 ? 0 : first - 1,
+             std::min(last, m_waypoints.size() - 2));
+  return m_trajectory;
+}
+
+void IncrementalTrajectoryGenerator::Regenerate(size_t firstSpline,
+                                                size_t lastSpline) {
+  const Transform2d flip{Translation2d(), Rotation2d(180_deg)};
+
+  bool full = m_points.empty();
+  if (full) {
+    firstSpline = 0;
+    lastSpline = m_waypoints.size() - 2;
+  }
+
+  // Parameterize the changed splines. Like
+  // TrajectoryGenerator::SplinePointsFromSplines(), the first point of each
+  // spline after the first is dropped because it's a duplicate of the last
+  // point of the previous spline.
+  PoseWithCurvature firstPoint;
+  std::vector<PoseWithCurvature> points;
+  std::vector<size_t> splineEnds;
+  try {
+    for (size_t i = firstSpline; i <= lastSpline; ++i) {
+      // Make theta normal for trajectory generation if path is reversed.
+      std::vector<Pose2d> waypoints{m_waypoints[i], m_waypoints[i + 1]};
+      if (m_config.IsReversed()) {
+        for (auto& waypoint : waypoints) {
+          waypoint = waypoint + flip;
+        }
+      }
+
+      auto splinePoints = SplineParameterizer::Parameterize(
+          SplineHelper::QuinticSplinesFromWaypoints(waypoints).front());
+      if (i == 0) {
+        firstPoint = splinePoints.front();
+      }
+      points.insert(points.end(), splinePoints.begin() + 1,
+                    splinePoints.end());
+      splineEnds.emplace_back(points.size());
+    }
+  } catch (SplineParameterizer::MalformedSplineException& e) {
+    TrajectoryGenerator::ReportError(e.what());
+    m_points.clear();
+    m_trajectory = TrajectoryGenerator::kDoNothingTrajectory;
+    return;
+  }
+
+  // After trajectory generation, flip theta back so it's relative to the
+  // field. Also fix curvature.
+  if (m_config.IsReversed()) {
+    firstPoint = {firstPoint.first + flip, -firstPoint.second};
+    for (auto& point : points) {
+      point = {point.first + flip, -point.second};
+    }
+  }
+
+  // Splice the new points in place of the old ones. The states after them
+  // keep their old values so the passes below can compare against them.
+  size_t start = firstSpline == 0 ? 0 : m_splineEnds[firstSpline - 1];
+  size_t oldCount = 0;
+  if (full) {
+    m_points.assign(1, firstPoint);
+    m_splineEnds.assign(m_waypoints.size() - 1, 0);
+    m_forwardStates.assign(1, ConstrainedState{});
+    m_constrainedStates.assign(1, ConstrainedState{});
+    m_states.assign(1, Trajectory::State{});
+  } else {
+    oldCount = m_splineEnds[lastSpline] - start;
+  }
+  size_t newCount = points.size();
+
+  ResizeRange(&m_points, start + 1, oldCount, newCount);
+  ResizeRange(&m_forwardStates, start + 1, oldCount, newCount);
+  ResizeRange(&m_constrainedStates, start + 1, oldCount, newCount);
+  ResizeRange(&m_states, start + 1, oldCount, newCount);
+
+  if (firstSpline == 0) {
+    m_points[0] = firstPoint;
+  }
+  std::copy(points.begin(), points.end(), m_points.begin() + start + 1);
+  for (size_t i = firstSpline; i <= lastSpline; ++i) {
+    m_splineEnds[i] = start + splineEnds[i - firstSpline];
+  }
+  for (size_t i = lastSpline + 1; i < m_splineEnds.size(); ++i) {
+    m_splineEnds[i] = m_splineEnds[i] + newCount - oldCount;
+  }
+
+  // Points before begin and from changedEnd on are unchanged
+  size_t begin = firstSpline == 0 ? 0 : start + 1;
+  size_t changedEnd = full ? m_points.size() : start + newCount + 1;
+
+  try {
+    size_t forwardEnd = ForwardPass(begin, changedEnd);
+    size_t integrateBegin = BackwardPass(forwardEnd, full ? 0 : begin);
+    TrajectoryParameterizer::IntegrateStates(m_constrainedStates,
+                                             m_config.IsReversed(),
+                                             integrateBegin, &m_states);
+  } catch (...) {
+    m_points.clear();
+    throw;
+  }
+
+  m_trajectory = Trajectory{m_states};
+}
+
+size_t IncrementalTrajectoryGenerator::ForwardPass(size_t begin,
+                                                   size_t compareFrom) {
+  auto maxAcceleration = m_config.MaxAcceleration();
+
+  ConstrainedState predecessor =
+      begin == 0 ? ConstrainedState{m_points.front(), 0_m,
+                                    m_config.StartVelocity(), -maxAcceleration,
+                                    maxAcceleration}
+                 : m_forwardStates[begin - 1];
+
+  for (size_t i = begin; i < m_points.size(); ++i) {
+    ConstrainedState state;
+    state.pose = m_points[i];
+    TrajectoryParameterizer::ForwardStep(
+        m_config.Constraints(), m_config.MaxVelocity(), maxAcceleration,
+        m_config.IsReversed(), &predecessor, &state);
+
+    // Each forward state only depends on its predecessor, so once a state
+    // after the changed points matches its old value, the rest of the old
+    // states are still valid once their distances are shifted. So are the
+    // backward pass states from there on, since they only depend on later
+    // states.
+    if (i >= compareFrom && SameProfile(state, m_forwardStates[i])) {
+      units::meter_t shift = state.distance - m_forwardStates[i].distance;
+      m_forwardStates[i] = state;
+      for (size_t j = i + 1; j < m_points.size(); ++j) {
+        m_forwardStates[j].distance += shift;
+      }
+      for (size_t j = i; j < m_points.size(); ++j) {
+        m_constrainedStates[j].distance += shift;
+      }
+      return i;
+    }
+
+    m_forwardStates[i] = state;
+    predecessor = state;
+  }
+  return m_points.size();
+}
+
+size_t IncrementalTrajectoryGenerator::BackwardPass(size_t end,
+                                                    size_t compareBefore) {
+  auto maxAcceleration = m_config.MaxAcceleration();
+
+  ConstrainedState successor =
+      end == m_points.size()
+          ? ConstrainedState{m_points.back(), m_forwardStates.back().distance,
+                             m_config.EndVelocity(), -maxAcceleration,
+                             maxAcceleration}
+          : m_constrainedStates[end];
+
+  for (size_t i = end; i-- > 0;) {
+    ConstrainedState state = m_forwardStates[i];
+    TrajectoryParameterizer::BackwardStep(m_config.Constraints(),
+                                          m_config.IsReversed(), &successor,
+                                          &state);
+
+    // Before the changed points, the forward states are unchanged, so once a
+    // state matches its old value so do all of the states before it
+    if (i < compareBefore && SameProfile(state, m_constrainedStates[i])) {
+      return i + 1;
+    }
+
+    m_constrainedStates[i] = state;
+    successor = state;
+  }
+  return 0;
+}
+
+bool IncrementalTrajectoryGenerator::SameProfile(const ConstrainedState& a,
+                                                 const ConstrainedState& b) {
+  return a.maxVelocity == b.maxVelocity &&
+         a.minAcceleration == b.minAcceleration &&
+         a.maxAcceleration == b.maxAcceleration;
+}
@@ -63,6 +63,10 @@ Trajectory::State Trajectory::State::Interpolate(State endValue,
 }
 
 Trajectory::Trajectory(const std::vector<State>& states) : m_states(states) {
+  m_times.reserve(states.size());
+  for (auto&& state : states) {
+    m_times.emplace_back(state.t);
+  }
   m_totalTime = states.back().t;
 }
 
@@ -77,11 +81,26 @@ Trajectory::State Trajectory::Sample(units::second_t t) const {
   // Use binary search to get the element with a timestamp no less than the
   // requested timestamp. This starts at 1 because we use the previous state
   // later on for interpolation.
-  auto sample =
-      std::lower_bound(m_states.cbegin() + 1, m_states.cend(), t,
-                       [](const auto& a, const auto& b) { return a.t < b; });
+  auto sample = std::lower_bound(m_times.cbegin() + 1, m_times.cend(), t);
 
-  auto prevSample = sample - 1;
+  return Interpolate(sample - m_times.cbegin(), t);
+}
+
+std::vector<Trajectory::State> Trajectory::SampleMany(
+    wpi::span<const units::second_t> times) const {
+  std::vector<State> states;
+  states.reserve(times.size());
+  Sampler sampler{*this};
+  for (auto t : times) {
+    states.emplace_back(sampler.Sample(t));
+  }
+  return states;
+}
+
+Trajectory::State Trajectory::Interpolate(size_t index,
+                                          units::second_t t) const {
+  auto& sample = m_states[index];
+  auto& prevSample = m_states[index - 1];
 
   // The sample's timestamp is now greater than or equal to the requested
   // timestamp. If it is greater, we need to interpolate between the
@@ -89,12 +108,47 @@ Trajectory::State Trajectory::Sample(units::second_t t) const {
   // want.
 
   // If the difference in states is negligible, then we are spot on!
-  if (units::math::abs(sample->t - prevSample->t) < 1E-9_s) {
-    return *sample;
+  if (units::math::abs(sample.t - prevSample.t) < 1E-9_s) {
+    return sample;
   }
   // Interpolate between the two states for the state that we want.
-  return prevSample->Interpolate(
-      *sample, (t - prevSample->t) / (sample->t - prevSample->t));
+  return prevSample.Interpolate(sample,
+                                (t - prevSample.t) / (sample.t - prevSample.t));
+}
+
+Trajectory::State Trajectory::Sampler::Sample(units::second_t t) {
+  auto& times = m_trajectory->m_times;
+  if (t <= times.front()) {
+    m_index = 1;
+    return m_trajectory->m_states.front();
+  }
+  if (t >= m_trajectory->m_totalTime) {
+    m_index = times.size() - 1;
+    return m_trajectory->m_states.back();
+  }
+
+  // Find the first state with a timestamp no less than t, like Sample().
+  // There's always one since t is less than the total time.
+  if (m_index >= times.size() || times[m_index - 1] >= t) {
+    // Time went backwards, so search the states before the previous sample
+    m_index = std::lower_bound(times.cbegin() + 1,
+                               times.cbegin() + std::min(m_index, times.size()),
+                               t) -
+              times.cbegin();
+  } else {
+    // Walk forward a few states, which is enough for a control loop, then
+    // fall back to a binary search for large jumps
+    size_t end = m_index + kMaxLinearSteps;
+    while (m_index < end && times[m_index] < t) {
+      ++m_index;
+    }
+    if (m_index == end) {
+      m_index = std::lower_bound(times.cbegin() + m_index, times.cend(), t) -
+                times.cbegin();
+    }
+  }
+
+  return m_trajectory->Interpolate(m_index, t);
 }
 
 Trajectory Trajectory::TransformBy(const Transform2d& transform) {
@@ -4,9 +4,16 @@
 
 #include "frc/trajectory/TrajectoryGenerator.h"
 
+#include <algorithm>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <thread>
 #include <utility>
 
 #include <fmt/format.h>
+#include <wpi/condition_variable.h>
+#include <wpi/mutex.h>
 
 #include "frc/spline/SplineHelper.h"
 #include "frc/spline/SplineParameterizer.h"
@@ -14,9 +21,125 @@
 
 using namespace frc;
 
+namespace {
+// Worker threads are started on first use and reused for later calls, so
+// generating a trajectory doesn't pay for thread creation.
+class WorkerPool {
+ public:
+  ~WorkerPool();
+
+  void Run(size_t count, size_t numThreads,
+           const std::function<void(size_t)>& func);
+
+ private:
+  struct Job {
+    const std::function<void(size_t)>* func;
+    size_t count;
+    std::atomic<size_t> next{0};
+    size_t done = 0;  // protected by m_mutex
+    std::exception_ptr error;
+  };
+
+  void RunTasks(Job& job);
+  void WorkerMain();
+
+  wpi::mutex m_mutex;
+  wpi::condition_variable m_workCv;
+  wpi::condition_variable m_doneCv;
+  std::deque<std::shared_ptr<Job>> m_jobs;
+  std::vector<std::thread> m_threads;
+  bool m_stop = false;
+};
+}  // namespace
+
+WorkerPool::~WorkerPool() {
+  {
+    std::scoped_lock lock(m_mutex);
+    m_stop = true;
+  }
+  m_workCv.notify_all();
+  for (auto&& thread : m_threads) {
+    thread.join();
+  }
+}
+
+void WorkerPool::Run(size_t count, size_t numThreads,
+                     const std::function<void(size_t)>& func) {
+  auto job = std::make_shared<Job>();
+  job->func = &func;
+  job->count = count;
+  {
+    std::scoped_lock lock(m_mutex);
+    // The calling thread is one of the threads
+    while (m_threads.size() + 1 < numThreads) {
+      m_threads.emplace_back([this] { WorkerMain(); });
+    }
+    m_jobs.emplace_back(job);
+  }
+  m_workCv.notify_all();
+
+  RunTasks(*job);
+
+  std::unique_lock lock(m_mutex);
+  m_doneCv.wait(lock, [&] { return job->done == job->count; });
+  auto it = std::find(m_jobs.begin(), m_jobs.end(), job);
+  if (it != m_jobs.end()) {
+    m_jobs.erase(it);
+  }
+  if (job->error) {
+    std::rethrow_exception(job->error);
+  }
+}
+
+void WorkerPool::RunTasks(Job& job) {
+  for (size_t i = job.next++; i < job.count; i = job.next++) {
+    std::exception_ptr error;
+    try {
+      (*job.func)(i);
+    } catch (...) {
+      error = std::current_exception();
+    }
+
+    std::scoped_lock lock(m_mutex);
+    if (error && !job.error) {
+      job.error = error;
+    }
+    if (++job.done == job.count) {
+      m_doneCv.notify_all();
+    }
+  }
+}
+
+void WorkerPool::WorkerMain() {
+  std::unique_lock lock(m_mutex);
+  for (;;) {
+    m_workCv.wait(lock, [&] { return m_stop || !m_jobs.empty(); });
+    if (m_stop) {
+      return;
+    }
+    auto job = m_jobs.front();
+    if (job->next >= job->count) {
+      // every task has been claimed
+      m_jobs.pop_front();
+      continue;
+    }
+    lock.unlock();
+    RunTasks(*job);
+    lock.lock();
+  }
+}
+
 const Trajectory TrajectoryGenerator::kDoNothingTrajectory(
     std::vector<Trajectory::State>{Trajectory::State()});
 std::function<void(const char*)> TrajectoryGenerator::s_errorFunc;
+std::atomic<unsigned int> TrajectoryGenerator::s_maxThreads{
+    std::max(std::thread::hardware_concurrency(), 1u)};
+
+void TrajectoryGenerator::RunInParallel(
+    size_t count, const std::function<void(size_t)>& func) {
+  static WorkerPool pool;
+  pool.Run(count, std::min<size_t>(count, s_maxThreads), func);
+}
 
 void TrajectoryGenerator::ReportError(const char* error) {
   if (s_errorFunc) {
@@ -52,66 +52,8 @@ Trajectory TrajectoryParameterizer::TimeParameterizeTrajectory(
   for (unsigned int i = 0; i < points.size(); i++) {
     auto& constrainedState = constrainedStates[i];
     constrainedState.pose = points[i];
-
-    // Begin constraining based on predecessor
-    units::meter_t ds = constrainedState.pose.first.Translation().Distance(
-        predecessor.pose.first.Translation());
-    constrainedState.distance = ds + predecessor.distance;
-
-    // We may need to iterate to find the maximum end velocity and common
-    // acceleration, since acceleration limits may be a function of velocity.
-    while (true) {
-      // Enforce global max velocity and max reachable velocity by global
-      // acceleration limit. vf = std::sqrt(vi^2 + 2*a*d).
-
-      constrainedState.maxVelocity = units::math::min(
-          maxVelocity,
-          units::math::sqrt(predecessor.maxVelocity * predecessor.maxVelocity +
-                            predecessor.maxAcceleration * ds * 2.0));
-
-      constrainedState.minAcceleration = -maxAcceleration;
-      constrainedState.maxAcceleration = maxAcceleration;
-
-      // At this point, the constrained state is fully constructed apart from
-      // all the custom-defined user constraints.
-      for (const auto& constraint : constraints) {
-        constrainedState.maxVelocity = units::math::min(
-            constrainedState.maxVelocity,
-            constraint->MaxVelocity(constrainedState.pose.first,
-                                    constrainedState.pose.second,
-                                    constrainedState.maxVelocity));
-      }
-
-      // Now enforce all acceleration limits.
-      EnforceAccelerationLimits(reversed, constraints, &constrainedState);
-
-      if (ds.to<double>() < kEpsilon) {
-        break;
-      }
-
-      // If the actual acceleration for this state is higher than the max
-      // acceleration that we applied, then we need to reduce the max
-      // acceleration of the predecessor and try again.
-      units::meters_per_second_squared_t actualAcceleration =
-          (constrainedState.maxVelocity * constrainedState.maxVelocity -
-           predecessor.maxVelocity * predecessor.maxVelocity) /
-          (ds * 2.0);
-
-      // If we violate the max acceleration constraint, let's modify the
-      // predecessor.
-      if (constrainedState.maxAcceleration < actualAcceleration - 1E-6_mps_sq) {
-        predecessor.maxAcceleration = constrainedState.maxAcceleration;
-      } else {
-        // Constrain the predecessor's max acceleration to the current
-        // acceleration.
-        if (actualAcceleration > predecessor.minAcceleration + 1E-6_mps_sq) {
-          predecessor.maxAcceleration = actualAcceleration;
-        }
-        // If the actual acceleration is less than the predecessor's min
-        // acceleration, it will be repaired in the backward pass.
-        break;
-      }
-    }
+    ForwardStep(constraints, maxVelocity, maxAcceleration, reversed,
+                &predecessor, &constrainedState);
     predecessor = constrainedState;
   }
 
@@ -121,56 +63,141 @@ Trajectory TrajectoryParameterizer::TimeParameterizeTrajectory(
   // Backward pass
   for (int i = points.size() - 1; i >= 0; i--) {
     auto& constrainedState = constrainedStates[i];
-    units::meter_t ds =
-        constrainedState.distance - successor.distance;  // negative
-
-    while (true) {
-      // Enforce max velocity limit (reverse)
-      // vf = std::sqrt(vi^2 + 2*a*d), where vi = successor.
-      units::meters_per_second_t newMaxVelocity =
-          units::math::sqrt(successor.maxVelocity * successor.maxVelocity +
-                            successor.minAcceleration * ds * 2.0);
-
-      // No more limits to impose! This state can be finalized.
-      if (newMaxVelocity >= constrainedState.maxVelocity) {
-        break;
-      }
+    BackwardStep(constraints, reversed, &successor, &constrainedState);
+    successor = constrainedState;
+  }
 
-      constrainedState.maxVelocity = newMaxVelocity;
+  // Now we can integrate the constrained states forward in time to obtain our
+  // trajectory states.
+  std::vector<Trajectory::State> states(points.size());
+  IntegrateStates(constrainedStates, reversed, 0, &states);
 
-      // Check all acceleration constraints with the new max velocity.
-      EnforceAccelerationLimits(reversed, constraints, &constrainedState);
+  return Trajectory(states);
+}
 
-      if (ds.to<double>() > -kEpsilon) {
-        break;
-      }
+void TrajectoryParameterizer::ForwardStep(
+    const std::vector<std::unique_ptr<TrajectoryConstraint>>& constraints,
+    units::meters_per_second_t maxVelocity,
+    units::meters_per_second_squared_t maxAcceleration, bool reversed,
+    ConstrainedState* predecessor, ConstrainedState* state) {
+  // Begin constraining based on predecessor
+  units::meter_t ds = state->pose.first.Translation().Distance(
+      predecessor->pose.first.Translation());
+  state->distance = ds + predecessor->distance;
+
+  // We may need to iterate to find the maximum end velocity and common
+  // acceleration, since acceleration limits may be a function of velocity.
+  while (true) {
+    // Enforce global max velocity and max reachable velocity by global
+    // acceleration limit. vf = std::sqrt(vi^2 + 2*a*d).
+
+    state->maxVelocity = units::math::min(
+        maxVelocity,
+        units::math::sqrt(predecessor->maxVelocity * predecessor->maxVelocity +
+                          predecessor->maxAcceleration * ds * 2.0));
+
+    state->minAcceleration = -maxAcceleration;
+    state->maxAcceleration = maxAcceleration;
+
+    // At this point, the constrained state is fully constructed apart from
+    // all the custom-defined user constraints.
+    for (const auto& constraint : constraints) {
+      state->maxVelocity = units::math::min(
+          state->maxVelocity,
+          constraint->MaxVelocity(state->pose.first, state->pose.second,
+                                  state->maxVelocity));
+    }
 
-      // If the actual acceleration for this state is lower than the min
-      // acceleration, then we need to lower the min acceleration of the
-      // successor and try again.
-      units::meters_per_second_squared_t actualAcceleration =
-          (constrainedState.maxVelocity * constrainedState.maxVelocity -
-           successor.maxVelocity * successor.maxVelocity) /
-          (ds * 2.0);
-      if (constrainedState.minAcceleration > actualAcceleration + 1E-6_mps_sq) {
-        successor.minAcceleration = constrainedState.minAcceleration;
-      } else {
-        successor.minAcceleration = actualAcceleration;
-        break;
+    // Now enforce all acceleration limits.
+    EnforceAccelerationLimits(reversed, constraints, state);
+
+    if (ds.to<double>() < kEpsilon) {
+      break;
+    }
+
+    // If the actual acceleration for this state is higher than the max
+    // acceleration that we applied, then we need to reduce the max
+    // acceleration of the predecessor and try again.
+    units::meters_per_second_squared_t actualAcceleration =
+        (state->maxVelocity * state->maxVelocity -
+         predecessor->maxVelocity * predecessor->maxVelocity) /
+        (ds * 2.0);
+
+    // If we violate the max acceleration constraint, let's modify the
+    // predecessor.
+    if (state->maxAcceleration < actualAcceleration - 1E-6_mps_sq) {
+      predecessor->maxAcceleration = state->maxAcceleration;
+    } else {
+      // Constrain the predecessor's max acceleration to the current
+      // acceleration.
+      if (actualAcceleration > predecessor->minAcceleration + 1E-6_mps_sq) {
+        predecessor->maxAcceleration = actualAcceleration;
       }
+      // If the actual acceleration is less than the predecessor's min
+      // acceleration, it will be repaired in the backward pass.
+      break;
     }
-    successor = constrainedState;
   }
+}
 
-  // Now we can integrate the constrained states forward in time to obtain our
-  // trajectory states.
+void TrajectoryParameterizer::BackwardStep(
+    const std::vector<std::unique_ptr<TrajectoryConstraint>>& constraints,
+    bool reversed, ConstrainedState* successor, ConstrainedState* state) {
+  units::meter_t ds = state->distance - successor->distance;  // negative
+
+  while (true) {
+    // Enforce max velocity limit (reverse)
+    // vf = std::sqrt(vi^2 + 2*a*d), where vi = successor.
+    units::meters_per_second_t newMaxVelocity =
+        units::math::sqrt(successor->maxVelocity * successor->maxVelocity +
+                          successor->minAcceleration * ds * 2.0);
+
+    // No more limits to impose! This state can be finalized.
+    if (newMaxVelocity >= state->maxVelocity) {
+      break;
+    }
 
-  std::vector<Trajectory::State> states(points.size());
+    state->maxVelocity = newMaxVelocity;
+
+    // Check all acceleration constraints with the new max velocity.
+    EnforceAccelerationLimits(reversed, constraints, state);
+
+    if (ds.to<double>() > -kEpsilon) {
+      break;
+    }
+
+    // If the actual acceleration for this state is lower than the min
+    // acceleration, then we need to lower the min acceleration of the
+    // successor and try again.
+    units::meters_per_second_squared_t actualAcceleration =
+        (state->maxVelocity * state->maxVelocity -
+         successor->maxVelocity * successor->maxVelocity) /
+        (ds * 2.0);
+    if (state->minAcceleration > actualAcceleration + 1E-6_mps_sq) {
+      successor->minAcceleration = state->minAcceleration;
+    } else {
+      successor->minAcceleration = actualAcceleration;
+      break;
+    }
+  }
+}
+
+void TrajectoryParameterizer::IntegrateStates(
+    const std::vector<ConstrainedState>& constrainedStates, bool reversed,
+    size_t begin, std::vector<Trajectory::State>* states) {
+  auto& trajectoryStates = *states;
   units::second_t t = 0_s;
   units::meter_t s = 0_m;
   units::meters_per_second_t v = 0_mps;
 
-  for (unsigned int i = 0; i < constrainedStates.size(); i++) {
+  // Continue from the state before begin
+  if (begin > 0) {
+    t = trajectoryStates[begin - 1].t;
+    s = constrainedStates[begin - 1].distance;
+    v = constrainedStates[begin - 1].maxVelocity;
+  }
+
+  for (size_t i = begin; i < constrainedStates.size(); i++) {
     auto state = constrainedStates[i];
 
     // Calculate the change in position between the current state and the
@@ -185,7 +212,7 @@ Trajectory TrajectoryParameterizer::TimeParameterizeTrajectory(
     // Calculate dt.
     units::second_t dt = 0_s;
     if (i > 0) {
-      states.at(i - 1).acceleration = reversed ? -accel : accel;
+      trajectoryStates.at(i - 1).acceleration = reversed ? -accel : accel;
       if (units::math::abs(accel) > 1E-6_mps_sq) {
         // v_f = v_0 + a * t
         dt = (state.maxVelocity - v) / accel;
@@ -204,11 +231,10 @@ Trajectory TrajectoryParameterizer::TimeParameterizeTrajectory(
 
     t += dt;
 
-    states[i] = {t, reversed ? -v : v, reversed ? -accel : accel,
-                 state.pose.first, state.pose.second};
+    trajectoryStates[i] = {t, reversed ? -v : v, reversed ? -accel : accel,
+                           state.pose.first, state.pose.second};
   }
 
-  return Trajectory(states);
 }
 
 void TrajectoryParameterizer::EnforceAccelerationLimits(
@@ -4,9 +4,12 @@
 
 #include "frc/trajectory/TrajectoryUtil.h"
 
+#include <cstring>
+#include <stdexcept>
 #include <system_error>
 
 #include <fmt/format.h>
+#include <wpi/Endian.h>
 #include <wpi/SmallString.h>
 #include <wpi/json.h>
 #include <wpi/raw_istream.h>
@@ -51,3 +54,71 @@ Trajectory TrajectoryUtil::DeserializeTrajectory(std::string_view json_str) {
   wpi::json json = wpi::json::parse(json_str);
   return Trajectory{json.get<std::vector<Trajectory::State>>()};
 }
+
+void TrajectoryUtil::ToBinary(const Trajectory& trajectory,
+                              std::string_view path, bool quantize) {
+  auto data = SerializeTrajectoryBinary(trajectory, quantize);
+
+  std::error_code error_code;
+
+  wpi::raw_fd_ostream output{path, error_code};
+  if (error_code) {
+    throw std::runtime_error(fmt::format("Cannot open file: {}", path));
+  }
+
+  output << wpi::span<const uint8_t>{data};
+  output.flush();
+}
+
+TrajectoryView TrajectoryUtil::FromBinary(std::string_view path) {
+  return TrajectoryView{path};
+}
+
+std::vector<uint8_t> TrajectoryUtil::SerializeTrajectoryBinary(
+    const Trajectory& trajectory, bool quantize) {
+  using namespace wpi::support::endian;
+
+  const auto& states = trajectory.States();
+  if (states.empty()) {
+    throw std::invalid_argument("Cannot serialize a trajectory with no states");
+  }
+
+  size_t fieldSize = quantize ? 4 : 8;
+  std::vector<uint8_t> data(TrajectoryView::kHeaderSize +
+                            states.size() * TrajectoryView::kFieldsPerState *
+                                fieldSize);
+
+  std::memcpy(data.data(), "WPITRAJ", 8);
+  write16le(data.data() + 8, TrajectoryView::kVersion);
+  write16le(data.data() + 10, quantize ? TrajectoryView::kQuantizedFlag : 0);
+  write32le(data.data() + 12, states.size());
+
+  uint8_t* out = data.data() + TrajectoryView::kHeaderSize;
+  for (auto&& state : states) {
+    for (double value :
+         {state.t.to<double>(), state.velocity.to<double>(),
+          state.acceleration.to<double>(), state.pose.X().to<double>(),
+          state.pose.Y().to<double>(),
+          state.pose.Rotation().Radians().to<double>(),
+          state.curvature.to<double>()}) {
+      if (quantize) {
+        float floatValue = value;
+        uint32_t bits;
+        std::memcpy(&bits, &floatValue, sizeof(bits));
+        write32le(out, bits);
+      } else {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        write64le(out, bits);
+      }
+      out += fieldSize;
+    }
+  }
+  return data;
+}
+
+void TrajectoryUtil::PathweaverJsonToBinary(std::string_view jsonPath,
+                                            std::string_view binaryPath,
+                                            bool quantize) {
+  ToBinary(FromPathweaverJson(jsonPath), binaryPath, quantize);
+}
@@ -0,0 +1,150 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc/trajectory/TrajectoryView.h"
+
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+
+#include <fmt/format.h>
+#include <wpi/Endian.h>
+#include <wpi/fs.h>
+
+#include "units/math.h"
+
+using namespace frc;
+
+TrajectoryView::TrajectoryView(std::string_view path) {
+  std::error_code ec;
+  fs::path fsPath{path};
+  uint64_t fileSize = fs::file_size(fsPath, ec);
+  if (ec) {
+    throw std::runtime_error(fmt::format("Cannot open file: {}", path));
+  }
+  if (fileSize < kHeaderSize) {
+    throw std::runtime_error(
+        fmt::format("Not a binary trajectory file: {}", path));
+  }
+
+  fs::file_t f = fs::OpenFileForRead(fsPath, ec);
+  if (ec) {
+    throw std::runtime_error(fmt::format("Cannot open file: {}", path));
+  }
+  m_file = wpi::MappedFileRegion{f, fileSize, 0, ec};
+  fs::CloseFile(f);
+  if (ec) {
+    throw std::runtime_error(fmt::format("Cannot map file: {}", path));
+  }
+
+  Init({m_file.data(), m_file.size()}, path);
+}
+
+TrajectoryView::TrajectoryView(wpi::span<const uint8_t> data) {
+  Init(data, "<memory>");
+}
+
+void TrajectoryView::Init(wpi::span<const uint8_t> data,
+                          std::string_view name) {
+  using namespace wpi::support::endian;
+
+  if (data.size() < kHeaderSize ||
+      std::memcmp(data.data(), "WPITRAJ", 8) != 0) {
+    throw std::runtime_error(
+        fmt::format("Not a binary trajectory file: {}", name));
+  }
+
+  uint16_t version = read16le(data.data() + 8);
+  if (version != kVersion) {
+    throw std::runtime_error(fmt::format(
+        "Unsupported binary trajectory version {}: {}", version, name));
+  }
+
+  m_quantized = (read16le(data.data() + 10) & kQuantizedFlag) != 0;
+  m_size = read32le(data.data() + 12);
+  if (m_size == 0) {
+    // Sample() needs at least one state, like Trajectory
+    throw std::runtime_error(
+        fmt::format("Binary trajectory has no states: {}", name));
+  }
+
+  size_t stateSize = kFieldsPerState * (m_quantized ? 4 : 8);
+  if ((data.size() - kHeaderSize) / stateSize < m_size) {
+    throw std::runtime_error(
+        fmt::format("Truncated binary trajectory file: {}", name));
+  }
+
+  m_states = data.data() + kHeaderSize;
+  m_totalTime = units::second_t{GetField(m_size - 1, 0)};
+}
+
+double TrajectoryView::GetField(size_t index, size_t field) const {
+  using namespace wpi::support::endian;
+
+  if (m_quantized) {
+    uint32_t bits =
+        read32le(m_states + (index * kFieldsPerState + field) * 4);
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+  } else {
+    uint64_t bits =
+        read64le(m_states + (index * kFieldsPerState + field) * 8);
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+}
+
+Trajectory::State TrajectoryView::GetState(size_t index) const {
+  return {units::second_t{GetField(index, 0)},
+          units::meters_per_second_t{GetField(index, 1)},
+          units::meters_per_second_squared_t{GetField(index, 2)},
+          Pose2d{units::meter_t{GetField(index, 3)},
+                 units::meter_t{GetField(index, 4)},
+                 units::radian_t{GetField(index, 5)}},
+          units::curvature_t{GetField(index, 6)}};
+}
+
+Trajectory::State TrajectoryView::Sample(units::second_t t) const {
+  if (t <= units::second_t{GetField(0, 0)}) {
+    return GetState(0);
+  }
+  if (t >= m_totalTime) {
+    return GetState(m_size - 1);
+  }
+
+  // Binary search for the first state with a timestamp no less than the
+  // requested timestamp, starting at 1 so there's a previous state to
+  // interpolate from
+  size_t low = 1;
+  size_t high = m_size;
+  while (low < high) {
+    size_t mid = low + (high - low) / 2;
+    if (units::second_t{GetField(mid, 0)} < t) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+
+  auto sample = GetState(low);
+  auto prevSample = GetState(low - 1);
+
+  if (units::math::abs(sample.t - prevSample.t) < 1E-9_s) {
+    return sample;
+  }
+  return prevSample.Interpolate(
+      sample, (t - prevSample.t) / (sample.t - prevSample.t));
+}
+
+Trajectory TrajectoryView::ToTrajectory() const {
+  std::vector<Trajectory::State> states;
+  states.reserve(m_size);
+  for (size_t i = 0; i < m_size; ++i) {
+    states.emplace_back(GetState(i));
+  }
+  return Trajectory{states};
+}
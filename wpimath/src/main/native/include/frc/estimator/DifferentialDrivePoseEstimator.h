@@ -4,7 +4,11 @@
 
 #pragma once
 
+#include <tuple>
+#include <utility>
+
 #include <wpi/array.h>
+#include <wpi/span.h>
 
 #include "Eigen/Core"
 #include "frc/estimator/KalmanFilterLatencyCompensator.h"
@@ -173,6 +177,45 @@ class DifferentialDrivePoseEstimator {
     AddVisionMeasurement(visionRobotPose, timestamp);
   }
 
+  /**
+   * Adds several vision measurements to the Unscented Kalman Filter at once,
+   * such as from multiple cameras.
+   *
+   * This is equivalent to calling AddVisionMeasurement() for each measurement
+   * in timestamp order, but it only replays the odometry history since the
+   * oldest measurement once.
+   *
+   * @param visionMeasurements Pairs of the robot pose as measured by a vision
+   *                           camera and the timestamp of that measurement,
+   *                           in any order. The timestamps follow the same
+   *                           rules as for AddVisionMeasurement().
+   */
+  void AddVisionMeasurements(
+      wpi::span<const std::pair<Pose2d, units::second_t>> visionMeasurements);
+
+  /**
+   * Adds several vision measurements with their own standard deviations to the
+   * Unscented Kalman Filter at once, such as from cameras with different
+   * accuracies.
+   *
+   * This is equivalent to calling AddVisionMeasurement() with standard
+   * deviations for each measurement in timestamp order, so the standard
+   * deviations of the newest measurement continue to apply to future
+   * measurements.
+   *
+   * @param visionMeasurements The robot pose as measured by a vision camera,
+   *                           the timestamp of that measurement, and the
+   *                           standard deviations of that measurement in the
+   *                           form [x, y, theta]^T with units in meters and
+   *                           radians. The measurements may be in any order,
+   *                           and the timestamps follow the same rules as for
+   *                           AddVisionMeasurement().
+   */
+  void AddVisionMeasurements(
+      wpi::span<const std::tuple<Pose2d, units::second_t,
+                                 wpi::array<double, 3>>>
+          visionMeasurements);
+
   /**
    * Updates the Unscented Kalman Filter using only wheel encoder information.
    * Note that this should be called every loop iteration.
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <functional>
+#include <utility>
 
 #include <wpi/array.h>
 
@@ -204,6 +205,39 @@ class ExtendedKalmanFilter {
     m_P = m_initP;
   }
 
+  /**
+   * Sets the function used to compute the Jacobian of f(x, u) with respect to
+   * x in Predict().
+   *
+   * By default, it's found numerically with central differences, which costs
+   * 2 * States evaluations of f(x, u) per prediction. An analytic Jacobian or
+   * one computed with AutoDiffJacobianX() is faster and exact.
+   *
+   * @param dfdx A function of x and u that returns the Jacobian of f(x, u)
+   *             with respect to x, or nullptr to use the numerical Jacobian.
+   */
+  void SetStateJacobian(std::function<Eigen::Matrix<double, States, States>(
+                            const Eigen::Matrix<double, States, 1>&,
+                            const Eigen::Matrix<double, Inputs, 1>&)>
+                            dfdx) {
+    m_dfdx = std::move(dfdx);
+  }
+
+  /**
+   * Sets the function used to compute the Jacobian of h(x, u) with respect to
+   * x in Correct() when the h(x, u) passed to the constructor is used.
+   *
+   * @param dhdx A function of x and u that returns the Jacobian of h(x, u)
+   *             with respect to x, or nullptr to use the numerical Jacobian.
+   */
+  void SetMeasurementJacobian(
+      std::function<Eigen::Matrix<double, Outputs, States>(
+          const Eigen::Matrix<double, States, 1>&,
+          const Eigen::Matrix<double, Inputs, 1>&)>
+          dhdx) {
+    m_dhdx = std::move(dhdx);
+  }
+
   /**
    * Project the model into the future with a new control input u.
    *
@@ -214,8 +248,12 @@ class ExtendedKalmanFilter {
     m_dt = dt;
 
     // Find continuous A
-    Eigen::Matrix<double, States, States> contA =
-        NumericalJacobianX<States, States, Inputs>(m_f, m_xHat, u);
+    Eigen::Matrix<double, States, States> contA;
+    if (m_dfdx) {
+      contA = m_dfdx(m_xHat, u);
+    } else {
+      contA = NumericalJacobianX<States, States, Inputs>(m_f, m_xHat, u);
+    }
 
     // Find discrete A and Q
     Eigen::Matrix<double, States, States> discA;
@@ -234,7 +272,12 @@ class ExtendedKalmanFilter {
    */
   void Correct(const Eigen::Matrix<double, Inputs, 1>& u,
                const Eigen::Matrix<double, Outputs, 1>& y) {
-    Correct<Outputs>(u, y, m_h, m_contR, m_residualFuncY, m_addFuncX);
+    if (m_dhdx) {
+      Correct<Outputs>(u, y, m_h, m_dhdx, m_contR, m_residualFuncY,
+                       m_addFuncX);
+    } else {
+      Correct<Outputs>(u, y, m_h, m_contR, m_residualFuncY, m_addFuncX);
+    }
   }
 
   template <int Rows>
@@ -254,6 +297,39 @@ class ExtendedKalmanFilter {
     Correct<Rows>(u, y, h, R, residualFuncY, addFuncX);
   }
 
+  /**
+   * Correct the state estimate x-hat using the measurements in y and a
+   * user-provided Jacobian of h(x, u).
+   *
+   * @param u    Same control input used in the predict step.
+   * @param y    Measurement vector.
+   * @param h    A vector-valued function of x and u that returns the
+   *             measurement vector.
+   * @param dhdx A function of x and u that returns the Jacobian of h(x, u)
+   *             with respect to x.
+   * @param R    Discrete measurement noise covariance matrix.
+   */
+  template <int Rows>
+  void Correct(const Eigen::Matrix<double, Inputs, 1>& u,
+               const Eigen::Matrix<double, Rows, 1>& y,
+               std::function<Eigen::Matrix<double, Rows, 1>(
+                   const Eigen::Matrix<double, States, 1>&,
+                   const Eigen::Matrix<double, Inputs, 1>&)>
+                   h,
+               std::function<Eigen::Matrix<double, Rows, States>(
+                   const Eigen::Matrix<double, States, 1>&,
+                   const Eigen::Matrix<double, Inputs, 1>&)>
+                   dhdx,
+               const Eigen::Matrix<double, Rows, Rows>& R) {
+    auto residualFuncY = [](auto a, auto b) -> Eigen::Matrix<double, Rows, 1> {
+      return a - b;
+    };
+    auto addFuncX = [](auto a, auto b) -> Eigen::Matrix<double, States, 1> {
+      return a + b;
+    };
+    Correct<Rows>(u, y, h, dhdx, R, residualFuncY, addFuncX);
+  }
+
   /**
    * Correct the state estimate x-hat using the measurements in y.
    *
@@ -286,8 +362,51 @@ class ExtendedKalmanFilter {
                    const Eigen::Matrix<double, States, 1>&,
                    const Eigen::Matrix<double, States, 1>)>
                    addFuncX) {
-    const Eigen::Matrix<double, Rows, States> C =
-        NumericalJacobianX<Rows, States, Inputs>(h, m_xHat, u);
+    Correct<Rows>(
+        u, y, h,
+        [&](const Eigen::Matrix<double, States, 1>& x,
+            const Eigen::Matrix<double, Inputs, 1>& u) {
+          return NumericalJacobianX<Rows, States, Inputs>(h, x, u);
+        },
+        R, residualFuncY, addFuncX);
+  }
+
+  /**
+   * Correct the state estimate x-hat using the measurements in y and a
+   * user-provided Jacobian of h(x, u).
+   *
+   * @param u             Same control input used in the predict step.
+   * @param y             Measurement vector.
+   * @param h             A vector-valued function of x and u that returns
+   *                      the measurement vector.
+   * @param dhdx          A function of x and u that returns the Jacobian of
+   *                      h(x, u) with respect to x.
+   * @param R             Discrete measurement noise covariance matrix.
+   * @param residualFuncY A function that computes the residual of two
+   *                      measurement vectors (i.e. it subtracts them.)
+   * @param addFuncX      A function that adds two state vectors.
+   */
+  template <int Rows>
+  void Correct(const Eigen::Matrix<double, Inputs, 1>& u,
+               const Eigen::Matrix<double, Rows, 1>& y,
+               std::function<Eigen::Matrix<double, Rows, 1>(
+                   const Eigen::Matrix<double, States, 1>&,
+                   const Eigen::Matrix<double, Inputs, 1>&)>
+                   h,
+               std::function<Eigen::Matrix<double, Rows, States>(
+                   const Eigen::Matrix<double, States, 1>&,
+                   const Eigen::Matrix<double, Inputs, 1>&)>
+                   dhdx,
+               const Eigen::Matrix<double, Rows, Rows>& R,
+               std::function<Eigen::Matrix<double, Rows, 1>(
+                   const Eigen::Matrix<double, Rows, 1>&,
+                   const Eigen::Matrix<double, Rows, 1>&)>
+                   residualFuncY,
+               std::function<Eigen::Matrix<double, States, 1>(
+                   const Eigen::Matrix<double, States, 1>&,
+                   const Eigen::Matrix<double, States, 1>)>
+                   addFuncX) {
+    const Eigen::Matrix<double, Rows, States> C = dhdx(m_xHat, u);
     const Eigen::Matrix<double, Rows, Rows> discR = DiscretizeR<Rows>(R, m_dt);
 
     Eigen::Matrix<double, Rows, Rows> S = C * m_P * C.transpose() + discR;
@@ -328,6 +447,14 @@ class ExtendedKalmanFilter {
       const Eigen::Matrix<double, States, 1>&,
       const Eigen::Matrix<double, States, 1>)>
       m_addFuncX;
+  std::function<Eigen::Matrix<double, States, States>(
+      const Eigen::Matrix<double, States, 1>&,
+      const Eigen::Matrix<double, Inputs, 1>&)>
+      m_dfdx;
+  std::function<Eigen::Matrix<double, Outputs, States>(
+      const Eigen::Matrix<double, States, 1>&,
+      const Eigen::Matrix<double, Inputs, 1>&)>
+      m_dhdx;
   Eigen::Matrix<double, States, 1> m_xHat;
   Eigen::Matrix<double, States, States> m_P;
   Eigen::Matrix<double, States, States> m_contQ;
@@ -152,7 +152,7 @@ class KalmanFilterImpl {
    * @param dt Timestep for prediction.
    */
   void Predict(const Eigen::Matrix<double, Inputs, 1>& u, units::second_t dt) {
-    m_xHat = m_plant->CalculateX(m_xHat, u, dt);
+    m_xHat = m_plant->CalculateX(m_xHat, u, dt, m_discCache);
   }
 
   /**
@@ -178,6 +178,11 @@ class KalmanFilterImpl {
    * The state estimate.
    */
   Eigen::Matrix<double, States, 1> m_xHat;
+
+  /**
+   * Discretization of the plant for the most recent timestep.
+   */
+  DiscretizationCache<States, Inputs> m_discCache;
 };
 
 }  // namespace detail
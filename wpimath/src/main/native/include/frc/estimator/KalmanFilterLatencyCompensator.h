@@ -5,10 +5,11 @@
 #pragma once
 
 #include <algorithm>
-#include <array>
 #include <functional>
 #include <utility>
-#include <vector>
+
+#include <wpi/span.h>
+#include <wpi/static_circular_buffer.h>
 
 #include "Eigen/Core"
 #include "units/math.h"
@@ -25,6 +26,7 @@ class KalmanFilterLatencyCompensator {
     Eigen::Matrix<double, Inputs, 1> inputs;
     Eigen::Matrix<double, Outputs, 1> localMeasurements;
 
+    ObserverSnapshot() = default;
     ObserverSnapshot(const KalmanFilterType& observer,
                      const Eigen::Matrix<double, Inputs, 1>& u,
                      const Eigen::Matrix<double, Outputs, 1>& localY)
@@ -37,7 +39,7 @@ class KalmanFilterLatencyCompensator {
   /**
    * Clears the observer snapshot buffer.
    */
-  void Reset() { m_pastObserverSnapshots.clear(); }
+  void Reset() { m_pastObserverSnapshots.reset(); }
 
   /**
    * Add past observer states to the observer snapshots list.
@@ -51,14 +53,10 @@ class KalmanFilterLatencyCompensator {
                         Eigen::Matrix<double, Inputs, 1> u,
                         Eigen::Matrix<double, Outputs, 1> localY,
                         units::second_t timestamp) {
-    // Add the new state into the vector.
-    m_pastObserverSnapshots.emplace_back(timestamp,
-                                         ObserverSnapshot{observer, u, localY});
-
-    // Remove the oldest snapshot if the vector exceeds our maximum size.
-    if (m_pastObserverSnapshots.size() > kMaxPastObserverStates) {
-      m_pastObserverSnapshots.erase(m_pastObserverSnapshots.begin());
-    }
+    // Add the new state into the buffer. This overwrites the oldest snapshot
+    // if the buffer is full.
+    m_pastObserverSnapshots.push_back(
+        {timestamp, ObserverSnapshot{observer, u, localY}});
   }
 
   /**
@@ -80,71 +78,134 @@ class KalmanFilterLatencyCompensator {
                          const Eigen::Matrix<double, Rows, 1>& y)>
           globalMeasurementCorrect,
       units::second_t timestamp) {
+    std::pair<units::second_t, Eigen::Matrix<double, Rows, 1>> measurement{
+        timestamp, y};
+    ApplyPastGlobalMeasurements<Eigen::Matrix<double, Rows, 1>>(
+        observer, nominalDt, {&measurement, 1}, globalMeasurementCorrect);
+  }
+
+  /**
+   * Add several past global measurements (such as from multiple vision
+   * cameras) to the estimator.
+   *
+   * This replays the observer history once from the oldest measurement
+   * instead of once per measurement.
+   *
+   * @tparam Measurement             The type of each measurement, such as the
+   *                                 measurement vector. It's passed as is to
+   *                                 globalMeasurementCorrect.
+   * @param observer                 The observer to apply the past global
+   *                                 measurements.
+   * @param nominalDt                The nominal timestep.
+   * @param measurements             Pairs of measurement timestamp and
+   *                                 measurement. These will be sorted by
+   *                                 timestamp in place.
+   * @param globalMeasurementCorrect The function take calls correct() on the
+   *                                 observer.
+   */
+  template <typename Measurement>
+  void ApplyPastGlobalMeasurements(
+      KalmanFilterType* observer, units::second_t nominalDt,
+      wpi::span<std::pair<units::second_t, Measurement>> measurements,
+      std::function<void(const Eigen::Matrix<double, Inputs, 1>& u,
+                         const Measurement& y)>
+          globalMeasurementCorrect) {
     if (m_pastObserverSnapshots.size() == 0) {
       // State map was empty, which means that we got a measurement right at
       // startup. The only thing we can do is ignore the measurement.
       return;
     }
+    if (measurements.empty()) {
+      return;
+    }
+
+    std::stable_sort(
+        measurements.begin(), measurements.end(),
+        [](const auto& a, const auto& b) { return a.first < b.first; });
 
-    // We will perform a binary search to find the index of the element in the
-    // vector that has a timestamp that is equal to or greater than the vision
-    // measurement timestamp.
-    auto lowerBoundIter = std::lower_bound(
-        m_pastObserverSnapshots.cbegin(), m_pastObserverSnapshots.cend(),
-        timestamp,
-        [](const auto& entry, const auto& ts) { return entry.first < ts; });
-    int index = std::distance(m_pastObserverSnapshots.cbegin(), lowerBoundIter);
-
-    // High and Low should be the same. The sampled timestamp is greater than or
-    // equal to the vision pose timestamp. We will now find the entry which is
-    // closest in time to the requested timestamp.
-
-    size_t indexOfClosestEntry =
-        units::math::abs(
-            timestamp - m_pastObserverSnapshots[std::max(index - 1, 0)].first) <
-                units::math::abs(timestamp -
-                                 m_pastObserverSnapshots[index].first)
-            ? index - 1
-            : index;
+    auto measurement = measurements.begin();
+    size_t startIndex = ClosestSnapshotIndex(measurement->first);
+    size_t measurementIndex = startIndex;
 
     units::second_t lastTimestamp =
-        m_pastObserverSnapshots[indexOfClosestEntry].first - nominalDt;
+        m_pastObserverSnapshots[startIndex].first - nominalDt;
 
     // We will now go back in time to the state of the system at the time when
-    // the measurement was captured. We will reset the observer to that state,
-    // and apply correction based on the measurement. Then, we will go back
-    // through all observer states until the present and apply past inputs to
-    // get the present estimated state.
-    for (size_t i = indexOfClosestEntry; i < m_pastObserverSnapshots.size();
-         ++i) {
+    // the oldest measurement was captured. We will reset the observer to that
+    // state, and apply correction based on the measurements as we reach them.
+    // Then, we will go back through all observer states until the present and
+    // apply past inputs to get the present estimated state.
+    for (size_t i = startIndex; i < m_pastObserverSnapshots.size(); ++i) {
       auto& [key, snapshot] = m_pastObserverSnapshots[i];
 
-      if (i == indexOfClosestEntry) {
+      if (i == startIndex) {
         observer->SetP(snapshot.errorCovariances);
         observer->SetXhat(snapshot.xHat);
+      } else {
+        // Snapshots hold the observer state from before their timestep, so
+        // they're updated before replaying it. Otherwise, a later replay
+        // starting from this snapshot would apply its timestep twice.
+        snapshot = ObserverSnapshot{*observer, snapshot.inputs,
+                                    snapshot.localMeasurements};
       }
 
       observer->Predict(snapshot.inputs, key - lastTimestamp);
       observer->Correct(snapshot.inputs, snapshot.localMeasurements);
 
-      if (i == indexOfClosestEntry) {
-        // Note that the measurement is at a timestep close but probably not
-        // exactly equal to the timestep for which we called predict. This makes
-        // the assumption that the dt is small enough that the difference
-        // between the measurement time and the time that the inputs were
-        // captured at is very small.
-        globalMeasurementCorrect(snapshot.inputs, y);
+      // Note that the measurements are at a timestep close but probably not
+      // exactly equal to the timestep for which we called predict. This makes
+      // the assumption that the dt is small enough that the difference between
+      // the measurement time and the time that the inputs were captured at is
+      // very small.
+      while (measurement != measurements.end() && measurementIndex == i) {
+        globalMeasurementCorrect(snapshot.inputs, measurement->second);
+        ++measurement;
+        if (measurement != measurements.end()) {
+          measurementIndex = ClosestSnapshotIndex(measurement->first);
+        }
       }
 
       lastTimestamp = key;
-      snapshot = ObserverSnapshot{*observer, snapshot.inputs,
-                                  snapshot.localMeasurements};
     }
   }
 
  private:
   static constexpr size_t kMaxPastObserverStates = 300;
-  std::vector<std::pair<units::second_t, ObserverSnapshot>>
+  wpi::static_circular_buffer<std::pair<units::second_t, ObserverSnapshot>,
+                              kMaxPastObserverStates>
       m_pastObserverSnapshots;
+
+  /**
+   * Returns the index of the snapshot closest in time to the given timestamp.
+   *
+   * The snapshot buffer must not be empty.
+   */
+  size_t ClosestSnapshotIndex(units::second_t timestamp) const {
+    // Binary search for the first snapshot with a timestamp equal to or
+    // greater than the requested timestamp.
+    size_t low = 0;
+    size_t high = m_pastObserverSnapshots.size();
+    while (low < high) {
+      size_t mid = low + (high - low) / 2;
+      if (m_pastObserverSnapshots[mid].first < timestamp) {
+        low = mid + 1;
+      } else {
+        high = mid;
+      }
+    }
+
+    if (low == m_pastObserverSnapshots.size()) {
+      return low - 1;
+    } else if (low == 0) {
+      return 0;
+    }
+
+    auto before = m_pastObserverSnapshots[low - 1].first;
+    auto after = m_pastObserverSnapshots[low].first;
+    return units::math::abs(timestamp - before) <
+                   units::math::abs(timestamp - after)
+               ? low - 1
+               : low;
+  }
 };
 }  // namespace frc
@@ -5,8 +5,12 @@
 #pragma once
 
 #include <limits>
+#include <tuple>
+#include <utility>
 
+#include <wpi/SmallVector.h>
 #include <wpi/array.h>
+#include <wpi/span.h>
 #include <wpi/timestamp.h>
 
 #include "Eigen/Core"
@@ -227,6 +231,96 @@ class SwerveDrivePoseEstimator {
     AddVisionMeasurement(visionRobotPose, timestamp);
   }
 
+  /**
+   * Adds several vision measurements to the Unscented Kalman Filter at once,
+   * such as from multiple cameras.
+   *
+   * This is equivalent to calling AddVisionMeasurement() for each measurement
+   * in timestamp order, but it only replays the odometry history since the
+   * oldest measurement once.
+   *
+   * @param visionMeasurements Pairs of the robot pose as measured by a vision
+   *                           camera and the timestamp of that measurement,
+   *                           in any order. The timestamps follow the same
+   *                           rules as for AddVisionMeasurement().
+   */
+  void AddVisionMeasurements(
+      wpi::span<const std::pair<Pose2d, units::second_t>> visionMeasurements) {
+    if (visionMeasurements.size() == 1) {
+      // Skip copying the measurement into a batch
+      AddVisionMeasurement(visionMeasurements[0].first,
+                           visionMeasurements[0].second);
+      return;
+    }
+
+    wpi::SmallVector<std::pair<units::second_t, Eigen::Vector3d>, 4>
+        measurements;
+    for (auto&& [pose, timestamp] : visionMeasurements) {
+      measurements.emplace_back(timestamp, PoseTo3dVector(pose));
+    }
+    m_latencyCompensator.ApplyPastGlobalMeasurements<Eigen::Vector3d>(
+        &m_observer, m_nominalDt, measurements, m_visionCorrect);
+  }
+
+  /**
+   * Adds several vision measurements with their own standard deviations to the
+   * Unscented Kalman Filter at once, such as from cameras with different
+   * accuracies.
+   *
+   * This is equivalent to calling AddVisionMeasurement() with standard
+   * deviations for each measurement in timestamp order, so the standard
+   * deviations of the newest measurement continue to apply to future
+   * measurements.
+   *
+   * @param visionMeasurements The robot pose as measured by a vision camera,
+   *                           the timestamp of that measurement, and the
+   *                           standard deviations of that measurement in the
+   *                           form [x, y, theta]^T with units in meters and
+   *                           radians. The measurements may be in any order,
+   *                           and the timestamps follow the same rules as for
+   *                           AddVisionMeasurement().
+   */
+  void AddVisionMeasurements(
+      wpi::span<const std::tuple<Pose2d, units::second_t,
+                                 wpi::array<double, 3>>>
+          visionMeasurements) {
+    if (visionMeasurements.empty()) {
+      return;
+    }
+    if (visionMeasurements.size() == 1) {
+      auto& [pose, timestamp, stdDevs] = visionMeasurements[0];
+      AddVisionMeasurement(pose, timestamp, stdDevs);
+      return;
+    }
+
+    // Each measurement carries its own vision measurement covariance
+    using VisionMeasurement = std::pair<Eigen::Vector3d, Eigen::Matrix3d>;
+    wpi::SmallVector<std::pair<units::second_t, VisionMeasurement>, 4>
+        measurements;
+    size_t newest = 0;
+    for (size_t i = 0; i < visionMeasurements.size(); ++i) {
+      auto& [pose, timestamp, stdDevs] = visionMeasurements[i];
+      if (timestamp >= std::get<1>(visionMeasurements[newest])) {
+        newest = i;
+      }
+      measurements.emplace_back(
+          timestamp,
+          VisionMeasurement{PoseTo3dVector(pose), frc::MakeCovMatrix(stdDevs)});
+    }
+    Eigen::Matrix3d newestR = measurements[newest].second.second;
+
+    m_latencyCompensator.ApplyPastGlobalMeasurements<VisionMeasurement>(
+        &m_observer, m_nominalDt, measurements,
+        [&](const Eigen::Vector3d& u, const VisionMeasurement& y) {
+          m_visionContR = y.second;
+          m_visionCorrect(u, y.first);
+        });
+
+    // Like AddVisionMeasurement(), leave the newest standard deviations in
+    // effect for future measurements
+    m_visionContR = newestR;
+  }
+
   /**
    * Updates the the Unscented Kalman Filter using only wheel encoder
    * information. This should be called every loop, and the correct loop period
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <functional>
+#include <utility>
 
 #include <wpi/array.h>
 
@@ -195,6 +196,24 @@ class UnscentedKalmanFilter {
     m_sigmasF.setZero();
   }
 
+  /**
+   * Sets the function used to compute the Jacobian of f(x, u) with respect to
+   * x, which Predict() uses to discretize the process noise covariance.
+   *
+   * By default, it's found numerically with central differences, which costs
+   * 2 * States evaluations of f(x, u) per prediction. An analytic Jacobian or
+   * one computed with AutoDiffJacobianX() is faster and exact.
+   *
+   * @param dfdx A function of x and u that returns the Jacobian of f(x, u)
+   *             with respect to x, or nullptr to use the numerical Jacobian.
+   */
+  void SetStateJacobian(std::function<Eigen::Matrix<double, States, States>(
+                            const Eigen::Matrix<double, States, 1>&,
+                            const Eigen::Matrix<double, Inputs, 1>&)>
+                            dfdx) {
+    m_dfdx = std::move(dfdx);
+  }
+
   /**
    * Project the model into the future with a new control input u.
    *
@@ -205,8 +224,12 @@ class UnscentedKalmanFilter {
     m_dt = dt;
 
     // Discretize Q before projecting mean and covariance forward
-    Eigen::Matrix<double, States, States> contA =
-        NumericalJacobianX<States, States, Inputs>(m_f, m_xHat, u);
+    Eigen::Matrix<double, States, States> contA;
+    if (m_dfdx) {
+      contA = m_dfdx(m_xHat, u);
+    } else {
+      contA = NumericalJacobianX<States, States, Inputs>(m_f, m_xHat, u);
+    }
     Eigen::Matrix<double, States, States> discA;
     Eigen::Matrix<double, States, States> discQ;
     DiscretizeAQTaylor<States>(contA, m_contQ, dt, &discA, &discQ);
@@ -391,6 +414,10 @@ class UnscentedKalmanFilter {
       const Eigen::Matrix<double, States, 1>&,
       const Eigen::Matrix<double, States, 1>)>
       m_addFuncX;
+  std::function<Eigen::Matrix<double, States, States>(
+      const Eigen::Matrix<double, States, 1>&,
+      const Eigen::Matrix<double, Inputs, 1>&)>
+      m_dfdx;
   Eigen::Matrix<double, States, 1> m_xHat;
   Eigen::Matrix<double, States, States> m_P;
   Eigen::Matrix<double, States, States> m_contQ;
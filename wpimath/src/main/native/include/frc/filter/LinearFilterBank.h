@@ -0,0 +1,196 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <initializer_list>
+#include <stdexcept>
+#include <vector>
+
+#include <wpi/span.h>
+
+#include "Eigen/Core"
+#include "units/time.h"
+#include "wpimath/MathShared.h"
+
+namespace frc {
+
+/**
+ * A bank of linear filters with the same gains, one per channel, which are
+ * updated together. This gives the same results as a LinearFilter per channel,
+ * such as for each module of a swerve drive, but stores the history of every
+ * channel side by side so each update is a vectorized matrix-vector product
+ * over all channels.
+ *
+ * The number of feedforward and feedback gains can be fixed at compile time
+ * with FFTaps and FBTaps, which stores the history inline and lets the
+ * products over the taps be unrolled.
+ *
+ * See LinearFilter for the filter equations and factory methods.
+ *
+ * @tparam Channels The number of channels.
+ * @tparam FFTaps   The number of feedforward gains, or Eigen::Dynamic to set
+ *                  it at runtime.
+ * @tparam FBTaps   The number of feedback gains, or Eigen::Dynamic to set it
+ *                  at runtime.
+ */
+template <int Channels, int FFTaps = Eigen::Dynamic,
+          int FBTaps = Eigen::Dynamic>
+class LinearFilterBank {
+ public:
+  using Vector = Eigen::Matrix<double, Channels, 1>;
+
+  /**
+   * Create a bank of linear FIR or IIR filters.
+   *
+   * @param ffGains The "feed forward" or FIR gains.
+   * @param fbGains The "feed back" or IIR gains.
+   * @throws std::runtime_error if the number of gains doesn't match FFTaps or
+   *         FBTaps.
+   */
+  LinearFilterBank(wpi::span<const double> ffGains,
+                   wpi::span<const double> fbGains) {
+    if ((FFTaps != Eigen::Dynamic &&
+         ffGains.size() != static_cast<size_t>(FFTaps)) ||
+        (FBTaps != Eigen::Dynamic &&
+         fbGains.size() != static_cast<size_t>(FBTaps))) {
+      throw std::runtime_error(
+          "Number of gains must match the filter bank's number of taps.");
+    }
+
+    m_inputGains.resize(ffGains.size());
+    std::copy(ffGains.begin(), ffGains.end(), m_inputGains.data());
+    m_outputGains.resize(fbGains.size());
+    std::copy(fbGains.begin(), fbGains.end(), m_outputGains.data());
+
+    m_inputs.resize(Channels, 2 * ffGains.size());
+    m_outputs.resize(Channels, 2 * fbGains.size());
+    Reset();
+
+    wpi::math::MathSharedStore::ReportUsage(
+        wpi::math::MathUsageId::kFilter_Linear, 1);
+  }
+
+  /**
+   * Create a bank of linear FIR or IIR filters.
+   *
+   * @param ffGains The "feed forward" or FIR gains.
+   * @param fbGains The "feed back" or IIR gains.
+   * @throws std::runtime_error if the number of gains doesn't match FFTaps or
+   *         FBTaps.
+   */
+  LinearFilterBank(std::initializer_list<double> ffGains,
+                   std::initializer_list<double> fbGains)
+      : LinearFilterBank({ffGains.begin(), ffGains.end()},
+                         {fbGains.begin(), fbGains.end()}) {}
+
+  /**
+   * Creates a bank of one-pole IIR low-pass filters. See
+   * LinearFilter::SinglePoleIIR().
+   *
+   * @param timeConstant The discrete-time time constant in seconds.
+   * @param period       The period in seconds between samples taken by the
+   *                     user.
+   */
+  static LinearFilterBank SinglePoleIIR(double timeConstant,
+                                        units::second_t period) {
+    double gain = std::exp(-period.to<double>() / timeConstant);
+    return LinearFilterBank({1.0 - gain}, {-gain});
+  }
+
+  /**
+   * Creates a bank of first-order high-pass filters. See
+   * LinearFilter::HighPass().
+   *
+   * @param timeConstant The discrete-time time constant in seconds.
+   * @param period       The period in seconds between samples taken by the
+   *                     user.
+   */
+  static LinearFilterBank HighPass(double timeConstant,
+                                   units::second_t period) {
+    double gain = std::exp(-period.to<double>() / timeConstant);
+    return LinearFilterBank({gain, -gain}, {-gain});
+  }
+
+  /**
+   * Creates a bank of K-tap FIR moving average filters. See
+   * LinearFilter::MovingAverage().
+   *
+   * @param taps The number of samples to average over. Higher = smoother but
+   *             slower
+   */
+  static LinearFilterBank MovingAverage(int taps) {
+    if (taps <= 0) {
+      throw std::runtime_error("Number of taps must be greater than zero.");
+    }
+
+    std::vector<double> gains(taps, 1.0 / taps);
+    return LinearFilterBank(gains, {});
+  }
+
+  /**
+   * Reset the filter states.
+   */
+  void Reset() {
+    m_inputs.setZero();
+    m_outputs.setZero();
+    m_inputHead = 0;
+    m_outputHead = 0;
+  }
+
+  /**
+   * Calculates the next value of each filter.
+   *
+   * @param input Current input value of each channel.
+   *
+   * @return The filtered value of each channel at this step
+   */
+  Vector Calculate(const Vector& input) {
+    Vector retVal = Vector::Zero();
+
+    // The history is stored twice so the most recent taps, newest first,
+    // are always contiguous columns starting at the head
+    // A fixed tap count of zero has no history to index
+    if constexpr (FFTaps != 0) {
+      Eigen::Index ffTaps = m_inputGains.size();
+      if (ffTaps > 0) {
+        m_inputHead = (m_inputHead == 0 ? ffTaps : m_inputHead) - 1;
+        m_inputs.col(m_inputHead) = input;
+        m_inputs.col(m_inputHead + ffTaps) = input;
+        retVal += m_inputs.template middleCols<FFTaps>(m_inputHead, ffTaps) *
+                  m_inputGains;
+      }
+    }
+
+    if constexpr (FBTaps != 0) {
+      Eigen::Index fbTaps = m_outputGains.size();
+      if (fbTaps > 0) {
+        retVal -=
+            m_outputs.template middleCols<FBTaps>(m_outputHead, fbTaps) *
+            m_outputGains;
+        m_outputHead = (m_outputHead == 0 ? fbTaps : m_outputHead) - 1;
+        m_outputs.col(m_outputHead) = retVal;
+        m_outputs.col(m_outputHead + fbTaps) = retVal;
+      }
+    }
+
+    return retVal;
+  }
+
+ private:
+  static constexpr int HistorySize(int taps) {
+    return taps == Eigen::Dynamic ? Eigen::Dynamic : 2 * taps;
+  }
+
+  Eigen::Matrix<double, Channels, HistorySize(FFTaps)> m_inputs;
+  Eigen::Matrix<double, Channels, HistorySize(FBTaps)> m_outputs;
+  Eigen::Matrix<double, FFTaps, 1> m_inputGains;
+  Eigen::Matrix<double, FBTaps, 1> m_outputGains;
+  Eigen::Index m_inputHead = 0;
+  Eigen::Index m_outputHead = 0;
+};
+
+}  // namespace frc
@@ -4,18 +4,124 @@
 
 #pragma once
 
-#include <algorithm>
-#include <vector>
+#include <iterator>
+#include <set>
+#include <utility>
 
-#include <wpi/Algorithm.h>
 #include <wpi/circular_buffer.h>
 
 namespace frc {
+namespace detail {
+/**
+ * Tracks the median of a multiset of values with O(log n) insertion and
+ * removal. The lower half of the values is kept in one set and the upper half
+ * in another, with the lower half holding the extra value if the count is odd.
+ *
+ * The set node of the last removed value is reused by the next insertion, so
+ * a sliding window doesn't allocate once it's full.
+ */
+template <class T>
+class SlidingMedian {
+ public:
+  SlidingMedian() = default;
+
+  // The spare node isn't copied
+  SlidingMedian(const SlidingMedian& rhs)
+      : m_low{rhs.m_low}, m_high{rhs.m_high} {}
+  SlidingMedian& operator=(const SlidingMedian& rhs) {
+    m_low = rhs.m_low;
+    m_high = rhs.m_high;
+    return *this;
+  }
+
+  SlidingMedian(SlidingMedian&&) = default;
+  SlidingMedian& operator=(SlidingMedian&&) = default;
+
+  /**
+   * Adds a value.
+   *
+   * @param value The value.
+   */
+  void Insert(T value) {
+    if (m_low.empty() || value <= *m_low.rbegin()) {
+      Insert(m_low, value);
+    } else {
+      Insert(m_high, value);
+    }
+    Rebalance();
+  }
+
+  /**
+   * Removes one occurrence of a value previously added with Insert().
+   *
+   * @param value The value.
+   */
+  void Erase(T value) {
+    // Values equal to the largest lower value are in the lower half
+    auto& set = !m_low.empty() && value <= *m_low.rbegin() ? m_low : m_high;
+    auto it = set.find(value);
+    if (it != set.end()) {
+      m_spare = set.extract(it);
+      Rebalance();
+    }
+  }
+
+  /**
+   * Returns the median of the values, or the mean of the two middle values if
+   * the count is even. There must be at least one value.
+   */
+  T Median() const {
+    if (m_low.size() > m_high.size()) {
+      return *m_low.rbegin();
+    } else {
+      return (*m_low.rbegin() + *m_high.begin()) / 2.0;
+    }
+  }
+
+  /**
+   * Returns the number of values.
+   */
+  size_t Size() const { return m_low.size() + m_high.size(); }
+
+  /**
+   * Removes all values.
+   */
+  void Clear() {
+    m_low.clear();
+    m_high.clear();
+  }
+
+ private:
+  std::multiset<T> m_low;
+  std::multiset<T> m_high;
+  typename std::multiset<T>::node_type m_spare;
+
+  void Insert(std::multiset<T>& set, T value) {
+    if (m_spare) {
+      m_spare.value() = value;
+      set.insert(std::move(m_spare));
+    } else {
+      set.insert(value);
+    }
+  }
+
+  void Rebalance() {
+    if (m_low.size() > m_high.size() + 1) {
+      m_high.insert(m_low.extract(std::prev(m_low.end())));
+    } else if (m_high.size() > m_low.size()) {
+      m_low.insert(m_high.extract(m_high.begin()));
+    }
+  }
+};
+}  // namespace detail
+
 /**
  * A class that implements a moving-window median filter.  Useful for reducing
  * measurement noise, especially with processes that generate occasional,
  * extreme outliers (such as values from vision processing, LIDAR, or ultrasonic
  * sensors).
+ *
+ * Each update costs O(log n) in the window size n.
  */
 template <class T>
 class MedianFilter {
@@ -34,44 +140,30 @@ class MedianFilter {
    * @return The median of the moving window, updated to include the next value.
    */
   T Calculate(T next) {
-    // Insert next value at proper point in sorted array
-    wpi::insert_sorted(m_orderedValues, next);
-
-    size_t curSize = m_orderedValues.size();
-
     // If buffer is at max size, pop element off of end of circular buffer
-    // and remove from ordered list
-    if (curSize > m_size) {
-      m_orderedValues.erase(std::find(m_orderedValues.begin(),
-                                      m_orderedValues.end(),
-                                      m_valueBuffer.pop_back()));
-      curSize = curSize - 1;
+    // and remove it from the median
+    if (m_median.Size() == m_size) {
+      m_median.Erase(m_valueBuffer.pop_back());
     }
 
-    // Add next value to circular buffer
+    // Add next value to circular buffer and the median
     m_valueBuffer.push_front(next);
+    m_median.Insert(next);
 
-    if (curSize % 2 == 1) {
-      // If size is odd, return middle element of sorted list
-      return m_orderedValues[curSize / 2];
-    } else {
-      // If size is even, return average of middle elements
-      return (m_orderedValues[curSize / 2 - 1] + m_orderedValues[curSize / 2]) /
-             2.0;
-    }
+    return m_median.Median();
   }
 
   /**
    * Resets the filter, clearing the window of all elements.
    */
   void Reset() {
-    m_orderedValues.clear();
+    m_median.Clear();
     m_valueBuffer.reset();
   }
 
  private:
   wpi::circular_buffer<T> m_valueBuffer;
-  std::vector<T> m_orderedValues;
+  detail::SlidingMedian<T> m_median;
   size_t m_size;
 };
 }  // namespace frc
@@ -0,0 +1,89 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+
+#include "Eigen/Core"
+#include "frc/filter/MedianFilter.h"
+
+namespace frc {
+/**
+ * A bank of moving-window median filters, one per channel, which are updated
+ * together. This gives the same results as a MedianFilter per channel, but
+ * keeps the window of every channel in one buffer.
+ *
+ * Each update costs O(log n) per channel in the window size n.
+ *
+ * @tparam Channels The number of channels.
+ */
+template <int Channels>
+class MedianFilterBank {
+ public:
+  using Vector = Eigen::Matrix<double, Channels, 1>;
+
+  /**
+   * Creates a new MedianFilterBank.
+   *
+   * @param size The number of samples in the moving window.
+   * @throws std::runtime_error if size is zero.
+   */
+  explicit MedianFilterBank(size_t size) : m_window(Channels, size) {
+    if (size == 0) {
+      throw std::runtime_error("Window size must be greater than zero.");
+    }
+  }
+
+  /**
+   * Calculates the moving-window median of each channel for the next values
+   * of the input streams.
+   *
+   * @param next The next input value of each channel.
+   * @return The median of each channel's moving window, updated to include
+   *         the next value.
+   */
+  Vector Calculate(const Vector& next) {
+    bool full = m_count == static_cast<size_t>(m_window.cols());
+
+    // The oldest values are overwritten by the next ones
+    Vector median;
+    for (int i = 0; i < Channels; ++i) {
+      if (full) {
+        m_medians[i].Erase(m_window(i, m_head));
+      }
+      m_medians[i].Insert(next(i));
+      median(i) = m_medians[i].Median();
+    }
+
+    m_window.col(m_head) = next;
+    m_head = (m_head + 1) % m_window.cols();
+    if (!full) {
+      ++m_count;
+    }
+
+    return median;
+  }
+
+  /**
+   * Resets the filters, clearing the windows of all elements.
+   */
+  void Reset() {
+    for (auto&& median : m_medians) {
+      median.Clear();
+    }
+    m_head = 0;
+    m_count = 0;
+  }
+
+ private:
+  // Column m_head holds the oldest values once the window is full
+  Eigen::Matrix<double, Channels, Eigen::Dynamic> m_window;
+  std::array<detail::SlidingMedian<double>, Channels> m_medians;
+  Eigen::Index m_head = 0;
+  size_t m_count = 0;
+};
+}  // namespace frc
@@ -0,0 +1,229 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "frc/geometry/Pose2d.h"
+#include "frc/geometry/Rotation2d.h"
+#include "frc/geometry/Twist2d.h"
+#include "units/time.h"
+
+namespace frc {
+
+/**
+ * Interpolates between two values of type T.
+ *
+ * The primary template linearly interpolates with start + (end - start) * t,
+ * which covers double, unit types, and Eigen vectors and matrices.
+ * Specialize this for other types.
+ */
+template <typename T>
+struct Interpolator {
+  /**
+   * Returns the value between start and end at fraction t.
+   *
+   * @param start The value at t = 0.
+   * @param end   The value at t = 1.
+   * @param t     The fraction between start and end, in [0, 1].
+   */
+  static T Interpolate(const T& start, const T& end, double t) {
+    return start + (end - start) * t;
+  }
+};
+
+/**
+ * Interpolates rotations along the shortest path between them.
+ */
+template <>
+struct Interpolator<Rotation2d> {
+  static Rotation2d Interpolate(const Rotation2d& start, const Rotation2d& end,
+                                double t) {
+    return start + (end - start) * t;
+  }
+};
+
+/**
+ * Interpolates poses along the constant-curvature arc between them, which is
+ * how a drivetrain moves between two odometry updates.
+ */
+template <>
+struct Interpolator<Pose2d> {
+  static Pose2d Interpolate(const Pose2d& start, const Pose2d& end, double t) {
+    Twist2d twist = start.Log(end);
+    return start.Exp(Twist2d{twist.dx * t, twist.dy * t, twist.dtheta * t});
+  }
+};
+
+/**
+ * A fixed-capacity buffer of timestamped samples that returns interpolated
+ * values between them.
+ *
+ * Samples are stored contiguously in a ring in timestamp order, so appending
+ * and expiring old samples are O(1) and sampling at a time is O(log n).
+ * Samples older than the history size relative to the newest sample are
+ * discarded, as is the oldest sample when the buffer is full.
+ *
+ * For example, this can hold the robot pose history so a vision measurement
+ * taken at a past time can be compared against where the robot was then.
+ *
+ * @tparam T      The sample type.
+ * @tparam Interp The interpolation policy; see Interpolator.
+ */
+template <typename T, typename Interp = Interpolator<T>>
+class TimeInterpolatableBuffer {
+ public:
+  /**
+   * Constructs a buffer.
+   *
+   * @param historySize The amount of time to keep samples for, relative to
+   *                    the newest sample.
+   * @param capacity    The maximum number of samples.
+   */
+  explicit TimeInterpolatableBuffer(units::second_t historySize,
+                                    size_t capacity = 1024)
+      : m_historySize(historySize), m_samples(std::max<size_t>(capacity, 1)) {}
+
+  /**
+   * Adds a sample to the buffer.
+   *
+   * Samples are normally added in increasing timestamp order, which is O(1).
+   * An out-of-order sample is inserted in place in O(n), and a sample with
+   * the same timestamp as an existing one replaces it.
+   *
+   * @param time   The timestamp of the sample.
+   * @param sample The sample value.
+   */
+  void AddSample(units::second_t time, T sample) {
+    if (m_size == 0 || time > At(m_size - 1).first) {
+      if (m_size == m_samples.size()) {
+        PopFront();
+      }
+      At(m_size++) = {time, std::move(sample)};
+    } else {
+      size_t index = LowerBound(time);
+      if (At(index).first == time) {
+        At(index).second = std::move(sample);
+        return;
+      }
+      if (index == 0 && m_size == m_samples.size()) {
+        // Older than everything in a full buffer
+        return;
+      }
+      if (m_size == m_samples.size()) {
+        PopFront();
+        --index;
+      }
+      for (size_t i = m_size; i > index; --i) {
+        At(i) = std::move(At(i - 1));
+      }
+      At(index) = {time, std::move(sample)};
+      ++m_size;
+    }
+
+    // Expire samples that have fallen out of the history window
+    units::second_t oldest = At(m_size - 1).first - m_historySize;
+    while (m_size > 0 && At(0).first < oldest) {
+      PopFront();
+    }
+  }
+
+  /**
+   * Removes all samples.
+   */
+  void Clear() {
+    m_front = 0;
+    m_size = 0;
+  }
+
+  /**
+   * Returns the number of samples in the buffer.
+   */
+  size_t Size() const { return m_size; }
+
+  /**
+   * Returns true if the buffer has no samples.
+   */
+  bool Empty() const { return m_size == 0; }
+
+  /**
+   * Returns the interpolated value at the given time.
+   *
+   * Times before the oldest sample or after the newest one return the oldest
+   * or newest sample respectively.
+   *
+   * @param time The time at which to sample.
+   * @return The value at the given time, or std::nullopt if the buffer is
+   *         empty.
+   */
+  std::optional<T> Sample(units::second_t time) const {
+    if (m_size == 0) {
+      return std::nullopt;
+    }
+
+    size_t index = LowerBound(time);
+    if (index == 0) {
+      return At(0).second;
+    } else if (index == m_size) {
+      return At(m_size - 1).second;
+    }
+
+    const auto& [startTime, start] = At(index - 1);
+    const auto& [endTime, end] = At(index);
+    if (endTime == time) {
+      return end;
+    }
+    return Interp::Interpolate(start, end,
+                               ((time - startTime) / (endTime - startTime))
+                                   .template to<double>());
+  }
+
+ private:
+  units::second_t m_historySize;
+  std::vector<std::pair<units::second_t, T>> m_samples;
+
+  // Index of the oldest sample in m_samples
+  size_t m_front = 0;
+
+  // Number of samples in the buffer
+  size_t m_size = 0;
+
+  std::pair<units::second_t, T>& At(size_t index) {
+    return m_samples[(m_front + index) % m_samples.size()];
+  }
+
+  const std::pair<units::second_t, T>& At(size_t index) const {
+    return m_samples[(m_front + index) % m_samples.size()];
+  }
+
+  void PopFront() {
+    m_front = (m_front + 1) % m_samples.size();
+    --m_size;
+  }
+
+  /**
+   * Returns the index of the first sample with a timestamp equal to or
+   * greater than the given time, or Size() if there's none.
+   */
+  size_t LowerBound(units::second_t time) const {
+    size_t low = 0;
+    size_t high = m_size;
+    while (low < high) {
+      size_t mid = low + (high - low) / 2;
+      if (At(mid).first < time) {
+        low = mid + 1;
+      } else {
+        high = mid;
+      }
+    }
+    return low;
+  }
+};
+
+}  // namespace frc
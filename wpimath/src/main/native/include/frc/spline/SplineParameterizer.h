@@ -28,7 +28,7 @@
 
 #pragma once
 
-#include <stack>
+#include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
@@ -76,30 +76,31 @@ class SplineParameterizer {
     splinePoints.push_back(spline.GetPoint(t0));
 
     // We use an "explicit stack" to simulate recursion, instead of a recursive
-    // function call This give us greater control, instead of a stack overflow
-    std::stack<StackContents> stack;
-    stack.emplace(StackContents{t0, t1});
+    // function call This give us greater control, instead of a stack overflow.
+    // Each interval carries the points at its ends, so subdividing only
+    // evaluates the spline at the new midpoint.
+    std::vector<StackContents> stack;
+    stack.push_back(
+        StackContents{t0, t1, splinePoints.front(), spline.GetPoint(t1)});
 
-    StackContents current;
-    PoseWithCurvature start;
-    PoseWithCurvature end;
     int iterations = 0;
 
     while (!stack.empty()) {
-      current = stack.top();
-      stack.pop();
-      start = spline.GetPoint(current.t0);
-      end = spline.GetPoint(current.t1);
+      StackContents current = std::move(stack.back());
+      stack.pop_back();
 
-      const auto twist = start.first.Log(end.first);
+      const auto twist = current.start.first.Log(current.end.first);
 
       if (units::math::abs(twist.dy) > kMaxDy ||
           units::math::abs(twist.dx) > kMaxDx ||
           units::math::abs(twist.dtheta) > kMaxDtheta) {
-        stack.emplace(StackContents{(current.t0 + current.t1) / 2, current.t1});
-        stack.emplace(StackContents{current.t0, (current.t0 + current.t1) / 2});
+        double mid = (current.t0 + current.t1) / 2;
+        PoseWithCurvature midPoint = spline.GetPoint(mid);
+        stack.push_back(StackContents{mid, current.t1, midPoint, current.end});
+        stack.push_back(
+            StackContents{current.t0, mid, current.start, midPoint});
       } else {
-        splinePoints.push_back(spline.GetPoint(current.t1));
+        splinePoints.push_back(current.end);
       }
 
       if (iterations++ >= kMaxIterations) {
@@ -123,6 +124,8 @@ class SplineParameterizer {
   struct StackContents {
     double t0;
     double t1;
+    PoseWithCurvature start;
+    PoseWithCurvature end;
   };
 
   /**
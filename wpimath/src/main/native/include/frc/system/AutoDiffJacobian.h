@@ -0,0 +1,113 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include "Eigen/Core"
+#include "unsupported/Eigen/AutoDiff"
+
+namespace frc {
+
+/**
+ * Forward-mode dual number carrying the derivatives with respect to N
+ * variables.
+ *
+ * Functions passed to the AutoDiffJacobian functions must be templated on
+ * their scalar type so they can be evaluated with this in place of double.
+ * Math functions should be called unqualified (e.g., `using std::sin;` then
+ * `sin(x(2))`) so the overloads for dual numbers are found.
+ */
+template <int N>
+using AutoDiffScalar = Eigen::AutoDiffScalar<Eigen::Matrix<double, N, 1>>;
+
+/**
+ * Returns the Jacobian with respect to x for f(x) computed with forward-mode
+ * automatic differentiation.
+ *
+ * Unlike NumericalJacobian(), the result is exact to floating point precision
+ * and f is only evaluated once.
+ *
+ * @tparam Rows Number of rows in result of f(x).
+ * @tparam Cols Number of columns in result of f(x).
+ * @param f     Vector-valued function from which to compute Jacobian. It must
+ *              accept and return Eigen vectors of AutoDiffScalar<Cols>.
+ * @param x     Vector argument.
+ */
+template <int Rows, int Cols, typename F>
+Eigen::Matrix<double, Rows, Cols> AutoDiffJacobian(
+    F&& f, const Eigen::Matrix<double, Cols, 1>& x) {
+  using Scalar = AutoDiffScalar<Cols>;
+
+  Eigen::Matrix<Scalar, Cols, 1> xDual;
+  for (int i = 0; i < Cols; ++i) {
+    xDual(i) = Scalar{x(i), Cols, i};
+  }
+
+  Eigen::Matrix<Scalar, Rows, 1> y = f(xDual);
+
+  Eigen::Matrix<double, Rows, Cols> result;
+  for (int i = 0; i < Rows; ++i) {
+    result.row(i) = y(i).derivatives().transpose();
+  }
+
+  return result;
+}
+
+/**
+ * Returns the Jacobian with respect to x for f(x, u, ...) computed with
+ * forward-mode automatic differentiation.
+ *
+ * @tparam Rows    Number of rows in result of f(x, u, ...).
+ * @tparam States  Number of rows in x.
+ * @tparam Inputs  Number of rows in u.
+ * @tparam F       Function object type.
+ * @tparam Args... Remaining arguments to f(x, u, ...).
+ * @param f        Vector-valued function from which to compute Jacobian. It
+ *                 is called with x and u as Eigen vectors of
+ *                 AutoDiffScalar<States>.
+ * @param x        State vector.
+ * @param u        Input vector.
+ */
+template <int Rows, int States, int Inputs, typename F, typename... Args>
+Eigen::Matrix<double, Rows, States> AutoDiffJacobianX(
+    F&& f, const Eigen::Matrix<double, States, 1>& x,
+    const Eigen::Matrix<double, Inputs, 1>& u, Args&&... args) {
+  const Eigen::Matrix<AutoDiffScalar<States>, Inputs, 1> uDual =
+      u.template cast<AutoDiffScalar<States>>();
+  return AutoDiffJacobian<Rows, States>(
+      [&](const Eigen::Matrix<AutoDiffScalar<States>, States, 1>& x) {
+        return f(x, uDual, args...);
+      },
+      x);
+}
+
+/**
+ * Returns the Jacobian with respect to u for f(x, u, ...) computed with
+ * forward-mode automatic differentiation.
+ *
+ * @tparam Rows    Number of rows in result of f(x, u, ...).
+ * @tparam States  Number of rows in x.
+ * @tparam Inputs  Number of rows in u.
+ * @tparam F       Function object type.
+ * @tparam Args... Remaining arguments to f(x, u, ...).
+ * @param f        Vector-valued function from which to compute Jacobian. It
+ *                 is called with x and u as Eigen vectors of
+ *                 AutoDiffScalar<Inputs>.
+ * @param x        State vector.
+ * @param u        Input vector.
+ */
+template <int Rows, int States, int Inputs, typename F, typename... Args>
+Eigen::Matrix<double, Rows, Inputs> AutoDiffJacobianU(
+    F&& f, const Eigen::Matrix<double, States, 1>& x,
+    const Eigen::Matrix<double, Inputs, 1>& u, Args&&... args) {
+  const Eigen::Matrix<AutoDiffScalar<Inputs>, States, 1> xDual =
+      x.template cast<AutoDiffScalar<Inputs>>();
+  return AutoDiffJacobian<Rows, Inputs>(
+      [&](const Eigen::Matrix<AutoDiffScalar<Inputs>, Inputs, 1>& u) {
+        return f(xDual, u, args...);
+      },
+      u);
+}
+
+}  // namespace frc
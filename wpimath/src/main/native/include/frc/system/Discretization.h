@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <cmath>
+
 #include "Eigen/Core"
 #include "Eigen/src/LU/PartialPivLU.h"
 #include "units/time.h"
@@ -52,6 +54,95 @@ void DiscretizeAB(const Eigen::Matrix<double, States, States>& contA,
   *discB = Mdisc.template block<States, Inputs>(0, States);
 }
 
+/**
+ * Caches the discretization of a pair of continuous A and B matrices.
+ *
+ * Loops running at a fixed period discretize with the same timestep every
+ * iteration, which makes the matrix exponential in DiscretizeAB() redundant.
+ * This remembers the last exponential and returns it directly when the
+ * timestep matches exactly.  For a timestep that differs only slightly
+ * (loop jitter), it uses e^(M(dt₀ + δ)) = e^(Mdt₀)e^(Mδ) and approximates
+ * e^(Mδ) with a short Taylor series instead of computing a new exponential.
+ *
+ * The cached matrices must be the same on every call; call Reset() if they
+ * change.  This class is not thread-safe.
+ */
+template <int States, int Inputs>
+class DiscretizationCache {
+ public:
+  /**
+   * Discretizes the given continuous A and B matrices, reusing the previous
+   * result where possible.
+   *
+   * @param contA Continuous system matrix.
+   * @param contB Continuous input matrix.
+   * @param dt    Discretization timestep.
+   * @param discA Storage for discrete system matrix.
+   * @param discB Storage for discrete input matrix.
+   */
+  void DiscretizeAB(const Eigen::Matrix<double, States, States>& contA,
+                    const Eigen::Matrix<double, States, Inputs>& contB,
+                    units::second_t dt,
+                    Eigen::Matrix<double, States, States>* discA,
+                    Eigen::Matrix<double, States, Inputs>* discB) {
+    double T = dt.to<double>();
+    if (m_valid && T == m_dt) {
+      *discA = m_discA;
+      *discB = m_discB;
+      return;
+    }
+
+    // Powers of M = [[A, B], [0, 0]] are [[Aᵏ, Aᵏ⁻¹B], [0, 0]], so the
+    // truncation error relative to each block depends only on ‖A‖|δ|.
+    double delta = T - m_dt;
+    if (m_valid && std::abs(delta) * m_normA <= kMaxTaylorStep) {
+      // e^(Mδ) = I + Σ Mᵏδᵏ/k!, stored as the [[Φ, Γ], [0, I]] blocks
+      Eigen::Matrix<double, States, States> phi =
+          Eigen::Matrix<double, States, States>::Identity();
+      Eigen::Matrix<double, States, States> termA =
+          Eigen::Matrix<double, States, States>::Identity();
+      Eigen::Matrix<double, States, Inputs> gamma = contB * delta;
+      Eigen::Matrix<double, States, Inputs> termB = gamma;
+      for (int k = 1; k <= kTaylorOrder; ++k) {
+        termA = termA * contA * (delta / k);
+        phi += termA;
+        if (k < kTaylorOrder) {
+          termB = contA * termB * (delta / (k + 1));
+          gamma += termB;
+        }
+      }
+
+      // [[A₀, B₀], [0, I]] [[Φ, Γ], [0, I]] = [[A₀Φ, A₀Γ + B₀], [0, I]]
+      *discA = m_discA * phi;
+      *discB = m_discA * gamma + m_discB;
+      return;
+    }
+
+    frc::DiscretizeAB<States, Inputs>(contA, contB, dt, discA, discB);
+    m_discA = *discA;
+    m_discB = *discB;
+    m_dt = T;
+    m_normA = contA.cwiseAbs().colwise().sum().maxCoeff();
+    m_valid = true;
+  }
+
+  /**
+   * Discards the cached discretization.
+   */
+  void Reset() { m_valid = false; }
+
+ private:
+  // With ‖Aδ‖ ≤ 0.1, the 6th-order truncation error is below 1e-10 relative.
+  static constexpr double kMaxTaylorStep = 0.1;
+  static constexpr int kTaylorOrder = 6;
+
+  Eigen::Matrix<double, States, States> m_discA;
+  Eigen::Matrix<double, States, Inputs> m_discB;
+  double m_dt = 0.0;
+  double m_normA = 0.0;
+  bool m_valid = false;
+};
+
 /**
  * Discretizes the given continuous A and Q matrices.
  *
@@ -121,6 +121,29 @@ class LinearSystem {
     return discA * x + discB * clampedU;
   }
 
+  /**
+   * Computes the new x given the old x and the control input, reusing the
+   * discretization of A and B from a previous call with the same cache.
+   *
+   * The cache belongs to the caller (e.g. an observer or simulation), so
+   * callers that share a plant across threads each use their own cache.
+   *
+   * @param x     The current state.
+   * @param u     The control input.
+   * @param dt    Timestep for model update.
+   * @param cache The discretization cache.
+   */
+  Eigen::Matrix<double, States, 1> CalculateX(
+      const Eigen::Matrix<double, States, 1>& x,
+      const Eigen::Matrix<double, Inputs, 1>& clampedU, units::second_t dt,
+      DiscretizationCache<States, Inputs>& cache) const {
+    Eigen::Matrix<double, States, States> discA;
+    Eigen::Matrix<double, States, Inputs> discB;
+    cache.DiscretizeAB(m_A, m_B, dt, &discA, &discB);
+
+    return discA * x + discB * clampedU;
+  }
+
   /**
    * Computes the new y given the control input.
    *
@@ -0,0 +1,97 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "frc/geometry/Pose2d.h"
+#include "frc/spline/SplineParameterizer.h"
+#include "frc/trajectory/Trajectory.h"
+#include "frc/trajectory/TrajectoryConfig.h"
+#include "frc/trajectory/TrajectoryParameterizer.h"
+
+namespace frc {
+/**
+ * Generates a trajectory through a list of waypoints with quintic hermite
+ * splines, and regenerates it incrementally when waypoints move.
+ *
+ * Each spline only depends on the waypoints at its ends, so moving a waypoint
+ * only reparameterizes the splines next to it. The forward and backward passes
+ * of time parameterization resume at the changed spline points and stop once
+ * their states match the previous ones, and the unchanged states are spliced
+ * back in. This makes replanning, like moving the final pose after a vision
+ * update, much cheaper than calling TrajectoryGenerator::GenerateTrajectory()
+ * again.
+ *
+ * The trajectory matches TrajectoryGenerator::GenerateTrajectory() for the
+ * same waypoints and config up to floating point rounding.
+ */
+class IncrementalTrajectoryGenerator {
+ public:
+  /**
+   * Generates the initial trajectory.
+   *
+   * @param waypoints The waypoints; there must be at least two.
+   * @param config    The configuration for the trajectory.
+   */
+  IncrementalTrajectoryGenerator(std::vector<Pose2d> waypoints,
+                                 TrajectoryConfig config);
+
+  /**
+   * Returns the trajectory through the current waypoints.
+   */
+  const Trajectory& GetTrajectory() const { return m_trajectory; }
+
+  /**
+   * Returns the current waypoints.
+   */
+  const std::vector<Pose2d>& GetWaypoints() const { return m_waypoints; }
+
+  /**
+   * Moves one waypoint and regenerates the affected part of the trajectory.
+   *
+   * @param index The index of the waypoint; must be less than the number of
+   *              waypoints.
+   * @param pose  The new pose of the waypoint.
+   * @return The regenerated trajectory.
+   */
+  const Trajectory& SetWaypoint(size_t index, const Pose2d& pose);
+
+  /**
+   * Replaces the waypoints and regenerates the trajectory. If the number of
+   * waypoints is unchanged, only the part between the first and last changed
+   * waypoints is regenerated.
+   *
+   * @param waypoints The new waypoints; there must be at least two.
+   * @return The regenerated trajectory.
+   */
+  const Trajectory& SetWaypoints(const std::vector<Pose2d>& waypoints);
+
+ private:
+  using ConstrainedState = TrajectoryParameterizer::ConstrainedState;
+  using PoseWithCurvature = SplineParameterizer::PoseWithCurvature;
+
+  std::vector<Pose2d> m_waypoints;
+  TrajectoryConfig m_config;
+
+  // Cached time parameterization, empty if it has to be fully regenerated.
+  // m_splineEnds[i] is the index of the last point of spline i.
+  std::vector<PoseWithCurvature> m_points;
+  std::vector<size_t> m_splineEnds;
+  std::vector<ConstrainedState> m_forwardStates;
+  std::vector<ConstrainedState> m_constrainedStates;
+  std::vector<Trajectory::State> m_states;
+
+  Trajectory m_trajectory;
+
+  void Regenerate(size_t firstSpline, size_t lastSpline);
+  size_t ForwardPass(size_t begin, size_t compareFrom);
+  size_t BackwardPass(size_t end, size_t compareBefore);
+
+  static bool SameProfile(const ConstrainedState& a,
+                          const ConstrainedState& b);
+};
+}  // namespace frc
@@ -4,8 +4,11 @@
 
 #pragma once
 
+#include <cstddef>
 #include <vector>
 
+#include <wpi/span.h>
+
 #include "frc/geometry/Pose2d.h"
 #include "frc/geometry/Transform2d.h"
 #include "units/acceleration.h"
@@ -71,6 +74,55 @@ class Trajectory {
     State Interpolate(State endValue, double i) const;
   };
 
+  /**
+   * Samples a trajectory at increasing points in time, such as from a
+   * trajectory follower's control loop.
+   *
+   * Each sample continues the search for the surrounding states from where the
+   * previous sample left off, so sampling in time order costs amortized O(1)
+   * instead of a binary search per sample. Sampling an earlier time falls back
+   * to a binary search.
+   *
+   * The sampler refers to the trajectory, which must outlive it and must not
+   * be moved or modified while the sampler is in use.
+   */
+  class Sampler {
+   public:
+    Sampler() = default;
+
+    /**
+     * Constructs a sampler for a trajectory, starting at its beginning.
+     *
+     * @param trajectory The trajectory to sample.
+     */
+    explicit Sampler(const Trajectory& trajectory)
+        : m_trajectory{&trajectory} {}
+
+    /**
+     * Sample the trajectory at a point in time. This returns the same state
+     * as Trajectory::Sample().
+     *
+     * @param t The point in time since the beginning of the trajectory to
+     *          sample.
+     * @return The state at that point in time.
+     */
+    State Sample(units::second_t t);
+
+    /**
+     * Moves the sampler back to the beginning of the trajectory.
+     */
+    void Reset() { m_index = 1; }
+
+   private:
+    // Sampling further ahead than this uses a binary search
+    static constexpr size_t kMaxLinearSteps = 8;
+
+    const Trajectory* m_trajectory = nullptr;
+
+    // The index of the state after the previous sample
+    size_t m_index = 1;
+  };
+
   Trajectory() = default;
 
   /**
@@ -98,6 +150,16 @@ class Trajectory {
    */
   State Sample(units::second_t t) const;
 
+  /**
+   * Sample the trajectory at several points in time, such as for
+   * visualization. Times in increasing order are sampled fastest.
+   *
+   * @param times The points in time since the beginning of the trajectory to
+   *              sample.
+   * @return The states at those points in time.
+   */
+  std::vector<State> SampleMany(wpi::span<const units::second_t> times) const;
+
   /**
    * Transforms all poses in the trajectory by the given transform. This is
    * useful for converting a robot-relative trajectory into a field-relative
@@ -154,8 +216,19 @@ class Trajectory {
 
  private:
   std::vector<State> m_states;
+
+  // The times of m_states, kept contiguous so searches for a time don't
+  // touch the rest of each state
+  std::vector<units::second_t> m_times;
+
   units::second_t m_totalTime = 0_s;
 
+  /**
+   * Returns the state at time t, which must be between the times of the
+   * states at index - 1 and index.
+   */
+  State Interpolate(size_t index, units::second_t t) const;
+
   /**
    * Linearly interpolates between two values.
    *
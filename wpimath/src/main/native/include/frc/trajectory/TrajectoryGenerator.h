@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <utility>
@@ -86,6 +88,9 @@ class TrajectoryGenerator {
    * Generate spline points from a vector of splines by parameterizing the
    * splines.
    *
+   * The splines are independent, so paths with many splines are split across
+   * up to SetMaxThreads() threads.
+   *
    * @param splines The splines to parameterize.
    *
    * @return The spline points for use in time parameterization of a trajectory.
@@ -93,25 +98,61 @@ class TrajectoryGenerator {
   template <typename Spline>
   static std::vector<PoseWithCurvature> SplinePointsFromSplines(
       const std::vector<Spline>& splines) {
-    // Create the vector of spline points.
-    std::vector<PoseWithCurvature> splinePoints;
+    // Parameterize each spline into its own vector.
+    std::vector<std::vector<PoseWithCurvature>> pointsPerSpline(
+        splines.size());
+    auto parameterizeRange = [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        pointsPerSpline[i] = SplineParameterizer::Parameterize(splines[i]);
+      }
+    };
 
-    // Add the first point to the vector.
-    splinePoints.push_back(splines.front().GetPoint(0.0));
+    size_t numThreads = std::min<size_t>(
+        s_maxThreads, splines.size() / kMinSplinesPerThread);
+    if (numThreads > 1) {
+      size_t chunkSize = (splines.size() + numThreads - 1) / numThreads;
+      RunInParallel(numThreads, [&](size_t chunk) {
+        size_t begin = chunk * chunkSize;
+        parameterizeRange(begin, std::min(begin + chunkSize, splines.size()));
+      });
+    } else {
+      parameterizeRange(0, splines.size());
+    }
+
+    // Concatenate the points, reserving the final size up front. We are
+    // removing the first point of each spline after the first because it's a
+    // duplicate of the last point from the previous spline.
+    size_t numPoints = 1;
+    for (auto&& points : pointsPerSpline) {
+      numPoints += points.size() - 1;
+    }
 
-    // Iterate through the vector and parameterize each spline, adding the
-    // parameterized points to the final vector.
-    for (auto&& spline : splines) {
-      auto points = SplineParameterizer::Parameterize(spline);
-      // Append the array of poses to the vector. We are removing the first
-      // point because it's a duplicate of the last point from the previous
-      // spline.
+    std::vector<PoseWithCurvature> splinePoints;
+    splinePoints.reserve(numPoints);
+    splinePoints.push_back(pointsPerSpline.front().front());
+    for (auto&& points : pointsPerSpline) {
       splinePoints.insert(std::end(splinePoints), std::begin(points) + 1,
                           std::end(points));
     }
     return splinePoints;
   }
 
+  /**
+   * Sets the maximum number of threads SplinePointsFromSplines() uses. The
+   * default is the number of hardware threads. Set this to 1 to parameterize
+   * all splines on the calling thread.
+   *
+   * @param threads The maximum number of threads.
+   */
+  static void SetMaxThreads(unsigned int threads) {
+    s_maxThreads = std::max(threads, 1u);
+  }
+
+  /**
+   * Returns the maximum number of threads SplinePointsFromSplines() uses.
+   */
+  static unsigned int GetMaxThreads() { return s_maxThreads; }
+
   /**
    * Set error reporting function. By default, it is output to stderr.
    *
@@ -122,9 +163,22 @@ class TrajectoryGenerator {
   }
 
  private:
+  friend class IncrementalTrajectoryGenerator;
+
   static void ReportError(const char* error);
 
+  // Runs func(0) through func(count - 1) on the calling thread and a
+  // persistent pool of worker threads, and returns once all have finished. The
+  // first exception thrown by func is rethrown on the calling thread.
+  static void RunInParallel(size_t count,
+                            const std::function<void(size_t)>& func);
+
+  // Each thread should parameterize at least this many splines to make up for
+  // the cost of handing work to it.
+  static constexpr size_t kMinSplinesPerThread = 4;
+
   static const Trajectory kDoNothingTrajectory;
   static std::function<void(const char*)> s_errorFunc;
+  static std::atomic<unsigned int> s_maxThreads;
 };
 }  // namespace frc
@@ -71,6 +71,8 @@ class TrajectoryParameterizer {
       units::meters_per_second_squared_t maxAcceleration, bool reversed);
 
  private:
+  friend class IncrementalTrajectoryGenerator;
+
   constexpr static double kEpsilon = 1E-6;
 
   /**
@@ -86,6 +88,55 @@ class TrajectoryParameterizer {
     units::meters_per_second_squared_t maxAcceleration = 0_mps_sq;
   };
 
+  /**
+   * Constrains a state by its predecessor. This is one step of the forward
+   * pass, and only depends on the predecessor and the state's pose.
+   *
+   * @param constraints A vector of the user-defined velocity and acceleration
+   * constraints.
+   * @param maxVelocity The max velocity for the trajectory.
+   * @param maxAcceleration The max acceleration for the trajectory.
+   * @param reversed Whether the robot is traveling backwards.
+   * @param predecessor Pointer to the previous constrained state. Its max
+   * acceleration may be lowered.
+   * @param state Pointer to the constrained state with its pose set. This is
+   * mutated in place.
+   */
+  static void ForwardStep(
+      const std::vector<std::unique_ptr<TrajectoryConstraint>>& constraints,
+      units::meters_per_second_t maxVelocity,
+      units::meters_per_second_squared_t maxAcceleration, bool reversed,
+      ConstrainedState* predecessor, ConstrainedState* state);
+
+  /**
+   * Constrains a state from the forward pass by its successor. This is one
+   * step of the backward pass.
+   *
+   * @param constraints A vector of the user-defined velocity and acceleration
+   * constraints.
+   * @param reversed Whether the robot is traveling backwards.
+   * @param successor Pointer to the next constrained state. Its min
+   * acceleration may be raised.
+   * @param state Pointer to the constrained state. This is mutated in place.
+   */
+  static void BackwardStep(
+      const std::vector<std::unique_ptr<TrajectoryConstraint>>& constraints,
+      bool reversed, ConstrainedState* successor, ConstrainedState* state);
+
+  /**
+   * Integrates the constrained states forward in time to obtain the
+   * trajectory states.
+   *
+   * @param constrainedStates The constrained states from the backward pass.
+   * @param reversed Whether the robot is traveling backwards.
+   * @param begin The index of the first state to integrate. The states before
+   * it must already be integrated.
+   * @param states Pointer to the trajectory states, one per constrained state.
+   */
+  static void IntegrateStates(
+      const std::vector<ConstrainedState>& constrainedStates, bool reversed,
+      size_t begin, std::vector<Trajectory::State>* states);
+
   /**
    * Enforces acceleration limits as defined by the constraints. This function
    * is used when time parameterizing a trajectory.
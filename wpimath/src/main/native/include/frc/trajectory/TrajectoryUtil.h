@@ -4,10 +4,14 @@
 
 #pragma once
 
+#include <stdint.h>
+
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include "frc/trajectory/Trajectory.h"
+#include "frc/trajectory/TrajectoryView.h"
 
 namespace frc {
 class TrajectoryUtil {
@@ -50,5 +54,51 @@ class TrajectoryUtil {
    * @return the string containing the serialized JSON
    */
   static Trajectory DeserializeTrajectory(std::string_view json_str);
+
+  /**
+   * Exports a Trajectory to a binary trajectory file. These load much faster
+   * than PathWeaver-style JSON; see TrajectoryView for the format.
+   *
+   * @param trajectory the trajectory to export
+   * @param path the path of the file to export to
+   * @param quantize whether to store the states as floats, which halves the
+   *                 file size at the cost of precision
+   */
+  static void ToBinary(const Trajectory& trajectory, std::string_view path,
+                       bool quantize = false);
+
+  /**
+   * Memory-maps a binary trajectory file. No states are parsed until they are
+   * sampled.
+   *
+   * @param path The path of the binary file to import from.
+   *
+   * @return A view of the trajectory in the file.
+   */
+  static TrajectoryView FromBinary(std::string_view path);
+
+  /**
+   * Serializes a Trajectory to the binary trajectory format.
+   *
+   * @param trajectory the trajectory to serialize; it must have at least one
+   *                   state
+   * @param quantize whether to store the states as floats
+   *
+   * @return the serialized trajectory
+   */
+  static std::vector<uint8_t> SerializeTrajectoryBinary(
+      const Trajectory& trajectory, bool quantize = false);
+
+  /**
+   * Converts a PathWeaver-style JSON file to a binary trajectory file, such
+   * as at build time so the robot program only loads the binary file.
+   *
+   * @param jsonPath The path of the json file to import from.
+   * @param binaryPath The path of the binary file to export to.
+   * @param quantize whether to store the states as floats
+   */
+  static void PathweaverJsonToBinary(std::string_view jsonPath,
+                                     std::string_view binaryPath,
+                                     bool quantize = false);
 };
 }  // namespace frc
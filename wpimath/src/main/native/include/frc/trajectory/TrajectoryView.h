@@ -0,0 +1,124 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <cstddef>
+#include <string_view>
+
+#include <wpi/MappedFileRegion.h>
+#include <wpi/span.h>
+
+#include "frc/trajectory/Trajectory.h"
+#include "units/time.h"
+
+namespace frc {
+
+/**
+ * A read-only view of a trajectory in the binary trajectory format.
+ *
+ * Opening a file memory-maps it, so no states are parsed or copied until they
+ * are sampled. Use TrajectoryUtil::ToBinary() to write files in this format.
+ *
+ * All fields are little-endian. The file starts with a 16-byte header:
+ *
+ * <pre>
+ * Offset  Size  Field
+ * 0       8     Magic "WPITRAJ\0"
+ * 8       2     Format version, currently 1
+ * 10      2     Flags; bit 0 is set if the states are quantized
+ * 12      4     Number of states
+ * </pre>
+ *
+ * The header is followed by the states, each of which is time (s), velocity
+ * (m/s), acceleration (m/s²), x (m), y (m), heading (rad), and curvature
+ * (rad/m). Each field is an 8-byte double, or a 4-byte float if the states
+ * are quantized.
+ */
+class TrajectoryView {
+ public:
+  /// The current binary format version.
+  static constexpr uint16_t kVersion = 1;
+
+  /// The flag set if states are stored as floats.
+  static constexpr uint16_t kQuantizedFlag = 1;
+
+  /// The size of the header in bytes.
+  static constexpr size_t kHeaderSize = 16;
+
+  /// The number of fields in each state.
+  static constexpr size_t kFieldsPerState = 7;
+
+  /**
+   * Memory-maps a binary trajectory file.
+   *
+   * @param path The path of the file.
+   * @throws std::runtime_error if the file can't be opened or isn't a valid
+   *         binary trajectory with at least one state.
+   */
+  explicit TrajectoryView(std::string_view path);
+
+  /**
+   * Constructs a view of binary trajectory data in memory. The data must
+   * outlive the view.
+   *
+   * @param data The binary trajectory.
+   * @throws std::runtime_error if the data isn't a valid binary trajectory
+   *         with at least one state.
+   */
+  explicit TrajectoryView(wpi::span<const uint8_t> data);
+
+  TrajectoryView(TrajectoryView&&) = default;
+  TrajectoryView& operator=(TrajectoryView&&) = default;
+
+  /**
+   * Returns the number of states.
+   */
+  size_t size() const { return m_size; }
+
+  /**
+   * Returns true if the states are quantized to floats.
+   */
+  bool IsQuantized() const { return m_quantized; }
+
+  /**
+   * Returns the state at the given index.
+   *
+   * @param index The index of the state; must be less than size().
+   */
+  Trajectory::State GetState(size_t index) const;
+
+  /**
+   * Returns the overall duration of the trajectory.
+   */
+  units::second_t TotalTime() const { return m_totalTime; }
+
+  /**
+   * Sample the trajectory at a point in time. This matches
+   * Trajectory::Sample().
+   *
+   * @param t The point in time since the beginning of the trajectory to sample.
+   * @return The state at that point in time.
+   */
+  Trajectory::State Sample(units::second_t t) const;
+
+  /**
+   * Copies the states into a Trajectory.
+   */
+  Trajectory ToTrajectory() const;
+
+ private:
+  wpi::MappedFileRegion m_file;
+  const uint8_t* m_states = nullptr;
+  size_t m_size = 0;
+  bool m_quantized = false;
+  units::second_t m_totalTime = 0_s;
+
+  void Init(wpi::span<const uint8_t> data, std::string_view name);
+  double GetField(size_t index, size_t field) const;
+};
+
+}  // namespace frc
@@ -0,0 +1,91 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <chrono>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include "frc/estimator/DifferentialDrivePoseEstimator.h"
+#include "frc/geometry/Pose2d.h"
+#include "frc/geometry/Rotation2d.h"
+#include "gtest/gtest.h"
+#include "units/angle.h"
+#include "units/length.h"
+#include "units/time.h"
+
+using std::chrono::duration_cast;
+using std::chrono::high_resolution_clock;
+using std::chrono::nanoseconds;
+
+namespace {
+
+constexpr auto kOdometryPeriod = 5_ms;
+constexpr int kLoops = 2000;
+constexpr auto kCameraPeriod = 33_ms;
+constexpr auto kCameraLatency = 80_ms;
+
+// Drives in a circle at 200 Hz with the given number of 30 Hz cameras and
+// returns the average time per loop spent applying vision measurements.
+double RunLoops(int numCameras, bool batched) {
+  frc::DifferentialDrivePoseEstimator estimator{frc::Rotation2d(),
+                                                frc::Pose2d(),
+                                                {0.02, 0.02, 0.01, 0.02, 0.02},
+                                                {0.01, 0.01, 0.001},
+                                                {0.1, 0.1, 0.01},
+                                                kOdometryPeriod};
+
+  std::vector<std::pair<frc::Pose2d, units::second_t>> pending;
+  units::second_t lastCameraTime = 0_s;
+  nanoseconds visionTime{0};
+
+  for (int i = 0; i < kLoops; ++i) {
+    units::second_t t = kOdometryPeriod * i;
+    units::radian_t heading{0.5 * t.to<double>()};
+    units::meter_t distance{t.to<double>()};
+    estimator.UpdateWithTime(t, frc::Rotation2d{heading}, {1_mps, 1_mps},
+                             distance, distance);
+
+    pending.clear();
+    if (t - lastCameraTime >= kCameraPeriod && t > kCameraLatency) {
+      lastCameraTime = t;
+      for (int camera = 0; camera < numCameras; ++camera) {
+        // Stagger the cameras' capture times
+        units::second_t captureTime = t - kCameraLatency + 2_ms * camera;
+        units::radian_t captureHeading{0.5 * captureTime.to<double>()};
+        pending.emplace_back(
+            frc::Pose2d{units::meter_t{captureTime.to<double>()}, 0_m,
+                        frc::Rotation2d{captureHeading}},
+            captureTime);
+      }
+    }
+
+    auto start = high_resolution_clock::now();
+    if (batched) {
+      estimator.AddVisionMeasurements(pending);
+    } else {
+      for (auto&& [pose, timestamp] : pending) {
+        estimator.AddVisionMeasurement(pose, timestamp);
+      }
+    }
+    visionTime += duration_cast<nanoseconds>(high_resolution_clock::now() -
+                                             start);
+  }
+
+  return static_cast<double>(visionTime.count()) / kLoops;
+}
+
+}  // namespace
+
+// Disabled by default as it only reports timings; run with
+// --gtest_also_run_disabled_tests --gtest_filter='*Benchmark*'
+TEST(DifferentialDrivePoseEstimatorBenchmark, DISABLED_AddVisionMeasurement) {
+  for (int numCameras : {1, 2, 4}) {
+    double individualNs = RunLoops(numCameras, false);
+    double batchedNs = RunLoops(numCameras, true);
+    std::cout << "cameras: " << numCameras
+              << " vision time per loop individual: " << individualNs
+              << " ns batched: " << batchedNs << " ns\n";
+  }
+}
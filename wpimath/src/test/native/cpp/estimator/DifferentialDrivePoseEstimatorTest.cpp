@@ -2,8 +2,12 @@
 // Open Source Software; you can modify and/or share it under the terms of
 // the WPILib BSD license file in the root directory of this project.
 
+#include <algorithm>
 #include <limits>
 #include <random>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 #include "frc/StateSpaceUtil.h"
 #include "frc/estimator/DifferentialDrivePoseEstimator.h"
@@ -97,3 +101,111 @@ TEST(DifferentialDrivePoseEstimatorTest, TestAccuracy) {
       0.2);
   EXPECT_NEAR(0.0, maxError, 0.4);
 }
+
+TEST(DifferentialDrivePoseEstimatorTest, BatchedVisionMeasurements) {
+  auto makeEstimator = [] {
+    return frc::DifferentialDrivePoseEstimator{frc::Rotation2d(),
+                                               frc::Pose2d(),
+                                               {0.02, 0.02, 0.01, 0.02, 0.02},
+                                               {0.01, 0.01, 0.001},
+                                               {0.1, 0.1, 0.01}};
+  };
+  auto individual = makeEstimator();
+  auto batched = makeEstimator();
+
+  for (int i = 0; i < 400; ++i) {
+    units::second_t t = 0.02_s * i;
+    frc::Rotation2d heading{units::radian_t{0.3 * t.to<double>()}};
+    units::meter_t distance{t.to<double>()};
+    individual.UpdateWithTime(t, heading, {1_mps, 1_mps}, distance, distance);
+    batched.UpdateWithTime(t, heading, {1_mps, 1_mps}, distance, distance);
+
+    if (i % 5 == 0 && i >= 10) {
+      std::vector<std::pair<frc::Pose2d, units::second_t>> measurements{
+          {frc::Pose2d{units::meter_t{t.to<double>() - 0.1}, 0.2_m, heading},
+           t - 0.1_s},
+          {frc::Pose2d{units::meter_t{t.to<double>() - 0.2}, -0.1_m, heading},
+           t - 0.2_s},
+          {frc::Pose2d{units::meter_t{t.to<double>() - 0.05}, 0.1_m, heading},
+           t - 0.05_s}};
+
+      // AddVisionMeasurements() takes measurements in any order
+      batched.AddVisionMeasurements(measurements);
+      std::sort(
+          measurements.begin(), measurements.end(),
+          [](const auto& a, const auto& b) { return a.second < b.second; });
+      for (auto&& [pose, timestamp] : measurements) {
+        individual.AddVisionMeasurement(pose, timestamp);
+      }
+    }
+
+    // Each replay's first step uses the nominal dt, so individual replays
+    // differ slightly from one batched replay
+    auto individualPose = individual.GetEstimatedPosition();
+    auto batchedPose = batched.GetEstimatedPosition();
+    ASSERT_NEAR(individualPose.X().to<double>(), batchedPose.X().to<double>(),
+                1e-6);
+    ASSERT_NEAR(individualPose.Y().to<double>(), batchedPose.Y().to<double>(),
+                1e-6);
+    ASSERT_NEAR(individualPose.Rotation().Radians().to<double>(),
+                batchedPose.Rotation().Radians().to<double>(), 1e-6);
+  }
+}
+
+TEST(DifferentialDrivePoseEstimatorTest, BatchedVisionMeasurementStdDevs) {
+  auto makeEstimator = [] {
+    return frc::DifferentialDrivePoseEstimator{frc::Rotation2d(),
+                                               frc::Pose2d(),
+                                               {0.02, 0.02, 0.01, 0.02, 0.02},
+                                               {0.01, 0.01, 0.001},
+                                               {0.1, 0.1, 0.01}};
+  };
+  auto individual = makeEstimator();
+  auto batched = makeEstimator();
+
+  for (int i = 0; i < 400; ++i) {
+    units::second_t t = 0.02_s * i;
+    frc::Rotation2d heading{units::radian_t{0.3 * t.to<double>()}};
+    units::meter_t distance{t.to<double>()};
+    individual.UpdateWithTime(t, heading, {1_mps, 1_mps}, distance, distance);
+    batched.UpdateWithTime(t, heading, {1_mps, 1_mps}, distance, distance);
+
+    if (i % 5 == 0 && i >= 10) {
+      // A close, accurate camera and a far, noisy one
+      std::vector<std::tuple<frc::Pose2d, units::second_t,
+                             wpi::array<double, 3>>>
+          measurements{
+              {frc::Pose2d{units::meter_t{t.to<double>() - 0.05}, 0.1_m,
+                           heading},
+               t - 0.05_s,
+               {0.05, 0.05, 0.01}},
+              {frc::Pose2d{units::meter_t{t.to<double>() - 0.2}, -0.3_m,
+                           heading},
+               t - 0.2_s,
+               {1.0, 1.0, 0.5}}};
+
+      batched.AddVisionMeasurements(measurements);
+      std::sort(measurements.begin(), measurements.end(),
+                [](const auto& a, const auto& b) {
+                  return std::get<1>(a) < std::get<1>(b);
+                });
+      for (auto&& [pose, timestamp, stdDevs] : measurements) {
+        individual.AddVisionMeasurement(pose, timestamp, stdDevs);
+      }
+    } else if (i % 5 == 1 && i >= 10) {
+      // Later measurements use the newest measurement's standard deviations
+      frc::Pose2d pose{units::meter_t{t.to<double>()}, 0_m, heading};
+      individual.AddVisionMeasurement(pose, t);
+      batched.AddVisionMeasurement(pose, t);
+    }
+
+    auto individualPose = individual.GetEstimatedPosition();
+    auto batchedPose = batched.GetEstimatedPosition();
+    ASSERT_NEAR(individualPose.X().to<double>(), batchedPose.X().to<double>(),
+                1e-6);
+    ASSERT_NEAR(individualPose.Y().to<double>(), batchedPose.Y().to<double>(),
+                1e-6);
+    ASSERT_NEAR(individualPose.Rotation().Radians().to<double>(),
+                batchedPose.Rotation().Radians().to<double>(), 1e-6);
+  }
+}
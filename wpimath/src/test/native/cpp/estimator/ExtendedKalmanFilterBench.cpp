@@ -0,0 +1,105 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+
+#include "Eigen/Core"
+#include "estimator/DrivetrainDynamics.h"
+#include "frc/estimator/ExtendedKalmanFilter.h"
+#include "frc/estimator/UnscentedKalmanFilter.h"
+#include "frc/system/AutoDiffJacobian.h"
+
+using std::chrono::duration_cast;
+using std::chrono::high_resolution_clock;
+using std::chrono::nanoseconds;
+
+namespace {
+
+constexpr int kSteps = 20000;
+constexpr auto kDt = 5_ms;
+
+constexpr auto Dynamics = &frc::DrivetrainDynamics<double>;
+
+Eigen::Matrix<double, 3, 1> LocalMeasurementModel(
+    const Eigen::Matrix<double, 5, 1>& x, const Eigen::Matrix<double, 2, 1>&) {
+  Eigen::Matrix<double, 3, 1> y;
+  y << x(2), x(3), x(4);
+  return y;
+}
+
+Eigen::Matrix<double, 5, 5> AutoDiffStateJacobian(
+    const Eigen::Matrix<double, 5, 1>& x,
+    const Eigen::Matrix<double, 2, 1>& u) {
+  return frc::AutoDiffJacobianX<5, 5, 2>(
+      [](const auto& x, const auto& u) {
+        return frc::DrivetrainDynamics(x, u);
+      },
+      x, u);
+}
+
+Eigen::Matrix<double, 3, 5> MeasurementJacobian(
+    const Eigen::Matrix<double, 5, 1>&, const Eigen::Matrix<double, 2, 1>&) {
+  Eigen::Matrix<double, 3, 5> C;
+  C << 0, 0, 1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 1;
+  return C;
+}
+
+template <typename Filter>
+double TimeNsPerStep(Filter& filter) {
+  Eigen::Matrix<double, 2, 1> u;
+  u << 8.0, 10.0;
+  Eigen::Matrix<double, 5, 1> x = Eigen::Matrix<double, 5, 1>::Zero();
+
+  auto start = high_resolution_clock::now();
+  for (int i = 0; i < kSteps; ++i) {
+    x(2) += 0.001;
+    filter.Predict(u, kDt);
+    filter.Correct(u, LocalMeasurementModel(x, u));
+  }
+  auto stop = high_resolution_clock::now();
+  return static_cast<double>(duration_cast<nanoseconds>(stop - start).count()) /
+         kSteps;
+}
+
+}  // namespace
+
+// Disabled by default as it only reports timings; run with
+// --gtest_also_run_disabled_tests --gtest_filter='*Benchmark*'
+TEST(ExtendedKalmanFilterBenchmark, DISABLED_Jacobians) {
+  frc::ExtendedKalmanFilter<5, 2, 3> numerical{
+      Dynamics, LocalMeasurementModel, {0.5, 0.5, 10.0, 1.0, 1.0},
+      {0.0001, 0.5, 0.5}, kDt};
+  frc::ExtendedKalmanFilter<5, 2, 3> autoDiff{
+      Dynamics, LocalMeasurementModel, {0.5, 0.5, 10.0, 1.0, 1.0},
+      {0.0001, 0.5, 0.5}, kDt};
+  autoDiff.SetStateJacobian(AutoDiffStateJacobian);
+  autoDiff.SetMeasurementJacobian(MeasurementJacobian);
+
+  double numericalNs = TimeNsPerStep(numerical);
+  double autoDiffNs = TimeNsPerStep(autoDiff);
+  std::cout << "EKF Predict + Correct numerical Jacobians: " << numericalNs
+            << " ns autodiff Jacobians: " << autoDiffNs << " ns\n";
+  EXPECT_TRUE(autoDiff.Xhat().allFinite());
+}
+
+// Disabled by default as it only reports timings; run with
+// --gtest_also_run_disabled_tests --gtest_filter='*Benchmark*'
+TEST(UnscentedKalmanFilterBenchmark, DISABLED_Jacobians) {
+  frc::UnscentedKalmanFilter<5, 2, 3> numerical{
+      Dynamics, LocalMeasurementModel, {0.5, 0.5, 10.0, 1.0, 1.0},
+      {0.0001, 0.5, 0.5}, kDt};
+  frc::UnscentedKalmanFilter<5, 2, 3> autoDiff{
+      Dynamics, LocalMeasurementModel, {0.5, 0.5, 10.0, 1.0, 1.0},
+      {0.0001, 0.5, 0.5}, kDt};
+  autoDiff.SetStateJacobian(AutoDiffStateJacobian);
+
+  double numericalNs = TimeNsPerStep(numerical);
+  double autoDiffNs = TimeNsPerStep(autoDiff);
+  std::cout << "UKF Predict + Correct numerical Jacobian: " << numericalNs
+            << " ns autodiff Jacobian: " << autoDiffNs << " ns\n";
+  EXPECT_TRUE(autoDiff.Xhat().allFinite());
+}
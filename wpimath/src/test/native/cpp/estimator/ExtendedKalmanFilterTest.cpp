@@ -9,50 +9,16 @@
 
 #include "Eigen/Core"
 #include "Eigen/QR"
+#include "estimator/DrivetrainDynamics.h"
 #include "frc/StateSpaceUtil.h"
 #include "frc/estimator/ExtendedKalmanFilter.h"
+#include "frc/system/AutoDiffJacobian.h"
 #include "frc/system/NumericalJacobian.h"
-#include "frc/system/plant/DCMotor.h"
 #include "frc/trajectory/TrajectoryGenerator.h"
-#include "units/moment_of_inertia.h"
 
 namespace {
 
-Eigen::Matrix<double, 5, 1> Dynamics(const Eigen::Matrix<double, 5, 1>& x,
-                                     const Eigen::Matrix<double, 2, 1>& u) {
-  auto motors = frc::DCMotor::CIM(2);
-
-  // constexpr double Glow = 15.32;       // Low gear ratio
-  constexpr double Ghigh = 7.08;       // High gear ratio
-  constexpr auto rb = 0.8382_m / 2.0;  // Robot radius
-  constexpr auto r = 0.0746125_m;      // Wheel radius
-  constexpr auto m = 63.503_kg;        // Robot mass
-  constexpr auto J = 5.6_kg_sq_m;      // Robot moment of inertia
-
-  auto C1 = -std::pow(Ghigh, 2) * motors.Kt /
-            (motors.Kv * motors.R * units::math::pow<2>(r));
-  auto C2 = Ghigh * motors.Kt / (motors.R * r);
-  auto k1 = (1 / m + units::math::pow<2>(rb) / J);
-  auto k2 = (1 / m - units::math::pow<2>(rb) / J);
-
-  units::meters_per_second_t vl{x(3)};
-  units::meters_per_second_t vr{x(4)};
-  units::volt_t Vl{u(0)};
-  units::volt_t Vr{u(1)};
-
-  Eigen::Matrix<double, 5, 1> result;
-  auto v = 0.5 * (vl + vr);
-  result(0) = v.to<double>() * std::cos(x(2));
-  result(1) = v.to<double>() * std::sin(x(2));
-  result(2) = ((vr - vl) / (2.0 * rb)).to<double>();
-  result(3) =
-      k1.to<double>() * ((C1 * vl).to<double>() + (C2 * Vl).to<double>()) +
-      k2.to<double>() * ((C1 * vr).to<double>() + (C2 * Vr).to<double>());
-  result(4) =
-      k2.to<double>() * ((C1 * vl).to<double>() + (C2 * Vl).to<double>()) +
-      k1.to<double>() * ((C1 * vr).to<double>() + (C2 * Vr).to<double>());
-  return result;
-}
+constexpr auto Dynamics = &frc::DrivetrainDynamics<double>;
 
 Eigen::Matrix<double, 3, 1> LocalMeasurementModel(
     const Eigen::Matrix<double, 5, 1>& x,
@@ -167,3 +133,65 @@ TEST(ExtendedKalmanFilterTest, Convergence) {
   ASSERT_NEAR(0.0, observer.Xhat(3), 1.0);
   ASSERT_NEAR(0.0, observer.Xhat(4), 1.0);
 }
+
+// Test that a filter using analytic and autodiff Jacobians tracks the one
+// using numerical Jacobians
+TEST(ExtendedKalmanFilterTest, UserJacobians) {
+  constexpr auto dt = 0.00505_s;
+
+  frc::ExtendedKalmanFilter<5, 2, 3> numerical{Dynamics,
+                                               LocalMeasurementModel,
+                                               {0.5, 0.5, 10.0, 1.0, 1.0},
+                                               {0.0001, 0.5, 0.5},
+                                               dt};
+  frc::ExtendedKalmanFilter<5, 2, 3> analytic{Dynamics,
+                                              LocalMeasurementModel,
+                                              {0.5, 0.5, 10.0, 1.0, 1.0},
+                                              {0.0001, 0.5, 0.5},
+                                              dt};
+  analytic.SetStateJacobian([](const Eigen::Matrix<double, 5, 1>& x,
+                               const Eigen::Matrix<double, 2, 1>& u) {
+    return frc::AutoDiffJacobianX<5, 5, 2>(
+        [](const auto& x, const auto& u) {
+          return frc::DrivetrainDynamics(x, u);
+        },
+        x, u);
+  });
+  analytic.SetMeasurementJacobian([](const Eigen::Matrix<double, 5, 1>&,
+                                     const Eigen::Matrix<double, 2, 1>&) {
+    Eigen::Matrix<double, 3, 5> C;
+    C << 0, 0, 1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 1;
+    return C;
+  });
+
+  Eigen::Matrix<double, 5, 5> globalC =
+      Eigen::Matrix<double, 5, 5>::Identity();
+  auto R = frc::MakeCovMatrix(0.01, 0.01, 0.0001, 0.5, 0.5);
+
+  Eigen::Matrix<double, 5, 1> x = Eigen::Matrix<double, 5, 1>::Zero();
+  Eigen::Matrix<double, 2, 1> u;
+  u << 8.0, 10.0;
+  for (int i = 0; i < 200; ++i) {
+    x = frc::RK4(Dynamics, x, u, dt);
+
+    numerical.Predict(u, dt);
+    analytic.Predict(u, dt);
+
+    auto localY = LocalMeasurementModel(x, u);
+    numerical.Correct(u, localY);
+    analytic.Correct(u, localY);
+
+    if (i % 20 == 0) {
+      auto globalY = GlobalMeasurementModel(x, u);
+      numerical.Correct<5>(u, globalY, GlobalMeasurementModel, R);
+      analytic.Correct<5>(
+          u, globalY, GlobalMeasurementModel,
+          [&](const Eigen::Matrix<double, 5, 1>&,
+              const Eigen::Matrix<double, 2, 1>&) { return globalC; },
+          R);
+    }
+
+    ASSERT_LT((numerical.Xhat() - analytic.Xhat()).norm(), 1e-6);
+    ASSERT_LT((numerical.P() - analytic.P()).norm(), 1e-6);
+  }
+}
@@ -0,0 +1,97 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc/filter/LinearFilterBank.h"  // NOLINT(build/include_order)
+
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "frc/filter/LinearFilter.h"
+#include "gtest/gtest.h"
+#include "units/time.h"
+
+namespace {
+
+constexpr int kChannels = 6;
+
+// Runs the bank and a LinearFilter per channel over the same random inputs
+template <typename Bank>
+void ExpectMatchesFilters(Bank bank,
+                          std::vector<frc::LinearFilter<double>> filters) {
+  std::mt19937 gen{1234};
+  std::uniform_real_distribution<double> dist{-10.0, 10.0};
+
+  for (int step = 0; step < 200; ++step) {
+    Eigen::Matrix<double, kChannels, 1> input;
+    for (int i = 0; i < kChannels; ++i) {
+      input(i) = dist(gen);
+    }
+
+    auto output = bank.Calculate(input);
+    for (int i = 0; i < kChannels; ++i) {
+      EXPECT_NEAR(filters[i].Calculate(input(i)), output(i), 1E-9);
+    }
+  }
+}
+
+template <typename Factory>
+std::vector<frc::LinearFilter<double>> MakeFilters(Factory factory) {
+  std::vector<frc::LinearFilter<double>> filters;
+  for (int i = 0; i < kChannels; ++i) {
+    filters.emplace_back(factory());
+  }
+  return filters;
+}
+
+}  // namespace
+
+TEST(LinearFilterBankTest, SinglePoleIIR) {
+  auto factory = [] {
+    return frc::LinearFilter<double>::SinglePoleIIR(0.015915, 5_ms);
+  };
+  ExpectMatchesFilters(
+      frc::LinearFilterBank<kChannels>::SinglePoleIIR(0.015915, 5_ms),
+      MakeFilters(factory));
+  ExpectMatchesFilters(
+      frc::LinearFilterBank<kChannels, 1, 1>::SinglePoleIIR(0.015915, 5_ms),
+      MakeFilters(factory));
+}
+
+TEST(LinearFilterBankTest, HighPass) {
+  auto factory = [] {
+    return frc::LinearFilter<double>::HighPass(0.006631, 5_ms);
+  };
+  ExpectMatchesFilters(
+      frc::LinearFilterBank<kChannels>::HighPass(0.006631, 5_ms),
+      MakeFilters(factory));
+  ExpectMatchesFilters(
+      frc::LinearFilterBank<kChannels, 2, 1>::HighPass(0.006631, 5_ms),
+      MakeFilters(factory));
+}
+
+TEST(LinearFilterBankTest, MovingAverage) {
+  auto factory = [] { return frc::LinearFilter<double>::MovingAverage(6); };
+  ExpectMatchesFilters(frc::LinearFilterBank<kChannels>::MovingAverage(6),
+                       MakeFilters(factory));
+  ExpectMatchesFilters(
+      frc::LinearFilterBank<kChannels, 6, 0>::MovingAverage(6),
+      MakeFilters(factory));
+}
+
+TEST(LinearFilterBankTest, Reset) {
+  auto bank = frc::LinearFilterBank<2>::MovingAverage(3);
+  bank.Calculate(Eigen::Vector2d{3.0, 6.0});
+  bank.Reset();
+  auto output = bank.Calculate(Eigen::Vector2d{3.0, 6.0});
+  EXPECT_DOUBLE_EQ(1.0, output(0));
+  EXPECT_DOUBLE_EQ(2.0, output(1));
+}
+
+TEST(LinearFilterBankTest, WrongNumberOfTaps) {
+  EXPECT_THROW((frc::LinearFilterBank<2, 3, 0>::MovingAverage(4)),
+               std::runtime_error);
+  EXPECT_THROW((frc::LinearFilterBank<2, 2, 1>::SinglePoleIIR(0.1, 5_ms)),
+               std::runtime_error);
+}
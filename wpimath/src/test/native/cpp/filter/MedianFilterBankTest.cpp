@@ -0,0 +1,54 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc/filter/MedianFilterBank.h"  // NOLINT(build/include_order)
+
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "frc/filter/MedianFilter.h"
+#include "gtest/gtest.h"
+
+TEST(MedianFilterBankTest, MatchesMedianFilters) {
+  constexpr int kChannels = 4;
+
+  // Small integers so windows hold duplicates
+  std::mt19937 gen{1234};
+  std::uniform_int_distribution<int> dist{0, 8};
+
+  for (size_t size : {1, 4, 7}) {
+    frc::MedianFilterBank<kChannels> bank{size};
+    std::vector<frc::MedianFilter<double>> filters(
+        kChannels, frc::MedianFilter<double>{size});
+
+    for (int step = 0; step < 100; ++step) {
+      Eigen::Matrix<double, kChannels, 1> input;
+      for (int i = 0; i < kChannels; ++i) {
+        input(i) = dist(gen);
+      }
+
+      auto output = bank.Calculate(input);
+      for (int i = 0; i < kChannels; ++i) {
+        EXPECT_EQ(filters[i].Calculate(input(i)), output(i));
+      }
+    }
+  }
+}
+
+TEST(MedianFilterBankTest, Reset) {
+  frc::MedianFilterBank<2> bank{3};
+  bank.Calculate(Eigen::Vector2d{100.0, 100.0});
+  bank.Calculate(Eigen::Vector2d{100.0, 100.0});
+  bank.Reset();
+
+  bank.Calculate(Eigen::Vector2d{1.0, 4.0});
+  auto output = bank.Calculate(Eigen::Vector2d{3.0, 6.0});
+  EXPECT_EQ(2.0, output(0));
+  EXPECT_EQ(5.0, output(1));
+}
+
+TEST(MedianFilterBankTest, ZeroSize) {
+  EXPECT_THROW(frc::MedianFilterBank<2>{0}, std::runtime_error);
+}
@@ -50,3 +50,14 @@ TEST(MedianFilterTest, MedianFilterFullTestOdd) {
 
   EXPECT_EQ(filter.Calculate(99), 5);
 }
+
+TEST(MedianFilterTest, MedianFilterDuplicates) {
+  frc::MedianFilter<double> filter{3};
+
+  filter.Calculate(2);
+  filter.Calculate(2);
+  EXPECT_EQ(filter.Calculate(1), 2);
+  EXPECT_EQ(filter.Calculate(1), 1);
+  EXPECT_EQ(filter.Calculate(2), 1);
+  EXPECT_EQ(filter.Calculate(2), 2);
+}
@@ -0,0 +1,112 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "Eigen/Core"
+#include "frc/geometry/Pose2d.h"
+#include "frc/geometry/Rotation2d.h"
+#include "frc/interpolation/TimeInterpolatableBuffer.h"
+#include "units/angle.h"
+#include "units/length.h"
+#include "units/time.h"
+
+TEST(TimeInterpolatableBufferTest, Empty) {
+  frc::TimeInterpolatableBuffer<double> buffer{1_s};
+  EXPECT_TRUE(buffer.Empty());
+  EXPECT_FALSE(buffer.Sample(0_s).has_value());
+}
+
+TEST(TimeInterpolatableBufferTest, Double) {
+  frc::TimeInterpolatableBuffer<double> buffer{10_s};
+  buffer.AddSample(0_s, 0.0);
+  buffer.AddSample(1_s, 10.0);
+  buffer.AddSample(3_s, 30.0);
+
+  EXPECT_DOUBLE_EQ(*buffer.Sample(0.5_s), 5.0);
+  EXPECT_DOUBLE_EQ(*buffer.Sample(1_s), 10.0);
+  EXPECT_DOUBLE_EQ(*buffer.Sample(2_s), 20.0);
+
+  // Outside the buffer, the nearest sample is returned
+  EXPECT_DOUBLE_EQ(*buffer.Sample(-1_s), 0.0);
+  EXPECT_DOUBLE_EQ(*buffer.Sample(5_s), 30.0);
+}
+
+TEST(TimeInterpolatableBufferTest, OutOfOrder) {
+  frc::TimeInterpolatableBuffer<double> buffer{10_s};
+  buffer.AddSample(2_s, 20.0);
+  buffer.AddSample(0_s, 0.0);
+  buffer.AddSample(1_s, 100.0);
+  buffer.AddSample(1_s, 10.0);
+
+  EXPECT_EQ(buffer.Size(), 3u);
+  EXPECT_DOUBLE_EQ(*buffer.Sample(0.5_s), 5.0);
+  EXPECT_DOUBLE_EQ(*buffer.Sample(1.5_s), 15.0);
+}
+
+TEST(TimeInterpolatableBufferTest, Expiry) {
+  frc::TimeInterpolatableBuffer<double> buffer{1_s};
+  for (int i = 0; i <= 100; ++i) {
+    buffer.AddSample(0.1_s * i, i);
+  }
+
+  // Only samples within 1 second of the newest (t = 10 s) remain
+  EXPECT_EQ(buffer.Size(), 11u);
+  EXPECT_DOUBLE_EQ(*buffer.Sample(0_s), 90.0);
+}
+
+TEST(TimeInterpolatableBufferTest, Capacity) {
+  frc::TimeInterpolatableBuffer<double> buffer{100_s, 4};
+  for (int i = 0; i < 10; ++i) {
+    buffer.AddSample(1_s * i, i);
+  }
+
+  EXPECT_EQ(buffer.Size(), 4u);
+  EXPECT_DOUBLE_EQ(*buffer.Sample(0_s), 6.0);
+  EXPECT_DOUBLE_EQ(*buffer.Sample(8.5_s), 8.5);
+
+  // Older than everything in a full buffer
+  buffer.AddSample(0_s, 0.0);
+  EXPECT_EQ(buffer.Size(), 4u);
+  EXPECT_DOUBLE_EQ(*buffer.Sample(0_s), 6.0);
+
+  // Inserting in the middle of a full buffer drops the oldest sample
+  buffer.AddSample(7.5_s, 0.0);
+  EXPECT_EQ(buffer.Size(), 4u);
+  EXPECT_DOUBLE_EQ(*buffer.Sample(0_s), 7.0);
+  EXPECT_DOUBLE_EQ(*buffer.Sample(7.5_s), 0.0);
+}
+
+TEST(TimeInterpolatableBufferTest, Rotation2d) {
+  frc::TimeInterpolatableBuffer<frc::Rotation2d> buffer{10_s};
+  buffer.AddSample(0_s, frc::Rotation2d{170_deg});
+  buffer.AddSample(1_s, frc::Rotation2d{-170_deg});
+
+  // Interpolates across the +/-180 degree boundary
+  EXPECT_EQ(*buffer.Sample(0.5_s), frc::Rotation2d{180_deg});
+}
+
+TEST(TimeInterpolatableBufferTest, Pose2d) {
+  frc::TimeInterpolatableBuffer<frc::Pose2d> buffer{10_s};
+
+  // Quarter circle of radius 1 counterclockwise
+  buffer.AddSample(0_s, frc::Pose2d{0_m, 0_m, 0_deg});
+  buffer.AddSample(1_s, frc::Pose2d{1_m, 1_m, 90_deg});
+
+  auto pose = *buffer.Sample(0.5_s);
+  double expected = std::sqrt(2.0) / 2.0;
+  EXPECT_NEAR(pose.X().to<double>(), expected, 1e-9);
+  EXPECT_NEAR(pose.Y().to<double>(), 1.0 - expected, 1e-9);
+  EXPECT_NEAR(pose.Rotation().Degrees().to<double>(), 45.0, 1e-9);
+}
+
+TEST(TimeInterpolatableBufferTest, Vector) {
+  frc::TimeInterpolatableBuffer<Eigen::Vector3d> buffer{10_s};
+  buffer.AddSample(0_s, Eigen::Vector3d{0.0, 1.0, 2.0});
+  buffer.AddSample(2_s, Eigen::Vector3d{2.0, 3.0, 6.0});
+
+  EXPECT_TRUE(buffer.Sample(1_s)->isApprox(Eigen::Vector3d{1.0, 2.0, 4.0}));
+}
@@ -0,0 +1,94 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "frc/system/AutoDiffJacobian.h"
+#include "frc/system/NumericalJacobian.h"
+
+namespace {
+
+const Eigen::Matrix<double, 4, 4> A =
+    (Eigen::Matrix<double, 4, 4>() << 1, 2, 4, 1, 5, 2, 3, 4, 5, 1, 3, 2, 1, 1,
+     3, 7)
+        .finished();
+
+const Eigen::Matrix<double, 4, 2> B =
+    (Eigen::Matrix<double, 4, 2>() << 1, 1, 2, 1, 3, 2, 3, 7).finished();
+
+// Function from which to recover A and B
+template <typename T>
+Eigen::Matrix<T, 4, 1> AxBuFn(const Eigen::Matrix<T, 4, 1>& x,
+                              const Eigen::Matrix<T, 2, 1>& u) {
+  return A.cast<T>() * x + B.cast<T>() * u;
+}
+
+// Unicycle-like nonlinear function of x and u
+template <typename T>
+Eigen::Matrix<T, 3, 1> NonlinearFn(const Eigen::Matrix<T, 3, 1>& x,
+                                   const Eigen::Matrix<T, 2, 1>& u) {
+  using std::cos;
+  using std::exp;
+  using std::sin;
+  using std::sqrt;
+
+  Eigen::Matrix<T, 3, 1> result;
+  result(0) = u(0) * cos(x(2)) - x(1) * u(1);
+  result(1) = u(0) * sin(x(2)) + x(0) * u(1);
+  result(2) = sqrt(x(0) * x(0) + x(1) * x(1)) * exp(-u(1));
+  return result;
+}
+
+}  // namespace
+
+// Test that we can recover A from AxBuFn() exactly
+TEST(AutoDiffJacobianTest, Ax) {
+  Eigen::Matrix<double, 4, 4> newA = frc::AutoDiffJacobianX<4, 4, 2>(
+      [](const auto& x, const auto& u) { return AxBuFn(x, u); },
+      Eigen::Matrix<double, 4, 1>::Zero(),
+      Eigen::Matrix<double, 2, 1>::Zero());
+  EXPECT_EQ(newA, A);
+}
+
+// Test that we can recover B from AxBuFn() exactly
+TEST(AutoDiffJacobianTest, Bu) {
+  Eigen::Matrix<double, 4, 2> newB = frc::AutoDiffJacobianU<4, 4, 2>(
+      [](const auto& x, const auto& u) { return AxBuFn(x, u); },
+      Eigen::Matrix<double, 4, 1>::Zero(),
+      Eigen::Matrix<double, 2, 1>::Zero());
+  EXPECT_EQ(newB, B);
+}
+
+// Test that the Jacobians of a nonlinear function agree with the numerical
+// ones
+TEST(AutoDiffJacobianTest, Nonlinear) {
+  auto f = [](const auto& x, const auto& u) { return NonlinearFn(x, u); };
+
+  for (double theta : {-2.0, 0.0, 0.5, 3.0}) {
+    Eigen::Matrix<double, 3, 1> x;
+    x << 1.5, -0.75, theta;
+    Eigen::Matrix<double, 2, 1> u;
+    u << 2.0, 0.25 * theta;
+
+    Eigen::Matrix<double, 3, 3> numericalA =
+        frc::NumericalJacobianX<3, 3, 2>(f, x, u);
+    Eigen::Matrix<double, 3, 3> autoDiffA =
+        frc::AutoDiffJacobianX<3, 3, 2>(f, x, u);
+    EXPECT_LT((numericalA - autoDiffA).norm(), 1e-8)
+        << "numerical:\n"
+        << numericalA << "\nautodiff:\n"
+        << autoDiffA;
+
+    Eigen::Matrix<double, 3, 2> numericalB =
+        frc::NumericalJacobianU<3, 3, 2>(f, x, u);
+    Eigen::Matrix<double, 3, 2> autoDiffB =
+        frc::AutoDiffJacobianU<3, 3, 2>(f, x, u);
+    EXPECT_LT((numericalB - autoDiffB).norm(), 1e-8)
+        << "numerical:\n"
+        << numericalB << "\nautodiff:\n"
+        << autoDiffB;
+  }
+}
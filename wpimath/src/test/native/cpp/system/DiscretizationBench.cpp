@@ -0,0 +1,61 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+
+#include "Eigen/Core"
+#include "frc/system/Discretization.h"
+#include "frc/system/plant/LinearSystemId.h"
+#include "units/length.h"
+#include "units/mass.h"
+
+using std::chrono::duration_cast;
+using std::chrono::high_resolution_clock;
+using std::chrono::nanoseconds;
+
+static constexpr int kSteps = 100000;
+
+template <typename F>
+static double TimeNsPerStep(F&& func) {
+  auto start = high_resolution_clock::now();
+  for (int i = 0; i < kSteps; ++i) {
+    func(i);
+  }
+  auto stop = high_resolution_clock::now();
+  return static_cast<double>(duration_cast<nanoseconds>(stop - start).count()) /
+         kSteps;
+}
+
+// Disabled by default as it only reports timings; run with
+// --gtest_also_run_disabled_tests --gtest_filter='*Benchmark*'
+TEST(DiscretizationBenchmark, DISABLED_CalculateX) {
+  auto plant = frc::LinearSystemId::DrivetrainVelocitySystem(
+      frc::DCMotor::NEO(4), 70_kg, 0.05_m, 0.4_m, 6.0_kg_sq_m, 6.0);
+  Eigen::Matrix<double, 2, 1> u;
+  u << 6.0, 5.0;
+
+  // alternates between two nearby timesteps like a jittery loop
+  auto jitter = [](int i) { return i % 2 == 0 ? 20_ms : 20.1_ms; };
+
+  frc::DiscretizationCache<2, 2> cache;
+  Eigen::Matrix<double, 2, 1> x = Eigen::Matrix<double, 2, 1>::Zero();
+  double uncachedNs = TimeNsPerStep([&](int i) {
+    Eigen::Matrix<double, 2, 2> discA;
+    Eigen::Matrix<double, 2, 2> discB;
+    frc::DiscretizeAB<2, 2>(plant.A(), plant.B(), 20_ms, &discA, &discB);
+    x = discA * x + discB * u;
+  });
+  double fixedNs =
+      TimeNsPerStep([&](int i) { x = plant.CalculateX(x, u, 20_ms, cache); });
+  double jitterNs = TimeNsPerStep(
+      [&](int i) { x = plant.CalculateX(x, u, jitter(i), cache); });
+
+  std::cout << "DiscretizeAB: " << uncachedNs
+            << " ns cached fixed dt: " << fixedNs
+            << " ns cached jittered dt: " << jitterNs << " ns\n";
+  EXPECT_TRUE(x.allFinite());
+}
@@ -240,3 +240,35 @@ TEST(DiscretizationTest, DiscretizeR) {
       << discR << "\ndiscRTruth:\n"
       << discRTruth;
 }
+
+// Test that DiscretizationCache matches DiscretizeAB() for repeated, jittered,
+// and large timestep changes
+TEST(DiscretizationTest, DiscretizationCache) {
+  Eigen::Matrix<double, 2, 2> contA;
+  contA << -3.0, 1.5, 0.5, -8.0;
+
+  Eigen::Matrix<double, 2, 2> contB;
+  contB << 2.0, 0.0, 1.0, 4.0;
+
+  frc::DiscretizationCache<2, 2> cache;
+  for (double seconds : {0.02, 0.02, 0.0205, 0.019, 0.02, 0.023, 0.1, 1.0}) {
+    units::second_t dt{seconds};
+
+    Eigen::Matrix<double, 2, 2> discA;
+    Eigen::Matrix<double, 2, 2> discB;
+    frc::DiscretizeAB<2, 2>(contA, contB, dt, &discA, &discB);
+
+    Eigen::Matrix<double, 2, 2> cachedA;
+    Eigen::Matrix<double, 2, 2> cachedB;
+    cache.DiscretizeAB(contA, contB, dt, &cachedA, &cachedB);
+
+    EXPECT_LT((discA - cachedA).norm(), 1e-10)
+        << "dt = " << seconds << "\ndiscA:\n"
+        << discA << "\ncachedA:\n"
+        << cachedA;
+    EXPECT_LT((discB - cachedB).norm(), 1e-10)
+        << "dt = " << seconds << "\ndiscB:\n"
+        << discB << "\ncachedB:\n"
+        << cachedB;
+  }
+}
@@ -0,0 +1,80 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include "frc/trajectory/IncrementalTrajectoryGenerator.h"
+#include "frc/trajectory/TrajectoryGenerator.h"
+#include "frc/trajectory/constraint/CentripetalAccelerationConstraint.h"
+#include "gtest/gtest.h"
+
+using namespace frc;
+
+using std::chrono::duration_cast;
+using std::chrono::high_resolution_clock;
+using std::chrono::microseconds;
+
+namespace {
+
+constexpr int kRuns = 200;
+
+TrajectoryConfig MakeConfig() {
+  TrajectoryConfig config{3_mps, 2_mps_sq};
+  config.AddConstraint(CentripetalAccelerationConstraint{2_mps_sq});
+  return config;
+}
+
+}  // namespace
+
+// Disabled by default as it only reports timings; run with
+// --gtest_also_run_disabled_tests --gtest_filter='*Benchmark*'
+TEST(IncrementalTrajectoryGeneratorBenchmark, DISABLED_Replan) {
+  // An auto path across the field
+  std::vector<Pose2d> waypoints;
+  for (int i = 0; i < 8; ++i) {
+    waypoints.emplace_back(units::meter_t{1.0 + 2.0 * i},
+                           units::meter_t{i % 2 == 0 ? 2.0 : 3.0},
+                           Rotation2d(i % 2 == 0 ? 20_deg : -20_deg));
+  }
+
+  for (size_t index : {waypoints.size() - 1, waypoints.size() / 2}) {
+    // Alternate between two poses so every run changes the trajectory
+    Pose2d poses[] = {waypoints[index],
+                      waypoints[index] + Transform2d{{0.1_m, 0.05_m}, 2_deg}};
+
+    auto config = MakeConfig();
+    size_t numStates = 0;
+    auto start = high_resolution_clock::now();
+    for (int run = 0; run < kRuns; ++run) {
+      auto newWaypoints = waypoints;
+      newWaypoints[index] = poses[run % 2];
+      numStates +=
+          TrajectoryGenerator::GenerateTrajectory(newWaypoints, config)
+              .States()
+              .size();
+    }
+    auto fullUs =
+        duration_cast<microseconds>(high_resolution_clock::now() - start)
+            .count() /
+        static_cast<double>(kRuns);
+
+    IncrementalTrajectoryGenerator generator{waypoints, MakeConfig()};
+    start = high_resolution_clock::now();
+    for (int run = 0; run < kRuns; ++run) {
+      numStates +=
+          generator.SetWaypoint(index, poses[run % 2]).States().size();
+    }
+    auto incrementalUs =
+        duration_cast<microseconds>(high_resolution_clock::now() - start)
+            .count() /
+        static_cast<double>(kRuns);
+
+    EXPECT_GT(numStates, 0u);
+    std::cout << "Waypoint " << index << " of " << waypoints.size()
+              << " full: " << fullUs << " us incremental: " << incrementalUs
+              << " us\n";
+  }
+}
@@ -0,0 +1,115 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <memory>
+#include <vector>
+
+#include "frc/trajectory/IncrementalTrajectoryGenerator.h"
+#include "frc/trajectory/TrajectoryGenerator.h"
+#include "frc/trajectory/constraint/CentripetalAccelerationConstraint.h"
+#include "gtest/gtest.h"
+
+using namespace frc;
+
+namespace {
+
+TrajectoryConfig MakeConfig(bool reversed = false) {
+  TrajectoryConfig config{3_mps, 2_mps_sq};
+  config.AddConstraint(CentripetalAccelerationConstraint{2_mps_sq});
+  config.SetReversed(reversed);
+  return config;
+}
+
+std::vector<Pose2d> MakeWaypoints() {
+  return {Pose2d{0_m, 0_m, 0_deg}, Pose2d{2_m, 1_m, 30_deg},
+          Pose2d{4_m, 1_m, -30_deg}, Pose2d{6_m, 0_m, 0_deg},
+          Pose2d{9_m, 1_m, 45_deg}};
+}
+
+void ExpectTrajectoriesNear(const Trajectory& expected,
+                            const Trajectory& actual) {
+  ASSERT_EQ(expected.States().size(), actual.States().size());
+  for (size_t i = 0; i < expected.States().size(); ++i) {
+    auto& a = expected.States()[i];
+    auto& b = actual.States()[i];
+    EXPECT_NEAR(a.t.to<double>(), b.t.to<double>(), 1E-9);
+    EXPECT_NEAR(a.velocity.to<double>(), b.velocity.to<double>(), 1E-9);
+    EXPECT_NEAR(a.acceleration.to<double>(), b.acceleration.to<double>(),
+                1E-6);
+    EXPECT_EQ(a.pose, b.pose);
+    EXPECT_NEAR(a.curvature.to<double>(), b.curvature.to<double>(), 1E-9);
+  }
+}
+
+}  // namespace
+
+TEST(IncrementalTrajectoryGeneratorTest, MatchesFullGeneration) {
+  auto waypoints = MakeWaypoints();
+  IncrementalTrajectoryGenerator generator{waypoints, MakeConfig()};
+  ExpectTrajectoriesNear(
+      TrajectoryGenerator::GenerateTrajectory(waypoints, MakeConfig()),
+      generator.GetTrajectory());
+}
+
+TEST(IncrementalTrajectoryGeneratorTest, SetWaypoint) {
+  auto waypoints = MakeWaypoints();
+  IncrementalTrajectoryGenerator generator{waypoints, MakeConfig()};
+
+  // The end, the start, an interior waypoint, and one that makes the
+  // neighboring splines much longer
+  for (auto [index, pose] :
+       {std::pair{4, Pose2d{9.2_m, 0.8_m, 40_deg}},
+        std::pair{0, Pose2d{0_m, 0.3_m, 10_deg}},
+        std::pair{2, Pose2d{4.1_m, 1.2_m, -20_deg}},
+        std::pair{3, Pose2d{7_m, -2_m, 0_deg}}}) {
+    waypoints[index] = pose;
+    generator.SetWaypoint(index, pose);
+    ExpectTrajectoriesNear(
+        TrajectoryGenerator::GenerateTrajectory(waypoints, MakeConfig()),
+        generator.GetTrajectory());
+  }
+}
+
+TEST(IncrementalTrajectoryGeneratorTest, Reversed) {
+  auto waypoints = MakeWaypoints();
+  IncrementalTrajectoryGenerator generator{waypoints, MakeConfig(true)};
+
+  waypoints[2] = Pose2d{4_m, 1.5_m, -10_deg};
+  generator.SetWaypoint(2, waypoints[2]);
+  ExpectTrajectoriesNear(
+      TrajectoryGenerator::GenerateTrajectory(waypoints, MakeConfig(true)),
+      generator.GetTrajectory());
+}
+
+TEST(IncrementalTrajectoryGeneratorTest, SetWaypoints) {
+  auto waypoints = MakeWaypoints();
+  IncrementalTrajectoryGenerator generator{waypoints, MakeConfig()};
+
+  waypoints[1] = Pose2d{2_m, 1.5_m, 20_deg};
+  waypoints[3] = Pose2d{6.5_m, 0_m, 10_deg};
+  generator.SetWaypoints(waypoints);
+  ExpectTrajectoriesNear(
+      TrajectoryGenerator::GenerateTrajectory(waypoints, MakeConfig()),
+      generator.GetTrajectory());
+
+  waypoints.emplace_back(11_m, 1_m, 0_deg);
+  generator.SetWaypoints(waypoints);
+  ExpectTrajectoriesNear(
+      TrajectoryGenerator::GenerateTrajectory(waypoints, MakeConfig()),
+      generator.GetTrajectory());
+}
+
+TEST(IncrementalTrajectoryGeneratorTest, RecoversFromMalformed) {
+  auto waypoints = MakeWaypoints();
+  IncrementalTrajectoryGenerator generator{waypoints, MakeConfig()};
+
+  // Reversing direction makes the first spline malformed
+  generator.SetWaypoint(1, Pose2d{1_m, 0_m, 180_deg});
+  ASSERT_EQ(generator.GetTrajectory().States().size(), 1u);
+
+  generator.SetWaypoint(1, waypoints[1]);
+  ExpectTrajectoriesNear(
+      TrajectoryGenerator::GenerateTrajectory(waypoints, MakeConfig()),
+      generator.GetTrajectory());
+}
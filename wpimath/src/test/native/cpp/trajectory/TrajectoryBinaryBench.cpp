@@ -0,0 +1,81 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <wpi/fs.h>
+
+#include "frc/trajectory/TrajectoryConfig.h"
+#include "frc/trajectory/TrajectoryUtil.h"
+#include "gtest/gtest.h"
+#include "trajectory/TestTrajectory.h"
+
+using namespace frc;
+
+using std::chrono::duration_cast;
+using std::chrono::high_resolution_clock;
+using std::chrono::microseconds;
+
+namespace {
+
+// Number of paths a team might load in RobotInit()
+constexpr int kNumPaths = 30;
+
+}  // namespace
+
+// Disabled by default as it only reports timings; run with
+// --gtest_also_run_disabled_tests --gtest_filter='*Benchmark*'
+TEST(TrajectoryBinaryBenchmark, DISABLED_Startup) {
+  auto dir = fs::temp_directory_path();
+  std::vector<std::string> jsonPaths;
+  std::vector<std::string> binaryPaths;
+  size_t jsonBytes = 0;
+  size_t binaryBytes = 0;
+  for (int i = 0; i < kNumPaths; ++i) {
+    // Vary the speed so each path has a different number of states
+    TrajectoryConfig config{units::feet_per_second_t{4.0 + 0.25 * i},
+                            12_fps_sq};
+    auto trajectory = TestTrajectory::GetTrajectory(config);
+    jsonPaths.emplace_back(
+        (dir / fmt::format("trajectory-bench-{}.json", i)).string());
+    binaryPaths.emplace_back(
+        (dir / fmt::format("trajectory-bench-{}.wpitraj", i)).string());
+    TrajectoryUtil::ToPathweaverJson(trajectory, jsonPaths.back());
+    TrajectoryUtil::ToBinary(trajectory, binaryPaths.back());
+    jsonBytes += fs::file_size(jsonPaths.back());
+    binaryBytes += fs::file_size(binaryPaths.back());
+  }
+
+  // Sample each path once so the binary files are actually read
+  units::second_t totalTime = 0_s;
+  auto start = high_resolution_clock::now();
+  for (auto&& path : jsonPaths) {
+    auto trajectory = TrajectoryUtil::FromPathweaverJson(path);
+    totalTime += trajectory.Sample(trajectory.TotalTime() / 2).t;
+  }
+  auto jsonUs =
+      duration_cast<microseconds>(high_resolution_clock::now() - start).count();
+
+  start = high_resolution_clock::now();
+  for (auto&& path : binaryPaths) {
+    auto view = TrajectoryUtil::FromBinary(path);
+    totalTime -= view.Sample(view.TotalTime() / 2).t;
+  }
+  auto binaryUs =
+      duration_cast<microseconds>(high_resolution_clock::now() - start).count();
+  EXPECT_NEAR(totalTime.to<double>(), 0.0, 1e-9);
+
+  std::cout << kNumPaths << " paths JSON: " << jsonUs << " us (" << jsonBytes
+            << " bytes) binary: " << binaryUs << " us (" << binaryBytes
+            << " bytes)\n";
+
+  for (int i = 0; i < kNumPaths; ++i) {
+    fs::remove(jsonPaths[i]);
+    fs::remove(binaryPaths[i]);
+  }
+}
@@ -0,0 +1,113 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <stdint.h>
+
+#include <stdexcept>
+#include <vector>
+
+#include <wpi/fs.h>
+
+#include "frc/trajectory/TrajectoryConfig.h"
+#include "frc/trajectory/TrajectoryUtil.h"
+#include "frc/trajectory/TrajectoryView.h"
+#include "gtest/gtest.h"
+#include "trajectory/TestTrajectory.h"
+
+using namespace frc;
+
+TEST(TrajectoryBinaryTest, DeserializeMatches) {
+  TrajectoryConfig config{12_fps, 12_fps_sq};
+  auto trajectory = TestTrajectory::GetTrajectory(config);
+
+  auto data = TrajectoryUtil::SerializeTrajectoryBinary(trajectory);
+  TrajectoryView view{data};
+  EXPECT_FALSE(view.IsQuantized());
+  ASSERT_EQ(trajectory.States().size(), view.size());
+  EXPECT_EQ(trajectory.States(), view.ToTrajectory().States());
+  EXPECT_EQ(trajectory.TotalTime(), view.TotalTime());
+
+  for (auto t = -1_s; t < trajectory.TotalTime() + 1_s; t += 0.05_s) {
+    EXPECT_EQ(trajectory.Sample(t), view.Sample(t));
+  }
+}
+
+TEST(TrajectoryBinaryTest, Quantized) {
+  TrajectoryConfig config{12_fps, 12_fps_sq};
+  auto trajectory = TestTrajectory::GetTrajectory(config);
+
+  auto data = TrajectoryUtil::SerializeTrajectoryBinary(trajectory, true);
+  EXPECT_EQ(data.size(), TrajectoryView::kHeaderSize +
+                             trajectory.States().size() *
+                                 TrajectoryView::kFieldsPerState * 4);
+
+  TrajectoryView view{data};
+  EXPECT_TRUE(view.IsQuantized());
+  ASSERT_EQ(trajectory.States().size(), view.size());
+  for (size_t i = 0; i < view.size(); ++i) {
+    auto expected = trajectory.States()[i];
+    auto actual = view.GetState(i);
+    EXPECT_NEAR(expected.t.to<double>(), actual.t.to<double>(), 1e-5);
+    EXPECT_NEAR(expected.pose.X().to<double>(), actual.pose.X().to<double>(),
+                1e-5);
+    EXPECT_NEAR(expected.pose.Y().to<double>(), actual.pose.Y().to<double>(),
+                1e-5);
+    EXPECT_NEAR(expected.velocity.to<double>(),
+                actual.velocity.to<double>(), 1e-5);
+  }
+}
+
+TEST(TrajectoryBinaryTest, File) {
+  TrajectoryConfig config{12_fps, 12_fps_sq};
+  auto trajectory = TestTrajectory::GetTrajectory(config);
+
+  auto jsonPath =
+      (fs::temp_directory_path() / "trajectory-binary-test.json").string();
+  auto binaryPath =
+      (fs::temp_directory_path() / "trajectory-binary-test.wpitraj").string();
+  TrajectoryUtil::ToPathweaverJson(trajectory, jsonPath);
+  TrajectoryUtil::PathweaverJsonToBinary(jsonPath, binaryPath);
+
+  {
+    auto view = TrajectoryUtil::FromBinary(binaryPath);
+    EXPECT_EQ(TrajectoryUtil::FromPathweaverJson(jsonPath).States(),
+              view.ToTrajectory().States());
+  }
+
+  fs::remove(jsonPath);
+  fs::remove(binaryPath);
+}
+
+TEST(TrajectoryBinaryTest, Invalid) {
+  EXPECT_THROW(TrajectoryUtil::SerializeTrajectoryBinary(Trajectory{}),
+               std::invalid_argument);
+
+  TrajectoryConfig config{12_fps, 12_fps_sq};
+  auto data = TrajectoryUtil::SerializeTrajectoryBinary(
+      TestTrajectory::GetTrajectory(config));
+
+  // Truncated
+  EXPECT_THROW(
+      TrajectoryView(wpi::span<const uint8_t>{data}.subspan(0, 100)),
+      std::runtime_error);
+
+  // No states
+  auto empty = data;
+  empty.resize(TrajectoryView::kHeaderSize);
+  empty[12] = empty[13] = empty[14] = empty[15] = 0;
+  EXPECT_THROW(TrajectoryView{empty}, std::runtime_error);
+
+  // Bad magic
+  auto badMagic = data;
+  badMagic[0] = 'X';
+  EXPECT_THROW(TrajectoryView{badMagic}, std::runtime_error);
+
+  // Newer version
+  auto badVersion = data;
+  badVersion[8] = TrajectoryView::kVersion + 1;
+  EXPECT_THROW(TrajectoryView{badVersion}, std::runtime_error);
+
+  EXPECT_THROW(TrajectoryUtil::FromBinary("/nonexistent/trajectory.wpitraj"),
+               std::runtime_error);
+}
@@ -0,0 +1,84 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "frc/trajectory/TrajectoryGenerator.h"
+#include "frc/trajectory/constraint/CentripetalAccelerationConstraint.h"
+#include "gtest/gtest.h"
+
+using namespace frc;
+
+using std::chrono::duration_cast;
+using std::chrono::high_resolution_clock;
+using std::chrono::microseconds;
+
+namespace {
+
+// Builds a corpus resembling a season of PathWeaver paths: 3 to 12 waypoints
+// spread across the field with headings roughly along the direction of travel.
+std::vector<std::vector<Pose2d>> MakeCorpus() {
+  std::mt19937 gen{2021};
+  std::uniform_int_distribution<int> countDist{3, 12};
+  std::uniform_real_distribution<double> stepDist{1.0, 2.5};
+  std::uniform_real_distribution<double> turnDist{-0.6, 0.6};
+
+  std::vector<std::vector<Pose2d>> corpus;
+  for (int path = 0; path < 40; ++path) {
+    std::vector<Pose2d> waypoints;
+    double x = 1.0;
+    double y = 4.0;
+    double heading = 0.0;
+    int count = countDist(gen);
+    for (int i = 0; i < count; ++i) {
+      waypoints.emplace_back(units::meter_t{x}, units::meter_t{y},
+                             Rotation2d{units::radian_t{heading}});
+      heading += turnDist(gen);
+      double step = stepDist(gen);
+      x += step * std::cos(heading);
+      y += step * std::sin(heading);
+    }
+    corpus.emplace_back(std::move(waypoints));
+  }
+  return corpus;
+}
+
+double TimeCorpusUs(const std::vector<std::vector<Pose2d>>& corpus) {
+  TrajectoryConfig config{4_mps, 3_mps_sq};
+  config.AddConstraint(CentripetalAccelerationConstraint{2_mps_sq});
+
+  auto start = high_resolution_clock::now();
+  size_t numStates = 0;
+  for (auto&& waypoints : corpus) {
+    auto trajectory = TrajectoryGenerator::GenerateTrajectory(waypoints, config);
+    numStates += trajectory.States().size();
+  }
+  auto stop = high_resolution_clock::now();
+  EXPECT_GT(numStates, corpus.size());
+  return duration_cast<microseconds>(stop - start).count();
+}
+
+}  // namespace
+
+// Disabled by default as it only reports timings; run with
+// --gtest_also_run_disabled_tests --gtest_filter='*Benchmark*'
+TEST(TrajectoryGeneratorBenchmark, DISABLED_Corpus) {
+  auto corpus = MakeCorpus();
+
+  unsigned int maxThreads = TrajectoryGenerator::GetMaxThreads();
+  TrajectoryGenerator::SetMaxThreads(1);
+  double serialUs = TimeCorpusUs(corpus);
+  TrajectoryGenerator::SetMaxThreads(std::thread::hardware_concurrency());
+  double parallelUs = TimeCorpusUs(corpus);
+  TrajectoryGenerator::SetMaxThreads(maxThreads);
+
+  std::cout << corpus.size() << " paths serial: " << serialUs
+            << " us parallel (" << std::thread::hardware_concurrency()
+            << " threads): " << parallelUs << " us\n";
+}
@@ -41,3 +41,33 @@ TEST(TrajectoryGenertionTest, ReturnsEmptyOnMalformed) {
   ASSERT_EQ(t.States().size(), 1u);
   ASSERT_EQ(t.TotalTime(), 0_s);
 }
+
+TEST(TrajectoryGenerationTest, ParallelMatchesSerial) {
+  // Weave back and forth so the path has enough splines to use threads
+  std::vector<Pose2d> waypoints;
+  for (int i = 0; i < 16; ++i) {
+    waypoints.emplace_back(units::meter_t{1.0 * i},
+                           units::meter_t{i % 2 == 0 ? 0.0 : 1.0},
+                           Rotation2d(i % 2 == 0 ? 30_deg : -30_deg));
+  }
+  TrajectoryConfig config{3_mps, 3_mps_sq};
+
+  // Restore the global thread limit even if an assertion fails
+  struct MaxThreadsRestorer {
+    unsigned int threads = TrajectoryGenerator::GetMaxThreads();
+    ~MaxThreadsRestorer() { TrajectoryGenerator::SetMaxThreads(threads); }
+  } restorer;
+
+  TrajectoryGenerator::SetMaxThreads(1);
+  auto serial = TrajectoryGenerator::GenerateTrajectory(waypoints, config);
+  TrajectoryGenerator::SetMaxThreads(4);
+  auto parallel = TrajectoryGenerator::GenerateTrajectory(waypoints, config);
+
+  EXPECT_EQ(serial, parallel);
+
+  // A malformed spline on another thread is still reported
+  waypoints[11] = Pose2d(waypoints[11].X(), waypoints[11].Y(), 0_deg);
+  waypoints[12] = Pose2d(waypoints[11].X() + 1_m, waypoints[11].Y(), 180_deg);
+  auto malformed = TrajectoryGenerator::GenerateTrajectory(waypoints, config);
+  EXPECT_EQ(malformed.States().size(), 1u);
+}
@@ -0,0 +1,62 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <chrono>
+#include <iostream>
+
+#include "frc/trajectory/TrajectoryConfig.h"
+#include "gtest/gtest.h"
+#include "trajectory/TestTrajectory.h"
+
+using namespace frc;
+
+using std::chrono::duration_cast;
+using std::chrono::high_resolution_clock;
+using std::chrono::nanoseconds;
+
+namespace {
+
+constexpr int kRuns = 200;
+
+template <typename F>
+double TimeNsPerSample(const Trajectory& trajectory, units::second_t dt,
+                       F&& sample) {
+  double sum = 0.0;
+  int numSamples = 0;
+  auto start = high_resolution_clock::now();
+  for (int run = 0; run < kRuns; ++run) {
+    for (auto t = 0_s; t < trajectory.TotalTime(); t += dt) {
+      sum += sample(t).velocity.template to<double>();
+      ++numSamples;
+    }
+  }
+  auto stop = high_resolution_clock::now();
+  EXPECT_NE(sum, 0.0);
+  return static_cast<double>(duration_cast<nanoseconds>(stop - start).count()) /
+         numSamples;
+}
+
+}  // namespace
+
+// Disabled by default as it only reports timings; run with
+// --gtest_also_run_disabled_tests --gtest_filter='*Benchmark*'
+TEST(TrajectorySamplerBenchmark, DISABLED_FollowerLoop) {
+  TrajectoryConfig config{4_fps, 12_fps_sq};
+  auto trajectory = TestTrajectory::GetTrajectory(config);
+
+  for (auto dt : {1_ms, 20_ms}) {
+    double sampleNs = TimeNsPerSample(
+        trajectory, dt, [&](auto t) { return trajectory.Sample(t); });
+    Trajectory::Sampler sampler;
+    double samplerNs = TimeNsPerSample(trajectory, dt, [&](auto t) {
+      if (t == 0_s) {
+        sampler = Trajectory::Sampler{trajectory};
+      }
+      return sampler.Sample(t);
+    });
+    std::cout << trajectory.States().size() << " states dt: " << dt.to<double>()
+              << " ms Sample(): " << sampleNs << " ns Sampler: " << samplerNs
+              << " ns\n";
+  }
+}
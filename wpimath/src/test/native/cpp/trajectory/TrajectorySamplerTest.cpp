@@ -0,0 +1,55 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <random>
+#include <vector>
+
+#include "frc/trajectory/TrajectoryConfig.h"
+#include "gtest/gtest.h"
+#include "trajectory/TestTrajectory.h"
+
+using namespace frc;
+
+TEST(TrajectorySamplerTest, MatchesSample) {
+  TrajectoryConfig config{12_fps, 12_fps_sq};
+  auto trajectory = TestTrajectory::GetTrajectory(config);
+
+  // Control loop rate, then steps larger than the linear search
+  for (auto dt : {5_ms, 20_ms, 250_ms}) {
+    Trajectory::Sampler sampler{trajectory};
+    for (auto t = -0.1_s; t < trajectory.TotalTime() + 0.1_s; t += dt) {
+      ASSERT_EQ(trajectory.Sample(t), sampler.Sample(t));
+    }
+  }
+}
+
+TEST(TrajectorySamplerTest, OutOfOrder) {
+  TrajectoryConfig config{12_fps, 12_fps_sq};
+  auto trajectory = TestTrajectory::GetTrajectory(config);
+
+  std::mt19937 gen{1234};
+  std::uniform_real_distribution<double> timeDist{
+      -0.5, trajectory.TotalTime().to<double>() + 0.5};
+
+  Trajectory::Sampler sampler{trajectory};
+  for (int i = 0; i < 1000; ++i) {
+    units::second_t t{timeDist(gen)};
+    ASSERT_EQ(trajectory.Sample(t), sampler.Sample(t));
+  }
+
+  sampler.Reset();
+  EXPECT_EQ(trajectory.Sample(0.1_s), sampler.Sample(0.1_s));
+}
+
+TEST(TrajectorySamplerTest, SampleMany) {
+  TrajectoryConfig config{12_fps, 12_fps_sq};
+  auto trajectory = TestTrajectory::GetTrajectory(config);
+
+  std::vector<units::second_t> times{0_s, 0.5_s, 0.25_s, 1_s, 100_s, 1.5_s};
+  auto states = trajectory.SampleMany(times);
+  ASSERT_EQ(times.size(), states.size());
+  for (size_t i = 0; i < times.size(); ++i) {
+    EXPECT_EQ(trajectory.Sample(times[i]), states[i]);
+  }
+}
@@ -0,0 +1,61 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <cmath>
+
+#include "Eigen/Core"
+#include "frc/system/plant/DCMotor.h"
+#include "units/moment_of_inertia.h"
+
+namespace frc {
+
+/**
+ * Nonlinear differential drivetrain dynamics used by the estimator tests.
+ *
+ * The state is [x, y, heading, left velocity, right velocity] and the input is
+ * [left voltage, right voltage]. The model is templated on the scalar type so
+ * it can be evaluated with automatic differentiation scalars.
+ */
+template <typename T>
+Eigen::Matrix<T, 5, 1> DrivetrainDynamics(const Eigen::Matrix<T, 5, 1>& x,
+                                          const Eigen::Matrix<T, 2, 1>& u) {
+  using std::cos;
+  using std::sin;
+
+  auto motors = DCMotor::CIM(2);
+
+  // constexpr double Glow = 15.32;       // Low gear ratio
+  constexpr double Ghigh = 7.08;       // High gear ratio
+  constexpr auto rb = 0.8382_m / 2.0;  // Robot radius
+  constexpr auto r = 0.0746125_m;      // Wheel radius
+  constexpr auto m = 63.503_kg;        // Robot mass
+  constexpr auto J = 5.6_kg_sq_m;      // Robot moment of inertia
+
+  auto C1 = -std::pow(Ghigh, 2) * motors.Kt /
+            (motors.Kv * motors.R * units::math::pow<2>(r));
+  auto C2 = Ghigh * motors.Kt / (motors.R * r);
+  auto k1 = (1 / m + units::math::pow<2>(rb) / J);
+  auto k2 = (1 / m - units::math::pow<2>(rb) / J);
+
+  // The state and input are unitless so they can hold autodiff scalars
+  const T& vl = x(3);
+  const T& vr = x(4);
+  const T& Vl = u(0);
+  const T& Vr = u(1);
+
+  Eigen::Matrix<T, 5, 1> result;
+  T v = 0.5 * (vl + vr);
+  result(0) = v * cos(x(2));
+  result(1) = v * sin(x(2));
+  result(2) = (vr - vl) / (2.0 * rb.to<double>());
+  result(3) = k1.to<double>() * (C1.to<double>() * vl + C2.to<double>() * Vl) +
+              k2.to<double>() * (C1.to<double>() * vr + C2.to<double>() * Vr);
+  result(4) = k2.to<double>() * (C1.to<double>() * vl + C2.to<double>() * Vl) +
+              k1.to<double>() * (C1.to<double>() * vr + C2.to<double>() * Vr);
+  return result;
+}
+
+}  // namespace frc
@@ -4,16 +4,300 @@
 
 #include "wpi/HttpServerConnection.h"
 
+#ifndef _WIN32
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/sendfile.h>
+#define WPI_HAVE_SENDFILE
+#elif defined(__APPLE__)
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+#define WPI_HAVE_SENDFILE
+#endif
+#endif
+
+#include <uv.h>
+
+#include <cerrno>
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <system_error>
+#include <tuple>
+#include <utility>
+
 #include "fmt/format.h"
 #include "wpi/SmallString.h"
 #include "wpi/SmallVector.h"
 #include "wpi/SpanExtras.h"
 #include "wpi/StringExtras.h"
 #include "wpi/fmt/raw_ostream.h"
+#include "wpi/fs.h"
 #include "wpi/raw_uv_ostream.h"
+#include "wpi/uv/Loop.h"
+#include "wpi/uv/Poll.h"
 
 using namespace wpi;
 
+static bool MatchesETag(std::string_view ifNoneMatch, std::string_view etag) {
+  // comma-separated list of (possibly weak) entity tags, or "*"
+  while (!ifNoneMatch.empty()) {
+    std::string_view tag;
+    std::tie(tag, ifNoneMatch) = wpi::split(ifNoneMatch, ',');
+    tag = wpi::trim(tag);
+    if (wpi::starts_with(tag, "W/")) {
+      tag.remove_prefix(2);
+    }
+    if (tag == "*" || tag == etag) {
+      return true;
+    }
+  }
+  return false;
+}
+
+namespace {
+
+// Sends a file body to a stream in chunks.  Each chunk is read with
+// uv_fs_read() and then written to the stream; the next chunk is only read
+// once the previous one has been written.  A client that stops reading
+// therefore just leaves the transfer idle, and the thread pool is only used
+// for the file reads themselves.  This is the fallback for platforms and
+// streams that can't use sendfile(2).
+class FileBodySender : public std::enable_shared_from_this<FileBodySender> {
+ public:
+  static constexpr size_t kChunkSize = 64 * 1024;
+
+  FileBodySender(uv::Stream& stream, uv_file file, uint64_t size,
+                 std::function<void(bool)> done)
+      : m_stream{stream.shared_from_this()},
+        m_file{file},
+        m_size{size},
+        m_done{std::move(done)} {
+    m_req.data = this;
+  }
+
+  ~FileBodySender() {
+    uv_fs_t req;
+    uv_fs_close(nullptr, &req, m_file, nullptr);
+    uv_fs_req_cleanup(&req);
+  }
+
+  FileBodySender(const FileBodySender&) = delete;
+  FileBodySender& operator=(const FileBodySender&) = delete;
+
+  void ReadChunk() {
+    m_buf = uv::Buffer::Allocate(static_cast<size_t>(
+        (std::min)(uint64_t{kChunkSize}, m_size - m_offset)));
+    // keep alive until the read completes
+    m_self = shared_from_this();
+    int err = uv_fs_read(m_stream->GetLoopRef().GetRaw(), &m_req, m_file,
+                         &m_buf, 1, m_offset, [](uv_fs_t* req) {
+                           static_cast<FileBodySender*>(req->data)->OnRead();
+                         });
+    if (err < 0) {
+      m_buf.Deallocate();
+      auto self = std::move(m_self);
+      m_done(false);
+    }
+  }
+
+ private:
+  void OnRead() {
+    auto self = std::move(m_self);
+    auto result = m_req.result;
+    uv_fs_req_cleanup(&m_req);
+    if (m_stream->IsClosing()) {
+      m_buf.Deallocate();
+      return;
+    }
+    if (result <= 0) {
+      // 0 means the file was truncated
+      m_buf.Deallocate();
+      m_done(false);
+      return;
+    }
+
+    uv::Buffer buf = m_buf.Move();
+    buf.len = static_cast<decltype(buf.len)>(result);
+    m_offset += result;
+    m_stream->Write({buf}, [self](auto bufs, uv::Error err) {
+      for (auto&& buf : bufs) {
+        buf.Deallocate();
+      }
+      if (self->m_stream->IsClosing()) {
+        return;
+      }
+      if (err) {
+        self->m_done(false);
+      } else if (self->m_offset < self->m_size) {
+        self->ReadChunk();
+      } else {
+        self->m_done(true);
+      }
+    });
+  }
+
+  std::shared_ptr<uv::Stream> m_stream;
+  uv_file m_file;
+  uint64_t m_size;
+  uint64_t m_offset = 0;
+  std::function<void(bool)> m_done;
+  uv_fs_t m_req;
+  uv::Buffer m_buf;
+  std::shared_ptr<FileBodySender> m_self;
+};
+
+#ifdef WPI_HAVE_SENDFILE
+// Sends up to len bytes of the file at offset.  Returns the number of bytes
+// sent, or -1 with errno set.
+static int64_t SendFileChunk(int outFd, int inFd, uint64_t offset,
+                             uint64_t len) {
+#if defined(__linux__)
+  off_t off = static_cast<off_t>(offset);
+  return ::sendfile(outFd, inFd, &off, static_cast<size_t>(len));
+#else
+  // on EAGAIN, macOS reports the bytes it sent in n
+  off_t n = static_cast<off_t>(len);
+  if (::sendfile(inFd, outFd, static_cast<off_t>(offset), &n, nullptr, 0) ==
+          0 ||
+      n > 0) {
+    return n;
+  }
+  return -1;
+#endif
+}
+
+// Sends a file body with non-blocking sendfile(2) calls from the loop, so
+// the file data goes straight from the page cache to the socket.  Whenever
+// the socket buffer fills, the transfer waits for the socket to become
+// writable.  The poll is on a dup of the stream's descriptor, since libuv
+// allows only one I/O watcher per descriptor and the stream owns that one.
+class SendFileSender : public std::enable_shared_from_this<SendFileSender> {
+ public:
+  // bytes sent per writable event, so a fast client doesn't stall the loop
+  static constexpr uint64_t kMaxPerEvent = 1024 * 1024;
+
+  SendFileSender(uv::Stream& stream, int socket, uv_file file, uint64_t size,
+                 std::function<void(bool)> done)
+      : m_stream{stream.shared_from_this()},
+        m_socket{socket},
+        m_file{file},
+        m_size{size},
+        m_done{std::move(done)} {}
+
+  ~SendFileSender() {
+    if (m_file >= 0) {
+      uv_fs_t req;
+      uv_fs_close(nullptr, &req, m_file, nullptr);
+      uv_fs_req_cleanup(&req);
+    }
+  }
+
+  SendFileSender(const SendFileSender&) = delete;
+  SendFileSender& operator=(const SendFileSender&) = delete;
+
+  void Send() {
+    if (m_stream->IsClosing()) {
+      StopPoll();
+      return;
+    }
+    uint64_t end = (std::min)(m_size, m_offset + kMaxPerEvent);
+    while (m_offset < end) {
+      int64_t n = SendFileChunk(m_socket, m_file, m_offset, end - m_offset);
+      if (n > 0) {
+        m_offset += n;
+      } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+        WaitWritable();
+        return;
+      } else if (n < 0 && errno == EINTR) {
+        continue;
+      } else if (m_offset == 0 && n < 0 &&
+                 (errno == EINVAL || errno == ENOSYS || errno == ENOTSOCK ||
+                  errno == EOPNOTSUPP)) {
+        // this file or stream doesn't support sendfile
+        StopPoll();
+        auto sender = std::make_shared<FileBodySender>(
+            *m_stream, std::exchange(m_file, -1), m_size, std::move(m_done));
+        sender->ReadChunk();
+        return;
+      } else {
+        // 0 means the file was truncated
+        StopPoll();
+        m_done(false);
+        return;
+      }
+    }
+    if (m_offset < m_size) {
+      // more to send; let other handles run first
+      WaitWritable();
+      return;
+    }
+    StopPoll();
+    m_done(true);
+  }
+
+  void Abort() {
+    if (!m_stream->IsClosing()) {
+      m_done(false);
+    }
+  }
+
+ private:
+  void WaitWritable() {
+    if (!m_poll) {
+      int fd = ::dup(m_socket);
+      if (fd >= 0) {
+        m_poll = uv::Poll::Create(m_stream->GetLoopRef(), fd);
+      }
+      if (!m_poll) {
+        if (fd >= 0) {
+          ::close(fd);
+        }
+        m_done(false);
+        return;
+      }
+      m_poll->closed.connect([fd] { ::close(fd); });
+      m_poll->pollEvent.connect(
+          [self = shared_from_this()](int) { self->Send(); });
+      m_poll->error.connect([self = shared_from_this()](uv::Error) {
+        self->StopPoll();
+        self->m_done(false);
+      });
+      // stop waiting if the connection is closed while the client is idle
+      m_streamClosedConn = m_stream->closed.connect_connection(
+          [self = weak_from_this()] {
+            if (auto s = self.lock()) {
+              s->StopPoll();
+            }
+          });
+    }
+    m_poll->Start(UV_WRITABLE);
+  }
+
+  void StopPoll() {
+    // the poll's callbacks hold a reference to this, so release it before
+    // closing to break the cycle
+    if (auto poll = std::move(m_poll)) {
+      m_streamClosedConn.disconnect();
+      poll->Close();
+    }
+  }
+
+  std::shared_ptr<uv::Stream> m_stream;
+  int m_socket;
+  uv_file m_file;
+  uint64_t m_size;
+  uint64_t m_offset = 0;
+  std::function<void(bool)> m_done;
+  std::shared_ptr<uv::Poll> m_poll;
+  sig::ScopedConnection m_streamClosedConn;
+};
+#endif
+
+}  // namespace
+
 HttpServerConnection::HttpServerConnection(std::shared_ptr<uv::Stream> stream)
     : m_stream(*stream) {
   // process HTTP messages
@@ -21,26 +305,32 @@ HttpServerConnection::HttpServerConnection(std::shared_ptr<uv::Stream> stream)
       m_request.messageComplete.connect_connection([this](bool keepAlive) {
         m_keepAlive = keepAlive;
         ProcessRequest();
+        if (m_sendingFile) {
+          // hold any pipelined requests until the file has been sent
+          m_request.Pause(true);
+        }
       });
 
-  // look for Accept-Encoding headers to determine if gzip is acceptable
-  m_request.messageBegin.connect([this] { m_acceptGzip = false; });
+  // look for Accept-Encoding headers to determine if gzip is acceptable,
+  // and If-None-Match headers for cache revalidation
+  m_request.messageBegin.connect([this] {
+    m_acceptGzip = false;
+    m_ifNoneMatch.clear();
+  });
   m_request.header.connect(
       [this](std::string_view name, std::string_view value) {
         if (wpi::equals_lower(name, "accept-encoding") &&
             wpi::contains(value, "gzip")) {
           m_acceptGzip = true;
+        } else if (wpi::equals_lower(name, "if-none-match")) {
+          m_ifNoneMatch = value;
         }
       });
 
   // pass incoming data to HTTP parser
   m_dataConn =
       stream->data.connect_connection([this](uv::Buffer& buf, size_t size) {
-        m_request.Execute({buf.base, size});
-        if (m_request.HasError()) {
-          // could not parse; just close the connection
-          m_stream.Close();
-        }
+        ExecuteRequest({buf.base, size});
       });
 
   // close when remote side closes
@@ -59,6 +349,11 @@ void HttpServerConnection::BuildCommonHeaders(raw_ostream& os) {
         "Expires: Mon, 3 Jan 2000 12:34:56 GMT\r\n";
 }
 
+void HttpServerConnection::BuildRevalidateHeaders(raw_ostream& os) {
+  os << "Server: WebServer/1.0\r\n"
+        "Cache-Control: no-cache\r\n";
+}
+
 void HttpServerConnection::BuildHeader(raw_ostream& os, int code,
                                        std::string_view codeText,
                                        std::string_view contentType,
@@ -66,13 +361,17 @@ void HttpServerConnection::BuildHeader(raw_ostream& os, int code,
                                        std::string_view extra) {
   fmt::print(os, "HTTP/{}.{} {} {}\r\n", m_request.GetMajor(),
              m_request.GetMinor(), code, codeText);
-  if (contentLength == 0) {
+  if (contentLength == 0 && code != 204 && code != 304) {
     m_keepAlive = false;
   }
   if (!m_keepAlive) {
     os << "Connection: close\r\n";
   }
-  BuildCommonHeaders(os);
+  if (m_revalidate) {
+    BuildRevalidateHeaders(os);
+  } else {
+    BuildCommonHeaders(os);
+  }
   os << "Content-Type: " << contentType << "\r\n";
   if (contentLength != 0) {
     fmt::print(os, "Content-Length: {}\r\n", contentLength);
@@ -137,6 +436,128 @@ void HttpServerConnection::SendStaticResponse(
   });
 }
 
+void HttpServerConnection::SendFileResponse(int code, std::string_view codeText,
+                                            std::string_view contentType,
+                                            std::string_view filename,
+                                            std::string_view extraHeader) {
+  fs::path path{filename};
+  std::error_code ec;
+  uint64_t size = fs::file_size(path, ec);
+  if (ec) {
+    SendError(404, "error getting file size");
+    return;
+  }
+  auto mtime = fs::last_write_time(path, ec);
+  if (ec) {
+    SendError(404, "error getting file time");
+    return;
+  }
+
+  std::string etag =
+      fmt::format("\"{:x}-{:x}\"", size,
+                  static_cast<uint64_t>(mtime.time_since_epoch().count()));
+  std::string header = fmt::format("ETag: {}\r\n{}", etag, extraHeader);
+
+  SmallVector<uv::Buffer, 4> toSend;
+  raw_uv_ostream os{toSend, 4096};
+  if (code == 200 && MatchesETag(m_ifNoneMatch, etag)) {
+    m_revalidate = true;
+    BuildHeader(os, 304, "Not Modified", contentType, 0, header);
+    m_revalidate = false;
+    SendData(os.bufs(), !m_keepAlive);
+    return;
+  }
+
+  uv_fs_t req;
+  uv_file file = uv_fs_open(nullptr, &req, path.string().c_str(),
+                            UV_FS_O_RDONLY, 0, nullptr);
+  uv_fs_req_cleanup(&req);
+  if (file < 0) {
+    SendError(404, "error opening file");
+    return;
+  }
+
+  m_revalidate = true;
+  BuildHeader(os, code, codeText, contentType, size, header);
+  m_revalidate = false;
+  bool closeAfter = !m_keepAlive;
+  if (size == 0) {
+    uv_fs_close(nullptr, &req, file, nullptr);
+    uv_fs_req_cleanup(&req);
+    SendData(os.bufs(), closeAfter);
+    return;
+  }
+
+  m_sendingFile = true;
+  m_stream.StopRead();
+  auto done = [this, closeAfter](bool ok) {
+    if (!ok) {
+      // the response is incomplete, so the connection can't be reused
+      m_stream.Close();
+      return;
+    }
+    FinishFileResponse(closeAfter);
+  };
+
+#ifdef WPI_HAVE_SENDFILE
+  uv_os_fd_t socket;
+  if (uv_fileno(m_stream.GetRawHandle(), &socket) == 0) {
+    // the body bypasses the stream's write queue, so it can only start once
+    // the header has been written
+    auto sender = std::make_shared<SendFileSender>(m_stream, socket, file,
+                                                   size, std::move(done));
+    m_stream.Write(os.bufs(), [sender](auto bufs, uv::Error err) {
+      for (auto&& buf : bufs) {
+        buf.Deallocate();
+      }
+      if (err) {
+        sender->Abort();
+      } else {
+        sender->Send();
+      }
+    });
+    return;
+  }
+#endif
+
+  // writes are queued in order, so the body can be read while the header is
+  // being written
+  SendData(os.bufs(), false);
+  auto sender =
+      std::make_shared<FileBodySender>(m_stream, file, size, std::move(done));
+  sender->ReadChunk();
+}
+
+void HttpServerConnection::FinishFileResponse(bool closeAfter) {
+  m_sendingFile = false;
+  if (closeAfter) {
+    m_stream.Close();
+    return;
+  }
+
+  // resume processing pipelined requests
+  m_request.Pause(false);
+  m_stream.StartRead();
+  if (!m_pendingInput.empty()) {
+    std::string pending = std::move(m_pendingInput);
+    m_pendingInput.clear();
+    ExecuteRequest(pending);
+  }
+}
+
+void HttpServerConnection::ExecuteRequest(std::string_view in) {
+  auto rest = m_request.Execute(in);
+  if (m_request.GetError() == HPE_PAUSED) {
+    // a file response is in progress
+    m_pendingInput.append(rest);
+    return;
+  }
+  if (m_request.HasError()) {
+    // could not parse; just close the connection
+    m_stream.Close();
+  }
+}
+
 void HttpServerConnection::SendError(int code, std::string_view message) {
   std::string_view codeText, extra, baseMessage;
   switch (code) {
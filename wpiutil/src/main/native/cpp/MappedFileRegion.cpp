@@ -0,0 +1,100 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/MappedFileRegion.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+
+#include "wpi/WindowsError.h"
+#else  // _WIN32
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cerrno>
+#endif  // _WIN32
+
+using namespace wpi;
+
+#ifdef _WIN32
+
+MappedFileRegion::MappedFileRegion(fs::file_t f, uint64_t length,
+                                   uint64_t offset, std::error_code& ec)
+    : m_size(length) {
+  if (length == 0) {
+    ec = std::make_error_code(std::errc::invalid_argument);
+    return;
+  }
+
+  uint64_t maxSize = offset + length;
+  HANDLE fileMapping =
+      ::CreateFileMappingW(f, nullptr, PAGE_READONLY, maxSize >> 32,
+                           maxSize & 0xffffffff, nullptr);
+  if (fileMapping == nullptr) {
+    ec = wpi::mapWindowsError(::GetLastError());
+    m_size = 0;
+    return;
+  }
+
+  m_mapping = ::MapViewOfFile(fileMapping, FILE_MAP_READ, offset >> 32,
+                              offset & 0xffffffff, length);
+  if (m_mapping == nullptr) {
+    ec = wpi::mapWindowsError(::GetLastError());
+    m_size = 0;
+  }
+
+  // The view keeps the mapping object alive
+  ::CloseHandle(fileMapping);
+}
+
+void MappedFileRegion::Unmap() {
+  if (m_mapping) {
+    ::UnmapViewOfFile(m_mapping);
+  }
+  m_mapping = nullptr;
+  m_size = 0;
+}
+
+size_t MappedFileRegion::GetAlignment() {
+  SYSTEM_INFO sysInfo;
+  ::GetSystemInfo(&sysInfo);
+  return sysInfo.dwAllocationGranularity;
+}
+
+#else  // _WIN32
+
+MappedFileRegion::MappedFileRegion(fs::file_t f, uint64_t length,
+                                   uint64_t offset, std::error_code& ec)
+    : m_size(length) {
+  if (length == 0) {
+    ec = std::make_error_code(std::errc::invalid_argument);
+    return;
+  }
+
+  m_mapping = ::mmap(nullptr, length, PROT_READ, MAP_SHARED, f,
+                     static_cast<off_t>(offset));
+  if (m_mapping == MAP_FAILED) {
+    ec = std::error_code(errno, std::generic_category());
+    m_mapping = nullptr;
+    m_size = 0;
+  }
+}
+
+void MappedFileRegion::Unmap() {
+  if (m_mapping) {
+    ::munmap(m_mapping, m_size);
+  }
+  m_mapping = nullptr;
+  m_size = 0;
+}
+
+size_t MappedFileRegion::GetAlignment() {
+  return ::sysconf(_SC_PAGESIZE);
+}
+
+#endif  // _WIN32
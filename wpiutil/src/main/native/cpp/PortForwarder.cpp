@@ -28,7 +28,8 @@ PortForwarder& PortForwarder::GetInstance() {
 
 static void CopyStream(uv::Stream& in, std::weak_ptr<uv::Stream> outWeak) {
   in.data.connect([&in, outWeak](uv::Buffer& buf, size_t len) {
-    uv::Buffer buf2 = buf.Dup();
+    // take ownership of the read buffer rather than copying it
+    uv::Buffer buf2 = buf.Move();
     buf2.len = len;
     auto out = outWeak.lock();
     if (!out) {
@@ -0,0 +1,240 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/Trace.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "fmt/format.h"
+#include "wpi/fmt/raw_ostream.h"
+#include "wpi/json.h"
+#include "wpi/mutex.h"
+#include "wpi/raw_ostream.h"
+
+using namespace wpi;
+
+namespace {
+
+struct Zone {
+  const char* name;
+  uint64_t start;
+  uint64_t end;
+};
+
+// Ring buffer slot.  The fields are atomic so WriteChromeTrace() can copy a
+// slot while the owning thread overwrites it; a copy that raced with a write
+// is detected afterwards from head and discarded.
+struct Slot {
+  std::atomic<const char*> name{nullptr};
+  std::atomic<uint64_t> start{0};
+  std::atomic<uint64_t> end{0};
+};
+
+// Single-producer ring buffer; only the owning thread writes.
+struct ThreadBuffer {
+  static constexpr size_t kSize = 8192;  // must be power of 2
+
+  explicit ThreadBuffer(unsigned int tid) : tid{tid} {}
+
+  unsigned int tid;
+  std::string name;      // protected by Registry mutex
+  uint64_t cleared = 0;  // protected by Registry mutex
+  bool exited = false;   // protected by Registry mutex
+  // Number of committed zones; slots below this are fully written
+  std::atomic<uint64_t> head{0};
+  Slot slots[kSize];
+};
+
+// Buffers of exited threads are kept until their zones have been written out
+// or cleared, but at most this many, so short-lived threads can't accumulate
+// memory.
+constexpr size_t kMaxExitedBuffers = 8;
+
+struct Registry {
+  wpi::mutex mutex;
+  std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+  unsigned int nextTid = 1;
+
+  // Drops exited buffers with no unwritten zones, and the oldest exited
+  // buffers beyond kMaxExitedBuffers.  Mutex must be held.
+  void PruneExited(bool flushed) {
+    size_t numExited = std::count_if(buffers.begin(), buffers.end(),
+                                     [](auto& buf) { return buf->exited; });
+    auto it = std::remove_if(buffers.begin(), buffers.end(), [&](auto& buf) {
+      if (!buf->exited) {
+        return false;
+      }
+      if (flushed || numExited > kMaxExitedBuffers ||
+          buf->cleared == buf->head.load(std::memory_order_relaxed)) {
+        --numExited;
+        return true;
+      }
+      return false;
+    });
+    buffers.erase(it, buffers.end());
+  }
+};
+
+// Per-thread state.  The buffer is only allocated once the thread records a
+// zone while tracing is enabled.
+struct ThreadState {
+  ~ThreadState();
+
+  ThreadBuffer* buffer = nullptr;
+  std::string name;
+};
+
+}  // namespace
+
+static std::atomic_bool gEnabled{false};
+
+static Registry& GetRegistry() {
+  // intentionally leaked so exiting threads can still unregister
+  static Registry* registry = new Registry;
+  return *registry;
+}
+
+static thread_local ThreadState gThreadState;
+
+ThreadState::~ThreadState() {
+  if (!buffer) {
+    return;
+  }
+  auto& registry = GetRegistry();
+  std::scoped_lock lock(registry.mutex);
+  buffer->exited = true;
+  registry.PruneExited(false);
+}
+
+static ThreadBuffer* GetThreadBuffer() {
+  auto& state = gThreadState;
+  if (!state.buffer) {
+    // buffers are owned by the registry so data outlives the thread
+    auto& registry = GetRegistry();
+    std::scoped_lock lock(registry.mutex);
+    auto buf = std::make_unique<ThreadBuffer>(registry.nextTid++);
+    buf->name = state.name;
+    state.buffer = buf.get();
+    registry.buffers.emplace_back(std::move(buf));
+  }
+  return state.buffer;
+}
+
+void trace::SetEnabled(bool enabled) {
+  gEnabled = enabled;
+}
+
+bool trace::IsEnabled() {
+  return gEnabled.load(std::memory_order_relaxed);
+}
+
+uint64_t trace::NowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void trace::Record(const char* name, uint64_t startNs, uint64_t endNs) {
+  if (!gThreadState.buffer && !IsEnabled()) {
+    return;
+  }
+  auto buf = GetThreadBuffer();
+  uint64_t head = buf->head.load(std::memory_order_relaxed);
+  auto& slot = buf->slots[head & (ThreadBuffer::kSize - 1)];
+  // pairs with the fence in WriteChromeTrace(): a reader that sees any of
+  // these stores also sees head as at least the current value
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.name.store(name, std::memory_order_relaxed);
+  slot.start.store(startNs, std::memory_order_relaxed);
+  slot.end.store(endNs, std::memory_order_relaxed);
+  buf->head.store(head + 1, std::memory_order_release);
+}
+
+void trace::SetThreadName(std::string_view name) {
+  auto& state = gThreadState;
+  state.name = name;
+  if (state.buffer) {
+    auto& registry = GetRegistry();
+    std::scoped_lock lock(registry.mutex);
+    state.buffer->name = name;
+  }
+}
+
+void trace::Clear() {
+  auto& registry = GetRegistry();
+  std::scoped_lock lock(registry.mutex);
+  // only the owning thread may write head, so just remember where it was
+  for (auto&& buf : registry.buffers) {
+    buf->cleared = buf->head.load(std::memory_order_acquire);
+  }
+  registry.PruneExited(true);
+}
+
+void trace::WriteChromeTrace(raw_ostream& os) {
+  auto& registry = GetRegistry();
+  std::scoped_lock lock(registry.mutex);
+
+  os << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  bool first = true;
+  auto sep = [&] {
+    if (!first) {
+      os << ",\n";
+    }
+    first = false;
+  };
+
+  std::vector<Zone> zones;
+  for (auto&& buf : registry.buffers) {
+    if (!buf->name.empty()) {
+      sep();
+      fmt::print(os,
+                 "{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+                 "\"tid\":{},\"args\":{{\"name\":{}}}}}",
+                 buf->tid, json(buf->name).dump());
+    }
+
+    // Copy out the valid range, then discard anything the owning thread
+    // overwrote while we were copying.
+    uint64_t head = buf->head.load(std::memory_order_acquire);
+    uint64_t begin = (std::max)(
+        buf->cleared, head > ThreadBuffer::kSize ? head - ThreadBuffer::kSize
+                                                 : uint64_t{0});
+    zones.clear();
+    for (uint64_t i = begin; i < head; ++i) {
+      auto& slot = buf->slots[i & (ThreadBuffer::kSize - 1)];
+      zones.push_back({slot.name.load(std::memory_order_relaxed),
+                       slot.start.load(std::memory_order_relaxed),
+                       slot.end.load(std::memory_order_relaxed)});
+    }
+    // Slots written after the copy started may have been overwritten,
+    // including the slot for newHead which may be partially written
+    std::atomic_thread_fence(std::memory_order_acquire);
+    uint64_t newHead = buf->head.load(std::memory_order_relaxed);
+    size_t skip = 0;
+    if (newHead >= ThreadBuffer::kSize &&
+        newHead - ThreadBuffer::kSize + 1 > begin) {
+      skip = (std::min)(newHead - ThreadBuffer::kSize + 1 - begin,
+                        static_cast<uint64_t>(zones.size()));
+    }
+
+    for (size_t i = skip; i < zones.size(); ++i) {
+      auto& zone = zones[i];
+      sep();
+      fmt::print(os,
+                 "{{\"name\":{},\"ph\":\"X\",\"pid\":1,\"tid\":{},"
+                 "\"ts\":{:.3f},\"dur\":{:.3f}}}",
+                 json(zone.name).dump(), buf->tid, zone.start / 1000.0,
+                 (zone.end - zone.start) / 1000.0);
+    }
+  }
+  os << "]}\n";
+
+  // zones of exited threads have now been written out
+  registry.PruneExited(true);
+}
@@ -4,6 +4,7 @@
 
 #include "wpi/WebSocket.h"
 
+#include <cstring>
 #include <random>
 
 #include "fmt/format.h"
@@ -25,18 +26,43 @@ class WebSocketWriteReq : public uv::WriteReq {
       std::function<void(span<uv::Buffer>, uv::Error)> callback) {
     finish.connect([=](uv::Error err) {
       span<uv::Buffer> bufs{m_bufs};
-      for (auto&& buf : bufs.subspan(0, m_startUser)) {
+      // the first buffer is the frame header, which is stored inline
+      for (auto&& buf : bufs.subspan(1, m_startUser - 1)) {
         buf.Deallocate();
       }
       callback(bufs.subspan(m_startUser), err);
     });
   }
 
+  uint8_t m_header[14];
   SmallVector<uv::Buffer, 4> m_bufs;
   size_t m_startUser;
 };
 }  // namespace
 
+// XORs len bytes of in with the repeating masking key (starting at key byte
+// offset n) and stores the result in out (which may be the same as in).
+// Works a 64-bit word at a time; compilers vectorize the main loop.
+static void MaskBytes(uint8_t* out, const uint8_t* in, size_t len,
+                      const uint8_t key[4], size_t n) {
+  uint8_t rotKey[8];
+  for (size_t i = 0; i < 8; ++i) {
+    rotKey[i] = key[(n + i) & 3];
+  }
+  uint64_t key64;
+  std::memcpy(&key64, rotKey, 8);
+  size_t i = 0;
+  for (; (i + 8) <= len; i += 8) {
+    uint64_t v;
+    std::memcpy(&v, in + i, 8);
+    v ^= key64;
+    std::memcpy(out + i, &v, 8);
+  }
+  for (; i < len; ++i) {
+    out[i] = in[i] ^ rotKey[i & 7];
+  }
+}
+
 class WebSocket::ClientHandshakeData {
  public:
   ClientHandshakeData() {
@@ -438,137 +464,193 @@ void WebSocket::HandleIncoming(uv::Buffer& buf, size_t size) {
           m_frameSize = len;
         }
 
-        // limit maximum size
-        if ((m_payload.size() + m_frameSize) > m_maxMessageSize) {
+        uint8_t opcode = m_header[0] & kOpMask;
+        m_framePos = 0;
+        m_frameStreamed = m_streamFrames && (opcode == kOpCont ||
+                                             opcode == kOpText ||
+                                             opcode == kOpBinary);
+        if (m_frameStreamed) {
+          // validate fragment sequence up front, as data is passed through
+          // before the frame is complete
+          if (opcode == kOpCont) {
+            if (m_fragmentOpcode == 0) {
+              return Fail(1002, "invalid continuation message");
+            }
+          } else if (m_fragmentOpcode != 0) {
+            return Fail(1002, "incomplete fragment");
+          }
+        } else if ((m_payload.size() + m_frameSize) > m_maxMessageSize) {
+          // limit maximum size
           return Fail(1009, "message too large");
         }
       }
     }
 
     if (m_frameSize != UINT64_MAX) {
-      size_t need = m_frameStart + m_frameSize - m_payload.size();
-      size_t toCopy = (std::min)(need, data.size());
-      m_payload.append(data.data(), data.data() + toCopy);
-      data.remove_prefix(toCopy);
-      need -= toCopy;
-      if (need == 0) {
+      bool masking = (m_header[1] & kFlagMasking) != 0;
+      const uint8_t* key = masking ? &m_header[m_headerSize - 4] : nullptr;
+      bool fin = (m_header[0] & kFlagFin) != 0;
+      uint8_t opcode = m_header[0] & kOpMask;
+
+      // data is always in buf, so it is safe to unmask it in place
+      uint8_t* inData =
+          reinterpret_cast<uint8_t*>(buf.base + (data.data() - buf.base));
+
+      if (m_frameStreamed) {
+        // Pass through payload data as it arrives
+        size_t toCopy = (std::min)(m_frameSize - m_framePos,
+                                   static_cast<uint64_t>(data.size()));
+        if (masking) {
+          MaskBytes(inData, inData, toCopy, key, m_framePos & 3);
+        }
+        data.remove_prefix(toCopy);
+        m_framePos += toCopy;
+        bool frameDone = m_framePos == m_frameSize;
+        if (toCopy == 0 && !frameDone) {
+          return;  // need more data
+        }
+
+        uint8_t msgOpcode = opcode == kOpCont ? m_fragmentOpcode : opcode;
+        if (frameDone) {
+          m_fragmentOpcode = fin ? 0 : msgOpcode;
+          m_header.clear();
+          m_headerSize = 0;
+          m_frameSize = UINT64_MAX;
+        }
+        if (msgOpcode == kOpText) {
+          text(std::string_view{reinterpret_cast<char*>(inData), toCopy},
+               frameDone && fin);
+        } else {
+          binary(span<const uint8_t>{inData, toCopy}, frameDone && fin);
+        }
+        continue;
+      }
+
+      span<uint8_t> payload;
+      if (m_payload.empty() && data.size() >= m_frameSize &&
+          (!m_combineFragments || fin)) {
+        // The complete frame is available and does not need to be combined
+        // with previous fragments, so handle it directly from the read buffer
+        payload = span{inData, static_cast<size_t>(m_frameSize)};
+        data.remove_prefix(m_frameSize);
+        if (masking) {
+          MaskBytes(payload.data(), payload.data(), payload.size(), key, 0);
+        }
+      } else {
+        size_t need = m_frameStart + m_frameSize - m_payload.size();
+        size_t toCopy = (std::min)(need, data.size());
+        m_payload.append(data.data(), data.data() + toCopy);
+        data.remove_prefix(toCopy);
+        need -= toCopy;
+        if (need != 0) {
+          return;  // need more data
+        }
         // We have a complete frame
         // If the message had masking, unmask it
-        if ((m_header[1] & kFlagMasking) != 0) {
-          uint8_t key[4] = {
-              m_header[m_headerSize - 4], m_header[m_headerSize - 3],
-              m_header[m_headerSize - 2], m_header[m_headerSize - 1]};
-          int n = 0;
-          for (uint8_t& ch : span{m_payload}.subspan(m_frameStart)) {
-            ch ^= key[n++];
-            if (n >= 4) {
-              n = 0;
-            }
-          }
+        payload = m_payload;
+        if (masking) {
+          auto frame = payload.subspan(m_frameStart);
+          MaskBytes(frame.data(), frame.data(), frame.size(), key, 0);
         }
+      }
 
-        // Handle message
-        bool fin = (m_header[0] & kFlagFin) != 0;
-        uint8_t opcode = m_header[0] & kOpMask;
-        switch (opcode) {
-          case kOpCont:
-            switch (m_fragmentOpcode) {
-              case kOpText:
-                if (!m_combineFragments || fin) {
-                  text(std::string_view{reinterpret_cast<char*>(
-                                            m_payload.data()),
-                                        m_payload.size()},
-                       fin);
-                }
-                break;
-              case kOpBinary:
-                if (!m_combineFragments || fin) {
-                  binary(m_payload, fin);
-                }
-                break;
-              default:
-                // no preceding message?
-                return Fail(1002, "invalid continuation message");
-            }
-            if (fin) {
-              m_fragmentOpcode = 0;
-            }
-            break;
-          case kOpText:
-            if (m_fragmentOpcode != 0) {
-              return Fail(1002, "incomplete fragment");
-            }
-            if (!m_combineFragments || fin) {
-              text(std::string_view{reinterpret_cast<char*>(m_payload.data()),
-                                    m_payload.size()},
-                   fin);
-            }
-            if (!fin) {
-              m_fragmentOpcode = opcode;
-            }
-            break;
-          case kOpBinary:
-            if (m_fragmentOpcode != 0) {
-              return Fail(1002, "incomplete fragment");
-            }
-            if (!m_combineFragments || fin) {
-              binary(m_payload, fin);
-            }
-            if (!fin) {
-              m_fragmentOpcode = opcode;
-            }
-            break;
-          case kOpClose: {
-            uint16_t code;
-            std::string_view reason;
-            if (!fin) {
-              code = 1002;
-              reason = "cannot fragment control frames";
-            } else if (m_payload.size() < 2) {
-              code = 1005;
-            } else {
-              code = (static_cast<uint16_t>(m_payload[0]) << 8) |
-                     static_cast<uint16_t>(m_payload[1]);
-              reason = drop_front(
-                  {reinterpret_cast<char*>(m_payload.data()), m_payload.size()},
-                  2);
-            }
-            // Echo the close if we didn't previously send it
-            if (m_state != CLOSING) {
-              SendClose(code, reason);
-            }
-            SetClosed(code, reason);
-            // If we're the server, shutdown the connection.
-            if (m_server) {
-              Shutdown();
-            }
-            break;
+      // Handle message
+      switch (opcode) {
+        case kOpCont:
+          switch (m_fragmentOpcode) {
+            case kOpText:
+              if (!m_combineFragments || fin) {
+                text(std::string_view{reinterpret_cast<char*>(payload.data()),
+                                      payload.size()},
+                     fin);
+              }
+              break;
+            case kOpBinary:
+              if (!m_combineFragments || fin) {
+                binary(payload, fin);
+              }
+              break;
+            default:
+              // no preceding message?
+              return Fail(1002, "invalid continuation message");
           }
-          case kOpPing:
-            if (!fin) {
-              return Fail(1002, "cannot fragment control frames");
-            }
-            ping(m_payload);
-            break;
-          case kOpPong:
-            if (!fin) {
-              return Fail(1002, "cannot fragment control frames");
-            }
-            pong(m_payload);
-            break;
-          default:
-            return Fail(1002, "invalid message opcode");
+          if (fin) {
+            m_fragmentOpcode = 0;
+          }
+          break;
+        case kOpText:
+          if (m_fragmentOpcode != 0) {
+            return Fail(1002, "incomplete fragment");
+          }
+          if (!m_combineFragments || fin) {
+            text(std::string_view{reinterpret_cast<char*>(payload.data()),
+                                  payload.size()},
+                 fin);
+          }
+          if (!fin) {
+            m_fragmentOpcode = opcode;
+          }
+          break;
+        case kOpBinary:
+          if (m_fragmentOpcode != 0) {
+            return Fail(1002, "incomplete fragment");
+          }
+          if (!m_combineFragments || fin) {
+            binary(payload, fin);
+          }
+          if (!fin) {
+            m_fragmentOpcode = opcode;
+          }
+          break;
+        case kOpClose: {
+          uint16_t code;
+          std::string_view reason;
+          if (!fin) {
+            code = 1002;
+            reason = "cannot fragment control frames";
+          } else if (payload.size() < 2) {
+            code = 1005;
+          } else {
+            code = (static_cast<uint16_t>(payload[0]) << 8) |
+                   static_cast<uint16_t>(payload[1]);
+            reason = drop_front(
+                {reinterpret_cast<char*>(payload.data()), payload.size()}, 2);
+          }
+          // Echo the close if we didn't previously send it
+          if (m_state != CLOSING) {
+            SendClose(code, reason);
+          }
+          SetClosed(code, reason);
+          // If we're the server, shutdown the connection.
+          if (m_server) {
+            Shutdown();
+          }
+          break;
         }
+        case kOpPing:
+          if (!fin) {
+            return Fail(1002, "cannot fragment control frames");
+          }
+          ping(payload);
+          break;
+        case kOpPong:
+          if (!fin) {
+            return Fail(1002, "cannot fragment control frames");
+          }
+          pong(payload);
+          break;
+        default:
+          return Fail(1002, "invalid message opcode");
+      }
 
-        // Prepare for next message
-        m_header.clear();
-        m_headerSize = 0;
-        if (!m_combineFragments || fin) {
-          m_payload.clear();
-        }
-        m_frameStart = m_payload.size();
-        m_frameSize = UINT64_MAX;
+      // Prepare for next message
+      m_header.clear();
+      m_headerSize = 0;
+      if (!m_combineFragments || fin) {
+        m_payload.clear();
       }
+      m_frameStart = m_payload.size();
+      m_frameSize = UINT64_MAX;
     }
   }
 }
@@ -590,34 +672,31 @@ void WebSocket::Send(
   }
 
   auto req = std::make_shared<WebSocketWriteReq>(callback);
-  raw_uv_ostream os{req->m_bufs, 4096};
+
+  // Build the header directly into the request rather than allocating
+  uint8_t* header = req->m_header;
+  size_t headerSize = 0;
 
   // opcode (includes FIN bit)
-  os << static_cast<unsigned char>(opcode);
+  header[headerSize++] = opcode;
 
   // payload length
   uint64_t size = 0;
   for (auto&& buf : data) {
     size += buf.len;
   }
+  uint8_t maskFlag = m_server ? 0x00 : kFlagMasking;
   if (size < 126) {
-    os << static_cast<unsigned char>((m_server ? 0x00 : kFlagMasking) | size);
+    header[headerSize++] = maskFlag | size;
   } else if (size <= 0xffff) {
-    os << static_cast<unsigned char>((m_server ? 0x00 : kFlagMasking) | 126);
-    const uint8_t sizeMsb[] = {static_cast<uint8_t>((size >> 8) & 0xff),
-                               static_cast<uint8_t>(size & 0xff)};
-    os << span{sizeMsb};
+    header[headerSize++] = maskFlag | 126;
+    header[headerSize++] = (size >> 8) & 0xff;
+    header[headerSize++] = size & 0xff;
   } else {
-    os << static_cast<unsigned char>((m_server ? 0x00 : kFlagMasking) | 127);
-    const uint8_t sizeMsb[] = {static_cast<uint8_t>((size >> 56) & 0xff),
-                               static_cast<uint8_t>((size >> 48) & 0xff),
-                               static_cast<uint8_t>((size >> 40) & 0xff),
-                               static_cast<uint8_t>((size >> 32) & 0xff),
-                               static_cast<uint8_t>((size >> 24) & 0xff),
-                               static_cast<uint8_t>((size >> 16) & 0xff),
-                               static_cast<uint8_t>((size >> 8) & 0xff),
-                               static_cast<uint8_t>(size & 0xff)};
-    os << span{sizeMsb};
+    header[headerSize++] = maskFlag | 127;
+    for (int shift = 56; shift >= 0; shift -= 8) {
+      header[headerSize++] = (size >> shift) & 0xff;
+    }
   }
 
   // clients need to mask the input data
@@ -626,20 +705,24 @@ void WebSocket::Send(
     static std::random_device rd;
     static std::default_random_engine gen{rd()};
     std::uniform_int_distribution<unsigned int> dist(0, 255);
-    uint8_t key[4];
-    for (uint8_t& v : key) {
-      v = dist(gen);
+    uint8_t* key = &header[headerSize];
+    for (int i = 0; i < 4; ++i) {
+      key[i] = dist(gen);
     }
-    os << span<const uint8_t>{key, 4};
-    // copy and mask data
-    int n = 0;
-    for (auto&& buf : data) {
-      for (auto&& ch : buf.data()) {
-        os << static_cast<unsigned char>(static_cast<uint8_t>(ch) ^ key[n++]);
-        if (n >= 4) {
-          n = 0;
-        }
+    headerSize += 4;
+    req->m_bufs.emplace_back(reinterpret_cast<char*>(header), headerSize);
+
+    // copy and mask data into a single buffer
+    if (size > 0) {
+      auto masked = uv::Buffer::Allocate(size);
+      size_t pos = 0;
+      for (auto&& buf : data) {
+        MaskBytes(reinterpret_cast<uint8_t*>(masked.base + pos),
+                  reinterpret_cast<const uint8_t*>(buf.base), buf.len, key,
+                  pos & 3);
+        pos += buf.len;
       }
+      req->m_bufs.emplace_back(masked);
     }
     req->m_startUser = req->m_bufs.size();
     req->m_bufs.append(data.begin(), data.end());
@@ -647,6 +730,7 @@ void WebSocket::Send(
     m_stream.Write(span{req->m_bufs}.subspan(0, req->m_startUser), req);
   } else {
     // servers can just send the buffers directly without masking
+    req->m_bufs.emplace_back(reinterpret_cast<char*>(header), headerSize);
     req->m_startUser = req->m_bufs.size();
     req->m_bufs.append(data.begin(), data.end());
     m_stream.Write(req->m_bufs, req);
@@ -0,0 +1,17 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/uv/Buffer.h"
+
+#include "wpi/uv/BufferPool.h"
+
+using namespace wpi::uv;
+
+Buffer Buffer::Allocate(size_t size) {
+  return BufferPool::GetInstance().Allocate(size);
+}
+
+void Buffer::Deallocate() {
+  BufferPool::GetInstance().Release(*this);
+}
@@ -0,0 +1,257 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/uv/BufferPool.h"
+
+#include <algorithm>
+#include <new>
+#include <vector>
+
+using namespace wpi::uv;
+
+static constexpr size_t kThreadCacheDepth = 8;
+
+// Slabs are aligned to their size, so the slab containing a block is found
+// by masking the block address
+static constexpr uintptr_t kSlabMask = BufferPool::kSlabSize - 1;
+
+// Slab table entries hold the slab address with the size class + 1 in the
+// (otherwise zero) low bits; 0 marks an empty entry
+static_assert(BufferPool::kSlabSize > BufferPool::kNumClasses);
+
+static size_t SizeClassFor(size_t size) {
+  size_t sizeClass = 0;
+  for (size_t cap = BufferPool::kMinSize; cap < size; cap <<= 1) {
+    ++sizeClass;
+  }
+  return sizeClass;
+}
+
+static size_t SlabHash(uintptr_t slab) {
+  return static_cast<size_t>(
+      (static_cast<uint64_t>(slab / BufferPool::kSlabSize) *
+       0x9E3779B97F4A7C15ull) >>
+      32);
+}
+
+namespace wpi::uv {
+struct BufferPoolThreadCache {
+  // Counters are only written by the owning thread, so they are bumped with
+  // a plain load and store instead of a locked read-modify-write; they are
+  // atomic so GetStats() can read them from other threads.
+  struct Counters {
+    std::atomic<uint64_t> hits{0};
+    std::atomic<uint64_t> misses{0};
+    std::atomic<uint64_t> pooled{0};
+    std::atomic<uint64_t> freed{0};
+    // buffers may be released on another thread than they were allocated on,
+    // so these only add up to the outstanding totals across all threads
+    std::atomic<int64_t> buffers{0};
+    std::atomic<int64_t> bytes{0};
+  };
+
+  BufferPoolThreadCache() {
+    auto& pool = BufferPool::GetInstance();
+    std::scoped_lock lock(pool.m_mutex);
+    pool.m_caches.emplace_back(this);
+  }
+
+  ~BufferPoolThreadCache() {
+    Flush();
+    auto& pool = BufferPool::GetInstance();
+    std::scoped_lock lock(pool.m_mutex);
+    AddTo(&pool.m_retired);
+    auto& caches = pool.m_caches;
+    caches.erase(std::find(caches.begin(), caches.end(), this));
+  }
+
+  void Flush() {
+    auto& pool = BufferPool::GetInstance();
+    for (size_t i = 0; i < BufferPool::kNumClasses; ++i) {
+      while (count[i] > 0) {
+        pool.ReleaseBlock(blocks[i][--count[i]], i);
+      }
+    }
+  }
+
+  void AddTo(BufferPool::Stats* stats) const {
+    stats->hits += counters.hits.load(std::memory_order_relaxed);
+    stats->misses += counters.misses.load(std::memory_order_relaxed);
+    stats->pooled += counters.pooled.load(std::memory_order_relaxed);
+    stats->freed += counters.freed.load(std::memory_order_relaxed);
+    stats->outstandingBuffers +=
+        counters.buffers.load(std::memory_order_relaxed);
+    stats->outstandingBytes += counters.bytes.load(std::memory_order_relaxed);
+  }
+
+  char* blocks[BufferPool::kNumClasses][kThreadCacheDepth];
+  size_t count[BufferPool::kNumClasses] = {};
+  Counters counters;
+};
+}  // namespace wpi::uv
+
+static thread_local BufferPoolThreadCache gThreadCache;
+
+template <typename T>
+static void Bump(std::atomic<T>& counter, T delta = 1) {
+  counter.store(counter.load(std::memory_order_relaxed) + delta,
+                std::memory_order_relaxed);
+}
+
+BufferPool& BufferPool::GetInstance() {
+  // intentionally leaked so threads exiting during shutdown can still flush
+  // their caches
+  static BufferPool* instance = new BufferPool;
+  return *instance;
+}
+
+Buffer BufferPool::Allocate(size_t size) {
+  auto& cache = gThreadCache;
+  auto& counters = cache.counters;
+  char* block;
+  size_t capacity;
+  if (size > kMaxSize) {
+    block = AllocateLarge(size);
+    capacity = size;
+    Bump(counters.misses);
+  } else {
+    size_t sizeClass = SizeClassFor(size);
+    capacity = kMinSize << sizeClass;
+    bool reused = true;
+    if (cache.count[sizeClass] > 0) {
+      block = cache.blocks[sizeClass][--cache.count[sizeClass]];
+    } else {
+      block = AllocateBlock(sizeClass, &reused);
+    }
+    Bump(reused ? counters.hits : counters.misses);
+  }
+  Bump<int64_t>(counters.buffers, 1);
+  Bump<int64_t>(counters.bytes, capacity);
+  return Buffer{block, size};
+}
+
+void BufferPool::Release(Buffer& buf) {
+  char* block = buf.base;
+  buf.base = nullptr;
+  buf.len = 0;
+  if (!block) {
+    return;
+  }
+
+  auto& cache = gThreadCache;
+  auto& counters = cache.counters;
+  int sizeClass = FindSizeClass(block);
+  if (sizeClass < 0) {
+    // not from a slab; it was allocated with new[], either by the pool or
+    // by the caller
+    if (size_t capacity = ReleaseLarge(block)) {
+      Bump<int64_t>(counters.buffers, -1);
+      Bump<int64_t>(counters.bytes, -static_cast<int64_t>(capacity));
+    }
+    Bump(counters.freed);
+    delete[] block;
+    return;
+  }
+
+  Bump(counters.pooled);
+  Bump<int64_t>(counters.buffers, -1);
+  Bump<int64_t>(counters.bytes, -static_cast<int64_t>(kMinSize << sizeClass));
+  if (cache.count[sizeClass] < kThreadCacheDepth) {
+    cache.blocks[sizeClass][cache.count[sizeClass]++] = block;
+  } else {
+    ReleaseBlock(block, sizeClass);
+  }
+}
+
+BufferPool::Stats BufferPool::GetStats() const {
+  std::scoped_lock lock(m_mutex);
+  Stats stats = m_retired;
+  for (auto cache : m_caches) {
+    cache->AddTo(&stats);
+  }
+  return stats;
+}
+
+void BufferPool::FlushThreadCache() {
+  gThreadCache.Flush();
+}
+
+char* BufferPool::AllocateBlock(size_t sizeClass, bool* reused) {
+  std::unique_lock lock(m_mutex);
+  auto& freeList = m_free[sizeClass];
+  if (!freeList.empty()) {
+    char* block = freeList.back();
+    freeList.pop_back();
+    *reused = true;
+    return block;
+  }
+
+  *reused = false;
+  size_t capacity = kMinSize << sizeClass;
+  auto& carve = m_carve[sizeClass];
+  if (carve.next == carve.end) {
+    if (m_numSlabs == kMaxSlabs) {
+      // out of slab table space; fall back to an ordinary allocation
+      lock.unlock();
+      return AllocateLarge(capacity);
+    }
+    char* slab = static_cast<char*>(
+        ::operator new(kSlabSize, std::align_val_t{kSlabSize}));
+    InsertSlab(reinterpret_cast<uintptr_t>(slab), sizeClass);
+    carve.next = slab;
+    carve.end = slab + kSlabSize;
+  }
+  char* block = carve.next;
+  carve.next += capacity;
+  return block;
+}
+
+void BufferPool::ReleaseBlock(char* block, size_t sizeClass) {
+  std::scoped_lock lock(m_mutex);
+  m_free[sizeClass].emplace_back(block);
+}
+
+char* BufferPool::AllocateLarge(size_t size) {
+  char* block = new char[size];
+  std::scoped_lock lock(m_largeMutex);
+  m_large[block] = size;
+  return block;
+}
+
+size_t BufferPool::ReleaseLarge(char* block) {
+  std::scoped_lock lock(m_largeMutex);
+  auto it = m_large.find(block);
+  if (it == m_large.end()) {
+    return 0;
+  }
+  size_t size = it->second;
+  m_large.erase(it);
+  return size;
+}
+
+void BufferPool::InsertSlab(uintptr_t slab, size_t sizeClass) {
+  // called with m_mutex held; readers are lock-free
+  for (size_t i = SlabHash(slab);; ++i) {
+    auto& entry = m_slabs[i & (kSlabTableSize - 1)];
+    if (entry.load(std::memory_order_relaxed) == 0) {
+      entry.store(slab | (sizeClass + 1), std::memory_order_release);
+      ++m_numSlabs;
+      return;
+    }
+  }
+}
+
+int BufferPool::FindSizeClass(const char* block) const {
+  uintptr_t slab = reinterpret_cast<uintptr_t>(block) & ~kSlabMask;
+  for (size_t i = SlabHash(slab);; ++i) {
+    uintptr_t entry =
+        m_slabs[i & (kSlabTableSize - 1)].load(std::memory_order_acquire);
+    if (entry == 0) {
+      return -1;
+    }
+    if ((entry & ~kSlabMask) == slab) {
+      return static_cast<int>(entry & kSlabMask) - 1;
+    }
+  }
+}
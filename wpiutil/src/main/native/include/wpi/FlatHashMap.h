@@ -0,0 +1,1238 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#ifndef WPIUTIL_WPI_FLATHASHMAP_H_
+#define WPIUTIL_WPI_FLATHASHMAP_H_
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "wpi/MathExtras.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define WPI_FLATHASH_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace wpi {
+
+/**
+ * Default hash function for FlatHashMap and FlatHashSet.  Uses std::hash.
+ */
+template <typename T>
+struct FlatHash : std::hash<T> {};
+
+/**
+ * Transparent string hash, so maps keyed by std::string can be looked up
+ * with std::string_view or const char* without constructing a std::string.
+ */
+template <>
+struct FlatHash<std::string> {
+  using is_transparent = void;
+  size_t operator()(std::string_view str) const noexcept {
+    return std::hash<std::string_view>{}(str);
+  }
+};
+
+/**
+ * Transparent pointer hash, so maps keyed by T* can be looked up with a
+ * const T*.
+ */
+template <typename T>
+struct FlatHash<T*> {
+  using is_transparent = void;
+  size_t operator()(const T* ptr) const noexcept {
+    return std::hash<const T*>{}(ptr);
+  }
+};
+
+namespace detail {
+
+using FlatHashCtrl = int8_t;
+inline constexpr FlatHashCtrl kFlatHashEmpty = -128;
+inline constexpr FlatHashCtrl kFlatHashDeleted = -2;
+inline constexpr size_t kFlatHashGroupWidth = 16;
+
+struct alignas(kFlatHashGroupWidth) FlatHashGroupStorage {
+  FlatHashCtrl ctrl[kFlatHashGroupWidth];
+};
+
+/** Control bytes for a table with no storage (always a probe miss). */
+inline FlatHashCtrl* FlatHashEmptyGroup() {
+  alignas(kFlatHashGroupWidth) static FlatHashCtrl group[kFlatHashGroupWidth] =
+      {kFlatHashEmpty, kFlatHashEmpty, kFlatHashEmpty, kFlatHashEmpty,
+       kFlatHashEmpty, kFlatHashEmpty, kFlatHashEmpty, kFlatHashEmpty,
+       kFlatHashEmpty, kFlatHashEmpty, kFlatHashEmpty, kFlatHashEmpty,
+       kFlatHashEmpty, kFlatHashEmpty, kFlatHashEmpty, kFlatHashEmpty};
+  return group;
+}
+
+/**
+ * A group of control bytes, matched in parallel.  Each match returns a
+ * bitmask with bit i set if control byte i matches.
+ */
+class FlatHashGroup {
+ public:
+  explicit FlatHashGroup(const FlatHashCtrl* ctrl) {
+#ifdef WPI_FLATHASH_SSE2
+    m_ctrl = _mm_load_si128(reinterpret_cast<const __m128i*>(ctrl));
+#else
+    for (size_t i = 0; i < kFlatHashGroupWidth; ++i) {
+      m_ctrl[i] = ctrl[i];
+    }
+#endif
+  }
+
+  uint32_t Match(FlatHashCtrl h2) const {
+#ifdef WPI_FLATHASH_SSE2
+    return static_cast<uint32_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), m_ctrl)));
+#else
+    uint32_t mask = 0;
+    for (size_t i = 0; i < kFlatHashGroupWidth; ++i) {
+      mask |= static_cast<uint32_t>(m_ctrl[i] == h2) << i;
+    }
+    return mask;
+#endif
+  }
+
+  uint32_t MatchEmpty() const { return Match(kFlatHashEmpty); }
+
+  uint32_t MatchEmptyOrDeleted() const {
+#ifdef WPI_FLATHASH_SSE2
+    // empty and deleted are the only values less than -1
+    return static_cast<uint32_t>(
+        _mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), m_ctrl)));
+#else
+    uint32_t mask = 0;
+    for (size_t i = 0; i < kFlatHashGroupWidth; ++i) {
+      mask |= static_cast<uint32_t>(m_ctrl[i] < -1) << i;
+    }
+    return mask;
+#endif
+  }
+
+ private:
+#ifdef WPI_FLATHASH_SSE2
+  __m128i m_ctrl;
+#else
+  FlatHashCtrl m_ctrl[kFlatHashGroupWidth];
+#endif
+};
+
+template <bool Transparent>
+struct FlatHashKeyArg {
+  template <typename K, typename Key>
+  using type = Key;
+};
+
+template <>
+struct FlatHashKeyArg<true> {
+  template <typename K, typename Key>
+  using type = K;
+};
+
+template <typename T, typename = void>
+struct FlatHashIsTransparent : std::false_type {};
+
+template <typename T>
+struct FlatHashIsTransparent<T, std::void_t<typename T::is_transparent>>
+    : std::true_type {};
+
+template <typename Key, typename T>
+struct FlatHashMapPolicy {
+  using key_type = Key;
+  using value_type = std::pair<const Key, T>;
+  using slot_type = value_type;
+
+  static const Key& GetKey(const slot_type& slot) { return slot.first; }
+  static slot_type& Element(slot_type& slot) { return slot; }
+  static const slot_type& Element(const slot_type& slot) { return slot; }
+
+  // Moves the slot at src into uninitialized storage at dst, then destroys
+  // src.  The key is only const to users; the source slot is destroyed
+  // immediately afterwards, so it is safe to move from it.
+  static void Transfer(slot_type* dst, slot_type* src) {
+    new (dst) slot_type(std::move(const_cast<Key&>(src->first)),
+                        std::move(src->second));
+    src->~slot_type();
+  }
+};
+
+template <typename Key>
+struct FlatHashSetPolicy {
+  using key_type = Key;
+  using value_type = Key;
+  using slot_type = Key;
+
+  static const Key& GetKey(const slot_type& slot) { return slot; }
+  static slot_type& Element(slot_type& slot) { return slot; }
+  static const slot_type& Element(const slot_type& slot) { return slot; }
+
+  static void Transfer(slot_type* dst, slot_type* src) {
+    new (dst) slot_type(std::move(*src));
+    src->~slot_type();
+  }
+};
+
+/**
+ * Open-addressing hash table storing elements inline in a flat array.  This
+ * is the common implementation of FlatHashMap and FlatHashSet.
+ */
+template <typename Policy, typename Hash, typename Eq>
+class FlatHashTable {
+ protected:
+  using slot_type = typename Policy::slot_type;
+  using key_type = typename Policy::key_type;
+
+  static constexpr bool kTransparent =
+      FlatHashIsTransparent<Hash>::value && FlatHashIsTransparent<Eq>::value;
+
+  template <typename K>
+  using key_arg =
+      typename FlatHashKeyArg<kTransparent>::template type<K, key_type>;
+
+  template <bool Const>
+  class Iterator {
+    friend class FlatHashTable;
+    using slot_pointer =
+        std::conditional_t<Const, const slot_type*, slot_type*>;
+
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = typename Policy::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<Const, const value_type*, value_type*>;
+    using reference =
+        std::conditional_t<Const, const value_type&, value_type&>;
+
+    Iterator() = default;
+
+    template <bool C = Const, typename = std::enable_if_t<C>>
+    Iterator(const Iterator<false>& other)  // NOLINT
+        : m_ctrl{other.m_ctrl}, m_slot{other.m_slot}, m_end{other.m_end} {}
+
+    reference operator*() const { return Policy::Element(*m_slot); }
+    pointer operator->() const { return &Policy::Element(*m_slot); }
+
+    Iterator& operator++() {
+      ++m_ctrl;
+      ++m_slot;
+      SkipEmpty();
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      Iterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    friend bool operator==(const Iterator& lhs, const Iterator& rhs) {
+      return lhs.m_ctrl == rhs.m_ctrl;
+    }
+    friend bool operator!=(const Iterator& lhs, const Iterator& rhs) {
+      return lhs.m_ctrl != rhs.m_ctrl;
+    }
+
+   private:
+    friend class Iterator<!Const>;
+
+    Iterator(const FlatHashCtrl* ctrl, slot_pointer slot,
+             const FlatHashCtrl* end)
+        : m_ctrl{ctrl}, m_slot{slot}, m_end{end} {}
+
+    void SkipEmpty() {
+      while (m_ctrl != m_end && *m_ctrl < 0) {
+        ++m_ctrl;
+        ++m_slot;
+      }
+    }
+
+    const FlatHashCtrl* m_ctrl = nullptr;
+    slot_pointer m_slot = nullptr;
+    const FlatHashCtrl* m_end = nullptr;
+  };
+
+ public:
+  using size_type = size_t;
+  using difference_type = std::ptrdiff_t;
+  using hasher = Hash;
+  using key_equal = Eq;
+
+  FlatHashTable() = default;
+
+  FlatHashTable(const FlatHashTable& other)
+      : m_hash{other.m_hash}, m_eq{other.m_eq} {
+    reserve(other.m_size);
+    for (size_t i = 0; i < other.capacity(); ++i) {
+      if (other.m_ctrl[i] >= 0) {
+        const slot_type& slot = other.m_slots[i];
+        ConstructAt(PrepareInsert(HashKey(Policy::GetKey(slot))), slot);
+      }
+    }
+  }
+
+  FlatHashTable(FlatHashTable&& other) noexcept
+      : m_hash{std::move(other.m_hash)}, m_eq{std::move(other.m_eq)} {
+    TakeStorage(other);
+  }
+
+  FlatHashTable& operator=(const FlatHashTable& other) {
+    if (this != &other) {
+      FlatHashTable tmp{other};
+      swap(tmp);
+    }
+    return *this;
+  }
+
+  FlatHashTable& operator=(FlatHashTable&& other) noexcept {
+    if (this != &other) {
+      DestroyAll();
+      Deallocate();
+      m_hash = std::move(other.m_hash);
+      m_eq = std::move(other.m_eq);
+      TakeStorage(other);
+    }
+    return *this;
+  }
+
+  ~FlatHashTable() {
+    DestroyAll();
+    Deallocate();
+  }
+
+  /** Returns true if the table has no elements. */
+  bool empty() const { return m_size == 0; }
+
+  /** Returns the number of elements in the table. */
+  size_type size() const { return m_size; }
+
+  /** Returns the number of slots allocated. */
+  size_type capacity() const { return m_numGroups * kFlatHashGroupWidth; }
+
+  /**
+   * Removes all elements.  Allocated storage is kept.
+   */
+  void clear() {
+    DestroyAll();
+    for (size_t i = 0; i < capacity(); ++i) {
+      m_ctrl[i] = kFlatHashEmpty;
+    }
+    m_size = 0;
+    m_growthLeft = MaxLoad(capacity());
+  }
+
+  /**
+   * Reserves storage so that at least count elements can be held without
+   * rehashing.
+   */
+  void reserve(size_type count) {
+    size_t numGroups = m_numGroups == 0 ? 1 : m_numGroups;
+    while (MaxLoad(numGroups * kFlatHashGroupWidth) < count) {
+      numGroups *= 2;
+    }
+    if (numGroups != m_numGroups) {
+      Resize(numGroups);
+    }
+  }
+
+  void swap(FlatHashTable& other) noexcept {
+    using std::swap;
+    swap(m_hash, other.m_hash);
+    swap(m_eq, other.m_eq);
+    swap(m_ctrl, other.m_ctrl);
+    swap(m_slots, other.m_slots);
+    swap(m_numGroups, other.m_numGroups);
+    swap(m_size, other.m_size);
+    swap(m_growthLeft, other.m_growthLeft);
+  }
+
+  hasher hash_function() const { return m_hash; }
+  key_equal key_eq() const { return m_eq; }
+
+ protected:
+  using iterator_impl = Iterator<false>;
+  using const_iterator_impl = Iterator<true>;
+
+  iterator_impl BeginImpl() {
+    iterator_impl it{m_ctrl, m_slots, m_ctrl + capacity()};
+    it.SkipEmpty();
+    return it;
+  }
+  const_iterator_impl BeginImpl() const {
+    const_iterator_impl it{m_ctrl, m_slots, m_ctrl + capacity()};
+    it.SkipEmpty();
+    return it;
+  }
+  iterator_impl EndImpl() { return IteratorAt(capacity()); }
+  const_iterator_impl EndImpl() const { return IteratorAt(capacity()); }
+
+  iterator_impl IteratorAt(size_t idx) {
+    return {m_ctrl + idx, m_slots + idx, m_ctrl + capacity()};
+  }
+  const_iterator_impl IteratorAt(size_t idx) const {
+    return {m_ctrl + idx, m_slots + idx, m_ctrl + capacity()};
+  }
+
+  size_t IndexOf(const const_iterator_impl& it) const {
+    return it.m_ctrl - m_ctrl;
+  }
+
+  template <typename K>
+  size_t HashKey(const K& key) const {
+    // std::hash is the identity function for integers and pointers on common
+    // implementations, so mix the bits before splitting into H1 and H2.
+    uint64_t x = m_hash(key);
+    x ^= x >> 33;
+    x *= UINT64_C(0xff51afd7ed558ccd);
+    x ^= x >> 33;
+    return static_cast<size_t>(x);
+  }
+
+  static size_t H1(size_t hash) { return hash >> 7; }
+  static FlatHashCtrl H2(size_t hash) {
+    return static_cast<FlatHashCtrl>(hash & 0x7f);
+  }
+
+  static size_t MaxLoad(size_t capacity) { return capacity - capacity / 8; }
+
+  /**
+   * Finds the index of key, or capacity() if not found.
+   */
+  template <typename K>
+  size_t FindIndex(const K& key, size_t hash) const {
+    if (m_numGroups == 0) {
+      return 0;
+    }
+    size_t mask = m_numGroups - 1;
+    size_t group = H1(hash) & mask;
+    for (size_t i = 1;; ++i) {
+      size_t base = group * kFlatHashGroupWidth;
+      FlatHashGroup g{m_ctrl + base};
+      for (uint32_t m = g.Match(H2(hash)); m != 0; m &= m - 1) {
+        size_t idx = base + countTrailingZeros(m, ZB_Undefined);
+        if (m_eq(Policy::GetKey(m_slots[idx]), key)) {
+          return idx;
+        }
+      }
+      if (g.MatchEmpty() != 0) {
+        return capacity();
+      }
+      // triangular probing visits every group when the count is a power of 2
+      group = (group + i) & mask;
+    }
+  }
+
+  template <typename K>
+  size_t FindIndex(const K& key) const {
+    return FindIndex(key, HashKey(key));
+  }
+
+  /**
+   * Finds the index of key, or claims a slot for it.  If the returned bool is
+   * true, the caller must construct an element at the returned index.
+   */
+  template <typename K>
+  std::pair<size_t, bool> FindOrPrepareInsert(const K& key) {
+    size_t hash = HashKey(key);
+    size_t idx = FindIndex(key, hash);
+    if (idx != capacity()) {
+      return {idx, false};
+    }
+    return {PrepareInsert(hash), true};
+  }
+
+  size_t PrepareInsert(size_t hash) {
+    size_t idx = FindFirstNonFull(hash);
+    if (m_growthLeft == 0 && m_ctrl[idx] != kFlatHashDeleted) {
+      Grow();
+      idx = FindFirstNonFull(hash);
+    }
+    if (m_ctrl[idx] == kFlatHashEmpty) {
+      --m_growthLeft;
+    }
+    m_ctrl[idx] = H2(hash);
+    ++m_size;
+    return idx;
+  }
+
+  template <typename... Args>
+  void ConstructAt(size_t idx, Args&&... args) {
+    try {
+      new (m_slots + idx) slot_type(std::forward<Args>(args)...);
+    } catch (...) {
+      EraseMeta(idx);
+      throw;
+    }
+  }
+
+  void EraseAt(size_t idx) {
+    m_slots[idx].~slot_type();
+    EraseMeta(idx);
+  }
+
+  template <typename K>
+  size_type EraseKey(const K& key) {
+    size_t idx = FindIndex(key);
+    if (idx == capacity()) {
+      return 0;
+    }
+    EraseAt(idx);
+    return 1;
+  }
+
+  hasher m_hash;
+  key_equal m_eq;
+
+ private:
+  size_t FindFirstNonFull(size_t hash) const {
+    if (m_numGroups == 0) {
+      return 0;
+    }
+    size_t mask = m_numGroups - 1;
+    size_t group = H1(hash) & mask;
+    for (size_t i = 1;; ++i) {
+      size_t base = group * kFlatHashGroupWidth;
+      uint32_t m = FlatHashGroup{m_ctrl + base}.MatchEmptyOrDeleted();
+      if (m != 0) {
+        return base + countTrailingZeros(m, ZB_Undefined);
+      }
+      group = (group + i) & mask;
+    }
+  }
+
+  void EraseMeta(size_t idx) {
+    --m_size;
+    // A probe only continues past a group with no empty slots, so if this
+    // group has one, no probe sequence depends on this slot being occupied.
+    size_t base = idx & ~(kFlatHashGroupWidth - 1);
+    if (FlatHashGroup{m_ctrl + base}.MatchEmpty() != 0) {
+      m_ctrl[idx] = kFlatHashEmpty;
+      ++m_growthLeft;
+    } else {
+      m_ctrl[idx] = kFlatHashDeleted;
+    }
+  }
+
+  void Grow() {
+    if (m_numGroups == 0) {
+      Resize(1);
+    } else if (m_size <= MaxLoad(capacity()) / 2) {
+      // mostly tombstones; rehash in place to reclaim them
+      Resize(m_numGroups);
+    } else {
+      Resize(m_numGroups * 2);
+    }
+  }
+
+  void Resize(size_t numGroups) {
+    FlatHashCtrl* oldCtrl = m_ctrl;
+    slot_type* oldSlots = m_slots;
+    size_t oldCapacity = capacity();
+
+    auto groups = new FlatHashGroupStorage[numGroups];
+    m_ctrl = groups[0].ctrl;
+    m_slots = std::allocator<slot_type>{}.allocate(numGroups *
+                                                   kFlatHashGroupWidth);
+    m_numGroups = numGroups;
+    for (size_t i = 0; i < capacity(); ++i) {
+      m_ctrl[i] = kFlatHashEmpty;
+    }
+
+    for (size_t i = 0; i < oldCapacity; ++i) {
+      if (oldCtrl[i] >= 0) {
+        size_t hash = HashKey(Policy::GetKey(oldSlots[i]));
+        size_t idx = FindFirstNonFull(hash);
+        m_ctrl[idx] = H2(hash);
+        Policy::Transfer(m_slots + idx, oldSlots + i);
+      }
+    }
+    m_growthLeft = MaxLoad(capacity()) - m_size;
+
+    if (oldCapacity != 0) {
+      delete[] reinterpret_cast<FlatHashGroupStorage*>(oldCtrl);
+      std::allocator<slot_type>{}.deallocate(oldSlots, oldCapacity);
+    }
+  }
+
+  void DestroyAll() {
+    if constexpr (!std::is_trivially_destructible_v<slot_type>) {
+      for (size_t i = 0; i < capacity(); ++i) {
+        if (m_ctrl[i] >= 0) {
+          m_slots[i].~slot_type();
+        }
+      }
+    }
+  }
+
+  void Deallocate() {
+    if (m_numGroups != 0) {
+      delete[] reinterpret_cast<FlatHashGroupStorage*>(m_ctrl);
+      std::allocator<slot_type>{}.deallocate(m_slots, capacity());
+    }
+    m_ctrl = FlatHashEmptyGroup();
+    m_slots = nullptr;
+    m_numGroups = 0;
+    m_size = 0;
+    m_growthLeft = 0;
+  }
+
+  void TakeStorage(FlatHashTable& other) {
+    m_ctrl = other.m_ctrl;
+    m_slots = other.m_slots;
+    m_numGroups = other.m_numGroups;
+    m_size = other.m_size;
+    m_growthLeft = other.m_growthLeft;
+    other.m_ctrl = FlatHashEmptyGroup();
+    other.m_slots = nullptr;
+    other.m_numGroups = 0;
+    other.m_size = 0;
+    other.m_growthLeft = 0;
+  }
+
+  FlatHashCtrl* m_ctrl = FlatHashEmptyGroup();
+  slot_type* m_slots = nullptr;
+  size_t m_numGroups = 0;
+  size_t m_size = 0;
+  size_t m_growthLeft = 0;
+};
+
+/**
+ * Element of a FlatStringMap.  Keys of up to N characters are stored inline;
+ * longer keys are stored in a separate heap allocation.
+ */
+template <typename T, size_t N>
+class FlatStringMapEntry {
+  // declared first, so it exists before first is pointed at it
+  char m_inlineKey[N];
+
+ public:
+  template <typename... Args>
+  explicit FlatStringMapEntry(std::string_view key, Args&&... args)
+      : first{StoreKey(key)}, second(std::forward<Args>(args)...) {}
+
+  ~FlatStringMapEntry() {
+    if (first.data() != m_inlineKey) {
+      delete[] first.data();
+    }
+  }
+
+  FlatStringMapEntry(const FlatStringMapEntry&) = delete;
+  FlatStringMapEntry& operator=(const FlatStringMapEntry&) = delete;
+
+  /** The key. */
+  const std::string_view first;
+
+  /** The mapped value. */
+  T second;
+
+ private:
+  std::string_view StoreKey(std::string_view key) {
+    char* buf = key.size() <= N ? m_inlineKey : new char[key.size()];
+    std::copy(key.begin(), key.end(), buf);
+    return {buf, key.size()};
+  }
+};
+
+/**
+ * Allocates fixed-size nodes in blocks, so nodes never move and freed nodes
+ * are reused without going back to the heap.
+ */
+template <typename T>
+class FlatHashNodeArena {
+ public:
+  static constexpr size_t kBlockSize = 32;
+
+  FlatHashNodeArena() = default;
+  FlatHashNodeArena(FlatHashNodeArena&& other) noexcept { swap(other); }
+  FlatHashNodeArena& operator=(FlatHashNodeArena&& other) noexcept {
+    FlatHashNodeArena tmp{std::move(other)};
+    swap(tmp);
+    return *this;
+  }
+
+  // All nodes must have been deleted
+  ~FlatHashNodeArena() {
+    for (Node* block = m_blocks; block;) {
+      Node* next = block[0].next;
+      delete[] block;
+      block = next;
+    }
+  }
+
+  template <typename... Args>
+  T* New(Args&&... args) {
+    Node* node = Allocate();
+    try {
+      return new (node->storage) T(std::forward<Args>(args)...);
+    } catch (...) {
+      Free(node);
+      throw;
+    }
+  }
+
+  void Delete(T* ptr) {
+    ptr->~T();
+    Free(reinterpret_cast<Node*>(ptr));
+  }
+
+  void swap(FlatHashNodeArena& other) noexcept {
+    using std::swap;
+    swap(m_blocks, other.m_blocks);
+    swap(m_free, other.m_free);
+    swap(m_next, other.m_next);
+    swap(m_end, other.m_end);
+  }
+
+ private:
+  union Node {
+    Node* next;
+    alignas(T) unsigned char storage[sizeof(T)];
+  };
+
+  Node* Allocate() {
+    if (m_free) {
+      Node* node = m_free;
+      m_free = node->next;
+      return node;
+    }
+    if (m_next == m_end) {
+      // the first node of each block links the list of blocks
+      Node* block = new Node[kBlockSize + 1];
+      block[0].next = m_blocks;
+      m_blocks = block;
+      m_next = block + 1;
+      m_end = block + kBlockSize + 1;
+    }
+    return m_next++;
+  }
+
+  void Free(Node* node) {
+    node->next = m_free;
+    m_free = node;
+  }
+
+  Node* m_blocks = nullptr;
+  Node* m_free = nullptr;
+  Node* m_next = nullptr;
+  Node* m_end = nullptr;
+};
+
+template <typename T, size_t N>
+struct FlatStringMapPolicy {
+  using key_type = std::string_view;
+  using value_type = FlatStringMapEntry<T, N>;
+  using slot_type = value_type*;
+
+  static std::string_view GetKey(const slot_type& slot) { return slot->first; }
+  static value_type& Element(slot_type slot) { return *slot; }
+  static void Transfer(slot_type* dst, slot_type* src) { *dst = *src; }
+};
+
+}  // namespace detail
+
+/**
+ * A hash map that stores its elements inline in a single open-addressed
+ * array, probing 16 slots at a time using a parallel (SSE2 where available)
+ * match on one byte of hash per slot.  Lookups typically touch one cache line
+ * of metadata and one element, which is much faster than node-based maps for
+ * small keys and values.
+ *
+ * When the hash and equality functions are transparent (the default for
+ * std::string keys), lookups accept any comparable key type, e.g. a
+ * std::string_view, without constructing a key_type.
+ *
+ * Unlike std::unordered_map, inserting may move existing elements, so
+ * pointers and references to elements are invalidated by any insertion that
+ * rehashes.  Use FlatStringMap for string keys that need stable references.  Erasing never rehashes and does not invalidate iterators or
+ * references to other elements, so it is safe to erase the current element
+ * while iterating.
+ *
+ * @tparam Key key type
+ * @tparam T mapped type
+ * @tparam Hash hash function
+ * @tparam Eq key equality function
+ */
+template <typename Key, typename T, typename Hash = FlatHash<Key>,
+          typename Eq = std::equal_to<>>
+class FlatHashMap
+    : public detail::FlatHashTable<detail::FlatHashMapPolicy<Key, T>, Hash,
+                                   Eq> {
+  using Base =
+      detail::FlatHashTable<detail::FlatHashMapPolicy<Key, T>, Hash, Eq>;
+  template <typename K>
+  using key_arg = typename Base::template key_arg<K>;
+
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const Key, T>;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using iterator = typename Base::iterator_impl;
+  using const_iterator = typename Base::const_iterator_impl;
+
+  FlatHashMap() = default;
+
+  FlatHashMap(std::initializer_list<value_type> init) {
+    this->reserve(init.size());
+    for (auto&& value : init) {
+      insert(value);
+    }
+  }
+
+  iterator begin() { return this->BeginImpl(); }
+  const_iterator begin() const { return this->BeginImpl(); }
+  const_iterator cbegin() const { return this->BeginImpl(); }
+  iterator end() { return this->EndImpl(); }
+  const_iterator end() const { return this->EndImpl(); }
+  const_iterator cend() const { return this->EndImpl(); }
+
+  template <typename K = key_type>
+  iterator find(const key_arg<K>& key) {
+    return this->IteratorAt(this->FindIndex(key));
+  }
+
+  template <typename K = key_type>
+  const_iterator find(const key_arg<K>& key) const {
+    return this->IteratorAt(this->FindIndex(key));
+  }
+
+  template <typename K = key_type>
+  bool contains(const key_arg<K>& key) const {
+    return this->FindIndex(key) != this->capacity();
+  }
+
+  template <typename K = key_type>
+  size_t count(const key_arg<K>& key) const {
+    return contains(key) ? 1 : 0;
+  }
+
+  template <typename K = key_type>
+  T& at(const key_arg<K>& key) {
+    size_t idx = this->FindIndex(key);
+    if (idx == this->capacity()) {
+      throw std::out_of_range("FlatHashMap::at");
+    }
+    return this->IteratorAt(idx)->second;
+  }
+
+  template <typename K = key_type>
+  const T& at(const key_arg<K>& key) const {
+    size_t idx = this->FindIndex(key);
+    if (idx == this->capacity()) {
+      throw std::out_of_range("FlatHashMap::at");
+    }
+    return this->IteratorAt(idx)->second;
+  }
+
+  /**
+   * Inserts a value-initialized element if key is not present.
+   */
+  template <typename K = key_type>
+  T& operator[](key_arg<K>&& key) {
+    return try_emplace(std::forward<key_arg<K>>(key)).first->second;
+  }
+
+  template <typename K = key_type>
+  T& operator[](const key_arg<K>& key) {
+    return try_emplace(key).first->second;
+  }
+
+  /**
+   * Inserts an element constructed from args if key is not present.  Unlike
+   * emplace(), args are not used if the key is present.
+   */
+  template <typename K = key_type, typename... Args>
+  std::pair<iterator, bool> try_emplace(key_arg<K>&& key, Args&&... args) {
+    auto [idx, inserted] = this->FindOrPrepareInsert(key);
+    if (inserted) {
+      this->ConstructAt(idx, std::piecewise_construct,
+                        std::forward_as_tuple(std::forward<key_arg<K>>(key)),
+                        std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+    return {this->IteratorAt(idx), inserted};
+  }
+
+  template <typename K = key_type, typename... Args>
+  std::pair<iterator, bool> try_emplace(const key_arg<K>& key,
+                                        Args&&... args) {
+    auto [idx, inserted] = this->FindOrPrepareInsert(key);
+    if (inserted) {
+      this->ConstructAt(idx, std::piecewise_construct,
+                        std::forward_as_tuple(key),
+                        std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+    return {this->IteratorAt(idx), inserted};
+  }
+
+  template <typename K = key_type, typename V>
+  std::pair<iterator, bool> insert_or_assign(key_arg<K>&& key, V&& value) {
+    auto rv =
+        try_emplace(std::forward<key_arg<K>>(key), std::forward<V>(value));
+    if (!rv.second) {
+      rv.first->second = std::forward<V>(value);
+    }
+    return rv;
+  }
+
+  template <typename K = key_type, typename V>
+  std::pair<iterator, bool> insert_or_assign(const key_arg<K>& key,
+                                             V&& value) {
+    auto rv = try_emplace(key, std::forward<V>(value));
+    if (!rv.second) {
+      rv.first->second = std::forward<V>(value);
+    }
+    return rv;
+  }
+
+  std::pair<iterator, bool> insert(const value_type& value) {
+    return try_emplace(value.first, value.second);
+  }
+
+  std::pair<iterator, bool> insert(value_type&& value) {
+    return try_emplace(std::move(const_cast<Key&>(value.first)),
+                       std::move(value.second));
+  }
+
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last) {
+    for (; first != last; ++first) {
+      insert(*first);
+    }
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    value_type value(std::forward<Args>(args)...);
+    return insert(std::move(value));
+  }
+
+  template <typename K = key_type>
+  size_t erase(const key_arg<K>& key) {
+    return this->EraseKey(key);
+  }
+
+  /**
+   * Erases the element at pos.
+   * @return iterator to the next element
+   */
+  iterator erase(const_iterator pos) {
+    size_t idx = this->IndexOf(pos);
+    this->EraseAt(idx);
+    auto it = this->IteratorAt(idx);
+    ++it;
+    return it;
+  }
+
+  iterator erase(iterator pos) { return erase(const_iterator{pos}); }
+};
+
+/**
+ * A hash set with the same flat storage as FlatHashMap.
+ *
+ * @tparam Key key type
+ * @tparam Hash hash function
+ * @tparam Eq key equality function
+ */
+template <typename Key, typename Hash = FlatHash<Key>,
+          typename Eq = std::equal_to<>>
+class FlatHashSet
+    : public detail::FlatHashTable<detail::FlatHashSetPolicy<Key>, Hash, Eq> {
+  using Base = detail::FlatHashTable<detail::FlatHashSetPolicy<Key>, Hash, Eq>;
+  template <typename K>
+  using key_arg = typename Base::template key_arg<K>;
+
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using reference = const value_type&;
+  using const_reference = const value_type&;
+  using iterator = typename Base::const_iterator_impl;
+  using const_iterator = typename Base::const_iterator_impl;
+
+  FlatHashSet() = default;
+
+  FlatHashSet(std::initializer_list<value_type> init) {
+    this->reserve(init.size());
+    for (auto&& value : init) {
+      insert(value);
+    }
+  }
+
+  const_iterator begin() const { return this->BeginImpl(); }
+  const_iterator cbegin() const { return this->BeginImpl(); }
+  const_iterator end() const { return this->EndImpl(); }
+  const_iterator cend() const { return this->EndImpl(); }
+
+  template <typename K = key_type>
+  const_iterator find(const key_arg<K>& key) const {
+    return this->IteratorAt(this->FindIndex(key));
+  }
+
+  template <typename K = key_type>
+  bool contains(const key_arg<K>& key) const {
+    return this->FindIndex(key) != this->capacity();
+  }
+
+  template <typename K = key_type>
+  size_t count(const key_arg<K>& key) const {
+    return contains(key) ? 1 : 0;
+  }
+
+  template <typename K = key_type>
+  std::pair<iterator, bool> insert(key_arg<K>&& key) {
+    auto [idx, inserted] = this->FindOrPrepareInsert(key);
+    if (inserted) {
+      this->ConstructAt(idx, std::forward<key_arg<K>>(key));
+    }
+    return {this->IteratorAt(idx), inserted};
+  }
+
+  template <typename K = key_type>
+  std::pair<iterator, bool> insert(const key_arg<K>& key) {
+    auto [idx, inserted] = this->FindOrPrepareInsert(key);
+    if (inserted) {
+      this->ConstructAt(idx, key);
+    }
+    return {this->IteratorAt(idx), inserted};
+  }
+
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last) {
+    for (; first != last; ++first) {
+      insert(*first);
+    }
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    return insert(key_type(std::forward<Args>(args)...));
+  }
+
+  template <typename K = key_type>
+  size_t erase(const key_arg<K>& key) {
+    return this->EraseKey(key);
+  }
+
+  /**
+   * Erases the element at pos.
+   * @return iterator to the next element
+   */
+  iterator erase(const_iterator pos) {
+    size_t idx = this->IndexOf(pos);
+    this->EraseAt(idx);
+    auto it = this->IteratorAt(idx);
+    ++it;
+    return it;
+  }
+};
+
+/**
+ * A string-keyed hash map with the same flat probing as FlatHashMap, whose
+ * elements are stored outside the probe array so they never move.  Like
+ * StringMap, pointers and references to elements (including the key) stay
+ * valid until the element is erased.
+ *
+ * Each element is allocated from a per-map pool of fixed-size nodes, with
+ * keys of up to N characters stored inline in the node, so inserting a short
+ * key doesn't allocate once the pool has grown.  Longer keys are stored in a
+ * separate allocation.
+ *
+ * Elements have a std::string_view first (the key) and a T second.
+ *
+ * @tparam T mapped type
+ * @tparam N maximum length of keys stored inline
+ */
+template <typename T, size_t N = 40>
+class FlatStringMap
+    : public detail::FlatHashTable<detail::FlatStringMapPolicy<T, N>,
+                                   FlatHash<std::string>, std::equal_to<>> {
+  using Base = detail::FlatHashTable<detail::FlatStringMapPolicy<T, N>,
+                                     FlatHash<std::string>, std::equal_to<>>;
+
+ public:
+  using key_type = std::string_view;
+  using mapped_type = T;
+  using value_type = detail::FlatStringMapEntry<T, N>;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using iterator = typename Base::iterator_impl;
+  using const_iterator = typename Base::const_iterator_impl;
+
+  FlatStringMap() = default;
+
+  FlatStringMap(std::initializer_list<std::pair<std::string_view, T>> init) {
+    this->reserve(init.size());
+    for (auto&& value : init) {
+      try_emplace(value.first, value.second);
+    }
+  }
+
+  FlatStringMap(const FlatStringMap& other) : Base{} {
+    this->reserve(other.size());
+    for (auto&& value : other) {
+      try_emplace(value.first, value.second);
+    }
+  }
+
+  FlatStringMap(FlatStringMap&& other) noexcept = default;
+
+  FlatStringMap& operator=(const FlatStringMap& other) {
+    if (this != &other) {
+      FlatStringMap tmp{other};
+      swap(tmp);
+    }
+    return *this;
+  }
+
+  FlatStringMap& operator=(FlatStringMap&& other) noexcept {
+    if (this != &other) {
+      DeleteAll();
+      Base::operator=(std::move(other));
+      m_arena = std::move(other.m_arena);
+    }
+    return *this;
+  }
+
+  ~FlatStringMap() { DeleteAll(); }
+
+  iterator begin() { return this->BeginImpl(); }
+  const_iterator begin() const { return this->BeginImpl(); }
+  const_iterator cbegin() const { return this->BeginImpl(); }
+  iterator end() { return this->EndImpl(); }
+  const_iterator end() const { return this->EndImpl(); }
+  const_iterator cend() const { return this->EndImpl(); }
+
+  iterator find(std::string_view key) {
+    return this->IteratorAt(this->FindIndex(key));
+  }
+
+  const_iterator find(std::string_view key) const {
+    return this->IteratorAt(this->FindIndex(key));
+  }
+
+  bool contains(std::string_view key) const {
+    return this->FindIndex(key) != this->capacity();
+  }
+
+  size_t count(std::string_view key) const { return contains(key) ? 1 : 0; }
+
+  T& at(std::string_view key) {
+    size_t idx = this->FindIndex(key);
+    if (idx == this->capacity()) {
+      throw std::out_of_range("FlatStringMap::at");
+    }
+    return this->IteratorAt(idx)->second;
+  }
+
+  const T& at(std::string_view key) const {
+    size_t idx = this->FindIndex(key);
+    if (idx == this->capacity()) {
+      throw std::out_of_range("FlatStringMap::at");
+    }
+    return this->IteratorAt(idx)->second;
+  }
+
+  /**
+   * Inserts a value-initialized element if key is not present.
+   */
+  T& operator[](std::string_view key) { return try_emplace(key).first->second; }
+
+  /**
+   * Inserts an element constructed from args if key is not present.  Args
+   * are not used if the key is present.
+   */
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(std::string_view key, Args&&... args) {
+    size_t hash = this->HashKey(key);
+    size_t idx = this->FindIndex(key, hash);
+    if (idx != this->capacity()) {
+      return {this->IteratorAt(idx), false};
+    }
+    // create the element first, so nothing needs undoing if that throws
+    value_type* element = m_arena.New(key, std::forward<Args>(args)...);
+    try {
+      idx = this->PrepareInsert(hash);
+    } catch (...) {
+      m_arena.Delete(element);
+      throw;
+    }
+    this->ConstructAt(idx, element);
+    return {this->IteratorAt(idx), true};
+  }
+
+  template <typename V>
+  std::pair<iterator, bool> insert_or_assign(std::string_view key, V&& value) {
+    auto rv = try_emplace(key, std::forward<V>(value));
+    if (!rv.second) {
+      rv.first->second = std::forward<V>(value);
+    }
+    return rv;
+  }
+
+  size_t erase(std::string_view key) {
+    size_t idx = this->FindIndex(key);
+    if (idx == this->capacity()) {
+      return 0;
+    }
+    erase(this->IteratorAt(idx));
+    return 1;
+  }
+
+  /**
+   * Erases the element at pos.
+   * @return iterator to the next element
+   */
+  iterator erase(const_iterator pos) {
+    size_t idx = this->IndexOf(pos);
+    m_arena.Delete(const_cast<value_type*>(&*pos));
+    this->EraseAt(idx);
+    auto it = this->IteratorAt(idx);
+    ++it;
+    return it;
+  }
+
+  iterator erase(iterator pos) { return erase(const_iterator{pos}); }
+
+  /**
+   * Removes all elements.  Allocated storage is kept.
+   */
+  void clear() {
+    DeleteAll();
+    Base::clear();
+  }
+
+  void swap(FlatStringMap& other) noexcept {
+    Base::swap(other);
+    m_arena.swap(other.m_arena);
+  }
+
+ private:
+  void DeleteAll() {
+    for (auto&& element : *this) {
+      m_arena.Delete(&element);
+    }
+  }
+
+  detail::FlatHashNodeArena<value_type> m_arena;
+};
+
+}  // namespace wpi
+
+#endif  // WPIUTIL_WPI_FLATHASHMAP_H_
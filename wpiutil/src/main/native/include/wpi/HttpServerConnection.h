@@ -6,6 +6,7 @@
 #define WPIUTIL_WPI_HTTPSERVERCONNECTION_H_
 
 #include <memory>
+#include <string>
 #include <string_view>
 
 #include "wpi/HttpParser.h"
@@ -51,6 +52,24 @@ class HttpServerConnection {
    */
   virtual void BuildCommonHeaders(raw_ostream& os);
 
+  /**
+   * Build common response headers for cacheable responses.
+   *
+   * Called by BuildHeader() instead of BuildCommonHeaders() for responses that
+   * include an ETag (e.g. from SendFileResponse()).  Each line must be
+   * terminated with \r\n.
+   *
+   * The default implementation sends the following:
+   * "Server: WebServer/1.0\r\n"
+   * "Cache-Control: no-cache\r\n"
+   *
+   * This allows the browser to store the response, but requires it to
+   * revalidate with If-None-Match before each use.
+   *
+   * @param os response stream
+   */
+  virtual void BuildRevalidateHeaders(raw_ostream& os);
+
   /**
    * Build HTTP response header, along with other header information like
    * mimetype.  Calls BuildCommonHeaders().
@@ -60,7 +79,8 @@ class HttpServerConnection {
    * @param codeText HTTP response code text (e.g. "OK")
    * @param contentType MIME content type (e.g. "text/plain")
    * @param contentLength Length of content.  If 0 is provided, m_keepAlive will
-   *                      be set to false.
+   *                      be set to false (unless code is 204 or 304, which
+   *                      never have content).
    * @param extra Extra HTTP headers to send, including final "\r\n"
    */
   virtual void BuildHeader(raw_ostream& os, int code, std::string_view codeText,
@@ -114,6 +134,31 @@ class HttpServerConnection {
                                   std::string_view content, bool gzipped,
                                   std::string_view extraHeader = {});
 
+  /**
+   * Send HTTP response from a file, along with other header information like
+   * mimetype.  Calls BuildHeader().
+   *
+   * An ETag is generated from the file size and modification time.  If it
+   * matches the request If-None-Match header, a 304 Not Modified response is
+   * sent instead of the file contents.
+   *
+   * The file contents are read in chunks on the libuv thread pool, and each
+   * chunk is read only once the previous one has been written to the client,
+   * so memory use is bounded and a slow client doesn't hold up the thread
+   * pool.  Any pipelined requests are not processed until the file has been
+   * sent.  If the file cannot be opened, a 404 error is sent.
+   *
+   * @param code HTTP response code (e.g. 200)
+   * @param codeText HTTP response code text (e.g. "OK")
+   * @param contentType MIME content type (e.g. "text/plain")
+   * @param filename Path of file to send
+   * @param extraHeader Extra HTTP headers to send, including final "\r\n"
+   */
+  virtual void SendFileResponse(int code, std::string_view codeText,
+                                std::string_view contentType,
+                                std::string_view filename,
+                                std::string_view extraHeader = {});
+
   /**
    * Send error header and message.
    * This provides standard code responses for 400, 401, 403, 404, 500, and 503.
@@ -134,6 +179,9 @@ class HttpServerConnection {
   /** If gzip is an acceptable encoding for responses. */
   bool m_acceptGzip = false;
 
+  /** The If-None-Match request header value (empty if not present). */
+  std::string m_ifNoneMatch;
+
   /** The underlying stream for the connection. */
   uv::Stream& m_stream;
 
@@ -145,6 +193,19 @@ class HttpServerConnection {
 
   /** The message complete connection. */
   sig::Connection m_messageCompleteConn;
+
+ private:
+  void ExecuteRequest(std::string_view in);
+  void FinishFileResponse(bool closeAfter);
+
+  // use BuildRevalidateHeaders() in BuildHeader()
+  bool m_revalidate = false;
+
+  // file response in progress; request parsing is paused
+  bool m_sendingFile = false;
+
+  // pipelined request data received while a file response is in progress
+  std::string m_pendingInput;
 };
 
 }  // namespace wpi
@@ -0,0 +1,81 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#ifndef WPIUTIL_WPI_MAPPEDFILEREGION_H_
+#define WPIUTIL_WPI_MAPPEDFILEREGION_H_
+
+#include <stdint.h>
+
+#include <cstddef>
+#include <system_error>
+
+#include "wpi/fs.h"
+
+namespace wpi {
+
+/**
+ * A read-only memory mapping of a region of a file.
+ *
+ * The mapping stays valid after the file handle it was created from is
+ * closed, and is unmapped when this object is destroyed.
+ */
+class MappedFileRegion {
+ public:
+  MappedFileRegion() = default;
+
+  /**
+   * Maps a region of an open file into memory.
+   *
+   * @param f      The file to map.
+   * @param length The number of bytes to map.
+   * @param offset The offset of the region in the file; must be a multiple of
+   *               GetAlignment().
+   * @param ec     Error code output, set to non-zero on error.
+   */
+  MappedFileRegion(fs::file_t f, uint64_t length, uint64_t offset,
+                   std::error_code& ec);
+
+  ~MappedFileRegion() { Unmap(); }
+
+  MappedFileRegion(const MappedFileRegion&) = delete;
+  MappedFileRegion& operator=(const MappedFileRegion&) = delete;
+
+  MappedFileRegion(MappedFileRegion&& rhs)
+      : m_size(rhs.m_size), m_mapping(rhs.m_mapping) {
+    rhs.m_size = 0;
+    rhs.m_mapping = nullptr;
+  }
+
+  MappedFileRegion& operator=(MappedFileRegion&& rhs) {
+    Unmap();
+    m_size = rhs.m_size;
+    m_mapping = rhs.m_mapping;
+    rhs.m_size = 0;
+    rhs.m_mapping = nullptr;
+    return *this;
+  }
+
+  explicit operator bool() const { return m_mapping != nullptr; }
+
+  size_t size() const { return m_size; }
+  const uint8_t* data() const { return static_cast<const uint8_t*>(m_mapping); }
+
+  /**
+   * Unmaps the region. Does nothing if nothing is mapped.
+   */
+  void Unmap();
+
+  /**
+   * Returns the required alignment of the offset passed to the constructor.
+   */
+  static size_t GetAlignment();
+
+ private:
+  size_t m_size = 0;
+  void* m_mapping = nullptr;
+};
+
+}  // namespace wpi
+
+#endif  // WPIUTIL_WPI_MAPPEDFILEREGION_H_
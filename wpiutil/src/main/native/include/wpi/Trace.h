@@ -0,0 +1,113 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#ifndef WPIUTIL_WPI_TRACE_H_
+#define WPIUTIL_WPI_TRACE_H_
+
+#include <stdint.h>
+
+#include <cstddef>
+#include <string_view>
+
+namespace wpi {
+
+class raw_ostream;
+
+namespace trace {
+
+/**
+ * Enable or disable recording of trace zones.  Disabled by default.
+ * @param enabled True to enable recording
+ */
+void SetEnabled(bool enabled);
+
+/**
+ * Return true if recording of trace zones is enabled.
+ */
+bool IsEnabled();
+
+/**
+ * Return the current time in nanoseconds from the monotonic clock used for
+ * trace timestamps.
+ *
+ * Note this is not wpi::Now(), which only has microsecond resolution and may
+ * be replaced by simulation time.
+ */
+uint64_t NowNs();
+
+/**
+ * Record a completed zone for the calling thread.  Normally this is called
+ * by Scope rather than directly.
+ *
+ * Each thread records into its own fixed-size ring buffer; when the buffer is
+ * full the oldest zones are overwritten.
+ *
+ * @param name Zone name; must have static storage duration (it is not copied)
+ * @param startNs Start time (from NowNs())
+ * @param endNs End time (from NowNs())
+ */
+void Record(const char* name, uint64_t startNs, uint64_t endNs);
+
+/**
+ * Set the name of the calling thread as shown in exported traces.
+ * @param name Thread name
+ */
+void SetThreadName(std::string_view name);
+
+/**
+ * Discard all recorded zones.
+ */
+void Clear();
+
+/**
+ * Write all recorded zones of all threads in Chrome trace event JSON format.
+ * The output can be loaded into chrome://tracing or Perfetto.
+ * @param os Output stream
+ */
+void WriteChromeTrace(raw_ostream& os);
+
+/**
+ * RAII trace zone.  Records the time between construction and destruction
+ * if tracing is enabled at construction.  Normally used via the
+ * WPI_TRACE_SCOPE() macro.
+ */
+class Scope {
+ public:
+  template <size_t N>
+  explicit Scope(const char (&name)[N])
+      : m_name{name}, m_start{IsEnabled() ? NowNs() : 0} {}
+
+  ~Scope() {
+    if (m_start != 0) {
+      Record(m_name, m_start, NowNs());
+    }
+  }
+
+  Scope(const Scope&) = delete;
+  Scope& operator=(const Scope&) = delete;
+
+ private:
+  const char* m_name;
+  uint64_t m_start;
+};
+
+}  // namespace trace
+}  // namespace wpi
+
+#define WPI_TRACE_CONCAT_IMPL(a, b) a##b
+#define WPI_TRACE_CONCAT(a, b) WPI_TRACE_CONCAT_IMPL(a, b)
+
+/**
+ * Records a trace zone covering the rest of the enclosing scope.  The name
+ * must be a string literal.  Define WPI_DISABLE_TRACING to compile out all
+ * zones.
+ */
+#ifdef WPI_DISABLE_TRACING
+#define WPI_TRACE_SCOPE(name)
+#else
+#define WPI_TRACE_SCOPE(name) \
+  ::wpi::trace::Scope WPI_TRACE_CONCAT(wpiTraceScope, __LINE__) { name }
+#endif
+
+#endif  // WPIUTIL_WPI_TRACE_H_
@@ -168,6 +168,19 @@ class WebSocket : public std::enable_shared_from_this<WebSocket> {
    */
   void SetCombineFragments(bool combine) { m_combineFragments = combine; }
 
+  /**
+   * Set whether or not incoming data frames should be streamed.  Default is
+   * to not stream.  When streaming, the text and binary callbacks are called
+   * with each piece of frame payload as soon as it is received, without
+   * buffering the complete frame or message, and fragments are never
+   * combined.  The second parameter (fin) of the callback is set to true only
+   * for the last piece of the final fragment of a message.  The maximum
+   * message size does not apply to streamed frames.  Note that text data may
+   * be split in the middle of a UTF-8 sequence.
+   * @param stream True if incoming data frames should be streamed.
+   */
+  void SetStreamFrames(bool stream) { m_streamFrames = stream; }
+
   /**
    * Initiate a closing handshake.
    * @param code A numeric status code (defaults to 1005, no status code)
@@ -439,6 +452,7 @@ class WebSocket : public std::enable_shared_from_this<WebSocket> {
   // user-settable configuration
   size_t m_maxMessageSize = 128 * 1024;
   bool m_combineFragments = true;
+  bool m_streamFrames = false;
 
   // operating state
   State m_state = CONNECTING;
@@ -449,6 +463,8 @@ class WebSocket : public std::enable_shared_from_this<WebSocket> {
   SmallVector<uint8_t, 1024> m_payload;
   size_t m_frameStart = 0;
   uint64_t m_frameSize = UINT64_MAX;
+  uint64_t m_framePos = 0;
+  bool m_frameStreamed = false;
   uint8_t m_fragmentOpcode = 0;
 
   // temporary data used only during client handshake
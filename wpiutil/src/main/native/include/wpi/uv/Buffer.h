@@ -19,6 +19,11 @@ namespace wpi::uv {
 
 /**
  * Data buffer.  Convenience wrapper around uv_buf_t.
+ *
+ * A Buffer does not own its memory.  Deallocate() may only be called on a
+ * buffer returned by Allocate() or Dup(), or one whose base was allocated
+ * with new char[].  Buffers that reference other memory (e.g. constructed
+ * from a string_view) must not be deallocated.
  */
 class Buffer : public uv_buf_t {
  public:
@@ -49,7 +54,12 @@ class Buffer : public uv_buf_t {
   operator span<const char>() const { return data(); }  // NOLINT
   operator span<char>() { return data(); }              // NOLINT
 
-  static Buffer Allocate(size_t size) { return Buffer{new char[size], size}; }
+  /**
+   * Allocate a buffer.  Memory is obtained from the shared BufferPool, which
+   * may reuse a previously deallocated block.  Free it with Deallocate().
+   * @param size Size in bytes
+   */
+  static Buffer Allocate(size_t size);
 
   static Buffer Dup(std::string_view in) {
     Buffer buf = Allocate(in.size());
@@ -69,11 +79,12 @@ class Buffer : public uv_buf_t {
     return buf;
   }
 
-  void Deallocate() {
-    delete[] base;
-    base = nullptr;
-    len = 0;
-  }
+  /**
+   * Free the buffer and reset it to empty.  The memory is returned to the
+   * shared BufferPool for reuse.  See the class documentation for which
+   * buffers may be deallocated.
+   */
+  void Deallocate();
 
   Buffer Move() {
     Buffer buf = *this;
@@ -0,0 +1,146 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#ifndef WPIUTIL_WPI_UV_BUFFERPOOL_H_
+#define WPIUTIL_WPI_UV_BUFFERPOOL_H_
+
+#include <stdint.h>
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+#include "wpi/DenseMap.h"
+#include "wpi/mutex.h"
+#include "wpi/uv/Buffer.h"
+
+namespace wpi::uv {
+
+struct BufferPoolThreadCache;
+
+/**
+ * Thread-safe, size-classed pool allocator backing Buffer::Allocate() and
+ * Buffer::Deallocate().
+ *
+ * Requests are rounded up to a power-of-two size class between 64 bytes and
+ * 64 KB; larger requests go directly to the heap.  Released buffers are
+ * first kept in a small per-thread cache and then in a global free list, so
+ * a buffer allocated on one thread may be released on any other thread.
+ *
+ * Pooled blocks are carved from aligned slabs that are never returned to
+ * the heap, so the pool holds on to its peak usage.  Release() recognizes
+ * pooled blocks by their slab without reading any memory around the block,
+ * and frees any other buffer with delete[].  This keeps Deallocate() valid
+ * for buffers that were allocated with new char[] outside the pool.
+ *
+ * Statistics are counted per thread, so the allocation fast path doesn't
+ * touch any shared cache lines; GetStats() sums the counters of all threads.
+ */
+class BufferPool {
+ public:
+  /**
+   * Pool statistics.
+   */
+  struct Stats {
+    /** Number of allocations satisfied by reusing a released block. */
+    uint64_t hits;
+    /** Number of allocations that required a new block. */
+    uint64_t misses;
+    /** Number of released blocks kept for reuse. */
+    uint64_t pooled;
+    /** Number of released buffers returned to the heap. */
+    uint64_t freed;
+    /** Number of buffers allocated but not yet released. */
+    uint64_t outstandingBuffers;
+    /** Total capacity (in bytes) of buffers allocated but not released. */
+    uint64_t outstandingBytes;
+  };
+
+  /** Smallest size class, in bytes. */
+  static constexpr size_t kMinSize = 64;
+
+  /** Largest size class, in bytes. */
+  static constexpr size_t kMaxSize = 64 * 1024;
+
+  /** Number of size classes. */
+  static constexpr size_t kNumClasses = 11;
+
+  /** Size (and alignment) of the slabs that blocks are carved from. */
+  static constexpr size_t kSlabSize = 128 * 1024;
+
+  /**
+   * Get the global pool instance.
+   */
+  static BufferPool& GetInstance();
+
+  BufferPool(const BufferPool&) = delete;
+  BufferPool& operator=(const BufferPool&) = delete;
+
+  /**
+   * Allocate a buffer.  The returned buffer has len set to size.
+   * @param size Size in bytes
+   */
+  Buffer Allocate(size_t size);
+
+  /**
+   * Release a buffer.  Blocks from Allocate() are kept for reuse; any other
+   * buffer must have been allocated with new char[] and is freed with
+   * delete[].  The buffer's len may have been changed since allocation.
+   * Sets the buffer's base to nullptr and len to 0.
+   * @param buf Buffer
+   */
+  void Release(Buffer& buf);
+
+  /**
+   * Get pool statistics.
+   */
+  Stats GetStats() const;
+
+  /**
+   * Move the blocks in the calling thread's cache to the global free lists,
+   * making them available to other threads.
+   */
+  void FlushThreadCache();
+
+ private:
+  BufferPool() = default;
+
+  static constexpr size_t kMaxSlabs = 1024;
+  static constexpr size_t kSlabTableSize = kMaxSlabs * 2;
+
+  friend struct BufferPoolThreadCache;
+
+  char* AllocateBlock(size_t sizeClass, bool* reused);
+  void ReleaseBlock(char* block, size_t sizeClass);
+  char* AllocateLarge(size_t size);
+  size_t ReleaseLarge(char* block);
+  void InsertSlab(uintptr_t slab, size_t sizeClass);
+  int FindSizeClass(const char* block) const;
+
+  struct Carve {
+    char* next = nullptr;
+    char* end = nullptr;
+  };
+
+  mutable wpi::mutex m_mutex;
+  std::vector<char*> m_free[kNumClasses];
+  Carve m_carve[kNumClasses];
+  size_t m_numSlabs = 0;
+
+  // open-addressed table of slabs, written under m_mutex and read lock-free
+  std::atomic<uintptr_t> m_slabs[kSlabTableSize] = {};
+
+  // capacity of blocks allocated outside the slabs, so releasing them can be
+  // told apart from releasing foreign buffers
+  wpi::mutex m_largeMutex;
+  wpi::DenseMap<char*, size_t> m_large;
+
+  // counters of live threads, and the totals of threads that have exited
+  std::vector<BufferPoolThreadCache*> m_caches;
+  Stats m_retired{};
+};
+
+}  // namespace wpi::uv
+
+#endif  // WPIUTIL_WPI_UV_BUFFERPOOL_H_
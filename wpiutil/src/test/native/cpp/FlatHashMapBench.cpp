@@ -0,0 +1,160 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "wpi/DenseMap.h"
+#include "wpi/FlatHashMap.h"
+#include "wpi/StringMap.h"
+
+using std::chrono::duration_cast;
+using std::chrono::high_resolution_clock;
+using std::chrono::nanoseconds;
+
+static constexpr int kLookupRounds = 100;
+
+template <typename F>
+static double TimeNs(F&& func) {
+  auto start = high_resolution_clock::now();
+  func();
+  auto stop = high_resolution_clock::now();
+  return duration_cast<nanoseconds>(stop - start).count();
+}
+
+// Keeps the optimizer from discarding benchmark results
+static volatile size_t gSink;
+
+template <typename Map, typename Insert, typename Lookup, typename Iterate,
+          typename Keys>
+static void BenchMap(const char* name, const Keys& keys, Insert&& insert,
+                     Lookup&& lookup, Iterate&& iterate) {
+  Map map;
+  double insertNs = TimeNs([&] {
+    for (auto&& key : keys) {
+      insert(map, key);
+    }
+  });
+  size_t sum = 0;
+  double lookupNs = TimeNs([&] {
+    for (int i = 0; i < kLookupRounds; ++i) {
+      for (auto&& key : keys) {
+        sum += lookup(map, key);
+      }
+    }
+  });
+  double iterateNs = TimeNs([&] {
+    for (int i = 0; i < kLookupRounds; ++i) {
+      sum += iterate(map);
+    }
+  });
+  gSink = sum;
+  std::cout << name << " size: " << keys.size()
+            << " insert: " << insertNs / keys.size()
+            << " ns lookup: " << lookupNs / (kLookupRounds * keys.size())
+            << " ns iterate: " << iterateNs / (kLookupRounds * keys.size())
+            << " ns\n";
+}
+
+// Disabled by default as it only reports timings; run with
+// --gtest_also_run_disabled_tests --gtest_filter='*Benchmark*'
+TEST(FlatHashMapBenchmark, DISABLED_StringKeys) {
+  for (int size : {16, 256, 4096}) {
+    // ntcore-like keys
+    std::vector<std::string> keys;
+    for (int i = 0; i < size; ++i) {
+      keys.emplace_back("/SmartDashboard/Subsystem" + std::to_string(i % 16) +
+                        "/value" + std::to_string(i));
+    }
+    std::vector<std::string_view> views{keys.begin(), keys.end()};
+
+    BenchMap<wpi::StringMap<int>>(
+        "StringMap    ", views,
+        [](auto& map, std::string_view key) { map[key] = 1; },
+        [](auto& map, std::string_view key) {
+          return map.find(key)->second;
+        },
+        [](auto& map) {
+          size_t sum = 0;
+          for (auto&& kv : map) {
+            sum += kv.second;
+          }
+          return sum;
+        });
+    BenchMap<std::unordered_map<std::string, int>>(
+        "unordered_map", keys,
+        [](auto& map, const std::string& key) { map[key] = 1; },
+        [](auto& map, const std::string& key) {
+          return map.find(key)->second;
+        },
+        [](auto& map) {
+          size_t sum = 0;
+          for (auto&& kv : map) {
+            sum += kv.second;
+          }
+          return sum;
+        });
+    BenchMap<wpi::FlatHashMap<std::string, int>>(
+        "FlatHashMap  ", views,
+        [](auto& map, std::string_view key) { map[key] = 1; },
+        [](auto& map, std::string_view key) {
+          return map.find(key)->second;
+        },
+        [](auto& map) {
+          size_t sum = 0;
+          for (auto&& kv : map) {
+            sum += kv.second;
+          }
+          return sum;
+        });
+    BenchMap<wpi::FlatStringMap<int>>(
+        "FlatStringMap", views,
+        [](auto& map, std::string_view key) { map[key] = 1; },
+        [](auto& map, std::string_view key) {
+          return map.find(key)->second;
+        },
+        [](auto& map) {
+          size_t sum = 0;
+          for (auto&& kv : map) {
+            sum += kv.second;
+          }
+          return sum;
+        });
+  }
+}
+
+// Disabled by default as it only reports timings; run with
+// --gtest_also_run_disabled_tests --gtest_filter='*Benchmark*'
+TEST(FlatHashMapBenchmark, DISABLED_PointerKeys) {
+  for (int size : {16, 256, 4096}) {
+    std::vector<std::unique_ptr<int>> objects;
+    std::vector<int*> keys;
+    for (int i = 0; i < size; ++i) {
+      objects.emplace_back(std::make_unique<int>(i));
+      keys.emplace_back(objects.back().get());
+    }
+
+    auto insert = [](auto& map, int* key) { map[key] = *key; };
+    auto lookup = [](auto& map, int* key) { return map.find(key)->second; };
+    auto iterate = [](auto& map) {
+      size_t sum = 0;
+      for (auto&& kv : map) {
+        sum += kv.second;
+      }
+      return sum;
+    };
+    BenchMap<wpi::DenseMap<int*, int>>("DenseMap     ", keys, insert, lookup,
+                                       iterate);
+    BenchMap<std::unordered_map<int*, int>>("unordered_map", keys, insert,
+                                            lookup, iterate);
+    BenchMap<wpi::FlatHashMap<int*, int>>("FlatHashMap  ", keys, insert,
+                                          lookup, iterate);
+  }
+}
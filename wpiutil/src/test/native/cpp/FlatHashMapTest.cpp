@@ -0,0 +1,248 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/FlatHashMap.h"  // NOLINT(build/include_order)
+
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "gtest/gtest.h"
+
+namespace wpi {
+
+TEST(FlatHashMapTest, Empty) {
+  FlatHashMap<int, int> map;
+  ASSERT_TRUE(map.empty());
+  ASSERT_EQ(map.size(), 0u);
+  ASSERT_EQ(map.begin(), map.end());
+  ASSERT_EQ(map.find(1), map.end());
+  ASSERT_FALSE(map.contains(1));
+  ASSERT_EQ(map.erase(1), 0u);
+}
+
+TEST(FlatHashMapTest, InsertFind) {
+  FlatHashMap<int, int> map;
+  for (int i = 0; i < 1000; ++i) {
+    auto [it, inserted] = map.try_emplace(i, i * 2);
+    ASSERT_TRUE(inserted);
+    ASSERT_EQ(it->first, i);
+  }
+  ASSERT_EQ(map.size(), 1000u);
+  for (int i = 0; i < 1000; ++i) {
+    auto it = map.find(i);
+    ASSERT_NE(it, map.end());
+    ASSERT_EQ(it->second, i * 2);
+  }
+  ASSERT_FALSE(map.try_emplace(5, 0).second);
+  ASSERT_EQ(map[5], 10);
+  ASSERT_EQ(map.at(5), 10);
+  ASSERT_THROW(map.at(1000), std::out_of_range);
+  ASSERT_EQ(map[1000], 0);
+  ASSERT_EQ(map.size(), 1001u);
+}
+
+TEST(FlatHashMapTest, StringKeys) {
+  FlatHashMap<std::string, int> map;
+  map["foo"] = 1;
+  map[std::string_view{"bar"}] = 2;
+  map.insert_or_assign("a long key that does not fit in SSO", 3);
+  ASSERT_EQ(map.size(), 3u);
+
+  // heterogeneous lookup
+  ASSERT_EQ(map.find(std::string_view{"foo"})->second, 1);
+  ASSERT_EQ(map.count("bar"), 1u);
+  ASSERT_TRUE(map.contains("a long key that does not fit in SSO"));
+  ASSERT_FALSE(map.contains(std::string_view{"baz"}));
+  ASSERT_EQ(map.erase(std::string_view{"foo"}), 1u);
+  ASSERT_FALSE(map.contains("foo"));
+}
+
+TEST(FlatHashMapTest, EraseWhileIterating) {
+  FlatHashMap<int, int> map;
+  for (int i = 0; i < 100; ++i) {
+    map[i] = i;
+  }
+  for (auto it = map.begin(); it != map.end();) {
+    if (it->first % 2 == 0) {
+      it = map.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  ASSERT_EQ(map.size(), 50u);
+  int count = 0;
+  for (auto&& [key, value] : map) {
+    ASSERT_EQ(key % 2, 1);
+    ASSERT_EQ(key, value);
+    ++count;
+  }
+  ASSERT_EQ(count, 50);
+}
+
+TEST(FlatHashMapTest, Tombstones) {
+  // repeated insert/erase must not grow without bound
+  FlatHashMap<int, int> map;
+  for (int i = 0; i < 100000; ++i) {
+    map[i] = i;
+    if (i >= 10) {
+      ASSERT_EQ(map.erase(i - 10), 1u);
+    }
+  }
+  ASSERT_EQ(map.size(), 10u);
+  ASSERT_LE(map.capacity(), 64u);
+  for (int i = 99990; i < 100000; ++i) {
+    ASSERT_TRUE(map.contains(i));
+  }
+}
+
+TEST(FlatHashMapTest, NonTrivialValues) {
+  FlatHashMap<std::string, std::unique_ptr<int>> map;
+  for (int i = 0; i < 100; ++i) {
+    map.try_emplace(std::to_string(i), std::make_unique<int>(i));
+  }
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_EQ(*map[std::to_string(i)], i);
+  }
+  auto moved = std::move(map);
+  ASSERT_TRUE(map.empty());  // NOLINT
+  ASSERT_EQ(moved.size(), 100u);
+  moved.clear();
+  ASSERT_TRUE(moved.empty());
+  ASSERT_EQ(moved.begin(), moved.end());
+}
+
+TEST(FlatHashMapTest, Copy) {
+  FlatHashMap<std::string, int> map{{"a", 1}, {"b", 2}};
+  auto copy = map;
+  copy["c"] = 3;
+  ASSERT_EQ(map.size(), 2u);
+  ASSERT_EQ(copy.size(), 3u);
+  ASSERT_EQ(copy["a"], 1);
+  map = copy;
+  ASSERT_EQ(map.size(), 3u);
+}
+
+TEST(FlatHashMapTest, Random) {
+  FlatHashMap<uint32_t, uint32_t> map;
+  std::unordered_map<uint32_t, uint32_t> ref;
+  std::mt19937 gen{1234};
+  std::uniform_int_distribution<uint32_t> keyDist{0, 2000};
+  for (int i = 0; i < 100000; ++i) {
+    uint32_t key = keyDist(gen);
+    switch (gen() % 3) {
+      case 0:
+        map[key] = i;
+        ref[key] = i;
+        break;
+      case 1:
+        ASSERT_EQ(map.erase(key), ref.erase(key));
+        break;
+      default: {
+        auto it = map.find(key);
+        auto refIt = ref.find(key);
+        ASSERT_EQ(it == map.end(), refIt == ref.end());
+        if (it != map.end()) {
+          ASSERT_EQ(it->second, refIt->second);
+        }
+        break;
+      }
+    }
+  }
+  ASSERT_EQ(map.size(), ref.size());
+  size_t count = 0;
+  for (auto&& [key, value] : map) {
+    ASSERT_EQ(ref.at(key), value);
+    ++count;
+  }
+  ASSERT_EQ(count, ref.size());
+}
+
+TEST(FlatHashSetTest, Basic) {
+  FlatHashSet<std::string> set{"a", "b"};
+  ASSERT_TRUE(set.insert("c").second);
+  ASSERT_FALSE(set.insert(std::string{"a"}).second);
+  ASSERT_EQ(set.size(), 3u);
+  ASSERT_TRUE(set.contains(std::string_view{"b"}));
+  ASSERT_EQ(set.erase("b"), 1u);
+  ASSERT_FALSE(set.contains("b"));
+
+  FlatHashSet<int*> ptrs;
+  int a, b;
+  ptrs.insert(&a);
+  ptrs.emplace(&b);
+  ASSERT_EQ(ptrs.count(&a), 1u);
+  ASSERT_EQ(ptrs.size(), 2u);
+}
+
+TEST(FlatStringMapTest, StableReferences) {
+  FlatStringMap<int> map;
+  auto& first = map["first"];
+  std::string_view key = map.find("first")->first;
+  first = 1;
+  for (int i = 0; i < 1000; ++i) {
+    map[std::to_string(i)] = i;
+  }
+  // still valid after many rehashes
+  ASSERT_EQ(&map["first"], &first);
+  ASSERT_EQ(map.find("first")->first.data(), key.data());
+  ASSERT_EQ(first, 1);
+  ASSERT_EQ(map.size(), 1001u);
+}
+
+TEST(FlatStringMapTest, InlineKeys) {
+  FlatStringMap<int, 8> map;
+  auto& shortKey = *map.try_emplace("short", 1).first;
+  auto& longKey = *map.try_emplace("a key longer than inline", 2).first;
+  auto inNode = [](auto& element, std::string_view key) {
+    auto begin = reinterpret_cast<const char*>(&element);
+    return key.data() >= begin && key.data() < begin + sizeof(element);
+  };
+  ASSERT_TRUE(inNode(shortKey, shortKey.first));
+  ASSERT_FALSE(inNode(longKey, longKey.first));
+  ASSERT_EQ(map.find("a key longer than inline")->second, 2);
+}
+
+TEST(FlatStringMapTest, EraseReuse) {
+  FlatStringMap<std::unique_ptr<int>> map;
+  auto* element = &*map.try_emplace("a", std::make_unique<int>(1)).first;
+  ASSERT_EQ(map.erase("a"), 1u);
+  ASSERT_FALSE(map.contains("a"));
+  // freed nodes are reused
+  ASSERT_EQ(&*map.try_emplace("b", std::make_unique<int>(2)).first, element);
+
+  for (int i = 0; i < 100; ++i) {
+    map.try_emplace(std::to_string(i), std::make_unique<int>(i));
+  }
+  for (auto it = map.begin(); it != map.end();) {
+    if (*it->second % 2 == 0) {
+      it = map.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  ASSERT_EQ(map.size(), 50u);
+  ASSERT_EQ(*map.at("51"), 51);
+
+  FlatStringMap<std::unique_ptr<int>> moved{std::move(map)};
+  ASSERT_EQ(moved.size(), 50u);
+  ASSERT_TRUE(map.empty());  // NOLINT(bugprone-use-after-move)
+  moved.clear();
+  ASSERT_TRUE(moved.empty());
+}
+
+TEST(FlatStringMapTest, Copy) {
+  FlatStringMap<int> map{{"a", 1}, {"b", 2}};
+  FlatStringMap<int> copy{map};
+  copy["a"] = 3;
+  ASSERT_EQ(map.at("a"), 1);
+  ASSERT_EQ(copy.at("a"), 3);
+  ASSERT_EQ(copy.at("b"), 2);
+  map = copy;
+  ASSERT_EQ(map.at("a"), 3);
+}
+
+}  // namespace wpi
@@ -0,0 +1,247 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/HttpServerConnection.h"  // NOLINT(build/include_order)
+
+#include <chrono>
+#include <ctime>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "wpi/HttpParser.h"
+#include "wpi/fs.h"
+#include "wpi/raw_ostream.h"
+#include "wpi/uv/BufferPool.h"
+#include "wpi/uv/Loop.h"
+#include "wpi/uv/Pipe.h"
+#include "wpi/uv/Timer.h"
+
+namespace wpi {
+
+#ifdef _WIN32
+static const char* pipeName = "\\\\.\\pipe\\http-server-unit-test";
+#else
+static const char* pipeName = "/tmp/http-server-unit-test";
+#endif
+
+namespace {
+class TestConnection : public HttpServerConnection {
+ public:
+  TestConnection(std::shared_ptr<uv::Stream> stream, std::string filename)
+      : HttpServerConnection{stream}, m_filename{std::move(filename)} {}
+
+  void ProcessRequest() override {
+    if (m_request.GetUrl() == "/file") {
+      SendFileResponse(200, "OK", "application/octet-stream", m_filename);
+    } else if (m_request.GetUrl() == "/missing") {
+      SendFileResponse(200, "OK", "application/octet-stream",
+                       m_filename + ".missing");
+    } else {
+      SendResponse(200, "OK", "text/plain", "text");
+    }
+  }
+
+ private:
+  std::string m_filename;
+};
+
+struct Response {
+  unsigned int code = 0;
+  std::string etag;
+  std::string body;
+};
+}  // namespace
+
+class HttpServerConnectionTest : public ::testing::Test {
+ public:
+  static void SetUpTestCase() {
+#ifndef _WIN32
+    fs::remove(pipeName);
+#endif
+  }
+
+  HttpServerConnectionTest() {
+    filename =
+        (fs::temp_directory_path() / "http-server-unit-test.bin").string();
+    for (int i = 0; i < 1024 * 1024; ++i) {
+      contents.push_back(static_cast<char>(i * 7));
+    }
+    {
+      std::error_code ec;
+      raw_fd_ostream os{filename, ec, fs::OF_None};
+      os << contents;
+    }
+
+    loop = uv::Loop::Create();
+    clientPipe = uv::Pipe::Create(loop);
+    serverPipe = uv::Pipe::Create(loop);
+    serverPipe->Bind(pipeName);
+    serverPipe->Listen([this] {
+      auto conn = serverPipe->Accept();
+      conn->SetData(std::make_shared<TestConnection>(conn, filename));
+    });
+
+    resp.messageBegin.connect([this] { responses.emplace_back(); });
+    resp.header.connect([this](std::string_view name, std::string_view value) {
+      if (name == "ETag") {
+        responses.back().etag = value;
+      }
+    });
+    resp.headersComplete.connect(
+        [this](bool) { responses.back().code = resp.GetStatusCode(); });
+    resp.body.connect([this](std::string_view data, bool) {
+      responses.back().body.append(data);
+    });
+
+    auto failTimer = uv::Timer::Create(loop);
+    failTimer->timeout.connect([this] {
+      loop->Stop();
+      FAIL() << "loop failed to terminate";
+    });
+    failTimer->Start(uv::Timer::Time{5000});
+    failTimer->Unreference();
+  }
+
+  ~HttpServerConnectionTest() override {
+    loop->Walk([](uv::Handle& it) { it.Close(); });
+    fs::remove(filename);
+  }
+
+  // sends request(s) and reads responses until the server closes
+  void Run(std::string request) {
+    clientPipe->Connect(pipeName, [this, request = std::move(request)] {
+      clientPipe->StartRead();
+      clientPipe->data.connect([this](uv::Buffer& buf, size_t size) {
+        resp.Execute({buf.base, size});
+        ASSERT_EQ(resp.GetError(), HPE_OK) << http_errno_name(resp.GetError());
+      });
+      clientPipe->end.connect(
+          [this] { loop->Walk([](uv::Handle& it) { it.Close(); }); });
+      clientPipe->Write({uv::Buffer{request}}, [](auto, uv::Error) {});
+    });
+    loop->Run();
+  }
+
+  std::string filename;
+  std::string contents;
+  std::shared_ptr<uv::Loop> loop;
+  std::shared_ptr<uv::Pipe> clientPipe;
+  std::shared_ptr<uv::Pipe> serverPipe;
+  HttpParser resp{HttpParser::kResponse};
+  std::vector<Response> responses;
+};
+
+TEST_F(HttpServerConnectionTest, Pipelined) {
+  Run("GET /file HTTP/1.1\r\nHost: x\r\n\r\n"
+      "GET /file HTTP/1.1\r\nHost: x\r\n\r\n"
+      "GET /text HTTP/1.1\r\nHost: x\r\nConnection: close\r\n\r\n");
+  ASSERT_EQ(responses.size(), 3u);
+  ASSERT_EQ(responses[0].code, 200u);
+  ASSERT_FALSE(responses[0].etag.empty());
+  ASSERT_EQ(responses[0].body, contents);
+  ASSERT_EQ(responses[1].code, 200u);
+  ASSERT_EQ(responses[1].etag, responses[0].etag);
+  ASSERT_EQ(responses[1].body, contents);
+  ASSERT_EQ(responses[2].code, 200u);
+  ASSERT_EQ(responses[2].body, "text");
+}
+
+TEST_F(HttpServerConnectionTest, NotModified) {
+  Run("GET /file HTTP/1.1\r\nHost: x\r\nConnection: close\r\n\r\n");
+  ASSERT_EQ(responses.size(), 1u);
+  std::string etag = responses[0].etag;
+  ASSERT_FALSE(etag.empty());
+
+  responses.clear();
+  resp.Reset(HttpParser::kResponse);
+  clientPipe = uv::Pipe::Create(loop);
+  serverPipe = uv::Pipe::Create(loop);
+  SetUpTestCase();
+  serverPipe->Bind(pipeName);
+  serverPipe->Listen([this] {
+    auto conn = serverPipe->Accept();
+    conn->SetData(std::make_shared<TestConnection>(conn, filename));
+  });
+  Run("GET /file HTTP/1.1\r\nHost: x\r\nIf-None-Match: W/\"other\", " + etag +
+      "\r\n\r\n"
+      "GET /text HTTP/1.1\r\nHost: x\r\nConnection: close\r\n\r\n");
+  ASSERT_EQ(responses.size(), 2u);
+  ASSERT_EQ(responses[0].code, 304u);
+  ASSERT_EQ(responses[0].etag, etag);
+  ASSERT_TRUE(responses[0].body.empty());
+  ASSERT_EQ(responses[1].body, "text");
+}
+
+TEST_F(HttpServerConnectionTest, SlowClient) {
+  // stop reading partway through the file; the transfer should wait for the
+  // client rather than fail
+  auto resumeTimer = uv::Timer::Create(loop);
+  resumeTimer->timeout.connect([this] { clientPipe->StartRead(); });
+  bool paused = false;
+  clientPipe->data.connect([&](uv::Buffer&, size_t) {
+    if (!paused) {
+      paused = true;
+      clientPipe->StopRead();
+      resumeTimer->Start(uv::Timer::Time{200});
+    }
+  });
+  Run("GET /file HTTP/1.1\r\nHost: x\r\nConnection: close\r\n\r\n");
+  ASSERT_TRUE(paused);
+  ASSERT_EQ(responses.size(), 1u);
+  ASSERT_EQ(responses[0].code, 200u);
+  ASSERT_EQ(responses[0].body, contents);
+}
+
+TEST_F(HttpServerConnectionTest, MissingFile) {
+  Run("GET /missing HTTP/1.1\r\nHost: x\r\n\r\n"
+      "GET /text HTTP/1.1\r\nHost: x\r\nConnection: close\r\n\r\n");
+  ASSERT_GE(responses.size(), 1u);
+  ASSERT_EQ(responses[0].code, 404u);
+}
+
+class HttpServerConnectionBenchmark : public HttpServerConnectionTest {};
+
+// Disabled by default as it only reports timings; run with
+// --gtest_also_run_disabled_tests --gtest_filter='*Benchmark*'
+TEST_F(HttpServerConnectionBenchmark, DISABLED_FileResponse) {
+  constexpr int kCount = 256;
+  std::string request;
+  for (int i = 1; i < kCount; ++i) {
+    request += "GET /file HTTP/1.1\r\nHost: x\r\n\r\n";
+  }
+  request += "GET /file HTTP/1.1\r\nHost: x\r\nConnection: close\r\n\r\n";
+
+  // only count the body, so the client doesn't dominate the timing
+  uint64_t bodyBytes = 0;
+  resp.body.disconnect_all();
+  resp.body.connect(
+      [&](std::string_view data, bool) { bodyBytes += data.size(); });
+
+  auto& pool = uv::BufferPool::GetInstance();
+  auto before = pool.GetStats();
+  auto start = std::chrono::steady_clock::now();
+  std::clock_t cpuStart = std::clock();
+  Run(request);
+  std::clock_t cpuStop = std::clock();
+  auto stop = std::chrono::steady_clock::now();
+  auto after = pool.GetStats();
+
+  ASSERT_EQ(responses.size(), static_cast<size_t>(kCount));
+  ASSERT_EQ(bodyBytes, kCount * contents.size());
+  auto us = std::chrono::duration_cast<std::chrono::microseconds>(stop - start)
+                .count();
+  std::cout << "file responses: " << kCount << " x " << contents.size()
+            << " bytes time: " << us << " us"
+            << " throughput: " << (bodyBytes / (us > 0 ? us : 1)) << " MB/s"
+            << " cpu: " << (cpuStop - cpuStart) * 1000000 / CLOCKS_PER_SEC
+            << " us"
+            << " pool allocations: "
+            << (after.hits + after.misses) - (before.hits + before.misses)
+            << "\n";
+}
+
+}  // namespace wpi
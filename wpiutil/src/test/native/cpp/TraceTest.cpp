@@ -0,0 +1,170 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/Trace.h"  // NOLINT(build/include_order)
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "gtest/gtest.h"
+#include "wpi/json.h"
+#include "wpi/raw_ostream.h"
+
+namespace wpi {
+
+class TraceTest : public ::testing::Test {
+ protected:
+  TraceTest() { trace::Clear(); }
+  ~TraceTest() override {
+    trace::SetEnabled(false);
+    trace::Clear();
+  }
+
+  static json Export() {
+    std::string str;
+    raw_string_ostream os{str};
+    trace::WriteChromeTrace(os);
+    os.flush();
+    return json::parse(str);
+  }
+
+  static int CountZones(const json& j, std::string_view name) {
+    int count = 0;
+    for (auto&& event : j.at("traceEvents")) {
+      if (event.at("ph") == "X" && event.at("name") == name) {
+        ++count;
+      }
+    }
+    return count;
+  }
+};
+
+TEST_F(TraceTest, Disabled) {
+  {
+    WPI_TRACE_SCOPE("disabled");
+  }
+  ASSERT_EQ(CountZones(Export(), "disabled"), 0);
+}
+
+TEST_F(TraceTest, Enabled) {
+  trace::SetEnabled(true);
+  {
+    WPI_TRACE_SCOPE("outer");
+    WPI_TRACE_SCOPE("inner");
+  }
+  auto j = Export();
+  ASSERT_EQ(CountZones(j, "outer"), 1);
+  ASSERT_EQ(CountZones(j, "inner"), 1);
+  for (auto&& event : j.at("traceEvents")) {
+    if (event.at("ph") == "X") {
+      ASSERT_GE(event.at("dur").get<double>(), 0.0);
+    }
+  }
+}
+
+TEST_F(TraceTest, Threads) {
+  trace::SetEnabled(true);
+  std::thread thr([] {
+    trace::SetThreadName("worker");
+    WPI_TRACE_SCOPE("thread");
+  });
+  thr.join();
+  {
+    WPI_TRACE_SCOPE("main");
+  }
+  auto j = Export();
+  ASSERT_EQ(CountZones(j, "thread"), 1);
+  ASSERT_EQ(CountZones(j, "main"), 1);
+  bool foundName = false;
+  for (auto&& event : j.at("traceEvents")) {
+    if (event.at("ph") == "M" && event.at("args").at("name") == "worker") {
+      foundName = true;
+    }
+  }
+  ASSERT_TRUE(foundName);
+}
+
+TEST_F(TraceTest, ExitedThreads) {
+  trace::SetEnabled(true);
+  for (int i = 0; i < 20; ++i) {
+    std::thread thr([] { WPI_TRACE_SCOPE("exited"); });
+    thr.join();
+  }
+
+  // Only a bounded number of exited threads are kept until written out
+  int count = CountZones(Export(), "exited");
+  ASSERT_GT(count, 0);
+  ASSERT_LT(count, 20);
+
+  // Once written out, exited threads' buffers are released
+  ASSERT_EQ(CountZones(Export(), "exited"), 0);
+}
+
+TEST_F(TraceTest, DisabledThreadName) {
+  std::thread thr([] { trace::SetThreadName("idle"); });
+  thr.join();
+  auto j = Export();
+  for (auto&& event : j.at("traceEvents")) {
+    ASSERT_NE(event.at("ph"), "M");
+  }
+}
+
+TEST_F(TraceTest, ConcurrentExport) {
+  trace::SetEnabled(true);
+  std::atomic_bool done{false};
+  std::thread thr([&] {
+    while (!done) {
+      WPI_TRACE_SCOPE("concurrent");
+    }
+  });
+  int bad = 0;
+  for (int i = 0; i < 10; ++i) {
+    auto j = Export();
+    for (auto&& event : j.at("traceEvents")) {
+      if (event.at("ph") == "X" && (event.at("name") != "concurrent" ||
+                                    event.at("dur").get<double>() < 0.0)) {
+        ++bad;
+      }
+    }
+  }
+  done = true;
+  thr.join();
+  ASSERT_EQ(bad, 0);
+}
+
+TEST_F(TraceTest, Wraparound) {
+  trace::SetEnabled(true);
+  for (int i = 0; i < 20000; ++i) {
+    WPI_TRACE_SCOPE("wrap");
+  }
+  int count = CountZones(Export(), "wrap");
+  ASSERT_GT(count, 0);
+  ASSERT_LT(count, 20000);
+}
+
+// Disabled by default as it only reports timings
+TEST_F(TraceTest, DISABLED_Benchmark) {
+  using std::chrono::duration_cast;
+  using std::chrono::high_resolution_clock;
+  using std::chrono::nanoseconds;
+
+  static constexpr int kCount = 1000000;
+
+  for (bool enabled : {false, true}) {
+    trace::SetEnabled(enabled);
+    auto start = high_resolution_clock::now();
+    for (int i = 0; i < kCount; ++i) {
+      WPI_TRACE_SCOPE("bench");
+    }
+    auto stop = high_resolution_clock::now();
+    std::cout << "trace zone enabled: " << enabled << " time per zone: "
+              << duration_cast<nanoseconds>(stop - start).count() / kCount
+              << " ns\n";
+  }
+}
+
+}  // namespace wpi
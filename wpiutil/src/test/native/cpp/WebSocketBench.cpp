@@ -0,0 +1,120 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/WebSocket.h"  // NOLINT(build/include_order)
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "wpi/WebSocketServer.h"
+#include "wpi/uv/Loop.h"
+#include "wpi/uv/Tcp.h"
+#include "wpi/uv/Timer.h"
+
+namespace wpi {
+
+// Sends totalBytes of binary messages from a (masking) client to a server
+// over TCP loopback and reports the achieved throughput.
+static void BenchmarkClientToServer(size_t msgSize, bool stream) {
+  using std::chrono::duration_cast;
+  using std::chrono::high_resolution_clock;
+  using std::chrono::microseconds;
+
+  static constexpr size_t kTotalBytes = 8 * 1024 * 1024;
+  static constexpr int kInFlight = 16;
+  size_t count = kTotalBytes / msgSize;
+
+  auto loop = uv::Loop::Create();
+  auto server = uv::Tcp::Create(loop);
+  auto client = uv::Tcp::Create(loop);
+
+  server->Bind("127.0.0.1", 0);
+  auto addr = server->GetSock();
+  unsigned int port =
+      ntohs(reinterpret_cast<const sockaddr_in&>(addr).sin_port);
+
+  std::vector<uint8_t> data(msgSize);
+  for (size_t i = 0; i < msgSize; ++i) {
+    data[i] = i & 0xff;
+  }
+
+  size_t sent = 0;
+  size_t recvBytes = 0;
+  size_t recvCount = 0;
+  high_resolution_clock::time_point start;
+  high_resolution_clock::time_point stop;
+
+  auto finish = [&] {
+    loop->Walk([](uv::Handle& it) { it.Close(); });
+  };
+
+  auto failTimer = uv::Timer::Create(loop);
+  failTimer->timeout.connect([&] {
+    finish();
+    FAIL() << "benchmark timed out";
+  });
+  failTimer->Start(uv::Timer::Time{60000});
+  failTimer->Unreference();
+
+  server->Listen([&] {
+    auto conn = server->Accept();
+    auto wss = WebSocketServer::Create(*conn);
+    wss->connected.connect([&](std::string_view, WebSocket& ws) {
+      ws.SetMaxMessageSize(msgSize);
+      ws.SetStreamFrames(stream);
+      ws.binary.connect([&](auto inData, bool fin) {
+        recvBytes += inData.size();
+        if (fin && ++recvCount == count) {
+          stop = high_resolution_clock::now();
+          finish();
+        }
+      });
+    });
+  });
+
+  std::function<void(WebSocket&)> sendNext = [&](WebSocket& ws) {
+    if (sent >= count) {
+      return;
+    }
+    ++sent;
+    ws.SendBinary({uv::Buffer{data}}, [&, s = &ws](auto, uv::Error err) {
+      if (!err) {
+        sendNext(*s);
+      }
+    });
+  };
+
+  client->Connect("127.0.0.1", port, [&] {
+    auto ws = WebSocket::CreateClient(*client, "/bench", "localhost");
+    ws->open.connect([&, s = ws.get()](std::string_view) {
+      start = high_resolution_clock::now();
+      for (int i = 0; i < kInFlight; ++i) {
+        sendNext(*s);
+      }
+    });
+  });
+
+  loop->Run();
+
+  ASSERT_EQ(recvBytes, count * msgSize);
+  auto us = duration_cast<microseconds>(stop - start).count();
+  std::cout << "WebSocket client->server msgSize: " << msgSize
+            << " stream: " << stream << " time: " << us << " us"
+            << " throughput: " << (recvBytes / (us > 0 ? us : 1)) << " MB/s"
+            << "\n";
+}
+
+// Disabled by default as it only reports timings; run with
+// --gtest_also_run_disabled_tests --gtest_filter='*Benchmark*'
+TEST(WebSocketBenchmark, DISABLED_ClientToServer) {
+  for (size_t msgSize : {64, 1024, 65536}) {
+    BenchmarkClientToServer(msgSize, false);
+    BenchmarkClientToServer(msgSize, true);
+  }
+}
+
+}  // namespace wpi
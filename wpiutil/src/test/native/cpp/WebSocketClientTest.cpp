@@ -271,6 +271,35 @@ TEST_P(WebSocketClientDataTest, SendBinary) {
   ASSERT_EQ(gotCallback, 1);
 }
 
+TEST_P(WebSocketClientDataTest, SendBinaryMultiple) {
+  int gotCallback = 0;
+  std::vector<uint8_t> data(GetParam());
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = (i * 7) & 0xff;
+  }
+  std::vector<uint8_t> data2(3, 0x05u);
+  std::vector<uint8_t> combData{data};
+  combData.insert(combData.end(), data2.begin(), data2.end());
+  setupWebSocket = [&] {
+    ws->open.connect([&](std::string_view) {
+      ws->SendBinary({{data}, {data2}}, [&](auto bufs, uv::Error) {
+        ++gotCallback;
+        ws->Terminate();
+        ASSERT_EQ(bufs.size(), 2u);
+        ASSERT_EQ(bufs[0].base, reinterpret_cast<const char*>(data.data()));
+        ASSERT_EQ(bufs[1].base, reinterpret_cast<const char*>(data2.data()));
+      });
+    });
+  };
+
+  loop->Run();
+
+  auto expectData = BuildMessage(0x02, true, true, combData);
+  AdjustMasking(wireData);
+  ASSERT_EQ(wireData, expectData);
+  ASSERT_EQ(gotCallback, 1);
+}
+
 TEST_P(WebSocketClientDataTest, ReceiveBinary) {
   int gotCallback = 0;
   std::vector<uint8_t> data(GetParam(), 0x03u);
@@ -470,6 +470,77 @@ TEST_F(WebSocketServerTest, ReceiveFragmentSeparate) {
   ASSERT_EQ(gotCallback, 3);
 }
 
+// Or streamed as frame data arrives
+TEST_F(WebSocketServerTest, ReceiveFragmentStreamed) {
+  int gotCallback = 0;
+
+  std::vector<uint8_t> data(5);
+  std::vector<uint8_t> data2(7);
+  std::vector<uint8_t> data3(300);
+  for (size_t i = 0; i < data3.size(); ++i) {
+    data3[i] = i & 0xff;
+    if (i < data.size()) {
+      data[i] = 0x10 + i;
+    }
+    if (i < data2.size()) {
+      data2[i] = 0x20 + i;
+    }
+  }
+  std::vector<uint8_t> combData{data};
+  combData.insert(combData.end(), data2.begin(), data2.end());
+  combData.insert(combData.end(), data3.begin(), data3.end());
+  std::vector<uint8_t> recvData;
+
+  setupWebSocket = [&] {
+    ws->SetStreamFrames(true);
+    ws->binary.connect([&](auto inData, bool fin) {
+      ++gotCallback;
+      recvData.insert(recvData.end(), inData.begin(), inData.end());
+      if (fin) {
+        ws->Terminate();
+      }
+    });
+  };
+
+  auto message = BuildMessage(0x02, false, true, data);
+  auto message2 = BuildMessage(0x00, false, true, data2);
+  auto message3 = BuildMessage(0x00, true, true, data3);
+  resp.headersComplete.connect([&](bool) {
+    clientPipe->Write({{message}, {message2}, {message3}},
+                      [&](auto bufs, uv::Error) {});
+  });
+
+  loop->Run();
+
+  ASSERT_GE(gotCallback, 3);
+  ASSERT_EQ(combData, recvData);
+}
+
+// Streamed frames are still validated
+TEST_F(WebSocketServerTest, ReceiveFragmentStreamedInvalidNoPrevFrame) {
+  int gotCallback = 0;
+  std::vector<uint8_t> data(4, 0x03);
+  setupWebSocket = [&] {
+    ws->SetStreamFrames(true);
+    ws->binary.connect([&](auto, bool) {
+      ws->Terminate();
+      FAIL() << "Should not have gotten continuation data";
+    });
+    ws->closed.connect([&](uint16_t code, std::string_view reason) {
+      ++gotCallback;
+      ASSERT_EQ(code, 1002) << "reason: " << reason;
+    });
+  };
+  auto message = BuildMessage(0x00, false, true, data);
+  resp.headersComplete.connect([&](bool) {
+    clientPipe->Write({{message}}, [&](auto bufs, uv::Error) {});
+  });
+
+  loop->Run();
+
+  ASSERT_EQ(gotCallback, 1);
+}
+
 //
 // Maximum message size is limited.
 //
@@ -664,6 +735,59 @@ TEST_P(WebSocketServerDataTest, ReceiveBinary) {
   ASSERT_EQ(gotCallback, 1);
 }
 
+TEST_P(WebSocketServerDataTest, ReceiveBinaryPattern) {
+  int gotCallback = 0;
+  std::vector<uint8_t> data(GetParam());
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = (i * 7) & 0xff;
+  }
+  setupWebSocket = [&] {
+    ws->binary.connect([&](auto inData, bool fin) {
+      ++gotCallback;
+      ws->Terminate();
+      ASSERT_TRUE(fin);
+      std::vector<uint8_t> recvData{inData.begin(), inData.end()};
+      ASSERT_EQ(data, recvData);
+    });
+  };
+  auto message = BuildMessage(0x02, true, true, data);
+  resp.headersComplete.connect([&](bool) {
+    clientPipe->Write({{message}}, [&](auto bufs, uv::Error) {});
+  });
+
+  loop->Run();
+
+  ASSERT_EQ(gotCallback, 1);
+}
+
+TEST_P(WebSocketServerDataTest, ReceiveBinaryStreamed) {
+  int gotFin = 0;
+  std::vector<uint8_t> data(GetParam());
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = (i * 7) & 0xff;
+  }
+  std::vector<uint8_t> recvData;
+  setupWebSocket = [&] {
+    ws->SetStreamFrames(true);
+    ws->binary.connect([&](auto inData, bool fin) {
+      recvData.insert(recvData.end(), inData.begin(), inData.end());
+      if (fin) {
+        ++gotFin;
+        ws->Terminate();
+      }
+    });
+  };
+  auto message = BuildMessage(0x02, true, true, data);
+  resp.headersComplete.connect([&](bool) {
+    clientPipe->Write({{message}}, [&](auto bufs, uv::Error) {});
+  });
+
+  loop->Run();
+
+  ASSERT_EQ(gotFin, 1);
+  ASSERT_EQ(data, recvData);
+}
+
 TEST_P(WebSocketServerDataTest, ReceivePing) {
   int gotCallback = 0;
   std::vector<uint8_t> data(GetParam(), 0x03u);
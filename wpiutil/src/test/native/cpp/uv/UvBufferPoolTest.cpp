@@ -0,0 +1,138 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/uv/BufferPool.h"  // NOLINT(build/include_order)
+
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"  // NOLINT(build/include_order)
+
+namespace wpi::uv {
+
+TEST(UvBufferPool, AllocateSize) {
+  auto buf = Buffer::Allocate(100);
+  ASSERT_NE(buf.base, nullptr);
+  ASSERT_EQ(buf.len, 100u);  // NOLINT
+  buf.Deallocate();
+  ASSERT_EQ(buf.base, nullptr);
+  ASSERT_EQ(buf.len, 0u);  // NOLINT
+}
+
+TEST(UvBufferPool, ReleaseReuse) {
+  auto& pool = BufferPool::GetInstance();
+  auto buf1 = Buffer::Allocate(100);
+  auto base = buf1.base;
+  buf1.Deallocate();
+
+  auto before = pool.GetStats();
+  auto buf2 = Buffer::Allocate(128);  // same size class
+  auto after = pool.GetStats();
+  ASSERT_EQ(buf2.base, base);
+  ASSERT_EQ(after.hits, before.hits + 1);
+  ASSERT_EQ(after.misses, before.misses);
+  buf2.Deallocate();
+}
+
+TEST(UvBufferPool, ShortenedLen) {
+  auto buf1 = Buffer::Allocate(1000);
+  auto base = buf1.base;
+  buf1.len = 8;  // shrinking len must not affect the size class
+  buf1.Deallocate();
+
+  auto buf2 = Buffer::Allocate(1024);
+  ASSERT_EQ(buf2.base, base);
+  buf2.Deallocate();
+}
+
+TEST(UvBufferPool, Outstanding) {
+  auto& pool = BufferPool::GetInstance();
+  auto before = pool.GetStats();
+  auto buf1 = Buffer::Allocate(100);
+  auto buf2 = Buffer::Allocate(BufferPool::kMaxSize * 2);
+  auto during = pool.GetStats();
+  ASSERT_EQ(during.outstandingBuffers, before.outstandingBuffers + 2);
+  ASSERT_EQ(during.outstandingBytes,
+            before.outstandingBytes + 128 + BufferPool::kMaxSize * 2);
+
+  // released on another thread than they were allocated on
+  std::thread thr([&] {
+    buf1.Deallocate();
+    buf2.Deallocate();
+  });
+  thr.join();
+  auto after = pool.GetStats();
+  ASSERT_EQ(after.outstandingBuffers, before.outstandingBuffers);
+  ASSERT_EQ(after.outstandingBytes, before.outstandingBytes);
+}
+
+TEST(UvBufferPool, ForeignBuffer) {
+  auto& pool = BufferPool::GetInstance();
+
+  // buffers allocated with new[] outside the pool are freed, not pooled
+  Buffer buf{new char[100], 100};
+  auto before = pool.GetStats();
+  buf.Deallocate();
+  auto after = pool.GetStats();
+  ASSERT_EQ(buf.base, nullptr);
+  ASSERT_EQ(after.freed, before.freed + 1);
+  ASSERT_EQ(after.pooled, before.pooled);
+  ASSERT_EQ(after.outstandingBuffers, before.outstandingBuffers);
+}
+
+TEST(UvBufferPool, Oversized) {
+  auto& pool = BufferPool::GetInstance();
+  auto before = pool.GetStats();
+  auto buf = Buffer::Allocate(BufferPool::kMaxSize * 4);
+  ASSERT_EQ(buf.len, BufferPool::kMaxSize * 4);  // NOLINT
+  buf.Deallocate();
+  auto after = pool.GetStats();
+  ASSERT_EQ(after.misses, before.misses + 1);
+  ASSERT_EQ(after.freed, before.freed + 1);
+}
+
+TEST(UvBufferPool, CrossThread) {
+  auto& pool = BufferPool::GetInstance();
+  auto before = pool.GetStats();
+  std::vector<Buffer> bufs;
+  std::thread thr([&] {
+    for (int i = 0; i < 100; ++i) {
+      bufs.emplace_back(Buffer::Allocate(4096));
+    }
+  });
+  thr.join();
+  for (auto&& buf : bufs) {
+    buf.Deallocate();
+  }
+  auto after = pool.GetStats();
+  ASSERT_EQ(after.pooled, before.pooled + 100);
+
+  // the blocks are available to other threads once flushed
+  pool.FlushThreadCache();
+  std::thread thr2([&] {
+    auto before2 = pool.GetStats();
+    auto buf = Buffer::Allocate(4096);
+    ASSERT_EQ(pool.GetStats().hits, before2.hits + 1);
+    buf.Deallocate();
+  });
+  thr2.join();
+}
+
+TEST(UvBufferPool, SteadyState) {
+  auto& pool = BufferPool::GetInstance();
+  // warm up
+  for (int i = 0; i < 4; ++i) {
+    Buffer::Allocate(4096).Deallocate();
+  }
+  auto before = pool.GetStats();
+  for (int i = 0; i < 1000; ++i) {
+    auto buf = Buffer::Allocate(4096);
+    buf.Deallocate();
+  }
+  auto after = pool.GetStats();
+  ASSERT_EQ(after.misses, before.misses);
+  ASSERT_EQ(after.hits, before.hits + 1000);
+}
+
+}  // namespace wpi::uv